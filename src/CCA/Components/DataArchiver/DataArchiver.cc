@@ -41,6 +41,7 @@
 #include <Core/Grid/Grid.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Task.h>
+#include <Core/Grid/Variables/CompressionCodec.h>
 #include <Core/Grid/Variables/VarTypes.h>
 #include <Core/Parallel/Parallel.h>
 #include <Core/Parallel/ProcessorGroup.h>
@@ -56,6 +57,7 @@
 
 #include <sci_defs/visit_defs.h>
 
+#include <algorithm>
 #include <cerrno>
 #include <cmath>
 #include <cstdio>
@@ -64,6 +66,8 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <list>
+#include <map>
 #include <sstream>
 #include <strings.h>
 #include <sys/param.h>
@@ -94,12 +98,102 @@ namespace Uintah {
   Dout g_DA_dbg( "DataArchiver_DBG", "DataArchiver", "general debug information"  , false );
 }
 
+namespace {
+  Dout g_DA_async( "DataArchiver_Async", "DataArchiver", "asynchronous output staging and I/O thread activity", false );
+  Dout g_DA_aggregate( "DataArchiver_Aggregate", "DataArchiver", "aggregated (N-to-M) output groups and transfers", false );
+
+  // Largest single MPI message used when gathering aggregated output.
+  const size_t AGGREGATE_MSG_SIZE = 1UL << 30;
+
+  // Message tags of the aggregation transfers.  Output and checkpoints
+  // also use different communicators, the tags only make the traffic
+  // easy to tell apart.
+  const int AGGREGATE_OUTPUT_TAG     = 1;
+  const int AGGREGATE_CHECKPOINT_TAG = 2;
+
+  void
+  sendBytes( const char * buffer, size_t size, int dest, int tag, MPI_Comm comm )
+  {
+    for( size_t offset = 0; offset < size; offset += AGGREGATE_MSG_SIZE ) {
+      int count = (int) std::min( AGGREGATE_MSG_SIZE, size - offset );
+      Uintah::MPI::Send( const_cast<char*>( buffer + offset ), count, MPI_BYTE, dest, tag, comm );
+    }
+  }
+
+  void
+  recvBytes( char * buffer, size_t size, int source, int tag, MPI_Comm comm )
+  {
+    for( size_t offset = 0; offset < size; offset += AGGREGATE_MSG_SIZE ) {
+      int count = (int) std::min( AGGREGATE_MSG_SIZE, size - offset );
+      Uintah::MPI::Recv( buffer + offset, count, MPI_BYTE, source, tag, comm, MPI_STATUS_IGNORE );
+    }
+  }
+
+  // Creates the <Variable> elements of an xml index from a binary index.
+  void
+  appendVariableIndex( ProblemSpecP doc, const BinaryIndex & index )
+  {
+    const std::vector<BinaryIndex::Variable> & variables = index.variables();
+    const std::vector<BinaryIndex::Record>   & records   = index.records();
+
+    for( unsigned int i = 0; i < records.size(); ++i ) {
+      const BinaryIndex::Record   & record = records[i];
+      const BinaryIndex::Variable & var    = variables[ record.variable ];
+
+      ProblemSpecP pdElem = doc->appendChild( "Variable" );
+
+      pdElem->appendElement( "variable", var.name );
+      pdElem->appendElement( "index",    record.matl );
+      pdElem->appendElement( "patch",    record.patch );
+      pdElem->setAttribute(  "type",     var.type );
+
+      if( var.boundaryLayer != IntVector(0,0,0) ) {
+        pdElem->appendElement( "boundaryLayer", var.boundaryLayer );
+      }
+
+      pdElem->appendElement( "start", (long) record.start );
+
+      if( !var.compression.empty() ) {
+        pdElem->appendElement( "compression", var.compression );
+      }
+      if( record.numParticles >= 0 ) {
+        pdElem->appendElement( "numParticles", record.numParticles );
+      }
+
+      pdElem->appendElement( "end",      (long) record.end );
+      pdElem->appendElement( "filename", index.dataFilename() );
+    }
+  }
+}
+
 using namespace std;
 
 namespace {
 #ifdef HAVE_PIDX
   DebugStream dbgPIDX ("DataArchiverPIDX", "DataArchiver", "Data archiver PIDX debug stream", false);
 #endif
+
+  //______________________________________________________________________
+  //
+  void
+  checkCompressionMode( const string & mode, const string & where, bool allowLossy )
+  {
+    if( !CompressionCodec::isValid( mode ) ) {
+      string valid = "none";
+      for( const string & name : CompressionCodec::getNames() ) {
+        valid += ", " + name;
+      }
+      throw ProblemSetupException( "Unknown compression '" + mode + "' in " + where + ", valid modes are: " + valid
+                                   + " (lossy requires an absoluteError or relativeError)", __FILE__, __LINE__ );
+    }
+
+    const CompressionCodec * codec = CompressionCodec::find( mode );
+
+    if( codec != nullptr && !codec->isLossless() && !allowLossy ) {
+      throw ProblemSetupException( "Lossy compression '" + mode + "' in " + where + " is only allowed for individual <save> labels",
+                                   __FILE__, __LINE__ );
+    }
+  }
 }
 
 //______________________________________________________________________
@@ -142,8 +236,25 @@ DataArchiver::DataArchiver(const ProcessorGroup* myworld, int udaSuffix)
 DataArchiver::~DataArchiver()
 {
   DOUTR( g_DA_dbg,"DataArchiver::~DataArchiver()" );
+
+  // Never let an I/O error escape the destructor.
+  try {
+    stopAsyncWriter();
+  }
+  catch( const Exception & e ) {
+    std::cerr << "DataArchiver::~DataArchiver(): asynchronous output failed: " << e.message() << "\n";
+  }
+
   VarLabel::destroy( m_sync_io_label );
 
+  // The communicators are freed before MPI is finalized unless the
+  // run is being torn down after an error.
+  int finalized = 0;
+  Uintah::MPI::Finalized( &finalized );
+  if( !finalized ) {
+    freeAggregationCommunicators();
+  }
+
   if(m_tmpMatSubset && m_tmpMatSubset->removeReference()) {
     delete m_tmpMatSubset;
   }
@@ -243,6 +354,64 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
 
   m_outputDoubleAsFloat = p->findBlock("outputDoubleAsFloat") != nullptr;
 
+  //__________________________________
+  // Format of the per-rank variable index files
+  string indexFormat = "xml";
+  p->get( "indexFormat", indexFormat );
+
+  if( indexFormat == "binary" ) {
+    if( m_outputFileFormat == PIDX ) {
+      throw ProblemSetupException( "DataArchiver: a binary <indexFormat> is only supported for the UDA output format", __FILE__, __LINE__ );
+    }
+    m_binaryIndex = true;
+  }
+  else if( indexFormat != "xml" ) {
+    throw ProblemSetupException( "DataArchiver: unknown <indexFormat> '" + indexFormat + "' (xml or binary)", __FILE__, __LINE__ );
+  }
+
+  //__________________________________
+  // Asynchronous output
+  ProblemSpecP async_ps = p->findBlock("asyncOutput");
+  if( async_ps != nullptr ) {
+    if( m_outputFileFormat == PIDX ) {
+      throw ProblemSetupException( "DataArchiver: <asyncOutput> is only supported for the UDA output format", __FILE__, __LINE__ );
+    }
+
+    double memoryBudget = 512.0;   // MBytes
+    async_ps->getAttribute( "memoryBudget", memoryBudget );
+
+    if( memoryBudget <= 0.0 ) {
+      throw ProblemSetupException( "DataArchiver: <asyncOutput> memoryBudget must be positive", __FILE__, __LINE__ );
+    }
+
+    m_asyncOutput       = true;
+    m_asyncMemoryBudget = static_cast<size_t>( memoryBudget * 1024.0 * 1024.0 );
+
+    proc0cout << "DataArchiver: asynchronous output enabled, staging memory budget "
+              << memoryBudget << " MBytes per rank\n";
+
+    startAsyncWriter();
+  }
+
+  //__________________________________
+  // Aggregated (N-to-M) output
+  ProblemSpecP aggregate_ps = p->findBlock("aggregateOutput");
+  if( aggregate_ps != nullptr ) {
+    if( m_outputFileFormat == PIDX ) {
+      throw ProblemSetupException( "DataArchiver: <aggregateOutput> is only supported for the UDA output format", __FILE__, __LINE__ );
+    }
+
+    int ranksPerFile = 0;   // 0 - one file per compute node
+    aggregate_ps->getAttribute( "ranksPerFile", ranksPerFile );
+
+    if( ranksPerFile < 0 ) {
+      throw ProblemSetupException( "DataArchiver: <aggregateOutput> ranksPerFile must not be negative", __FILE__, __LINE__ );
+    }
+
+    m_aggregateOutput = true;
+    setupAggregationGroups( ranksPerFile );
+  }
+
   // For outputing the sim time and/or time step with the global vars
   p->get("timeStep", m_outputGlobalVarsTimeStep); // default false
   p->get("simTime",  m_outputGlobalVarsSimTime);  // default true
@@ -294,12 +463,19 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     m_outputLastTimeStep = false; // default
   }
 
-  // set default compression mode - can be "gzip" or ""
+  // set default compression mode - any CompressionCodec name or ""
   string defaultCompressionMode = "";
   if (p->get("compression", defaultCompressionMode)) {
+    checkCompressionMode( defaultCompressionMode, "<compression>", false );
     VarLabel::setDefaultCompressionMode(defaultCompressionMode);
   }
 
+  // threads used by the block compression codecs
+  int compressionThreads;
+  if (p->get("compressionThreads", compressionThreads)) {
+    CompressionCodec::setNumThreads(compressionThreads);
+  }
+
   if (params->findBlock("ParticlePosition")) {
     params->findBlock("ParticlePosition")->getAttribute("label",m_particlePositionName);
   }
@@ -327,6 +503,23 @@ DataArchiver::problemSetup( const ProblemSpecP    & params,
     saveItem.labelName       = attributes["label"];
     saveItem.compressionMode = attributes["compression"];
 
+    // lossy compression takes its error bound from the absoluteError
+    // or relativeError (fraction of the range of the values) attribute
+    if( saveItem.compressionMode == "lossy" ) {
+      if( attributes.count("absoluteError") == attributes.count("relativeError") ) {
+        throw ProblemSetupException( "<save label=\"" + saveItem.labelName + "\" compression=\"lossy\"> requires "
+                                     "either an absoluteError or a relativeError attribute", __FILE__, __LINE__ );
+      }
+      if( attributes.count("absoluteError") ) {
+        saveItem.compressionMode += ":abs=" + attributes["absoluteError"];
+      }
+      else {
+        saveItem.compressionMode += ":rel=" + attributes["relativeError"];
+      }
+    }
+
+    checkCompressionMode( saveItem.compressionMode, "<save label=\"" + saveItem.labelName + "\">", true );
+
     try {
       saveItem.matls = ConsecutiveRangeSet(attributes["material"]);
     }
@@ -1192,6 +1385,12 @@ DataArchiver::sched_allOutputTasks( const GridP      & grid,
     sched_outputVariables( m_checkpointLabels, grid, sched, true );
   }
 
+  //__________________________________
+  //  The aggregation groups on each level depend on the patch distribution.
+  if ( m_aggregateOutput ) {
+    createAggregationCommunicators( grid );
+  }
+
   //__________________________________
   //
 #if HAVE_PIDX
@@ -1240,6 +1439,11 @@ DataArchiver::setCheckpointTimeStep( bool val,
 
     // Create the output checkpoint directories
     if( m_isCheckpointTimeStep ) {
+
+      // A checkpoint must never be taken while output data is still
+      // in flight - drain the asynchronous writer first.
+      flushAsyncOutput();
+
       string timestepDir;
       makeTimeStepDirs( m_checkpointsDir, m_checkpointLabels, grid, &timestepDir );
       m_checkpointTimeStepDirs.push_back( timestepDir );
@@ -2276,26 +2480,25 @@ DataArchiver::writeGridOriginal( const bool hasGlobals,
   ProblemSpecP dataElem = rootElem->appendChild( "Data" );
 
   for( int l = 0;l < numLevels; l++ ) {
-    ostringstream lname;
-    lname << "l" << l;
 
-    // Create a pxxxxx.xml file for each proc doing the outputting.
+    // Create a pxxxxx.xml file for each proc doing the outputting
+    // (or an axxxxx.xml file for each aggregation group).
+    vector<DatafileEntry> entries;
+    getDatafileEntries( l, procOnLevel[l], entries );
 
-    for( int i = 0; i < d_myworld->nRanks(); i++ ) {
-      if( ( i % m_loadBalancer->getNthRank() ) != 0 || !procOnLevel[l][i] ){
-        continue;
-      }
-
-      ostringstream pname;
-      pname << lname.str() << "/p" << setw(5) << setfill('0') << i << ".xml";
+    for( unsigned int e = 0; e < entries.size(); e++ ) {
 
       ostringstream procID;
-      procID << i;
+      procID << entries[e].proc;
 
       ProblemSpecP df = dataElem->appendChild("Datafile");
 
-      df->setAttribute( "href", pname.str() );
+      df->setAttribute( "href", entries[e].href );
       df->setAttribute( "proc", procID.str() );
+
+      if( !entries[e].procs.empty() ) {
+        df->setAttribute( "procs", entries[e].procs );
+      }
     }
   }
 
@@ -2464,27 +2667,26 @@ DataArchiver::writeDataTextWriter( const bool hasGlobals,
   xmlTextWriterStartElement( data_writer, BAD_CAST "Data" );
 
   for( int l = 0; l < numLevels; l++ ) {
-    ostringstream lname;
-    lname << "l" << l;
 
     // create a pxxxxx.xml file for each proc doing the outputting
-    for( int i = 0; i < d_myworld->nRanks(); i++ ) {
+    // (or an axxxxx.xml file for each aggregation group)
+    vector<DatafileEntry> entries;
+    getDatafileEntries( l, procOnLevel[l], entries );
 
-      if ( i % m_loadBalancer->getNthRank() != 0 || !procOnLevel[l][i] ) {
-        continue;
-      }
+    for( unsigned int e = 0; e < entries.size(); e++ ) {
 
-      ostringstream pname;
       ostringstream procID;
-
-      pname << lname.str() << "/p" << setw(5) << setfill('0') << i << ".xml";
-      procID << i;
+      procID << entries[e].proc;
 
       xmlTextWriterStartElement( data_writer, BAD_CAST "Datafile" ); // Open <Datafile>
 
-      xmlTextWriterWriteAttribute( data_writer, BAD_CAST "href", BAD_CAST pname.str().c_str() );
+      xmlTextWriterWriteAttribute( data_writer, BAD_CAST "href", BAD_CAST entries[e].href.c_str() );
       xmlTextWriterWriteAttribute( data_writer, BAD_CAST "proc", BAD_CAST procID.str().c_str() );
 
+      if( !entries[e].procs.empty() ) {
+        xmlTextWriterWriteAttribute( data_writer, BAD_CAST "procs", BAD_CAST entries[e].procs.c_str() );
+      }
+
       xmlTextWriterEndElement( data_writer ); // Close <Datafile>
     }
   }
@@ -2559,6 +2761,16 @@ DataArchiver::sched_outputVariables(       vector<SaveItem> & saveLabels,
     msg = "DataArchiver::sched_outputVariables for (" + Uintah::to_string(var_cnt) + ") variables on";
     printSchedule( level, g_DA_dbg, msg );
 
+    // Aggregated output gathers the staged files of a group with
+    // blocking MPI calls, so the task must not run concurrently with
+    // other MPI tasks.
+    if( m_aggregateOutput ) {
+      if( m_loadBalancer->getNthRank() != 1 ) {
+        throw ProblemSetupException( "DataArchiver: <aggregateOutput> can not be combined with <outputNthProc>", __FILE__, __LINE__ );
+      }
+      task->usesMPI( true );
+    }
+
     task->setType( Task::Output );
     sched->addTask( task, patches, m_materialManager->allMaterials() );
   }
@@ -2959,7 +3171,7 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
 
     ostringstream pname;
     pname << "p" << setw(5) << setfill('0') << d_myworld->myRank();
-    xmlFilename = ldir.getName() + "/" + pname.str() + ".xml";
+    xmlFilename = ldir.getName() + "/" + pname.str() + ( m_binaryIndex ? ".idx" : ".xml" );
     dataFilebase = pname.str() + ".data";
     dataFilename = ldir.getName() + "/" + dataFilebase;
   }
@@ -2980,6 +3192,25 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
   // file, but also lock because xerces (DOM..) has thread-safety issues.
 
   if( m_outputFileFormat == UDA || type == CHECKPOINT_GLOBAL ) {
+
+    // With asynchronous output the variables of an output time step
+    // are staged in memory and handed to the I/O thread.  Checkpoints
+    // are always written synchronously.  With aggregated output the
+    // staged data is gathered by the group's aggregator rank.
+    const bool aggregate = m_aggregateOutput && type != CHECKPOINT_GLOBAL;
+
+    // A binary index is also what the members of an aggregation group
+    // send to their aggregator.
+    const bool binaryIndex = ( m_binaryIndex || aggregate ) && type != CHECKPOINT_GLOBAL;
+    BinaryIndex index;
+
+    StagedFile * job = nullptr;
+    if( ( m_asyncOutput && type == OUTPUT ) || aggregate ) {
+      job = scinew StagedFile;
+      job->dataFilename  = dataFilename;
+      job->indexFilename = xmlFilename;
+    }
+
     m_outputLock.lock();
     {
       // Make sure doc's constructor is called after the lock.
@@ -3018,9 +3249,9 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
       int flags = O_WRONLY|O_CREAT|O_TRUNC;       // file-opening flags
 
       const char* filename = dataFilename.c_str();
-      int fd  = open( filename, flags, 0666 );
+      int fd  = ( job != nullptr ) ? -1 : open( filename, flags, 0666 );
 
-      while( fd == -1 ) {
+      while( fd == -1 && job == nullptr ) {
 
         if( tries >= 50 ) {
           ostringstream msg;
@@ -3089,19 +3320,30 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
 
             // Variables may not exist when we get here due to
             // something whacky with weird AMR stuff...
-            ProblemSpecP pdElem = doc->appendChild( "Variable" );
-
-            pdElem->appendElement( "variable", var->getName() );
-            pdElem->appendElement( "index",    matlIndex );
-            pdElem->appendElement( "patch",    patchID );
-            pdElem->setAttribute(  "type",     TranslateVariableType( var->typeDescription()->getName().c_str(), type != OUTPUT ) );
-
-            if( var->getBoundaryLayer() != IntVector(0,0,0) ) {
-              pdElem->appendElement("boundaryLayer", var->getBoundaryLayer());
+            //
+            // With a binary index emit() reports the compression and
+            // number of particles through the OutputContext.
+            ProblemSpecP pdElem = nullptr;
+
+            if( !binaryIndex ) {
+              pdElem = doc->appendChild( "Variable" );
+              pdElem->appendElement( "variable", var->getName() );
+              pdElem->appendElement( "index",    matlIndex );
+              pdElem->appendElement( "patch",    patchID );
+              pdElem->setAttribute(  "type",     TranslateVariableType( var->typeDescription()->getName().c_str(), type != OUTPUT ) );
+
+              if( var->getBoundaryLayer() != IntVector(0,0,0) ) {
+                pdElem->appendElement("boundaryLayer", var->getBoundaryLayer());
+              }
             }
 
             // Pad appropriately
-            if( cur % PADSIZE != 0 ) {
+            if( cur % PADSIZE != 0 && job != nullptr ) {
+              long pad = PADSIZE-cur%PADSIZE;
+              job->data.append( pad, '\0' );
+              cur += pad;
+            }
+            else if( cur % PADSIZE != 0 ) {
               long pad  = PADSIZE-cur%PADSIZE;
               char* zero = scinew char[pad];
               memset(zero, 0, pad);
@@ -3118,46 +3360,103 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
               delete[] zero;
             }
             ASSERTEQ(cur%PADSIZE, 0);
-            pdElem->appendElement("start", cur);
-
-            // output data to data file
-            OutputContext oc(fd, filename, cur, pdElem, m_outputDoubleAsFloat && type != CHECKPOINT);
-            totalBytes += dw->emit(oc, var, matlIndex, patch);
+            const long start = cur;
+            if( !binaryIndex ) {
+              pdElem->appendElement("start", cur);
+            }
 
-            pdElem->appendElement("end", oc.cur);
-            pdElem->appendElement("filename", dataFilebase.c_str());
+            // output data to data file (or to the staging buffer)
+            string compression;
+            int    numParticles = -1;
+
+            if( job != nullptr ) {
+              OutputContext oc(&job->data, filename, cur, pdElem, m_outputDoubleAsFloat && type != CHECKPOINT);
+              oc.checkpoint = (type == CHECKPOINT);
+              totalBytes += dw->emit(oc, var, matlIndex, patch);
+              cur = oc.cur;
+              compression.swap( oc.compression );
+              numParticles = oc.numParticles;
+              ASSERTEQ(cur, (long) job->data.size());
+            }
+            else {
+              OutputContext oc(fd, filename, cur, pdElem, m_outputDoubleAsFloat && type != CHECKPOINT);
+              oc.checkpoint = (type == CHECKPOINT);
+              totalBytes += dw->emit(oc, var, matlIndex, patch);
+              cur = oc.cur;
+              compression.swap( oc.compression );
+              numParticles = oc.numParticles;
 
 #if SCI_ASSERTION_LEVEL >= 1
-            struct stat st;
-            int s = fstat(fd, &st);
-
-            if(s == -1) {
-              cerr << "fstat error - file: " << filename
-                   << ", errno=" << errno << '\n';
-              throw ErrnoException("DataArchiver::output (stat call)",
-                                   errno, __FILE__, __LINE__);
-            }
-            ASSERTEQ(oc.cur, st.st_size);
+              struct stat st;
+              int s = fstat(fd, &st);
+
+              if(s == -1) {
+                cerr << "fstat error - file: " << filename
+                     << ", errno=" << errno << '\n';
+                throw ErrnoException("DataArchiver::output (stat call)",
+                                     errno, __FILE__, __LINE__);
+              }
+              ASSERTEQ(oc.cur, st.st_size);
 #endif
-            cur = oc.cur;
+            }
+
+            if( binaryIndex ) {
+              index.add( var->getName(),
+                         TranslateVariableType( var->typeDescription()->getName().c_str(), type != OUTPUT ),
+                         compression, var->getBoundaryLayer(), matlIndex, patchID, numParticles, start, cur );
+            }
+            else {
+              pdElem->appendElement("end", cur);
+              pdElem->appendElement("filename", dataFilebase.c_str());
+            }
           }  // matls
         }  // patches
       }  // save items
 
       //__________________________________
       // close files and handles
-      int s = close( fd );
-      if( s == -1 ) {
-        cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
-        throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+      if( binaryIndex ) {
+        index.setDataFilename( dataFilebase );
+        index.sort();
+      }
+
+      if( job != nullptr ) {
+        // The I/O thread writes both the data and the index file.
+        if( binaryIndex ) {
+          job->index.swap( index );
+        }
+        else {
+          job->doc = doc;
+        }
       }
+      else {
+        int s = close( fd );
+        if( s == -1 ) {
+          cerr << "Error closing file: " << filename << ", errno=" << errno << '\n';
+          throw ErrnoException("DataArchiver::output (close call)", errno, __FILE__, __LINE__ );
+        }
 
-      doc->output( xmlFilename.c_str() );
-      //doc->releaseDocument();
+        if( binaryIndex ) {
+          index.write( xmlFilename );
+        }
+        else {
+          doc->output( xmlFilename.c_str() );
+        }
+        //doc->releaseDocument();
+      }
 
     } // end output locked section
 
     m_outputLock.unlock();
+
+    // Must be done outside of the output lock as the I/O thread needs
+    // the lock to write the xml file.
+    if( job != nullptr && aggregate ) {
+      aggregateStagedFile( job, level, ldir, type );
+    }
+    else if( job != nullptr ) {
+      enqueueAsyncWrite( job );
+    }
   } // end UDA or Global Var
 
 #if HAVE_PIDX
@@ -3239,6 +3538,524 @@ DataArchiver::outputVariables( const ProcessorGroup * pg,
 
 } // end outputVariables()
 
+//______________________________________________________________________
+//  Assign every rank to an aggregation group.  A group is identified
+//  by its lowest world rank.
+void
+DataArchiver::setupAggregationGroups( int ranksPerFile )
+{
+  const int myRank = d_myworld->myRank();
+  const int nRanks = d_myworld->nRanks();
+
+  int myGroup = myRank;
+
+  if( ranksPerFile > 0 ) {
+    myGroup = ( myRank / ranksPerFile ) * ranksPerFile;
+  }
+  else {
+    // One group per compute node, identified by the processor name.
+    char name[ MPI_MAX_PROCESSOR_NAME ];
+    int  length;
+    memset( name, 0, MPI_MAX_PROCESSOR_NAME );
+    Uintah::MPI::Get_processor_name( name, &length );
+
+    vector<char> allNames( nRanks * MPI_MAX_PROCESSOR_NAME );
+    Uintah::MPI::Allgather( name, MPI_MAX_PROCESSOR_NAME, MPI_CHAR,
+                            allNames.data(), MPI_MAX_PROCESSOR_NAME, MPI_CHAR, d_myworld->getComm() );
+
+    for( int r = 0; r < nRanks; ++r ) {
+      if( strncmp( &allNames[ r * MPI_MAX_PROCESSOR_NAME ], name, MPI_MAX_PROCESSOR_NAME ) == 0 ) {
+        myGroup = r;
+        break;
+      }
+    }
+  }
+
+  m_aggregationGroup.resize( nRanks );
+  Uintah::MPI::Allgather( &myGroup, 1, MPI_INT, m_aggregationGroup.data(), 1, MPI_INT, d_myworld->getComm() );
+
+  int nGroups = 0;
+  for( int r = 0; r < nRanks; ++r ) {
+    if( m_aggregationGroup[r] == r ) {
+      ++nGroups;
+    }
+  }
+
+  proc0cout << "DataArchiver: aggregated output enabled, " << nGroups
+            << " aggregation group(s) for " << nRanks << " ranks\n";
+}
+
+//______________________________________________________________________
+//  One communicator per level holding the ranks of this rank's group
+//  that have output on the level.  Collective over all ranks.
+void
+DataArchiver::createAggregationCommunicators( const GridP & grid )
+{
+  freeAggregationCommunicators();
+
+  const int myRank = d_myworld->myRank();
+
+  m_aggregationComms.resize(           grid->numLevels(), MPI_COMM_NULL );
+  m_checkpointAggregationComms.resize( grid->numLevels(), MPI_COMM_NULL );
+
+  for( int i = 0; i < grid->numLevels(); i++ ) {
+    const LevelP&   level   = grid->getLevel(i);
+    const PatchSet* patches = m_loadBalancer->getOutputPerProcessorPatchSet( level );
+
+    int color = MPI_UNDEFINED;
+    if( !patches->getSubset( myRank )->empty() ) {
+      color = m_aggregationGroup[ myRank ];
+    }
+
+    Uintah::MPI::Comm_split( d_myworld->getComm(), color, myRank, &m_aggregationComms[i] );
+
+    if( m_aggregationComms[i] != MPI_COMM_NULL ) {
+      Uintah::MPI::Comm_dup( m_aggregationComms[i], &m_checkpointAggregationComms[i] );
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+DataArchiver::freeAggregationCommunicators()
+{
+  for( unsigned int i = 0; i < m_aggregationComms.size(); i++ ) {
+    if( m_aggregationComms[i] != MPI_COMM_NULL ) {
+      Uintah::MPI::Comm_free( &m_aggregationComms[i] );
+    }
+    if( m_checkpointAggregationComms[i] != MPI_COMM_NULL ) {
+      Uintah::MPI::Comm_free( &m_checkpointAggregationComms[i] );
+    }
+  }
+  m_aggregationComms.clear();
+  m_checkpointAggregationComms.clear();
+}
+
+//______________________________________________________________________
+//  The <Datafile> entries of a level for the timestep's <Data> section.
+//  Mirrors the grouping done by createAggregationCommunicators(): the
+//  aggregator of a group is its lowest rank with output on the level.
+void
+DataArchiver::getDatafileEntries(       int                     levelIndex,
+                                  const vector<bool>          & procOnLevel,
+                                        vector<DatafileEntry> & entries )
+{
+  const int nRanks = d_myworld->nRanks();
+
+  ostringstream lname;
+  lname << "l" << levelIndex;
+
+  if( !m_aggregateOutput ) {
+    for( int i = 0; i < nRanks; i++ ) {
+      if( ( i % m_loadBalancer->getNthRank() ) != 0 || !procOnLevel[i] ) {
+        continue;
+      }
+
+      ostringstream pname;
+      pname << lname.str() << "/p" << setw(5) << setfill('0') << i << ( m_binaryIndex ? ".idx" : ".xml" );
+
+      DatafileEntry entry;
+      entry.href = pname.str();
+      entry.proc = i;
+      entries.push_back( entry );
+    }
+    return;
+  }
+
+  // Group id -> ranks in the group with output on this level (in order).
+  map< int, list<int> > groups;
+  for( int i = 0; i < nRanks; i++ ) {
+    if( procOnLevel[i] ) {
+      groups[ m_aggregationGroup[i] ].push_back( i );
+    }
+  }
+
+  for( map< int, list<int> >::iterator iter = groups.begin(); iter != groups.end(); ++iter ) {
+    const int aggregator = iter->second.front();
+
+    ostringstream aname;
+    aname << lname.str() << "/a" << setw(5) << setfill('0') << aggregator << ( m_binaryIndex ? ".idx" : ".xml" );
+
+    DatafileEntry entry;
+    entry.href  = aname.str();
+    entry.proc  = aggregator;
+    entry.procs = ConsecutiveRangeSet( iter->second ).toString();
+    entries.push_back( entry );
+  }
+}
+
+//______________________________________________________________________
+//  Gather the staged data of this rank's group on the level to the
+//  group's aggregator, which writes one data file and one xml index.
+void
+DataArchiver::aggregateStagedFile(       StagedFile * job,
+                                   const Level      * level,
+                                   const Dir        & ldir,
+                                         int          type )
+{
+  if( level->getIndex() >= (int) m_aggregationComms.size() ||
+      m_aggregationComms[ level->getIndex() ] == MPI_COMM_NULL ) {
+    throw InternalError( "DataArchiver::aggregateStagedFile(): no aggregation communicator for this level", __FILE__, __LINE__ );
+  }
+
+  // Checkpoints have their own communicator and tag so their gathers
+  // can never be matched with those of an output in flight.
+  const bool isCheckpoint = ( type == CHECKPOINT );
+  const int  tag          = isCheckpoint ? AGGREGATE_CHECKPOINT_TAG : AGGREGATE_OUTPUT_TAG;
+
+  MPI_Comm comm = isCheckpoint ? m_checkpointAggregationComms[ level->getIndex() ]
+                               : m_aggregationComms[ level->getIndex() ];
+
+  int groupRank;
+  int groupSize;
+  Uintah::MPI::Comm_rank( comm, &groupRank );
+  Uintah::MPI::Comm_size( comm, &groupSize );
+
+  // The index travels in its binary form.
+  std::string index;
+  job->index.serialize( index );
+
+  long long sizes[2] = { (long long) job->data.size(), (long long) index.size() };
+  vector<long long> allSizes( 2 * groupSize, 0 );
+
+  Uintah::MPI::Gather( sizes, 2, MPI_LONG_LONG, allSizes.data(), 2, MPI_LONG_LONG, 0, comm );
+
+  //__________________________________
+  //  Group members send and are done.
+  if( groupRank != 0 ) {
+    sendBytes( index.data(),     index.size(),     0, tag, comm );
+    sendBytes( job->data.data(), job->data.size(), 0, tag, comm );
+
+    releaseStagedFile( job );
+    return;
+  }
+
+  //__________________________________
+  //  The aggregator
+  Timers::Simple timer;
+  timer.start();
+
+  ostringstream aname;
+  aname << "a" << setw(5) << setfill('0') << d_myworld->myRank();
+
+  const string dataFilebase = aname.str() + ".data";
+
+  size_t totalBytes = 0;
+  for( int r = 0; r < groupSize; r++ ) {
+    totalBytes += allSizes[2*r] + PADSIZE;
+  }
+
+  StagedFile * aggregate = scinew StagedFile;
+  aggregate->dataFilename  = ldir.getName() + "/" + dataFilebase;
+  aggregate->indexFilename = ldir.getName() + "/" + aname.str() + ( m_binaryIndex ? ".idx" : ".xml" );
+  aggregate->data.reserve( totalBytes );
+
+  for( int r = 0; r < groupSize; r++ ) {
+
+    // Each member's data starts on a PADSIZE boundary so the
+    // alignment of the individual variables is preserved.
+    if( aggregate->data.size() % PADSIZE != 0 ) {
+      aggregate->data.append( PADSIZE - aggregate->data.size() % PADSIZE, '\0' );
+    }
+
+    const long offset = aggregate->data.size();
+
+    if( r == 0 ) {
+      aggregate->index.append( job->index, offset );
+      aggregate->data.append( job->data );
+    }
+    else {
+      std::string memberBytes( allSizes[2*r+1], '\0' );
+      recvBytes( &memberBytes[0], memberBytes.size(), r, tag, comm );
+
+      BinaryIndex memberIndex;
+      memberIndex.deserialize( memberBytes );
+      aggregate->index.append( memberIndex, offset );
+
+      aggregate->data.resize( offset + allSizes[2*r] );
+      recvBytes( &aggregate->data[offset], allSizes[2*r], r, tag, comm );
+    }
+  }
+
+  releaseStagedFile( job );
+
+  aggregate->index.setDataFilename( dataFilebase );
+  aggregate->index.sort();
+
+  if( !m_binaryIndex ) {
+    m_outputLock.lock();
+    {
+      aggregate->doc = ProblemSpec::createDocument( "Uintah_Output" );
+      appendVariableIndex( aggregate->doc, aggregate->index );
+    }
+    m_outputLock.unlock();
+  }
+
+  DOUT( g_DA_aggregate, "Rank-" << d_myworld->myRank() << " aggregated " << groupSize
+        << " rank(s) on level " << level->getIndex() << " into " << aggregate->dataFilename
+        << " (" << aggregate->data.size() << " bytes) in " << timer().seconds() << " seconds" );
+
+  if( m_asyncOutput && type == OUTPUT ) {
+    enqueueAsyncWrite( aggregate );
+  }
+  else {
+    try {
+      writeStagedFile( aggregate );
+    }
+    catch( ... ) {
+      releaseStagedFile( aggregate );
+      throw;
+    }
+    releaseStagedFile( aggregate );
+  }
+}
+
+//______________________________________________________________________
+//  Start the dedicated I/O thread used for asynchronous output.
+void
+DataArchiver::startAsyncWriter()
+{
+  if( m_asyncThread.joinable() ) {
+    return;
+  }
+
+  m_asyncStop = false;
+  m_asyncThread = std::thread( &DataArchiver::asyncWriterLoop, this );
+}
+
+//______________________________________________________________________
+//  Flush all pending writes and join the I/O thread.
+void
+DataArchiver::stopAsyncWriter()
+{
+  if( !m_asyncThread.joinable() ) {
+    return;
+  }
+
+  {
+    std::unique_lock<std::mutex> lock( m_asyncMutex );
+    m_asyncStop = true;
+  }
+  m_asyncCV.notify_all();
+
+  m_asyncThread.join();
+
+  if( !m_asyncError.empty() ) {
+    std::string msg = m_asyncError;
+    m_asyncError.clear();
+    throw InternalError( msg, __FILE__, __LINE__ );
+  }
+}
+
+//______________________________________________________________________
+//  Hand a staged time step file to the I/O thread.  Blocks while the
+//  staged data would exceed the memory budget.  A single job larger
+//  than the budget is accepted once the queue has drained.
+void
+DataArchiver::enqueueAsyncWrite( StagedFile * job )
+{
+  Timers::Simple timer;
+  timer.start();
+
+  const size_t bytes = job->data.size();
+  {
+    std::unique_lock<std::mutex> lock( m_asyncMutex );
+
+    m_asyncCV.wait( lock, [&]{
+        return !m_asyncError.empty() ||
+               ( m_asyncQueue.empty() && !m_asyncWriting ) ||
+               m_asyncBytesQueued + bytes <= m_asyncMemoryBudget; } );
+
+    if( !m_asyncError.empty() ) {
+      std::string msg = m_asyncError;
+      lock.unlock();
+      releaseStagedFile( job );
+      throw InternalError( msg, __FILE__, __LINE__ );
+    }
+
+    m_asyncBytesQueued += bytes;
+    m_asyncQueue.push_back( job );
+
+    DOUT( g_DA_async, "Rank-" << d_myworld->myRank() << " staged " << job->dataFilename
+          << " (" << bytes << " bytes), " << m_asyncQueue.size() << " file(s) / "
+          << m_asyncBytesQueued << " bytes pending" );
+  }
+  m_asyncCV.notify_all();
+
+  double waitTime = timer().seconds();
+  (*m_runtimeStats)[ OutputAsyncWaitTime ] += waitTime;
+  (*m_runtimeStats)[ TotalIOTime ] += waitTime;
+}
+
+//______________________________________________________________________
+//  Barrier - returns once every staged file is on disk.
+void
+DataArchiver::flushAsyncOutput()
+{
+  if( !m_asyncOutput ) {
+    return;
+  }
+
+  Timers::Simple timer;
+  timer.start();
+
+  std::unique_lock<std::mutex> lock( m_asyncMutex );
+
+  m_asyncCV.wait( lock, [&]{
+      return !m_asyncError.empty() || ( m_asyncQueue.empty() && !m_asyncWriting ); } );
+
+  if( !m_asyncError.empty() ) {
+    throw InternalError( m_asyncError, __FILE__, __LINE__ );
+  }
+
+  lock.unlock();
+
+  double waitTime = timer().seconds();
+  (*m_runtimeStats)[ OutputAsyncWaitTime ] += waitTime;
+  (*m_runtimeStats)[ TotalIOTime ] += waitTime;
+
+  DOUT( g_DA_async, "Rank-" << d_myworld->myRank() << " asynchronous output flushed in " << waitTime << " seconds" );
+}
+
+//______________________________________________________________________
+//  Body of the I/O thread.  Jobs are written in the order staged.
+void
+DataArchiver::asyncWriterLoop()
+{
+  std::unique_lock<std::mutex> lock( m_asyncMutex );
+
+  while( true ) {
+    m_asyncCV.wait( lock, [&]{ return m_asyncStop || !m_asyncQueue.empty(); } );
+
+    // After an error nothing more is written; drop what is staged so
+    // the producers are not left waiting on the memory budget.
+    if( !m_asyncError.empty() ) {
+      for( auto job : m_asyncQueue ) {
+        m_asyncBytesQueued -= job->data.size();
+        releaseStagedFile( job );
+      }
+      m_asyncQueue.clear();
+      m_asyncCV.notify_all();
+    }
+
+    if( m_asyncQueue.empty() ) {
+      if( m_asyncStop ) {
+        break;
+      }
+      continue;
+    }
+
+    StagedFile * job = m_asyncQueue.front();
+    m_asyncQueue.pop_front();
+    m_asyncWriting = true;
+
+    lock.unlock();
+
+    std::string error;
+    try {
+      writeStagedFile( job );
+    }
+    catch( const Exception & e ) {
+      error = e.message();
+    }
+
+    const size_t bytes = job->data.size();
+    releaseStagedFile( job );
+
+    lock.lock();
+
+    m_asyncWriting = false;
+    m_asyncBytesQueued -= bytes;
+
+    if( !error.empty() ) {
+      m_asyncError = "DataArchiver asynchronous output failed: " + error;
+    }
+
+    m_asyncCV.notify_all();
+  }
+}
+
+//______________________________________________________________________
+//  Free a staged job.  The xml document must be released under the
+//  output lock.
+void
+DataArchiver::releaseStagedFile( StagedFile * job )
+{
+  if( job->doc != nullptr ) {
+    m_outputLock.lock();
+    job->doc = nullptr;
+    m_outputLock.unlock();
+  }
+  delete job;
+}
+
+//______________________________________________________________________
+//  Write one staged data file and its (xml or binary) index file.
+void
+DataArchiver::writeStagedFile( StagedFile * job )
+{
+  Timers::Simple timer;
+  timer.start();
+
+  const char* filename = job->dataFilename.c_str();
+  int flags = O_WRONLY|O_CREAT|O_TRUNC;
+  int fd    = open( filename, flags, 0666 );
+
+  for( int tries = 1; fd == -1; ++tries ) {
+    if( tries >= 50 ) {
+      ostringstream msg;
+      msg << "DataArchiver::writeStagedFile(): Failed to open file '"
+          << job->dataFilename << "' (after 50 tries).";
+      throw ErrnoException( msg.str(), errno, __FILE__, __LINE__ );
+    }
+    fd = open( filename, flags, 0666 );
+  }
+
+  const char* buffer    = job->data.data();
+  size_t      remaining = job->data.size();
+
+  while( remaining > 0 ) {
+    ssize_t s = ::write( fd, buffer, remaining );
+
+    if( s == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+      close( fd );
+      throw ErrnoException( "DataArchiver::writeStagedFile (write call)", errno, __FILE__, __LINE__ );
+    }
+    buffer    += s;
+    remaining -= s;
+  }
+
+  if( close( fd ) == -1 ) {
+    throw ErrnoException( "DataArchiver::writeStagedFile (close call)", errno, __FILE__, __LINE__ );
+  }
+
+  if( job->doc == nullptr ) {
+    job->index.write( job->indexFilename );
+  }
+  else {
+    // libxml/xerces is not thread safe - both writing and releasing the
+    // document happen under the output lock.
+    m_outputLock.lock();
+    try {
+      job->doc->output( job->indexFilename.c_str() );
+      job->doc = nullptr;
+    }
+    catch( ... ) {
+      job->doc = nullptr;
+      m_outputLock.unlock();
+      throw;
+    }
+    m_outputLock.unlock();
+  }
+
+  DOUT( g_DA_async, "Rank-" << d_myworld->myRank() << " I/O thread wrote " << job->dataFilename
+        << " (" << job->data.size() << " bytes) in " << timer().seconds() << " seconds" );
+}
+
 //______________________________________________________________________
 //  output only the savedLabels of a specified type description in PIDX format.
 
@@ -3860,6 +4677,31 @@ DataArchiver::initSaveLabels( SchedulerP & sched,
     }
 
     if ( saveLabel.compressionMode != "") {
+      const CompressionCodec * codec = CompressionCodec::find( saveLabel.compressionMode );
+
+      // Lossy compression only handles grid variables of doubles.
+      if ( codec != nullptr && !codec->isLossless() ) {
+        const TypeDescription * td = var->typeDescription();
+        bool isGridVariable = false;
+
+        switch ( td->getType() ) {
+          case TypeDescription::CCVariable :
+          case TypeDescription::NCVariable :
+          case TypeDescription::SFCXVariable :
+          case TypeDescription::SFCYVariable :
+          case TypeDescription::SFCZVariable :
+            isGridVariable = true;
+            break;
+          default :
+            break;
+        }
+
+        if ( !isGridVariable || td->getSubType()->getType() != TypeDescription::double_type ) {
+          throw ProblemSetupException( "Lossy compression of " + saveLabel.labelName + " (" + td->getName() + ") is not supported, "
+                                       "only CC, NC and SFC variables of doubles may be saved lossy", __FILE__, __LINE__ );
+        }
+      }
+
       var->setCompressionMode( saveLabel.compressionMode );
     }
 
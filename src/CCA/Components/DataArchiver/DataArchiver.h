@@ -31,15 +31,22 @@
 #include <CCA/Components/Schedulers/RuntimeStatsEnum.h>
 
 #include <Core/Containers/ConsecutiveRangeSet.h>
+#include <Core/DataArchive/BinaryIndex.h>
 #include <Core/Grid/Level.h>
 #include <Core/Grid/Variables/MaterialSetP.h>
 #include <Core/Grid/MaterialManager.h>
 #include <Core/Grid/MaterialManagerP.h>
 #include <Core/OS/Dir.h>
 #include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/UintahMPI.h>
 #include <Core/Parallel/UintahParallelComponent.h>
 #include <Core/Util/Assert.h>
 
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 namespace Uintah {
 
 class DataWarehouse;
@@ -275,6 +282,10 @@ class LoadBalancer;
       m_runtimeStats = runtimeStats;
     };
 
+    // Blocks until all output staged for the asynchronous I/O thread
+    // has been written to disk.  A no-op for synchronous output.
+    void flushAsyncOutput();
+
     // Returns true if an output or checkpoint exists for the time step
     bool outputTimeStepExists( unsigned int ts );
     bool checkpointTimeStepExists( unsigned int ts );
@@ -653,6 +664,93 @@ class LoadBalancer;
 
     bool m_outputDoubleAsFloat {false};
 
+    //-----------------------------------------------------------
+    // If the <DataArchiver> section of the .ups file contains:
+    //
+    //   <indexFormat>binary</indexFormat>
+    //
+    // the per-rank index of each level (l<level>/p<rank>.xml) is
+    // written as a BinaryIndex (l<level>/p<rank>.idx) - fixed-size
+    // records instead of one xml <Variable> element per variable,
+    // material and patch.  The global variables (global.xml) are
+    // always indexed in xml.
+    //-----------------------------------------------------------
+
+    bool m_binaryIndex {false};
+
+    //-----------------------------------------------------------
+    // If the <DataArchiver> section of the .ups file contains:
+    //
+    //   <asyncOutput memoryBudget="512" />
+    //
+    // the data files of output (not checkpoint) time steps are staged
+    // in memory by the output tasks and written to disk by a dedicated
+    // I/O thread while the simulation proceeds.  The staged data is
+    // bounded by memoryBudget (MBytes); an output task blocks when the
+    // budget is exhausted.  All pending writes are flushed before a
+    // checkpoint and when the DataArchiver is destroyed.
+    //-----------------------------------------------------------
+    struct StagedFile {
+      std::string  dataFilename;
+      std::string  indexFilename;
+      std::string  data;
+      ProblemSpecP doc;     // xml index, nullptr for a binary index
+      BinaryIndex  index;
+    };
+
+    void startAsyncWriter();
+    void stopAsyncWriter();
+    void asyncWriterLoop();
+    void enqueueAsyncWrite( StagedFile * job );
+    void writeStagedFile( StagedFile * job );
+    void releaseStagedFile( StagedFile * job );
+
+    bool                        m_asyncOutput {false};
+    size_t                      m_asyncMemoryBudget {512 * 1024 * 1024};
+    size_t                      m_asyncBytesQueued {0};
+    bool                        m_asyncWriting {false};
+    bool                        m_asyncStop {false};
+    std::string                 m_asyncError;
+    std::deque<StagedFile*>     m_asyncQueue;
+    std::thread                 m_asyncThread;
+    std::mutex                  m_asyncMutex;
+    std::condition_variable     m_asyncCV;
+
+    //-----------------------------------------------------------
+    // If the <DataArchiver> section of the .ups file contains:
+    //
+    //   <aggregateOutput ranksPerFile="64" />
+    //
+    // the ranks are split into groups (one group per compute node if
+    // ranksPerFile is not given) and on each level the lowest rank of
+    // a group with data on that level gathers the group's staged data
+    // over MPI and writes a single l<level>/a<rank>.data file plus one
+    // l<level>/a<rank>.xml (or .idx) index.  The timestep's <Data> section lists
+    // the ranks each aggregated index covers, so that DataArchive can
+    // locate a patch's data without any per-rank files.
+    //-----------------------------------------------------------
+    struct DatafileEntry {
+      std::string href;
+      int         proc;
+      std::string procs;  // ranks covered by an aggregated file
+    };
+
+    void setupAggregationGroups( int ranksPerFile );
+    void createAggregationCommunicators( const GridP & grid );
+    void freeAggregationCommunicators();
+    void aggregateStagedFile(       StagedFile * job,
+                              const Level      * level,
+                              const Dir        & ldir,
+                                    int          type );
+    void getDatafileEntries(       int                        levelIndex,
+                             const std::vector<bool>        & procOnLevel,
+                                   std::vector<DatafileEntry> & entries );
+
+    bool                  m_aggregateOutput {false};
+    std::vector<int>      m_aggregationGroup;   // Group id (lowest world rank in the group) of each rank.
+    std::vector<MPI_Comm> m_aggregationComms;             // One per level, MPI_COMM_NULL if no data on the level.
+    std::vector<MPI_Comm> m_checkpointAggregationComms;   // Duplicates of the above, used by checkpoints only.
+
     //-----------------------------------------------------------
     // These four variables affect the global var output only.
 
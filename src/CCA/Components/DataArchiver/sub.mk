@@ -44,6 +44,7 @@ PSELIBS := \
 	Core/Exceptions    \
 	Core/ProblemSpec   \
 	CCA/Components/ProblemSpecification \
+	Core/DataArchive \
 	Core/OS          \
 	Core/Exceptions  \
 	Core/Containers  \
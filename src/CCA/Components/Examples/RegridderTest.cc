@@ -66,7 +66,9 @@ namespace Uintah
   
   RegridderTest::~RegridderTest ( void )
   {
-    delete d_examplesLabel;
+    VarLabel::destroy(d_oldDensityLabel);
+    VarLabel::destroy(d_densityLabel);
+    VarLabel::destroy(d_currentAngleLabel);
   }
 
   // Interface inherited from Simulation Interface
@@ -168,6 +170,7 @@ namespace Uintah
                    Task::NormalDomain, Ghost::None, 0);
     //    task->requires(Task::NewDW, d_oldDensityLabel, 0, Task::CoarseLevel, 0,
     //             Task::NormalDomain, Ghost::None, 0);
+    task->computes( d_densityLabel );
     scheduler->addTask( task, patches, m_materialManager->allMaterials() );
   }
 
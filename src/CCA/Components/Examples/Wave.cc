@@ -184,7 +184,7 @@ Wave::scheduleTimeAdvance( const LevelP& level, SchedulerP& sched)
                                this, &Wave::timeAdvanceRK4, s);
                                
       task->requires(Task::OldDW, getDelTLabel(), level.get_rep());
-      task->requires(Task::OldDW, phi_label,      Ghost::None);
+      task->requires(Task::OldDW, phi_label,      Ghost::AroundCells, 1);
       task->requires(Task::OldDW, pi_label,       Ghost::None);
       task->requires(s->cur_dw, s->curphi_label,  Ghost::AroundCells, 1);
       task->requires(s->cur_dw, s->curpi_label,   Ghost::None, 0);
@@ -34,3 +34,30 @@ EquationOfState::EquationOfState()
 EquationOfState::~EquationOfState()
 {
 }
+
+//__________________________________
+void EquationOfState::computeRhoMicroBatch(int numCells, const double* press,
+                                           const double* gamma,
+                                           const double* cv,
+                                           const double* Temp,
+                                           const double* rho_guess,
+                                           double* rhoM)
+{
+  for (int i = 0; i < numCells; i++) {
+    rhoM[i] = computeRhoMicro(press[i], gamma[i], cv[i], Temp[i], rho_guess[i]);
+  }
+}
+
+//__________________________________
+void EquationOfState::computePressEOSBatch(int numCells, const double* rhoM,
+                                           const double* gamma,
+                                           const double* cv,
+                                           const double* Temp,
+                                           double* press, double* dp_drho,
+                                           double* dp_de)
+{
+  for (int i = 0; i < numCells; i++) {
+    computePressEOS(rhoM[i], gamma[i], cv[i], Temp[i],
+                    press[i], dp_drho[i], dp_de[i]);
+  }
+}
@@ -77,6 +77,21 @@ WARNING
                                   double& press, double& dp_drho, 
                                   double& dp_de) = 0;
 
+    // Over numCells cells (a pencil), one array element per cell.  The defaults
+    // call the per cell versions, the models override them with loops
+    // the compiler can vectorize.  rhoM may be the rho_guess array, the
+    // other arrays must not overlap.
+
+     virtual void computeRhoMicroBatch(int numCells, const double* press,
+                                       const double* gamma, const double* cv,
+                                       const double* Temp,
+                                       const double* rho_guess, double* rhoM);
+
+     virtual void computePressEOSBatch(int numCells, const double* rhoM,
+                                       const double* gamma, const double* cv,
+                                       const double* Temp, double* press,
+                                       double* dp_drho, double* dp_de);
+
     virtual void computeTempCC(const Patch* patch,
                                const std::string& comp_domain,
                                const CCVariable<double>& press, 
@@ -93,6 +93,35 @@ void IdealGas::computePressEOS(double rhoM, double gamma,
   dp_drho = (gamma - 1.0)*cv*Temp;
   dp_de   = (gamma - 1.0)*rhoM;
 }
+
+//__________________________________
+void IdealGas::computeRhoMicroBatch(int numCells, const double* __restrict__ press,
+                                    const double* __restrict__ gamma,
+                                    const double* __restrict__ cv,
+                                    const double* __restrict__ Temp,
+                                    const double*,
+                                    double* __restrict__ rhoM)
+{
+  for (int i = 0; i < numCells; i++) {
+    rhoM[i] = press[i]/((gamma[i] - 1.0)*cv[i]*Temp[i]);
+  }
+}
+
+//__________________________________
+void IdealGas::computePressEOSBatch(int numCells, const double* __restrict__ rhoM,
+                                    const double* __restrict__ gamma,
+                                    const double* __restrict__ cv,
+                                    const double* __restrict__ Temp,
+                                    double* __restrict__ press,
+                                    double* __restrict__ dp_drho,
+                                    double* __restrict__ dp_de)
+{
+  for (int i = 0; i < numCells; i++) {
+    press[i]   = (gamma[i] - 1.0)*rhoM[i]*cv[i]*Temp[i];
+    dp_drho[i] = (gamma[i] - 1.0)*cv[i]*Temp[i];
+    dp_de[i]   = (gamma[i] - 1.0)*rhoM[i];
+  }
+}
 //__________________________________
 // Return (1/v)*(dv/dT)  (constant pressure thermal expansivity)
 double IdealGas::getAlpha(double Temp, double , double , double )
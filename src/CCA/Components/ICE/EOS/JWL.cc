@@ -231,6 +231,41 @@ void JWL::computePressEOS(double rhoM, double,
   dp_de   = om*rhoM;
 }
 
+//__________________________________
+// The Newton-Bisection solver takes a different path in every cell, it
+// is only the virtual call that is saved here
+void JWL::computeRhoMicroBatch(int numCells, const double* press,
+                               const double* gamma, const double* cv,
+                               const double* Temp,
+                               const double* rho_guess, double* rhoM)
+{
+  for (int i = 0; i < numCells; i++) {
+    rhoM[i] = JWL::computeRhoMicro(press[i], gamma[i], cv[i], Temp[i],
+                                   rho_guess[i]);
+  }
+}
+
+//__________________________________
+void JWL::computePressEOSBatch(int numCells, const double* __restrict__ rhoM,
+                               const double* __restrict__,
+                               const double* __restrict__ cv,
+                               const double* __restrict__ Temp,
+                               double* __restrict__ press,
+                               double* __restrict__ dp_drho,
+                               double* __restrict__ dp_de)
+{
+  for (int i = 0; i < numCells; i++) {
+    double V  = rho0/rhoM[i];
+    double P1 = A*exp(-R1*V);
+    double P2 = B*exp(-R2*V);
+    double P3 = om*cv[i]*Temp[i]*rhoM[i];
+
+    press[i]   = P1 + P2 + P3;
+    dp_drho[i] = (R1*rho0*P1 + R2*rho0*P2)/(rhoM[i]*rhoM[i]) + om*cv[i]*Temp[i];
+    dp_de[i]   = om*rhoM[i];
+  }
+}
+
 
 //______________________________________________________________________
 // Update temperature boundary conditions due to hydrostatic pressure gradient
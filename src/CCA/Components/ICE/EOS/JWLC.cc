@@ -213,6 +213,50 @@ void JWLC::computePressEOS(double rhoM, double, double, double,
   dp_de   = 0.0;
 }
 
+//__________________________________
+// Newton's method takes a different number of steps in every cell, it
+// is only the virtual call that is saved here
+void JWLC::computeRhoMicroBatch(int numCells, const double* press,
+                                const double* gamma, const double* cv,
+                                const double* Temp,
+                                const double* rho_guess, double* rhoM)
+{
+  for (int i = 0; i < numCells; i++) {
+    rhoM[i] = JWLC::computeRhoMicro(press[i], gamma[i], cv[i], Temp[i],
+                                    rho_guess[i]);
+  }
+}
+
+//__________________________________
+void JWLC::computePressEOSBatch(int numCells, const double* __restrict__ rhoM,
+                                const double* __restrict__,
+                                const double* __restrict__,
+                                const double* __restrict__,
+                                double* __restrict__ press,
+                                double* __restrict__ dp_drho,
+                                double* __restrict__ dp_de)
+{
+  double one_plus_omega = 1.+om;
+
+  for (int i = 0; i < numCells; i++) {
+    double inv_rho_rat=rho0/rhoM[i];
+    double rho_rat=rhoM[i]/rho0;
+    double A_e_to_the_R1_rho0_over_rhoM=A*exp(-R1*inv_rho_rat);
+    double B_e_to_the_R2_rho0_over_rhoM=B*exp(-R2*inv_rho_rat);
+    double C_rho_rat_tothe_one_plus_omega=C*pow(rho_rat,one_plus_omega);
+
+    press[i]   = A_e_to_the_R1_rho0_over_rhoM +
+                 B_e_to_the_R2_rho0_over_rhoM + C_rho_rat_tothe_one_plus_omega;
+
+    double rho0_rhoMsqrd = rho0/(rhoM[i]*rhoM[i]);
+    dp_drho[i] = R1*rho0_rhoMsqrd*A_e_to_the_R1_rho0_over_rhoM
+               + R2*rho0_rhoMsqrd*B_e_to_the_R2_rho0_over_rhoM
+               + (one_plus_omega/rhoM[i])*C_rho_rat_tothe_one_plus_omega;
+
+    dp_de[i]   = 0.0;
+  }
+}
+
 //______________________________________________________________________
 // Update temperature boundary conditions due to hydrostatic pressure gradient
 // call this after set Dirchlet and Neuman BC
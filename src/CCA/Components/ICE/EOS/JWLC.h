@@ -75,6 +75,16 @@ WARNING
                                      double& press, double& dp_drho,
                                      double& dp_de);
 
+        virtual void computeRhoMicroBatch(int numCells, const double* press,
+                                          const double* gamma, const double* cv,
+                                          const double* Temp,
+                                          const double* rho_guess, double* rhoM);
+
+        virtual void computePressEOSBatch(int numCells, const double* rhoM,
+                                          const double* gamma, const double* cv,
+                                          const double* Temp, double* press,
+                                          double* dp_drho, double* dp_de);
+
         virtual void computeTempCC(const Patch* patch,
                                    const std::string& comp_domain,
                                    const CCVariable<double>&, 
@@ -2585,18 +2585,24 @@ void ICE::computeThermoTransportProperties(const ProcessorGroup *,
  ----------------
     - Compute rho_micro_CC, SpeedSound, vol_frac
 
-    For each cell
-    _ WHILE LOOP(convergence, max_iterations)
+    For each pencil (row of cells along x)
+    _ WHILE LOOP(cells that have not converged or reached max_iterations)
         - compute the pressure and dp_drho from the EOS of each material.
         - Compute delta Pressure
         - Compute delta volume fraction and update the
           volume fraction and the celldensity.
         - Test for convergence of delta pressure and delta volume fraction
     - END WHILE LOOP
+    - speed of sound of the converged cells
     - bulletproofing
     end
 
 Note:  The nomenclature follows the reference.
+       The cells of a pencil still iterating are packed at the front of
+       the lane arrays, so each EOS is evaluated over all of them with one
+       (batched) call per material.  Every cell goes through the same
+       operations as it would on its own, so the results and the number
+       of iterations do not depend on the other cells of the pencil.
 _____________________________________________________________________*/
 void ICE::computeEquilibrationPressure(const ProcessorGroup *,
                                        const PatchSubset    * patches,
@@ -2619,16 +2625,12 @@ void ICE::computeEquilibrationPressure(const ProcessorGroup *,
 
     double converg_coeff = 15;
     double convergence_crit = converg_coeff * DBL_EPSILON;
-    double sum=0.;
-    double tmp;
 
     unsigned int  numMatls = m_materialManager->getNumMatls( "ICE" );
     static int n_passes;
     n_passes ++;
 
-    vector<double> press_eos(numMatls);
-    vector<double> dp_drho(numMatls);
-    vector<double> dp_de(numMatls);
+    vector<EquationOfState*> eos(numMatls);
 
     vector<CCVariable<double> > vol_frac(numMatls);
     vector<CCVariable<double> > rho_micro(numMatls);
@@ -2663,6 +2665,7 @@ void ICE::computeEquilibrationPressure(const ProcessorGroup *,
     for (unsigned int m = 0; m < numMatls; m++) {
       ICEMaterial* matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
       int indx = matl->getDWIndex();
+      eos[m] = matl->getEOS();
 
       old_dw->get( Temp[m],      lb->temp_CCLabel,      indx,patch, m_gn,0 );
       old_dw->get( rho_CC[m],    lb->rho_CCLabel,       indx,patch, m_gn,0 );
@@ -2693,186 +2696,250 @@ void ICE::computeEquilibrationPressure(const ProcessorGroup *,
     }
 
   //______________________________________________________________________
-  // Done with preliminary calcs, now loop over every cell
-    int count;
-    int test_max_iter = 0;
-
-    for (CellIterator iter=patch->getExtraCellIterator();!iter.done();iter++) {
-      IntVector c = *iter;
+  // Done with preliminary calcs, now loop over every pencil of cells
+    const IntVector low  = patch->getExtraCellLowIndex();
+    const IntVector high = patch->getExtraCellHighIndex();
+    const int nx = high.x() - low.x();
+
+    // Lane arrays, [m][lane] for the materials
+    vector<vector<double> > l_rhoMicro( numMatls, vector<double>(nx) );
+    vector<vector<double> > l_volFrac(  numMatls, vector<double>(nx) );
+    vector<vector<double> > l_rho_CC(   numMatls, vector<double>(nx) );
+    vector<vector<double> > l_gamma(    numMatls, vector<double>(nx) );
+    vector<vector<double> > l_cv(       numMatls, vector<double>(nx) );
+    vector<vector<double> > l_Temp(     numMatls, vector<double>(nx) );
+    vector<vector<double> > l_press_eos(numMatls, vector<double>(nx) );
+    vector<vector<double> > l_dp_drho(  numMatls, vector<double>(nx) );
+    vector<vector<double> > l_dp_de(    numMatls, vector<double>(nx) );
+    vector<double> l_press(nx), l_sum(nx), l_A(nx), l_B(nx), l_C(nx);
+    vector<int>    l_x(nx), l_count(nx);
+
+    // Outcome of each cell of the pencil
+    vector<int>    count(nx);
+    vector<double> sum(nx);
+    vector<int>    converged(nx);
 
-      double delPress = 0.;
-      bool converged  = false;
-      count           = 0;
-      vector<EqPress_dbg> dbgEqPress;
+    int test_max_iter = 0;
 
-      while ( count < d_max_iter_equilibration && converged == false) {
-        count++;
+    for (int k = low.z(); k < high.z(); k++) {
+      for (int j = low.y(); j < high.y(); j++) {
 
-        //__________________________________
-        // evaluate press_eos at cell i,j,k
-        for (unsigned int m = 0; m < numMatls; m++)  {
-          ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
-          ice_matl->getEOS()->computePressEOS(rho_micro[m][c],gamma[m][c],
-                                              cv[m][c], Temp[m][c],press_eos[m],
-                                              dp_drho[m], dp_de[m]);
-        }
+        int nLanes = nx;
+        for (int l = 0; l < nx; l++) {
+          IntVector c(low.x() + l, j, k);
+          l_x[l]     = l;
+          l_count[l] = 0;
+          l_press[l] = press_new[c];
 
-        //__________________________________
-        // - compute delPress
-        // - update press_CC
-        double A = 0., B = 0., C = 0.;
-        for (unsigned int m = 0; m < numMatls; m++)   {
-          double Q =  press_new[c] - press_eos[m];
-          double div_y =  (vol_frac[m][c] * vol_frac[m][c])
-                        / (dp_drho[m] * rho_CC[m][c] + d_SMALL_NUM);
-          A   +=  vol_frac[m][c];
-          B   +=  Q*div_y;
-          C   +=  div_y;
+          for (unsigned int m = 0; m < numMatls; m++) {
+            l_rhoMicro[m][l] = rho_micro[m][c];
+            l_volFrac[m][l]  = vol_frac[m][c];
+            l_rho_CC[m][l]   = rho_CC[m][c];
+            l_gamma[m][l]    = gamma[m][c];
+            l_cv[m][l]       = cv[m][c];
+            l_Temp[m][l]     = Temp[m][c];
+          }
         }
-        double vol_frac_not_close_packed = 1.0;
-        delPress = (A - vol_frac_not_close_packed - B)/C;
 
-        press_new[c] += delPress;
-
-        //__________________________________
-        // backout rho_micro_CC at this new pressure
-        for (unsigned int m = 0; m < numMatls; m++) {
-          ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
-          rho_micro[m][c] =
-           ice_matl->getEOS()->computeRhoMicro(press_new[c],gamma[m][c],
-                                          cv[m][c],Temp[m][c],rho_micro[m][c]);
+        while ( nLanes > 0 ) {
+          for (int l = 0; l < nLanes; l++) {
+            l_count[l]++;
+          }
 
-          double div = 1./rho_micro[m][c];
+          //__________________________________
+          // evaluate press_eos at the cells
+          for (unsigned int m = 0; m < numMatls; m++)  {
+            eos[m]->computePressEOSBatch(nLanes, &l_rhoMicro[m][0], &l_gamma[m][0],
+                                         &l_cv[m][0], &l_Temp[m][0],
+                                         &l_press_eos[m][0], &l_dp_drho[m][0],
+                                         &l_dp_de[m][0]);
+          }
 
-          // - updated volume fractions
-          vol_frac[m][c]   = rho_CC[m][c]*div;
-        }
+          //__________________________________
+          // - compute delPress
+          // - update press_CC
+          for (int l = 0; l < nLanes; l++) {
+            l_A[l] = 0.;
+            l_B[l] = 0.;
+            l_C[l] = 0.;
+          }
+          for (unsigned int m = 0; m < numMatls; m++)   {
+            for (int l = 0; l < nLanes; l++) {
+              double Q =  l_press[l] - l_press_eos[m][l];
+              double div_y =  (l_volFrac[m][l] * l_volFrac[m][l])
+                            / (l_dp_drho[m][l] * l_rho_CC[m][l] + d_SMALL_NUM);
+              l_A[l]   +=  l_volFrac[m][l];
+              l_B[l]   +=  Q*div_y;
+              l_C[l]   +=  div_y;
+            }
+          }
+          double vol_frac_not_close_packed = 1.0;
+          for (int l = 0; l < nLanes; l++) {
+            double delPress = (l_A[l] - vol_frac_not_close_packed - l_B[l])/l_C[l];
+            l_press[l] += delPress;
+          }
 
-        //__________________________________
-        // - Test for convergence
-        //  If sum of vol_frac_CC ~= vol_frac_not_close_packed then converged
-        sum = 0.0;
-        for (unsigned int m = 0; m < numMatls; m++)  {
-          sum += vol_frac[m][c];
-        }
+          //__________________________________
+          // backout rho_micro_CC at this new pressure
+          for (unsigned int m = 0; m < numMatls; m++) {
+            eos[m]->computeRhoMicroBatch(nLanes, &l_press[0], &l_gamma[m][0],
+                                         &l_cv[m][0], &l_Temp[m][0],
+                                         &l_rhoMicro[m][0], &l_rhoMicro[m][0]);
+
+            // - updated volume fractions
+            for (int l = 0; l < nLanes; l++) {
+              double div = 1./l_rhoMicro[m][l];
+              l_volFrac[m][l] = l_rho_CC[m][l]*div;
+            }
+          }
 
-        if (fabs(sum-1.0) < convergence_crit){
-          converged = true;
+          //__________________________________
+          // - Test for convergence
+          //  If sum of vol_frac_CC ~= vol_frac_not_close_packed then converged
+          for (int l = 0; l < nLanes; l++) {
+            l_sum[l] = 0.0;
+          }
+          for (unsigned int m = 0; m < numMatls; m++)  {
+            for (int l = 0; l < nLanes; l++) {
+              l_sum[l] += l_volFrac[m][l];
+            }
+          }
 
           //__________________________________
-          // Find the speed of sound based on converged solution
-          for (unsigned int m = 0; m < numMatls; m++) {
-            ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
+          // Store the cells that are done, pack the others
+          int nActive = 0;
+          for (int l = 0; l < nLanes; l++) {
+            bool conv = fabs(l_sum[l]-1.0) < convergence_crit;
+
+            if ( conv || l_count[l] >= d_max_iter_equilibration ) {
+              int x = l_x[l];
+              IntVector c(low.x() + x, j, k);
+              press_new[c] = l_press[l];
+              for (unsigned int m = 0; m < numMatls; m++) {
+                rho_micro[m][c] = l_rhoMicro[m][l];
+                vol_frac[m][c]  = l_volFrac[m][l];
+              }
+              count[x]     = l_count[l];
+              sum[x]       = l_sum[l];
+              converged[x] = conv;
+              continue;
+            }
 
-            ice_matl->getEOS()->computePressEOS(rho_micro[m][c],gamma[m][c],
-                                            cv[m][c],Temp[m][c],
-                                            press_eos[m],dp_drho[m], dp_de[m]);
+            if ( nActive != l ) {
+              l_x[nActive]     = l_x[l];
+              l_count[nActive] = l_count[l];
+              l_press[nActive] = l_press[l];
+              for (unsigned int m = 0; m < numMatls; m++) {
+                l_rhoMicro[m][nActive] = l_rhoMicro[m][l];
+                l_volFrac[m][nActive]  = l_volFrac[m][l];
+                l_rho_CC[m][nActive]   = l_rho_CC[m][l];
+                l_gamma[m][nActive]    = l_gamma[m][l];
+                l_cv[m][nActive]       = l_cv[m][l];
+                l_Temp[m][nActive]     = l_Temp[m][l];
+              }
+            }
+            nActive++;
+          }
+          nLanes = nActive;
+        }   // end of converged
 
-            tmp = dp_drho[m]
-                + dp_de[m] * press_eos[m]/(rho_micro[m][c] * rho_micro[m][c]);
-            speedSound_new[m][c] = sqrt(tmp);
+        //__________________________________
+        // Find the speed of sound based on converged solution
+        for (int x = 0; x < nx; x++) {
+          if ( converged[x] ) {
+            IntVector c(low.x() + x, j, k);
+            l_x[nLanes] = x;
+            for (unsigned int m = 0; m < numMatls; m++) {
+              l_rhoMicro[m][nLanes] = rho_micro[m][c];
+              l_gamma[m][nLanes]    = gamma[m][c];
+              l_cv[m][nLanes]       = cv[m][c];
+              l_Temp[m][nLanes]     = Temp[m][c];
+            }
+            nLanes++;
           }
         }
 
-        // Save iteration data for output in case of crash
-        if(ds_EqPress.active()){
-          EqPress_dbg dbg;
-          dbg.delPress     = delPress;
-          dbg.press_new    = press_new[c];
-          dbg.sumVolFrac   = sum;
-          dbg.count        = count;
-
-          for (unsigned int m = 0; m < numMatls; m++) {
-            EqPress_dbgMatl dmatl;
-            dmatl.press_eos   = press_eos[m];
-            dmatl.volFrac     = vol_frac[m][c];
-            dmatl.rhoMicro    = rho_micro[m][c];
-            dmatl.rho_CC      = rho_CC[m][c];
-            dmatl.temp_CC     = Temp[m][c];
-            dmatl.mat         = m;
-            dbg.matl.push_back(dmatl);
+        for (unsigned int m = 0; m < numMatls; m++) {
+          eos[m]->computePressEOSBatch(nLanes, &l_rhoMicro[m][0], &l_gamma[m][0],
+                                       &l_cv[m][0], &l_Temp[m][0],
+                                       &l_press_eos[m][0], &l_dp_drho[m][0],
+                                       &l_dp_de[m][0]);
+
+          for (int l = 0; l < nLanes; l++) {
+            IntVector c(low.x() + l_x[l], j, k);
+            double tmp = l_dp_drho[m][l]
+                + l_dp_de[m][l] * l_press_eos[m][l]/(l_rhoMicro[m][l] * l_rhoMicro[m][l]);
+            speedSound_new[m][c] = sqrt(tmp);
           }
-          dbgEqPress.push_back(dbg);
         }
-      }   // end of converged
 
-      test_max_iter = std::max(test_max_iter, count);
+        for (int x = 0; x < nx; x++) {
+          IntVector c(low.x() + x, j, k);
 
-      //__________________________________
-      //      BULLET PROOFING
-      // ignore BP if a recompute time step has already been requested
-      bool rts = new_dw->recomputeTimeStep();
+          test_max_iter = std::max(test_max_iter, count[x]);
 
-      string message;
-      bool allTestsPassed = true;
+          //__________________________________
+          //      BULLET PROOFING
+          // ignore BP if a recompute time step has already been requested
+          bool rts = new_dw->recomputeTimeStep();
 
-      if(test_max_iter == d_max_iter_equilibration && !rts){
-        allTestsPassed = false;
-        message += "Max. iterations reached ";
-      }
+          string message;
+          bool allTestsPassed = true;
 
-      for (unsigned int m = 0; m < numMatls; m++) {
-        if(( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0)){
-          message += " ( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0) ";
-        }
-      }
+          if(test_max_iter == d_max_iter_equilibration && !rts){
+            allTestsPassed = false;
+            message += "Max. iterations reached ";
+          }
 
-      if ( fabs(sum - 1.0) > convergence_crit && !rts) {
-        allTestsPassed = false;
-        message += " sum (volumeFractions) != 1 ";
-      }
+          for (unsigned int m = 0; m < numMatls; m++) {
+            if(( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0)){
+              message += " ( vol_frac[m][c] > 0.0 ) ||( vol_frac[m][c] < 1.0) ";
+            }
+          }
 
-      if ( press_new[c] < 0.0 && !rts) {
-        allTestsPassed = false;
-        message += " Computed pressure is < 0 ";
-      }
+          if ( fabs(sum[x] - 1.0) > convergence_crit && !rts) {
+            allTestsPassed = false;
+            message += " sum (volumeFractions) != 1 ";
+          }
 
-      for( unsigned int m = 0; m < numMatls; m++ ) {
-        if( (rho_micro[m][c] < 0.0 || vol_frac[m][c] < 0.0) && !rts ) {
-          allTestsPassed = false;
-          message += " rho_micro < 0 || vol_frac < 0";
-        }
-      }
-      if(allTestsPassed != true){  // throw an exception of there's a problem
-        Point pt = patch->getCellPosition(c);
-
-        ostringstream warn;
-        warn << "\nICE::ComputeEquilibrationPressure: Cell "<< c << " position: " << pt << ", L-"<<L_indx <<"\n"
-             << message
-             <<"\nThis usually means that something much deeper has gone wrong with the simulation. "
-             <<"\nCompute equilibration pressure task is rarely the problem. "
-             << "For more debugging information set the environmental variable:  \n"
-             << "   SCI_DEBUG DBG_EqPress:+\n\n";
-
-        warn << "INPUTS: \n";
-        for (unsigned int m = 0; m < numMatls; m++){
-          warn<< "\n matl: " << m << "\n"
-               << "   rho_CC:     " << rho_CC[m][c] << "\n"
-               << "   Temperature:   "<< Temp[m][c] << "\n";
-        }
-        if(ds_EqPress.active()){
-          warn << "\nDetails on iterations " << endl;
-          vector<EqPress_dbg>::iterator dbg_iter;
-
-          for( dbg_iter  = dbgEqPress.begin(); dbg_iter != dbgEqPress.end(); dbg_iter++){
-            EqPress_dbg & d = *dbg_iter;
-            warn << "Iteration:   " << d.count
-                 << "  press_new:   " << d.press_new
-                 << "  sumVolFrac:  " << d.sumVolFrac
-                 << "  delPress:    " << d.delPress << "\n";
+          if ( press_new[c] < 0.0 && !rts) {
+            allTestsPassed = false;
+            message += " Computed pressure is < 0 ";
+          }
+
+          for( unsigned int m = 0; m < numMatls; m++ ) {
+            if( (rho_micro[m][c] < 0.0 || vol_frac[m][c] < 0.0) && !rts ) {
+              allTestsPassed = false;
+              message += " rho_micro < 0 || vol_frac < 0";
+            }
+          }
+          if(allTestsPassed != true){  // throw an exception of there's a problem
+            Point pt = patch->getCellPosition(c);
+
+            ostringstream warn;
+            warn << "\nICE::ComputeEquilibrationPressure: Cell "<< c << " position: " << pt << ", L-"<<L_indx <<"\n"
+                 << message
+                 <<"\nThis usually means that something much deeper has gone wrong with the simulation. "
+                 <<"\nCompute equilibration pressure task is rarely the problem. "
+                 << "For more debugging information set the environmental variable:  \n"
+                 << "   SCI_DEBUG DBG_EqPress:+\n\n";
+
+            warn << "INPUTS: \n";
             for (unsigned int m = 0; m < numMatls; m++){
-              warn << "  matl: " << d.matl[m].mat
-                   << "  press_eos:  " << d.matl[m].press_eos
-                   << "  volFrac:    " << d.matl[m].volFrac
-                   << "  rhoMicro:   " << d.matl[m].rhoMicro
-                   << "  rho_CC:     " << d.matl[m].rho_CC
-                   << "  Temp:       " << d.matl[m].temp_CC << "\n";
+              warn<< "\n matl: " << m << "\n"
+                   << "   rho_CC:     " << rho_CC[m][c] << "\n"
+                   << "   Temperature:   "<< Temp[m][c] << "\n";
+            }
+            if(ds_EqPress.active()){
+              warn << "\nDetails on iterations " << endl;
+              printEqPressIterations(warn, c, press[c], rho_CC, sp_vol_CC,
+                                     gamma, cv, Temp, convergence_crit);
             }
+            throw InvalidValue(warn.str(), __FILE__, __LINE__);
           }
         }
-        throw InvalidValue(warn.str(), __FILE__, __LINE__);
       }
-    } // end of cell interator
+    } // end of pencil loop
 
     cout_norm << "max. iterations in any cell " << test_max_iter <<
                  " on patch "<<patch->getID()<<endl;
@@ -2933,6 +3000,119 @@ void ICE::computeEquilibrationPressure(const ProcessorGroup *,
   }  // patch loop
 }
 
+/* _____________________________________________________________________
+ Function:  ICE::printEqPressIterations--
+ Purpose:   Repeat the equilibration iterations of a cell, from the state
+            at the start of computeEquilibrationPressure, and print the
+            data of each of them (DBG_EqPress)
+_____________________________________________________________________*/
+void ICE::printEqPressIterations(ostream& warn,
+                                 const IntVector& c,
+                                 const double press,
+                                 const vector<constCCVariable<double> >& rho_CC,
+                                 const vector<constCCVariable<double> >& sp_vol_CC,
+                                 const vector<constCCVariable<double> >& gamma,
+                                 const vector<constCCVariable<double> >& cv,
+                                 const vector<constCCVariable<double> >& Temp,
+                                 const double convergence_crit)
+{
+  unsigned int numMatls = m_materialManager->getNumMatls( "ICE" );
+
+  vector<double> press_eos(numMatls), dp_drho(numMatls), dp_de(numMatls);
+  vector<double> rho_micro(numMatls), vol_frac(numMatls);
+
+  for (unsigned int m = 0; m < numMatls; m++) {
+    rho_micro[m] = 1.0/sp_vol_CC[m][c];
+    vol_frac[m]  = rho_CC[m][c] * sp_vol_CC[m][c];
+  }
+
+  double press_new = press;
+  double sum       = 0.;
+  bool converged   = false;
+  int count        = 0;
+  vector<EqPress_dbg> dbgEqPress;
+
+  while ( count < d_max_iter_equilibration && converged == false) {
+    count++;
+
+    for (unsigned int m = 0; m < numMatls; m++)  {
+      ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
+      ice_matl->getEOS()->computePressEOS(rho_micro[m],gamma[m][c],
+                                          cv[m][c], Temp[m][c],press_eos[m],
+                                          dp_drho[m], dp_de[m]);
+    }
+
+    double A = 0., B = 0., C = 0.;
+    for (unsigned int m = 0; m < numMatls; m++)   {
+      double Q =  press_new - press_eos[m];
+      double div_y =  (vol_frac[m] * vol_frac[m])
+                    / (dp_drho[m] * rho_CC[m][c] + d_SMALL_NUM);
+      A   +=  vol_frac[m];
+      B   +=  Q*div_y;
+      C   +=  div_y;
+    }
+    double vol_frac_not_close_packed = 1.0;
+    double delPress = (A - vol_frac_not_close_packed - B)/C;
+
+    press_new += delPress;
+
+    for (unsigned int m = 0; m < numMatls; m++) {
+      ICEMaterial* ice_matl = (ICEMaterial*) m_materialManager->getMaterial( "ICE", m);
+      rho_micro[m] =
+       ice_matl->getEOS()->computeRhoMicro(press_new,gamma[m][c],
+                                      cv[m][c],Temp[m][c],rho_micro[m]);
+
+      double div = 1./rho_micro[m];
+      vol_frac[m]   = rho_CC[m][c]*div;
+    }
+
+    sum = 0.0;
+    for (unsigned int m = 0; m < numMatls; m++)  {
+      sum += vol_frac[m];
+    }
+
+    if (fabs(sum-1.0) < convergence_crit){
+      converged = true;
+    }
+
+    EqPress_dbg dbg;
+    dbg.delPress     = delPress;
+    dbg.press_new    = press_new;
+    dbg.sumVolFrac   = sum;
+    dbg.count        = count;
+
+    for (unsigned int m = 0; m < numMatls; m++) {
+      EqPress_dbgMatl dmatl;
+      dmatl.press_eos   = press_eos[m];
+      dmatl.volFrac     = vol_frac[m];
+      dmatl.rhoMicro    = rho_micro[m];
+      dmatl.rho_CC      = rho_CC[m][c];
+      dmatl.temp_CC     = Temp[m][c];
+      dmatl.mat         = m;
+      dbg.matl.push_back(dmatl);
+    }
+    dbgEqPress.push_back(dbg);
+  }
+
+  vector<EqPress_dbg>::iterator dbg_iter;
+
+  for( dbg_iter  = dbgEqPress.begin(); dbg_iter != dbgEqPress.end(); dbg_iter++){
+    EqPress_dbg & d = *dbg_iter;
+    warn << "Iteration:   " << d.count
+         << "  press_new:   " << d.press_new
+         << "  sumVolFrac:  " << d.sumVolFrac
+         << "  delPress:    " << d.delPress << "\n";
+    for (unsigned int m = 0; m < numMatls; m++){
+      warn << "  matl: " << d.matl[m].mat
+           << "  press_eos:  " << d.matl[m].press_eos
+           << "  volFrac:    " << d.matl[m].volFrac
+           << "  rhoMicro:   " << d.matl[m].rhoMicro
+           << "  rho_CC:     " << d.matl[m].rho_CC
+           << "  Temp:       " << d.matl[m].temp_CC << "\n";
+    }
+  }
+}
+
 /* _____________________________________________________________________
  Task:      ICE::computeEquilPressure_1_matl--
  Purpose:   Compute the equilibration pressure for a single material problem
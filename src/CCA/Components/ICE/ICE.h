@@ -361,6 +361,16 @@ using namespace ExchangeModels;
                                         DataWarehouse*,
                                         DataWarehouse*);
 
+      void printEqPressIterations(std::ostream& warn,
+                                  const IntVector& c,
+                                  const double press,
+                                  const std::vector<constCCVariable<double> >& rho_CC,
+                                  const std::vector<constCCVariable<double> >& sp_vol_CC,
+                                  const std::vector<constCCVariable<double> >& gamma,
+                                  const std::vector<constCCVariable<double> >& cv,
+                                  const std::vector<constCCVariable<double> >& Temp,
+                                  const double convergence_crit);
+
 
       void computeEquilPressure_1_matl(const ProcessorGroup*,
                                        const PatchSubset* patches,
@@ -876,6 +876,198 @@ DynamicLoadBalancer::assignPatchesCyclic(const GridP&, bool force)
   return true;
 }
 
+//______________________________________________________________________
+//
+void
+DynamicLoadBalancer::getPatchGraph( const LevelP                  & level
+                                  , const std::vector<double>     & patch_costs
+                                  ,       GraphPartitioner::Graph & graph
+                                  )
+{
+  int ghost = d_ghostCells;
+  if (ghost <= 0) {
+    ghost = std::max(1, m_scheduler->getMaxGhost());
+  }
+  IntVector g(ghost, ghost, ghost);
+
+  // moving a patch is paid once per load balance, the ghost cells every time step
+  double interval = std::max(1, m_lb_timeStep_interval);
+
+  //__________________________________
+  // Where the patches are now.  After a regrid a patch's home is the
+  // owner of the old patch it overlaps most.
+  const GridP grid = level->getGrid();
+  int num_patches = 0;
+  for (int l = 0; l < grid->numLevels(); l++) {
+    num_patches += grid->getLevel(l)->numPatches();
+  }
+
+  DataWarehouse* olddw = m_scheduler->get_dw(0);
+  const Grid* oldGrid = (olddw != nullptr) ? olddw->getGrid() : nullptr;
+
+  bool sameGrid = (int)m_processor_assignment.size() == num_patches &&
+                  m_assignment_base_patch == (*grid->getLevel(0)->patchesBegin())->getID();
+
+  bool fromOldGrid = false;
+  if (!sameGrid && oldGrid != nullptr && oldGrid != grid.get_rep() && level->getIndex() < oldGrid->numLevels()) {
+    int old_patches = 0;
+    for (int l = 0; l < oldGrid->numLevels(); l++) {
+      old_patches += oldGrid->getLevel(l)->numPatches();
+    }
+    fromOldGrid = (int)m_processor_assignment.size() == old_patches;
+  }
+
+  //__________________________________
+  //
+  graph.xadj.assign(1, 0);
+  graph.adjncy.clear();
+  graph.adjwgt.clear();
+  graph.vwgt = patch_costs;
+  graph.home.assign(level->numPatches(), -1);
+  graph.mwgt.assign(level->numPatches(), 0);
+
+  for (int p = 0; p < level->numPatches(); p++) {
+    const Patch* patch = level->getPatch(p);
+    IntVector low  = patch->getCellLowIndex();
+    IntVector high = patch->getCellHighIndex();
+
+    // every patch that sends ghost cells to this one or receives from it
+    Level::selectType neighbors;
+    level->selectPatches(low - g, high + g, neighbors);
+
+    for (unsigned i = 0; i < neighbors.size(); i++) {
+      const Patch* neighbor = neighbors[i];
+      if (neighbor->getLevelIndex() == p) {
+        continue;
+      }
+      IntVector nlow  = neighbor->getCellLowIndex();
+      IntVector nhigh = neighbor->getCellHighIndex();
+
+      IntVector recv = Min(high + g, nhigh) - Max(low - g, nlow);
+      IntVector send = Min(high, nhigh + g) - Max(low, nlow - g);
+
+      double cells = 0;
+      if (recv.x() > 0 && recv.y() > 0 && recv.z() > 0) {
+        cells += (double)recv.x() * recv.y() * recv.z();
+      }
+      if (send.x() > 0 && send.y() > 0 && send.z() > 0) {
+        cells += (double)send.x() * send.y() * send.z();
+      }
+      if (cells > 0) {
+        graph.adjncy.push_back(neighbor->getLevelIndex());
+        graph.adjwgt.push_back(cells);
+      }
+    }
+    graph.xadj.push_back(graph.adjncy.size());
+
+    graph.mwgt[p] = d_migrationCost * patch->getNumCells() / interval;
+
+    if (sameGrid) {
+      graph.home[p] = m_processor_assignment[patch->getGridIndex()];
+    }
+    else if (fromOldGrid) {
+      Level::selectType oldPatches;
+      oldGrid->getLevel(level->getIndex())->selectPatches(low, high, oldPatches);
+
+      double maxOverlap = 0;
+      for (unsigned i = 0; i < oldPatches.size(); i++) {
+        IntVector overlap = Min(high, oldPatches[i]->getCellHighIndex()) - Max(low, oldPatches[i]->getCellLowIndex());
+        double cells = (double)overlap.x() * overlap.y() * overlap.z();
+        if (cells > maxOverlap) {
+          maxOverlap    = cells;
+          graph.home[p] = m_processor_assignment[oldPatches[i]->getGridIndex()];
+        }
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+DynamicLoadBalancer::assignPatchesGraph( const GridP & grid, bool force )
+{
+  // enabled in the UPS file with: <dynamicAlgorithm>graph</dynamicAlgorithm>
+  //
+  // Partitions the patch graph of each level (patches weighted by their
+  // forecast cost, edges by the ghost cells exchanged) so that the
+  // costs are balanced and as little as possible is communicated or
+  // moved.  The levels are partitioned independently.  Rank 0
+  // partitions and broadcasts the result.
+  doing << d_myworld->myRank() << "   APG\n";
+
+  Timers::Simple timer;
+  timer.start();
+
+  std::vector<std::vector<double> > patch_costs;
+  getCosts(grid.get_rep(), patch_costs);
+
+  int num_procs = d_myworld->nRanks();
+  int cutImproved = 0;
+
+  if (d_myworld->myRank() == 0) {
+    GraphPartitioner partitioner(num_procs, d_imbalanceTolerance);
+
+    double currentCut = 0;
+    double newCut = 0;
+    int level_offset = 0;
+
+    for (int l = 0; l < grid->numLevels(); l++) {
+      const LevelP& level = grid->getLevel(l);
+      int num_patches = level->numPatches();
+
+      GraphPartitioner::Graph graph;
+      getPatchGraph(level, patch_costs[l], graph);
+
+      std::vector<int> part;
+      partitioner.partition(graph, part);
+
+      for (int p = 0; p < num_patches; p++) {
+        m_temp_assignment[level_offset + p] = part[p];
+      }
+
+      double cut = GraphPartitioner::edgeCut(graph, part);
+      newCut += cut;
+
+      if (!force) {
+        std::vector<int> current(m_processor_assignment.begin() + level_offset,
+                                 m_processor_assignment.begin() + level_offset + num_patches);
+        currentCut += GraphPartitioner::edgeCut(graph, current);
+      }
+
+      if (stats.active()) {
+        stats << "LoadBalance Graph level(" << l << "): ghost cells cut: " << cut << std::endl;
+      }
+
+      level_offset += num_patches;
+    }
+
+    if (!force && currentCut > 0 && (currentCut - newCut) / currentCut > d_lbThreshold) {
+      cutImproved = 1;
+    }
+
+    if (stats.active()) {
+      stats << "LoadBalance Graph total: ghost cells cut: " << newCut << " current: " << currentCut << std::endl;
+    }
+  }
+
+  if (num_procs > 1) {
+    Uintah::MPI::Bcast(&m_temp_assignment[0], m_temp_assignment.size(), MPI_INT, 0, d_myworld->getComm());
+    Uintah::MPI::Bcast(&cutImproved, 1, MPI_INT, 0, d_myworld->getComm());
+  }
+
+  // take the new assignment if it balances the costs better or cuts
+  // enough communication
+  bool doLoadBalancing = force || cutImproved || thresholdExceeded(patch_costs);
+
+  if (d_myworld->myRank() == 0) {
+    dbg << " Time to LB: " << timer().seconds() << std::endl;
+  }
+  doing << d_myworld->myRank() << "   APG END\n";
+
+  return doLoadBalancing;
+}
+
 //______________________________________________________________________
 //
 bool 
@@ -1026,6 +1218,9 @@ DynamicLoadBalancer::possiblyDynamicallyReallocate( const GridP & grid, int stat
         case random_lb :
           dynamicAllocate = assignPatchesRandom(grid, force);
           break;
+        case graph_lb :
+          dynamicAllocate = assignPatchesGraph(grid, force);
+          break;
       }
     }
     else  //regridder has called dynamic load balancer so we must dynamically Allocate
@@ -1139,6 +1334,9 @@ DynamicLoadBalancer::problemSetup( ProblemSpecP & pspec, GridP & grid, const Mat
     p->getWithDefault("gainThreshold",    threshold, 0.05);
     p->getWithDefault("doSpaceCurve",     spaceCurve, true);
     p->getWithDefault("hasParticles",     d_collectParticles, false);
+    p->getWithDefault("ghostCells",         d_ghostCells, 0);
+    p->getWithDefault("imbalanceTolerance", d_imbalanceTolerance, 0.05);
+    p->getWithDefault("migrationCost",      d_migrationCost, 1.0);
     
     std::string costAlgo="ModelLS";
     p->get("costAlgorithm",costAlgo);
@@ -1183,6 +1381,9 @@ DynamicLoadBalancer::problemSetup( ProblemSpecP & pspec, GridP & grid, const Mat
   else if (dynamicAlgo == "patchFactor") {
     d_dynamicAlgorithm = patch_factor_lb;
   }
+  else if (dynamicAlgo == "graph") {
+    d_dynamicAlgorithm = graph_lb;
+  }
   else if (dynamicAlgo == "patchFactorParticles" || dynamicAlgo == "particle3") {
     // these are for backward-compatibility
     d_dynamicAlgorithm = patch_factor_lb;
@@ -1190,7 +1391,7 @@ DynamicLoadBalancer::problemSetup( ProblemSpecP & pspec, GridP & grid, const Mat
   }
   else {
     proc0cout << "Invalid Load Balancer Algorithm: " << dynamicAlgo
-              << "\nPlease select 'cyclic', 'random', 'patchFactor' (default), or 'patchFactorParticles'\n"
+              << "\nPlease select 'cyclic', 'random', 'patchFactor' (default), 'patchFactorParticles', or 'graph'\n"
               << "\nUsing 'patchFactor' load balancer\n";
     d_dynamicAlgorithm = patch_factor_lb;
   }
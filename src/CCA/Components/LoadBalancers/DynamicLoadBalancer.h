@@ -27,6 +27,7 @@
 
 #include <CCA/Components/LoadBalancers/CostForecasterBase.h>
 #include <CCA/Components/LoadBalancers/CostProfiler.h>
+#include <CCA/Components/LoadBalancers/GraphPartitioner.h>
 #include <CCA/Components/LoadBalancers/LoadBalancerCommon.h>
 
 #include <sci_defs/uintah_defs.h>
@@ -120,7 +121,7 @@ namespace Uintah {
 
     std::vector<IntVector> d_minPatchSize;
     CostForecasterBase * d_costForecaster{nullptr};
-    enum { static_lb, cyclic_lb, random_lb, patch_factor_lb };
+    enum { static_lb, cyclic_lb, random_lb, patch_factor_lb, graph_lb };
 
     DynamicLoadBalancer(const DynamicLoadBalancer&);
     DynamicLoadBalancer& operator=(const DynamicLoadBalancer&);
@@ -131,6 +132,13 @@ namespace Uintah {
     bool assignPatchesFactor(const GridP& grid, bool force);
     bool assignPatchesRandom(const GridP& grid, bool force);
     bool assignPatchesCyclic(const GridP& grid, bool force);
+    bool assignPatchesGraph(const GridP& grid, bool force);
+
+    /// Patch graph of a level for assignPatchesGraph: patches weighted by
+    /// cost, edges by the number of ghost cells exchanged, homes from the
+    /// current assignment (or the old grid's after a regrid).
+    void getPatchGraph(const LevelP& level, const std::vector<double>& patch_costs,
+                       GraphPartitioner::Graph& graph);
 
     bool thresholdExceeded(const std::vector<std::vector<double> >& patch_costs);
 
@@ -151,6 +159,10 @@ namespace Uintah {
     
     int  d_dynamicAlgorithm{patch_factor_lb};
     bool d_collectParticles{false};
+
+    int    d_ghostCells{0};             // ghost layers for the graph edges, 0 = scheduler's maximum
+    double d_imbalanceTolerance{0.05};  // allowed excess of the largest graph part over the average
+    double d_migrationCost{1.0};        // cost of moving a cell relative to one ghost cell exchange
   };
 } // End namespace Uintah
 
@@ -0,0 +1,517 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/LoadBalancers/GraphPartitioner.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+
+using namespace Uintah;
+
+namespace {
+  // Stop coarsening when a level shrinks by less than this.
+  const double MIN_CONTRACTION = 0.9;
+
+  const int    REFINE_PASSES   = 8;
+}
+
+GraphPartitioner::GraphPartitioner( int nparts, double imbalance )
+  : m_nparts(nparts)
+  , m_imbalance(imbalance)
+{
+}
+
+//______________________________________________________________________
+//
+double
+GraphPartitioner::edgeCut( const Graph & graph, const std::vector<int> & part )
+{
+  double cut = 0;
+  for (int v = 0; v < graph.nvtxs(); v++) {
+    for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+      if (part[v] != part[graph.adjncy[e]]) {
+        cut += graph.adjwgt[e];
+      }
+    }
+  }
+  return cut / 2;   // every edge is listed twice
+}
+
+//______________________________________________________________________
+//
+void
+GraphPartitioner::partition( const Graph & graph, std::vector<int> & part )
+{
+  const int nvtxs = graph.nvtxs();
+
+  part.assign(nvtxs, 0);
+
+  if (m_nparts <= 1 || nvtxs == 0) {
+    return;
+  }
+
+  // same partition for the same input
+  m_random.seed(5489u);
+
+  // a few vertices per part for the initial partition
+  m_coarsenTo = std::max(100, 4 * m_nparts);
+
+  //__________________________________
+  // Coarsen
+  std::vector<Graph>            graphs(1, graph);
+  std::vector<std::vector<int>> cmaps;
+
+  while (graphs.back().nvtxs() > m_coarsenTo) {
+    Graph            coarse;
+    std::vector<int> cmap;
+
+    coarsen(graphs.back(), coarse, cmap);
+
+    if (coarse.nvtxs() > MIN_CONTRACTION * graphs.back().nvtxs()) {
+      break;
+    }
+    graphs.push_back(coarse);
+    cmaps.push_back(cmap);
+  }
+
+  //__________________________________
+  // Partition the coarsest graph, then refine while uncoarsening
+  std::vector<int> coarsePart;
+
+  initialPartition(graphs.back(), coarsePart);
+  remap(graphs.back(), coarsePart);
+  refine(graphs.back(), coarsePart);
+
+  for (int l = (int)cmaps.size() - 1; l >= 0; l--) {
+    const std::vector<int>& cmap = cmaps[l];
+    std::vector<int> finePart(cmap.size());
+
+    for (unsigned v = 0; v < cmap.size(); v++) {
+      finePart[v] = coarsePart[cmap[v]];
+    }
+    refine(graphs[l], finePart);
+    coarsePart.swap(finePart);
+  }
+
+  part.swap(coarsePart);
+}
+
+//______________________________________________________________________
+//  Heavy edge matching: every vertex is merged with the unmatched
+//  neighbor it shares the heaviest edge with.
+void
+GraphPartitioner::coarsen( const Graph & fine, Graph & coarse, std::vector<int> & cmap )
+{
+  const int nvtxs = fine.nvtxs();
+
+  double total   = std::accumulate(fine.vwgt.begin(), fine.vwgt.end(), 0.0);
+  double maxVwgt = 1.5 * total / m_coarsenTo;
+
+  std::vector<int> order(nvtxs);
+  std::iota(order.begin(), order.end(), 0);
+  std::shuffle(order.begin(), order.end(), m_random);
+
+  std::vector<int> match(nvtxs, -1);
+
+  for (int i = 0; i < nvtxs; i++) {
+    int u = order[i];
+    if (match[u] != -1) {
+      continue;
+    }
+
+    int    best       = u;
+    double bestWeight = -1;
+
+    for (int e = fine.xadj[u]; e < fine.xadj[u + 1]; e++) {
+      int v = fine.adjncy[e];
+      if (match[v] == -1 && v != u && fine.vwgt[u] + fine.vwgt[v] <= maxVwgt && fine.adjwgt[e] > bestWeight) {
+        best       = v;
+        bestWeight = fine.adjwgt[e];
+      }
+    }
+    match[u]    = best;
+    match[best] = u;
+  }
+
+  // number the coarse vertices in the order of their first fine vertex
+  cmap.assign(nvtxs, -1);
+  int ncoarse = 0;
+  for (int u = 0; u < nvtxs; u++) {
+    if (cmap[u] == -1) {
+      cmap[u]        = ncoarse;
+      cmap[match[u]] = ncoarse;
+      ncoarse++;
+    }
+  }
+
+  coarse.vwgt.assign(ncoarse, 0);
+  coarse.home.assign(ncoarse, -1);
+  coarse.mwgt.assign(ncoarse, 0);
+  coarse.xadj.assign(1, 0);
+  coarse.adjncy.clear();
+  coarse.adjwgt.clear();
+
+  // where each coarse neighbor is in the edge list of the current vertex
+  std::vector<int> edge(ncoarse, -1);
+
+  for (int u = 0; u < nvtxs; u++) {
+    int c = cmap[u];
+    if (c != (int)coarse.xadj.size() - 1) {
+      continue;     // not the first fine vertex of c
+    }
+
+    int members[2] = {u, match[u]};
+    int nmembers   = (match[u] == u) ? 1 : 2;
+    int start      = coarse.adjncy.size();
+
+    for (int m = 0; m < nmembers; m++) {
+      int v = members[m];
+
+      coarse.vwgt[c] += fine.vwgt[v];
+
+      // a coarse vertex keeps the home its heaviest member would leave
+      if (fine.home[v] == coarse.home[c]) {
+        coarse.mwgt[c] += fine.mwgt[v];
+      }
+      else if (coarse.home[c] == -1 || fine.mwgt[v] > coarse.mwgt[c]) {
+        coarse.home[c] = fine.home[v];
+        coarse.mwgt[c] = fine.mwgt[v];
+      }
+
+      for (int e = fine.xadj[v]; e < fine.xadj[v + 1]; e++) {
+        int n = cmap[fine.adjncy[e]];
+        if (n == c) {
+          continue;
+        }
+        if (edge[n] == -1) {
+          edge[n] = coarse.adjncy.size();
+          coarse.adjncy.push_back(n);
+          coarse.adjwgt.push_back(fine.adjwgt[e]);
+        }
+        else {
+          coarse.adjwgt[edge[n]] += fine.adjwgt[e];
+        }
+      }
+    }
+
+    for (unsigned e = start; e < coarse.adjncy.size(); e++) {
+      edge[coarse.adjncy[e]] = -1;
+    }
+    coarse.xadj.push_back(coarse.adjncy.size());
+  }
+}
+
+//______________________________________________________________________
+//
+void
+GraphPartitioner::initialPartition( const Graph & graph, std::vector<int> & part )
+{
+  const int nvtxs = graph.nvtxs();
+
+  std::vector<int> vertices(nvtxs);
+  std::iota(vertices.begin(), vertices.end(), 0);
+
+  std::vector<char>   grown(nvtxs, 0);
+  std::vector<double> conn(nvtxs, 0);
+
+  part.assign(nvtxs, 0);
+  bisect(graph, vertices, 0, m_nparts, part, grown, conn);
+}
+
+//______________________________________________________________________
+//  Recursive bisection by greedy graph growing.  On entry part[v] is
+//  'first' for all of the vertices; the grown region keeps parts
+//  [first, first+nparts/2), the rest gets the others.
+void
+GraphPartitioner::bisect( const Graph             & graph
+                        , const std::vector<int>  & vertices
+                        ,       int                 first
+                        ,       int                 nparts
+                        ,       std::vector<int>    & part
+                        ,       std::vector<char>   & grown
+                        ,       std::vector<double> & conn
+                        )
+{
+  if (nparts == 1 || vertices.empty()) {
+    return;
+  }
+
+  const int nparts1 = nparts / 2;
+
+  double total = 0;
+  for (unsigned i = 0; i < vertices.size(); i++) {
+    total += graph.vwgt[vertices[i]];
+  }
+  const double target = total * nparts1 / nparts;
+
+  // Seed with a pseudo-peripheral vertex: the last one reached by a
+  // breadth first search of the subgraph.
+  int seed = vertices[0];
+  {
+    std::queue<int> bfs;
+    bfs.push(seed);
+    grown[seed] = 1;
+    while (!bfs.empty()) {
+      seed = bfs.front();
+      bfs.pop();
+      for (int e = graph.xadj[seed]; e < graph.xadj[seed + 1]; e++) {
+        int u = graph.adjncy[e];
+        if (part[u] == first && !grown[u]) {
+          grown[u] = 1;
+          bfs.push(u);
+        }
+      }
+    }
+    for (unsigned i = 0; i < vertices.size(); i++) {
+      grown[vertices[i]] = 0;
+    }
+  }
+
+  // Grow the region from the seed, always taking the frontier vertex
+  // most connected to it.  Restart from an unreached vertex if the
+  // subgraph is not connected.
+  std::priority_queue<std::pair<double, int>> frontier;
+  frontier.push(std::make_pair(0.0, seed));
+
+  double   weight = 0;
+  unsigned next   = 0;
+
+  while (weight < target) {
+    if (frontier.empty()) {
+      while (next < vertices.size() && grown[vertices[next]]) {
+        next++;
+      }
+      if (next == vertices.size()) {
+        break;
+      }
+      frontier.push(std::make_pair(0.0, vertices[next]));
+    }
+
+    std::pair<double, int> top = frontier.top();
+    frontier.pop();
+
+    int v = top.second;
+    if (grown[v] || top.first != conn[v]) {
+      continue;     // already taken or stale
+    }
+
+    // stop if taking v lands further from the target than leaving it
+    if (weight > 0 && weight + graph.vwgt[v] - target > target - weight) {
+      break;
+    }
+
+    grown[v] = 1;
+    weight  += graph.vwgt[v];
+
+    for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+      int u = graph.adjncy[e];
+      if (part[u] == first && !grown[u]) {
+        conn[u] += graph.adjwgt[e];
+        frontier.push(std::make_pair(conn[u], u));
+      }
+    }
+  }
+
+  std::vector<int> left, right;
+  for (unsigned i = 0; i < vertices.size(); i++) {
+    int v = vertices[i];
+    if (grown[v]) {
+      left.push_back(v);
+    }
+    else {
+      right.push_back(v);
+      part[v] = first + nparts1;
+    }
+    grown[v] = 0;
+    conn[v]  = 0;
+  }
+
+  bisect(graph, left,  first,           nparts1,          part, grown, conn);
+  bisect(graph, right, first + nparts1, nparts - nparts1, part, grown, conn);
+}
+
+//______________________________________________________________________
+//  Relabel the parts so that as much of the migration weight as
+//  possible stays home (greedy matching of parts to homes).
+void
+GraphPartitioner::remap( const Graph & graph, std::vector<int> & part )
+{
+  std::unordered_map<long long, double> overlap;
+
+  for (int v = 0; v < graph.nvtxs(); v++) {
+    int home = graph.home[v];
+    if (home >= 0 && home < m_nparts) {
+      overlap[(long long)part[v] * m_nparts + home] += graph.mwgt[v];
+    }
+  }
+
+  if (overlap.empty()) {
+    return;
+  }
+
+  std::vector<std::pair<double, long long>> pairs;
+  pairs.reserve(overlap.size());
+  for (auto iter = overlap.begin(); iter != overlap.end(); iter++) {
+    pairs.push_back(std::make_pair(iter->second, iter->first));
+  }
+
+  // heaviest first, ties broken by (part, home)
+  std::sort(pairs.begin(), pairs.end(),
+            [](const std::pair<double, long long>& a, const std::pair<double, long long>& b) {
+              return a.first > b.first || (a.first == b.first && a.second < b.second);
+            });
+
+  std::vector<int>  label(m_nparts, -1);
+  std::vector<bool> taken(m_nparts, false);
+
+  for (unsigned i = 0; i < pairs.size(); i++) {
+    int p    = pairs[i].second / m_nparts;
+    int home = pairs[i].second % m_nparts;
+    if (label[p] == -1 && !taken[home]) {
+      label[p]    = home;
+      taken[home] = true;
+    }
+  }
+
+  int free = 0;
+  for (int p = 0; p < m_nparts; p++) {
+    if (label[p] == -1) {
+      while (taken[free]) {
+        free++;
+      }
+      label[p]    = free;
+      taken[free] = true;
+    }
+  }
+
+  for (int v = 0; v < graph.nvtxs(); v++) {
+    part[v] = label[part[v]];
+  }
+}
+
+//______________________________________________________________________
+//  Greedy k-way refinement.  A vertex moves to the neighboring part
+//  with the largest gain (cut weight removed plus migration weight
+//  saved) if the move keeps that part under the load limit and either
+//  gains or improves the balance.  Vertices of overloaded parts also
+//  move at a loss to any part that ends up lighter than the one they
+//  leave, to the lightest part if they have no neighbor.
+void
+GraphPartitioner::refine( const Graph & graph, std::vector<int> & part )
+{
+  const int nvtxs = graph.nvtxs();
+
+  std::vector<double> load(m_nparts, 0);
+  for (int v = 0; v < nvtxs; v++) {
+    load[part[v]] += graph.vwgt[v];
+  }
+
+  const double total   = std::accumulate(load.begin(), load.end(), 0.0);
+  const double maxLoad = (1 + m_imbalance) * total / m_nparts;
+
+  std::vector<double> conn(m_nparts, 0);
+  std::vector<int>    touched;
+
+  for (int pass = 0; pass < REFINE_PASSES; pass++) {
+    int moves = 0;
+    int lightest = std::min_element(load.begin(), load.end()) - load.begin();
+
+    for (int v = 0; v < nvtxs; v++) {
+      const int    a = part[v];
+      const double w = graph.vwgt[v];
+
+      for (int e = graph.xadj[v]; e < graph.xadj[v + 1]; e++) {
+        int p = part[graph.adjncy[e]];
+        if (conn[p] == 0) {
+          touched.push_back(p);
+        }
+        conn[p] += graph.adjwgt[e];
+      }
+
+      const bool overloaded = load[a] > maxLoad;
+
+      if (overloaded && conn[lightest] == 0 && lightest != a) {
+        touched.push_back(lightest);
+      }
+
+      int    best     = -1;
+      double bestGain = -std::numeric_limits<double>::max();
+
+      for (unsigned i = 0; i < touched.size(); i++) {
+        int b = touched[i];
+        // over the limit only to relieve an overloaded part
+        if (b == a || (load[b] + w > maxLoad && !(overloaded && load[b] + w < load[a]))) {
+          continue;
+        }
+
+        double gain = conn[b] - conn[a];
+        if (graph.home[v] == b) {
+          gain += graph.mwgt[v];
+        }
+        else if (graph.home[v] == a) {
+          gain -= graph.mwgt[v];
+        }
+
+        if (gain > bestGain || (gain == bestGain && load[b] < load[best])) {
+          best     = b;
+          bestGain = gain;
+        }
+      }
+
+      for (unsigned i = 0; i < touched.size(); i++) {
+        conn[touched[i]] = 0;
+      }
+      touched.clear();
+
+      if (best == -1) {
+        continue;
+      }
+
+      bool balances = load[best] + w < load[a];
+
+      if (bestGain > 0 || (bestGain == 0 && balances) || (overloaded && balances)) {
+        load[a]    -= w;
+        load[best] += w;
+        part[v]     = best;
+        moves++;
+
+        if (best == lightest) {
+          lightest = std::min_element(load.begin(), load.end()) - load.begin();
+        }
+        else if (load[a] < load[lightest]) {
+          lightest = a;
+        }
+      }
+    }
+
+    if (moves == 0) {
+      break;
+    }
+  }
+}
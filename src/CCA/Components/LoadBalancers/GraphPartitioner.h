@@ -0,0 +1,122 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CCA_COMPONENTS_LOADBALANCERS_GRAPHPARTITIONER_H
+#define CCA_COMPONENTS_LOADBALANCERS_GRAPHPARTITIONER_H
+
+#include <random>
+#include <vector>
+
+namespace Uintah {
+   /**************************************
+     
+     CLASS
+       GraphPartitioner
+      
+       Multilevel k-way partitioner for the patch graph.
+      
+     GENERAL INFORMATION
+      
+       GraphPartitioner.h
+      
+     KEYWORDS
+       GraphPartitioner, DynamicLoadBalancer
+      
+     DESCRIPTION
+       Splits a weighted graph into k parts of (nearly) equal vertex
+       weight while minimizing the weight of the cut edges plus the
+       cost of moving vertices away from their current part:
+
+         - coarsening by heavy edge matching until the graph has a few
+           vertices per part,
+         - recursive bisection of the coarsest graph by greedy graph
+           growing,
+         - relabelling of the parts so they overlap the current
+           assignment as much as possible,
+         - greedy k-way refinement while projecting back to the
+           original graph.
+
+       The DynamicLoadBalancer uses it with a vertex per patch
+       (weighted by the forecast cost) and an edge per pair of patches
+       that exchange ghost cells (weighted by the number of cells).
+      
+     WARNING
+       Serial; the DynamicLoadBalancer partitions on one rank and
+       broadcasts the result.
+      
+     ****************************************/
+
+  class GraphPartitioner {
+  public:
+
+    // Compressed sparse row graph, every edge must be listed from both ends.
+    struct Graph {
+      std::vector<int>    xadj;     // first edge of each vertex (size nvtxs+1)
+      std::vector<int>    adjncy;   // neighbor at the other end of each edge
+      std::vector<double> adjwgt;   // communication weight of each edge
+      std::vector<double> vwgt;     // cost of each vertex
+      std::vector<int>    home;     // current part of each vertex, -1 if none
+      std::vector<double> mwgt;     // cost of moving each vertex off its home
+
+      int nvtxs() const { return (int)vwgt.size(); }
+    };
+
+    /// 'imbalance' is the allowed excess of the largest part over the
+    /// average, e.g. 0.05.
+    GraphPartitioner( int nparts, double imbalance );
+
+    /// Fills 'part' (one entry per vertex, in [0, nparts)).
+    void partition( const Graph & graph, std::vector<int> & part );
+
+    /// Total weight of the edges between different parts.
+    static double edgeCut( const Graph & graph, const std::vector<int> & part );
+
+  private:
+
+    void coarsen( const Graph & fine, Graph & coarse, std::vector<int> & cmap );
+
+    void initialPartition( const Graph & graph, std::vector<int> & part );
+
+    void bisect( const Graph            & graph
+               , const std::vector<int> & vertices
+               ,       int                first
+               ,       int                nparts
+               ,       std::vector<int>   & part
+               ,       std::vector<char>  & grown
+               ,       std::vector<double>& conn
+               );
+
+    void remap(  const Graph & graph, std::vector<int> & part );
+
+    void refine( const Graph & graph, std::vector<int> & part );
+
+    int          m_nparts;
+    double       m_imbalance;
+    int          m_coarsenTo{0};
+    std::mt19937 m_random;
+  };
+} // End namespace Uintah
+
+#endif // CCA_COMPONENTS_LOADBALANCERS_GRAPHPARTITIONER_H
@@ -24,6 +24,7 @@
 
 #include <CCA/Components/LoadBalancers/LoadBalancerFactory.h>
 #include <CCA/Components/LoadBalancers/DynamicLoadBalancer.h>
+#include <CCA/Components/LoadBalancers/ParallelSFCLoadBalancer.h>
 #include <CCA/Components/LoadBalancers/ParticleLoadBalancer.h>
 #include <CCA/Components/LoadBalancers/RoundRobinLoadBalancer.h>
 #include <CCA/Components/LoadBalancers/SimpleLoadBalancer.h>
@@ -78,6 +79,10 @@ LoadBalancerFactory::create( const ProblemSpecP   & ps
   else if (loadbalancer == "PLB") {
     bal = scinew ParticleLoadBalancer(world);
   }
+
+  else if (loadbalancer == "ParallelSFC") {
+    bal = scinew ParallelSFCLoadBalancer(world);
+  }
   else {
     bal = nullptr;
 
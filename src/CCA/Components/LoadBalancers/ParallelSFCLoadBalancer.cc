@@ -0,0 +1,530 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/LoadBalancers/ParallelSFCLoadBalancer.h>
+
+#include <CCA/Ports/ApplicationInterface.h>
+#include <CCA/Ports/DataWarehouse.h>
+#include <CCA/Ports/Scheduler.h>
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Grid/MaterialManager.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Parallel/ProcessorGroup.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+#include <Core/Util/DebugStream.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <algorithm>
+#include <climits>
+
+using namespace Uintah;
+
+namespace {
+  DebugStream dbg( "ParallelSFCLoadBalancer", "LoadBalancers", "", false );
+}
+
+ParallelSFCLoadBalancer::ParallelSFCLoadBalancer( const ProcessorGroup * myworld )
+  : LoadBalancerCommon(myworld)
+{
+}
+
+//______________________________________________________________________
+//
+void
+ParallelSFCLoadBalancer::getLocalCosts( const LevelP                 & level
+                                      ,       int                      level_offset
+                                      ,       bool                     owned
+                                      ,       std::vector<PatchCost> & local
+                                      )
+{
+  const long long num_procs   = d_myworld->nRanks();
+  const long long num_patches = level->numPatches();
+  const int       myRank      = d_myworld->myRank();
+
+  // Particles can only be counted on the patches this rank owns in
+  // the old data warehouse's grid.
+  DataWarehouse* dw = nullptr;
+  if (d_collectParticles && owned) {
+    dw = m_scheduler->get_dw(0);
+  }
+  bool countParticles = dw != nullptr && dw->getGrid() == level->getGrid().get_rep();
+
+  local.clear();
+
+  for (int p = 0; p < num_patches; p++) {
+    int rank;
+    if (owned) {
+      rank = m_processor_assignment[level_offset + p];
+    }
+    else {
+      // place in long longs to avoid overflows with large numbers of patches and processors
+      rank = (int)((p * num_procs) / num_patches);
+    }
+
+    if (rank != myRank) {
+      continue;
+    }
+
+    const Patch* patch = level->getPatch(p);
+
+    int numParticles = 0;
+    if (countParticles) {
+      //   go through all materials since getting an MPMMaterial correctly would depend on MPM
+      for (unsigned int m = 0; m < m_materialManager->getNumMatls(); m++) {
+        if (dw->haveParticleSubset(m, patch)) {
+          numParticles += dw->getParticleSubset(m, patch)->numParticles();
+        }
+      }
+    }
+
+    PatchCost pc;
+    pc.id   = p;
+    pc.cost = d_patchCost
+            + patch->getNumCells() * d_cellCost
+            + (patch->getNumExtraCells() - patch->getNumCells()) * d_extraCellCost
+            + numParticles * d_particleCost;
+    local.push_back(pc);
+  }
+}
+
+//______________________________________________________________________
+//
+double
+ParallelSFCLoadBalancer::assignLevel( const LevelP                 & level
+                                    ,       int                      level_offset
+                                    , const std::vector<PatchCost> & local
+                                    )
+{
+  const int num_procs = d_myworld->nRanks();
+  const int myRank    = d_myworld->myRank();
+  MPI_Comm  comm      = d_myworld->getComm();
+
+  //__________________________________
+  // Bounds of the level and the minimum patch size, from the local
+  // patches only.  The high index is negated so one MIN reduction does.
+  int bounds[9], gbounds[9];
+  std::fill(bounds, bounds + 9, INT_MAX);
+
+  std::vector<double> positions;
+  positions.reserve(local.size() * m_numDims);
+
+  for (unsigned i = 0; i < local.size(); i++) {
+    const Patch* patch = level->getPatch(local[i].id);
+    IntVector low  = patch->getCellLowIndex();
+    IntVector high = patch->getCellHighIndex();
+
+    for (int d = 0; d < 3; d++) {
+      bounds[d]     = std::min(bounds[d], low[d]);
+      bounds[d + 3] = std::min(bounds[d + 3], -high[d]);
+      bounds[d + 6] = std::min(bounds[d + 6], high[d] - low[d]);
+    }
+
+    Vector point = (low + high).asVector() / 2.0;
+    for (int d = 0; d < m_numDims; d++) {
+      positions.push_back(point[m_activeDims[d]]);
+    }
+  }
+
+  if (num_procs > 1) {
+    Uintah::MPI::Allreduce(bounds, gbounds, 9, MPI_INT, MPI_MIN, comm);
+  }
+  else {
+    std::copy(bounds, bounds + 9, gbounds);
+  }
+
+  double r[3]     = {0, 0, 0};
+  double c[3]     = {0, 0, 0};
+  double delta[3] = {0, 0, 0};
+
+  for (int d = 0; d < m_numDims; d++) {
+    int dim  = m_activeDims[d];
+    r[d]     = (double)(-gbounds[dim + 3] - gbounds[dim]);
+    c[d]     = (double)(-gbounds[dim + 3] + gbounds[dim]) / 2.0;
+    delta[d] = (double)gbounds[dim + 6];
+  }
+
+  //__________________________________
+  // Sort the curve.  Each rank ends up with a contiguous piece of it,
+  // as (local index, original rank) pairs.
+  std::vector<DistributedIndex> indices;
+
+  m_sfc.SetDimensions(r);
+  m_sfc.SetCenter(c);
+  m_sfc.SetRefinementsByDelta(delta);
+  m_sfc.SetLocations(&positions);
+  m_sfc.SetOutputVector(&indices);
+  m_sfc.SetLocalSize(local.size());
+
+  if (num_procs > 1) {
+    m_sfc.GenerateCurve();
+  }
+  else {
+    m_sfc.GenerateCurve(SERIAL);
+  }
+
+  //__________________________________
+  // Fetch the costs of this piece of the curve from their owners.
+  std::vector<PatchCost> piece(indices.size());
+
+  if (num_procs > 1) {
+    std::vector<int> sendcounts(num_procs, 0), recvcounts(num_procs, 0);
+    std::vector<int> sdispls(num_procs, 0),    rdispls(num_procs, 0);
+
+    for (unsigned i = 0; i < indices.size(); i++) {
+      sendcounts[indices[i].p]++;
+    }
+
+    Uintah::MPI::Alltoall(sendcounts.data(), 1, MPI_INT, recvcounts.data(), 1, MPI_INT, comm);
+
+    for (int p = 1; p < num_procs; p++) {
+      sdispls[p] = sdispls[p - 1] + sendcounts[p - 1];
+      rdispls[p] = rdispls[p - 1] + recvcounts[p - 1];
+    }
+
+    int numRequests = rdispls[num_procs - 1] + recvcounts[num_procs - 1];
+
+    std::vector<int> requests(indices.size());
+    std::vector<int> requested(numRequests);
+    std::vector<int> next(sdispls);
+
+    for (unsigned i = 0; i < indices.size(); i++) {
+      requests[next[indices[i].p]++] = indices[i].i;
+    }
+
+    Uintah::MPI::Alltoallv(requests.data(), sendcounts.data(), sdispls.data(), MPI_INT,
+                           requested.data(), recvcounts.data(), rdispls.data(), MPI_INT, comm);
+
+    std::vector<PatchCost> replies(numRequests);
+    for (int i = 0; i < numRequests; i++) {
+      replies[i] = local[requested[i]];
+    }
+
+    // the replies go back the way the requests came, in bytes
+    for (int p = 0; p < num_procs; p++) {
+      sendcounts[p] *= sizeof(PatchCost);
+      sdispls[p]    *= sizeof(PatchCost);
+      recvcounts[p] *= sizeof(PatchCost);
+      rdispls[p]    *= sizeof(PatchCost);
+    }
+
+    std::vector<PatchCost> answers(indices.size());
+    Uintah::MPI::Alltoallv(replies.data(), recvcounts.data(), rdispls.data(), MPI_BYTE,
+                           answers.data(), sendcounts.data(), sdispls.data(), MPI_BYTE, comm);
+
+    // the answers from each owner are in the order of the requests
+    for (int p = 0; p < num_procs; p++) {
+      next[p] = sdispls[p] / sizeof(PatchCost);
+    }
+    for (unsigned i = 0; i < indices.size(); i++) {
+      piece[i] = answers[next[indices[i].p]++];
+    }
+  }
+  else {
+    for (unsigned i = 0; i < indices.size(); i++) {
+      piece[i] = local[indices[i].i];
+    }
+  }
+
+  //__________________________________
+  // Prefix sum of the costs along the curve.  A patch goes to the rank
+  // whose share of the total cost contains the patch's midpoint.
+  double myCost = 0;
+  for (unsigned i = 0; i < piece.size(); i++) {
+    myCost += piece[i].cost;
+  }
+
+  double offset    = 0;
+  double totalCost = myCost;
+
+  if (num_procs > 1) {
+    Uintah::MPI::Exscan(&myCost, &offset, 1, MPI_DOUBLE, MPI_SUM, comm);
+    Uintah::MPI::Allreduce(&myCost, &totalCost, 1, MPI_DOUBLE, MPI_SUM, comm);
+    if (myRank == 0) {
+      offset = 0;   // undefined on the first rank
+    }
+  }
+
+  std::vector<double> procCosts(num_procs, 0);
+  std::vector<int>    assignment(2 * piece.size());
+
+  double cost = offset;
+  for (unsigned i = 0; i < piece.size(); i++) {
+    int proc = 0;
+    if (totalCost > 0) {
+      proc = (int)((cost + piece[i].cost / 2) / totalCost * num_procs);
+      proc = std::min(std::max(proc, 0), num_procs - 1);
+    }
+    cost += piece[i].cost;
+
+    procCosts[proc]      += piece[i].cost;
+    assignment[2 * i]     = piece[i].id;
+    assignment[2 * i + 1] = proc;
+  }
+
+  //__________________________________
+  // Every rank needs the new assignment of the whole level.
+  std::vector<int> level_assignment;
+
+  if (num_procs > 1) {
+    std::vector<double> costs(num_procs);
+    Uintah::MPI::Allreduce(procCosts.data(), costs.data(), num_procs, MPI_DOUBLE, MPI_SUM, comm);
+    procCosts.swap(costs);
+
+    int mySize = assignment.size();
+    std::vector<int> recvcounts(num_procs, 0), displs(num_procs, 0);
+
+    Uintah::MPI::Allgather(&mySize, 1, MPI_INT, recvcounts.data(), 1, MPI_INT, comm);
+
+    for (int p = 1; p < num_procs; p++) {
+      displs[p] = displs[p - 1] + recvcounts[p - 1];
+    }
+
+    level_assignment.resize(2 * level->numPatches());
+    Uintah::MPI::Allgatherv(assignment.data(), mySize, MPI_INT, level_assignment.data(),
+                            recvcounts.data(), displs.data(), MPI_INT, comm);
+  }
+  else {
+    level_assignment.swap(assignment);
+  }
+
+  for (unsigned i = 0; i < level_assignment.size(); i += 2) {
+    m_temp_assignment[level_offset + level_assignment[i]] = level_assignment[i + 1];
+  }
+
+  double maxCost = *std::max_element(procCosts.begin(), procCosts.end());
+
+  if (stats.active() && myRank == 0) {
+    stats << "LoadBalance Stats level(" << level->getIndex() << "):"
+          << " Mean: " << totalCost / num_procs << " Max: " << maxCost
+          << " Imbalance:" << 1 - totalCost / num_procs / maxCost << std::endl;
+  }
+
+  return maxCost;
+}
+
+//______________________________________________________________________
+//
+bool
+ParallelSFCLoadBalancer::assignPatches( const GridP & grid, bool force )
+{
+  Timers::Simple timer;
+  timer.start();
+
+  int num_patches = 0;
+  for (int l = 0; l < grid->numLevels(); l++) {
+    num_patches += grid->getLevel(l)->numPatches();
+  }
+
+  // After a regrid the current assignment belongs to the old grid.
+  bool owned = (int)m_processor_assignment.size() == num_patches &&
+               m_assignment_base_patch == (*grid->getLevel(0)->patchesBegin())->getID();
+
+  m_temp_assignment.resize(num_patches);
+
+  std::vector<PatchCost> local;
+  double currentMax = 0;
+  double newMax     = 0;
+  int level_offset  = 0;
+
+  for (int l = 0; l < grid->numLevels(); l++) {
+    const LevelP& level = grid->getLevel(l);
+
+    getLocalCosts(level, level_offset, owned, local);
+
+    if (owned) {
+      double myCost = 0, maxCost = 0;
+      for (unsigned i = 0; i < local.size(); i++) {
+        myCost += local[i].cost;
+      }
+      Uintah::MPI::Allreduce(&myCost, &maxCost, 1, MPI_DOUBLE, MPI_MAX, d_myworld->getComm());
+      currentMax += maxCost;
+    }
+
+    newMax += assignLevel(level, level_offset, local);
+
+    level_offset += level->numPatches();
+  }
+
+  if (stats.active() && d_myworld->myRank() == 0) {
+    stats << "Total:" << " maxCur:" << currentMax << " maxTemp:" << newMax << std::endl;
+  }
+
+  if (dbg.active() && d_myworld->myRank() == 0) {
+    dbg << " Time to LB: " << timer().seconds() << std::endl;
+  }
+
+  if (force || !owned || currentMax <= 0) {
+    return true;
+  }
+
+  // if tmp - cur is positive, it is an improvement
+  return (currentMax - newMax) / currentMax > d_lbThreshold;
+}
+
+//______________________________________________________________________
+//
+bool
+ParallelSFCLoadBalancer::needRecompile( const GridP & grid )
+{
+  const int timeStep   = m_application->getTimeStep();
+  const double simTime = m_application->getSimTime();
+
+  bool do_check = false;
+
+  if (m_lb_timeStep_interval != 0 &&
+      timeStep >= m_last_lb_timeStep + m_lb_timeStep_interval) {
+    m_last_lb_timeStep = timeStep;
+    do_check = true;
+  }
+  else if (m_lb_interval != 0 &&
+           simTime >= m_last_lb_simTime + m_lb_interval) {
+    m_last_lb_simTime = simTime;
+    do_check = true;
+  }
+  else if ((simTime == 0 && d_collectParticles == true) ||
+           m_check_after_restart) {
+    // do AFTER initialization time step too (no matter how much init
+    // regridding), so we can compensate for new particles
+    do_check = true;
+    m_check_after_restart = false;
+  }
+
+  if (dbg.active() && d_myworld->myRank() == 0) {
+    dbg << d_myworld->myRank() << " ParallelSFC::NeedRecompile: do_check: " << do_check << ", time step: " << timeStep
+        << ", time[s]: " << simTime << std::endl;
+  }
+
+  // If it determines we need to re-load-balance, recompile:
+  if (do_check && possiblyDynamicallyReallocate(grid, LoadBalancer::CHECK_LB)) {
+    return true;
+  }
+  else {
+    m_old_assignment = m_processor_assignment;
+    m_old_assignment_base_patch = m_assignment_base_patch;
+    return false;
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+ParallelSFCLoadBalancer::possiblyDynamicallyReallocate( const GridP & grid, int state )
+{
+  Timers::Simple timer;
+  timer.start();
+
+  const int timeStep   = m_application->getTimeStep();
+  const double simTime = m_application->getSimTime();
+
+  bool changed = false;
+
+  // don't do on a restart.  For restarts, this is called mainly to
+  // update the perProc Patch sets (at the bottom)
+  if (state != LoadBalancer::RESTART_LB) {
+    bool force = false;
+
+    if (state != LoadBalancer::CHECK_LB) {
+      force = true;
+      if (m_lb_timeStep_interval != 0) {
+        m_last_lb_timeStep = timeStep;
+      }
+      else if (m_lb_interval != 0) {
+        m_last_lb_simTime = simTime;
+      }
+    }
+
+    m_old_assignment = m_processor_assignment;
+    m_old_assignment_base_patch = m_assignment_base_patch;
+
+    if (assignPatches(grid, force) || state != LoadBalancer::CHECK_LB) {
+      changed = true;
+      m_processor_assignment = m_temp_assignment;
+      m_assignment_base_patch = (*grid->getLevel(0)->patchesBegin())->getID();
+
+      if (state == LoadBalancer::INIT_LB) {
+        // set it up so the old and new are in same place
+        m_old_assignment = m_processor_assignment;
+        m_old_assignment_base_patch = m_assignment_base_patch;
+      }
+    }
+  }
+
+  m_temp_assignment.resize(0);
+
+  int flag = LoadBalancer::CHECK_LB;
+  if (changed || state == LoadBalancer::RESTART_LB) {
+    flag = LoadBalancer::REGRID_LB;
+  }
+
+  // this must be called here (it creates the new per-proc patch sets) even if nothing changed.
+  LoadBalancerCommon::possiblyDynamicallyReallocate(grid, flag);
+
+  (*d_runtimeStats)[LoadBalancerTime] += timer().seconds();
+
+  return changed;
+}
+
+//______________________________________________________________________
+//
+void
+ParallelSFCLoadBalancer::problemSetup( ProblemSpecP & pspec, GridP & grid, const MaterialManagerP & materialManager )
+{
+  LoadBalancerCommon::problemSetup(pspec, grid, materialManager);
+
+  ProblemSpecP p = pspec->findBlock("LoadBalancer");
+  double interval = 0;
+  int    timestepInterval = 10;
+
+  if (p != nullptr) {
+    if (!p->get("timestepInterval", timestepInterval)) {
+      timestepInterval = 0;
+    }
+    if (timestepInterval != 0 && !p->get("interval", interval)) {
+      interval = 0.0; // default
+    }
+    p->getWithDefault("cellCost",      d_cellCost, 1);
+    p->getWithDefault("extraCellCost", d_extraCellCost, 1);
+    p->getWithDefault("particleCost",  d_particleCost, 1.25);
+    p->getWithDefault("patchCost",     d_patchCost, 16);
+    p->getWithDefault("gainThreshold", d_lbThreshold, 0.05);
+    p->getWithDefault("hasParticles",  d_collectParticles, false);
+  }
+
+  m_lb_interval = interval;
+  m_lb_timeStep_interval = timestepInterval;
+  m_do_space_curve = true;
+
+  // Set curve parameters that do not change between timesteps
+  ASSERT(m_numDims > 0 && m_numDims < 4);
+
+  m_sfc.SetNumDimensions(m_numDims);
+  m_sfc.SetMergeMode(1);
+  m_sfc.SetCleanup(BATCHERS);
+  m_sfc.SetMergeParameters(3000, 500, 2, .15);  //Should do this by profiling
+}
@@ -0,0 +1,122 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CCA_COMPONENTS_LOADBALANCERS_PARALLELSFCLOADBALANCER_H
+#define CCA_COMPONENTS_LOADBALANCERS_PARALLELSFCLOADBALANCER_H
+
+#include <CCA/Components/LoadBalancers/LoadBalancerCommon.h>
+
+#include <vector>
+
+namespace Uintah {
+   /**************************************
+     
+     CLASS
+       ParallelSFCLoadBalancer
+      
+       Distributed space-filling curve load balancer.
+      
+     GENERAL INFORMATION
+      
+       ParallelSFCLoadBalancer.h
+      
+     KEYWORDS
+       ParallelSFCLoadBalancer, SFC
+      
+     DESCRIPTION
+       Partitions each level along a Hilbert curve without gathering
+       the patch costs or particle counts on any one rank:
+
+         - every rank costs only the patches it currently owns (the
+           patches are block distributed after a regrid),
+         - the curve is sorted in parallel (SFC::GenerateCurve), which
+           leaves each rank holding a contiguous piece of the curve,
+         - the costs of that piece are fetched from their owners with
+           one Alltoallv,
+         - an exclusive prefix sum of the costs places each patch on
+           the rank whose share of the total cost contains the
+           patch's midpoint.
+
+       Only the final patch -> rank map is exchanged with every rank,
+       since LoadBalancerCommon keeps the whole assignment.
+
+     WARNING
+       Costs come from the cell/particle/patch cost model only; the
+       profiling forecasters of the DLB need global cost data.
+      
+     ****************************************/
+
+  class ParallelSFCLoadBalancer : public LoadBalancerCommon {
+  public:
+    ParallelSFCLoadBalancer( const ProcessorGroup * myworld );
+    ~ParallelSFCLoadBalancer() {};
+
+    virtual void problemSetup( ProblemSpecP & pspec, GridP & grid, const MaterialManagerP & materialManager );
+    virtual bool needRecompile( const GridP & grid );
+
+    /// Computes a new assignment (on the first time step, after a
+    /// regrid, or when needRecompile checks the load balance) and
+    /// takes it if it is forced or improves the maximum cost per rank
+    /// by more than the gain threshold.
+    virtual bool possiblyDynamicallyReallocate( const GridP & grid, int state );
+
+    //! Asks the load balancer if it is dynamic.
+    virtual bool isDynamic() { return true; }
+
+  private:
+
+    struct PatchCost {
+      double cost;
+      int    id;
+    };
+
+    ParallelSFCLoadBalancer( const ParallelSFCLoadBalancer & );
+    ParallelSFCLoadBalancer& operator=( const ParallelSFCLoadBalancer & );
+
+    /// Fills m_temp_assignment, returns true if it should be used.
+    bool assignPatches( const GridP & grid, bool force );
+
+    /// Partitions one level, returns the maximum cost per rank of
+    /// the new assignment.  The rank's current patches and their
+    /// costs are in 'local'.
+    double assignLevel( const LevelP & level, int level_offset, const std::vector<PatchCost> & local );
+
+    /// Costs of the patches of 'level' this rank holds, in level
+    /// index order.  'owned' selects the current assignment instead of
+    /// a block distribution.
+    void getLocalCosts( const LevelP & level, int level_offset, bool owned, std::vector<PatchCost> & local );
+
+    double d_lbThreshold{0.0};      //< gain threshold to exceed to require lb'ing
+
+    double d_cellCost{1};           //cost weight per cell
+    double d_extraCellCost{1};      //cost weight per extra cell
+    double d_particleCost{1.25};    //cost weight per particle
+    double d_patchCost{16};         //cost weight per patch
+
+    bool   d_collectParticles{false};
+  };
+} // End namespace Uintah
+
+#endif // CCA_COMPONENTS_LOADBALANCERS_PARALLELSFCLOADBALANCER_H
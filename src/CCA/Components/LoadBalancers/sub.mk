@@ -36,6 +36,8 @@ SRCS += \
 	$(SRCDIR)/LoadBalancerFactory.cc      \
 	$(SRCDIR)/RoundRobinLoadBalancer.cc   \
 	$(SRCDIR)/DynamicLoadBalancer.cc      \
+	$(SRCDIR)/GraphPartitioner.cc         \
+	$(SRCDIR)/ParallelSFCLoadBalancer.cc  \
 	$(SRCDIR)/SimpleLoadBalancer.cc       \
 	$(SRCDIR)/CostProfiler.cc             \
 	$(SRCDIR)/ProfileDriver.cc            \
@@ -380,6 +380,8 @@ void AMRMPM::problemSetup(const ProblemSpecP& prob_spec,
     NGN=2;
   }
 
+  d_particleScatter = scinew ThreadedParticleScatter(flags->d_numP2GThreads,NGN);
+
   MPMPhysicalBCFactory::create(mat_ps, grid, flags);
   
   bool needNormals = false;
@@ -1999,8 +2001,6 @@ void AMRMPM::interpolateParticlesToGrid(const ProcessorGroup*,
 
     unsigned int numMatls = m_materialManager->getNumMatls( "MPM" );
     ParticleInterpolator* interpolator = flags->d_interpolator->clone(patch);
-    vector<IntVector> ni(interpolator->size());
-    vector<double> S(interpolator->size());
 
 #ifdef CBDI_FLUXBCS
     LinearInterpolator* LPI;
@@ -2105,64 +2105,73 @@ void AMRMPM::interpolateParticlesToGrid(const ProcessorGroup*,
         gnegcharge.initialize(0.0);
       }
       
-      Vector pmom;
-      for (ParticleSubset::iterator iter  = pset->begin();
-                                    iter != pset->end(); iter++){
-        particleIndex idx = *iter;
+      // With <p2g_threads> the particles that can add to the same node
+      // are never run at the same time, see ThreadedParticleScatter
+      auto scatter = [&](ParticleInterpolator* interp,
+                         ParticleSubset::iterator begin,
+                         ParticleSubset::iterator end){
+        vector<IntVector> ni(interp->size());
+        vector<double> S(interp->size());
+
+        for (ParticleSubset::iterator iter = begin; iter != end; iter++){
+          particleIndex idx = *iter;
 
-        // Get the node indices that surround the cell
-        int NN = interpolator->findCellAndWeights(px[idx],ni,S,psize[idx]);
+          // Get the node indices that surround the cell
+          int NN = interp->findCellAndWeights(px[idx],ni,S,psize[idx]);
 
-        pmom = pvelocity[idx]*pmass[idx];
+          Vector pmom = pvelocity[idx]*pmass[idx];
 
-        // Add each particles contribution to the local mass & velocity 
-        IntVector node;
-        for(int k = 0; k < NN; k++) {
-          node = ni[k];
-          if(patch->containsNode(node)) {
-            if (flags->d_GEVelProj){
-              Point gpos = patch->getNodePosition(node);
-              Vector distance = px[idx] - gpos;
-              Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
-              pmom = pvel_ext*pmass[idx];
-            }
-            gmass[node]          += pmass[idx]                     * S[k];
-            gvelocity[node]      += pmom                           * S[k];
-            gvolume[node]        += pvolume[idx]                   * S[k];
-            gexternalforce[node] += pexternalforce[idx]            * S[k];
-            gTemperature[node]   += pTemperature[idx] * pmass[idx] * S[k];
-          }
-        }
-        if(flags->d_doScalarDiffusion){
-          double one_third = 1./3.;
-          double phydrostress = one_third*pStress[idx].Trace();
-          double pConc_Ext = pConcentration[idx];
+          // Add each particles contribution to the local mass & velocity 
+          IntVector node;
           for(int k = 0; k < NN; k++) {
             node = ni[k];
             if(patch->containsNode(node)) {
-              if (flags->d_GEVelProj) {
+              if (flags->d_GEVelProj){
                 Point gpos = patch->getNodePosition(node);
-                Vector pointOffset = px[idx]-gpos;
-                pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                Vector distance = px[idx] - gpos;
+                Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
+                pmom = pvel_ext*pmass[idx];
               }
-              ghydrostaticstress[node] += phydrostress        * pmass[idx]*S[k];
-              gconcentration[node]     += pConc_Ext           * pmass[idx]*S[k];
-#ifndef CBDI_FLUXBCS
-              gextscalarflux[node]+= (pExternalScalarFlux[idx]*pmass[idx])*S[k];
-#endif
+              gmass[node]          += pmass[idx]                     * S[k];
+              gvelocity[node]      += pmom                           * S[k];
+              gvolume[node]        += pvolume[idx]                   * S[k];
+              gexternalforce[node] += pexternalforce[idx]            * S[k];
+              gTemperature[node]   += pTemperature[idx] * pmass[idx] * S[k];
             }
           }
-        }
-        if(flags->d_withGaussSolver){
-          for(int k = 0; k < NN; k++) {
-            node = ni[k];
-            if(patch->containsNode(node)) {
-              gposcharge[node] += pPosCharge[idx] * pmass[idx]*S[k];
-              gnegcharge[node] += pNegCharge[idx] * pmass[idx]*S[k];
+          if(flags->d_doScalarDiffusion){
+            double one_third = 1./3.;
+            double phydrostress = one_third*pStress[idx].Trace();
+            double pConc_Ext = pConcentration[idx];
+            for(int k = 0; k < NN; k++) {
+              node = ni[k];
+              if(patch->containsNode(node)) {
+                if (flags->d_GEVelProj) {
+                  Point gpos = patch->getNodePosition(node);
+                  Vector pointOffset = px[idx]-gpos;
+                  pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                }
+                ghydrostaticstress[node] += phydrostress        * pmass[idx]*S[k];
+                gconcentration[node]     += pConc_Ext           * pmass[idx]*S[k];
+  #ifndef CBDI_FLUXBCS
+                gextscalarflux[node]+= (pExternalScalarFlux[idx]*pmass[idx])*S[k];
+  #endif
+              }
             }
           }
-        }
-      }  // End of particle loop
+          if(flags->d_withGaussSolver){
+            for(int k = 0; k < NN; k++) {
+              node = ni[k];
+              if(patch->containsNode(node)) {
+                gposcharge[node] += pPosCharge[idx] * pmass[idx]*S[k];
+                gnegcharge[node] += pNegCharge[idx] * pmass[idx]*S[k];
+              }
+            }
+          }
+        }  // End of particle loop
+      };
+
+      d_particleScatter->run(interpolator, pset, px, scatter);
 
 
 #ifdef CBDI_FLUXBCS
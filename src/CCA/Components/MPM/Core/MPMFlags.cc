@@ -74,6 +74,9 @@ MPMFlags::MPMFlags(const ProcessorGroup* myworld)
   d_doThermalExpansion            =  true;
   d_refineParticles               =  false;
   d_XPIC2                         =  false;
+  d_cacheParticleWeights          =  false;
+  d_numP2GThreads                 =  1;
+  d_batchedStressUpdate           =  false;
   d_artificialDampCoeff           =  0.0;
   d_interpolator                  =  scinew LinearInterpolator();
   d_do_contact_friction           =  false;
@@ -208,6 +211,9 @@ MPMFlags::readMPMFlags(ProblemSpecP& ps, Output* dataArchive)
   mpm_flag_ps->get("artificial_viscosity",     d_artificial_viscosity);
   mpm_flag_ps->get("refine_particles",         d_refineParticles);
   mpm_flag_ps->get("XPIC2",                    d_XPIC2);
+  mpm_flag_ps->get("cache_particle_weights",   d_cacheParticleWeights);
+  mpm_flag_ps->get("p2g_threads",              d_numP2GThreads);
+  mpm_flag_ps->get("batched_stress_update",    d_batchedStressUpdate);
   if(d_artificial_viscosity){
     d_artificial_viscosity_heating=true;
   }
@@ -380,6 +386,16 @@ else{
   // Get the size of the vectors associated with the interpolator
   d_8or27=d_interpolator->size();
 
+  // The axisymmetric interpolators return different weights from
+  // findCellAndWeights and findCellAndWeightsAndShapeDerivatives
+  if(d_cacheParticleWeights && d_axisymmetric){
+    if (d_myworld->myRank() == 0){
+      cerr << "WARNING:MPM: cache_particle_weights is ignored for "
+           << "axisymmetric problems" << endl;
+    }
+    d_cacheParticleWeights = false;
+  }
+
   mpm_flag_ps->get("extra_solver_flushes", d_extraSolverFlushes);
   mpm_flag_ps->get("boundary_traction_faces", d_bndy_face_txt_list);
 
@@ -397,6 +413,9 @@ else{
     dbg << " Artificial Viscosity Coeff2 = " << d_artificialViscCoeff2<< endl;
     dbg << " RefineParticles             = " << d_refineParticles << endl;
     dbg << " XPIC2                       = " << d_XPIC2 << endl;
+    dbg << " Cache Particle Weights      = " << d_cacheParticleWeights << endl;
+    dbg << " P2G Threads                 = " << d_numP2GThreads << endl;
+    dbg << " Batched Stress Update       = " << d_batchedStressUpdate << endl;
     dbg << " Use Load Curves             = " << d_useLoadCurves << endl;
     dbg << " Keep PressBC Normal         = " << d_keepPressBCNormalToSurface << endl;
     dbg << " Use CBDI boundary condition = " << d_useCBDI << endl;
@@ -427,6 +446,9 @@ MPMFlags::outputProblemSpec(ProblemSpecP& ps)
   ps->appendElement("artificial_viscosity_coeff2",        d_artificialViscCoeff2);
   ps->appendElement("refine_particles",                   d_refineParticles);
   ps->appendElement("XPIC2",                              d_XPIC2);
+  ps->appendElement("cache_particle_weights",             d_cacheParticleWeights);
+  ps->appendElement("p2g_threads",                        d_numP2GThreads);
+  ps->appendElement("batched_stress_update",              d_batchedStressUpdate);
   ps->appendElement("use_cohesive_zones",                 d_useCohesiveZones);
   ps->appendElement("use_load_curves",                    d_useLoadCurves);
   ps->appendElement("keepPressBCNormalToSurface", d_keepPressBCNormalToSurface);
@@ -88,6 +88,9 @@ class Output;
     bool        doMPMOnLevel(int level, int numLevels) const;
     bool        d_refineParticles;                             // Refine particles, step toward AMR
     bool        d_XPIC2;                                       // Use Nairn's XPIC2 algorithm
+    bool        d_cacheParticleWeights;                        // Reuse the shape functions within a timestep (memory for time)
+    int         d_numP2GThreads;                               // Threads per patch in interpolateParticlesToGrid
+    bool        d_batchedStressUpdate;                         // Constitutive models update blocks of particles
 
     double      d_artificialDampCoeff;
     double      d_artificialViscCoeff1;                        // Artificial viscosity coefficient 1
@@ -0,0 +1,168 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <CCA/Components/MPM/Core/ParticleWeightCache.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace Uintah;
+using namespace std;
+
+//______________________________________________________________________
+//
+int
+ParticleWeightCache::Weights::findCellAndWeights(particleIndex idx,
+                                                 vector<IntVector>& ni,
+                                                 vector<double>& S) const
+{
+  const int NN    = d_NN[idx];
+  const int first = idx*d_stride;
+  copy(&d_ni[first],    &d_ni[first]+NN,    ni.begin());
+  copy(&d_shape[first], &d_shape[first]+NN, S.begin());
+  return NN;
+}
+
+//______________________________________________________________________
+//
+int
+ParticleWeightCache::Weights::findCellAndShapeDerivatives(particleIndex idx,
+                                                          vector<IntVector>& ni,
+                                                          vector<Vector>& d_S) const
+{
+  const int NN    = d_NN[idx];
+  const int first = idx*d_stride;
+  copy(&d_ni[first],        &d_ni[first]+NN,        ni.begin());
+  copy(&d_shapeGrad[first], &d_shapeGrad[first]+NN, d_S.begin());
+  return NN;
+}
+
+//______________________________________________________________________
+//
+int
+ParticleWeightCache::Weights::findCellAndWeightsAndShapeDerivatives(
+                                                   particleIndex idx,
+                                                   vector<IntVector>& ni,
+                                                   vector<double>& S,
+                                                   vector<Vector>& d_S) const
+{
+  const int NN    = d_NN[idx];
+  const int first = idx*d_stride;
+  copy(&d_ni[first],        &d_ni[first]+NN,        ni.begin());
+  copy(&d_shape[first],     &d_shape[first]+NN,     S.begin());
+  copy(&d_shapeGrad[first], &d_shapeGrad[first]+NN, d_S.begin());
+  return NN;
+}
+
+//______________________________________________________________________
+//
+ParticleWeightCache::WeightsP
+ParticleWeightCache::getWeights(ParticleInterpolator* interpolator,
+                                int generation,
+                                ParticleSubset* pset,
+                                constParticleVariable<Point>& px,
+                                constParticleVariable<Matrix3>& psize)
+{
+  const Patch* patch = pset->getPatch();
+  const bool ghosts  = pset->getLow()  != patch->getExtraCellLowIndex() ||
+                       pset->getHigh() != patch->getExtraCellHighIndex();
+  const Key key(patch->getID(), pset->getMatlIndex(), ghosts);
+
+  {
+    std::lock_guard<Uintah::MasterLock> guard(d_lock);
+
+    if (generation > d_generation) {
+      d_weights.clear();
+      d_generation = generation;
+    }
+
+    map<Key, WeightsP>::iterator iter = d_weights.find(key);
+    if (iter != d_weights.end()) {
+      const Weights& w = *iter->second;
+      if (w.d_generation == generation &&
+          w.d_numParticles == pset->numParticles() &&
+          w.d_low == pset->getLow() && w.d_high == pset->getHigh()) {
+        return iter->second;
+      }
+    }
+  }
+
+  // Not cached yet, evaluate the shape functions outside of the lock
+  shared_ptr<Weights> weights = make_shared<Weights>();
+  weights->d_generation   = generation;
+  weights->d_numParticles = pset->numParticles();
+  weights->d_low          = pset->getLow();
+  weights->d_high         = pset->getHigh();
+  weights->d_stride       = interpolator->size();
+
+  particleIndex maxIndex = -1;
+  for (ParticleSubset::iterator iter = pset->begin();
+       iter != pset->end(); iter++) {
+    maxIndex = max(maxIndex, *iter);
+  }
+
+  const int stride = weights->d_stride;
+  weights->d_NN.resize(maxIndex+1, 0);
+  weights->d_ni.resize((maxIndex+1)*stride);
+  weights->d_shape.resize((maxIndex+1)*stride);
+  weights->d_shapeGrad.resize((maxIndex+1)*stride);
+
+  vector<IntVector> ni(stride);
+  vector<double>    S(stride);
+  vector<Vector>    d_S(stride);
+
+  for (ParticleSubset::iterator iter = pset->begin();
+       iter != pset->end(); iter++) {
+    particleIndex idx = *iter;
+    int NN = interpolator->findCellAndWeightsAndShapeDerivatives(px[idx], ni,
+                                                          S, d_S, psize[idx]);
+    const int first = idx*stride;
+    copy(ni.begin(),  ni.begin()+NN,  &weights->d_ni[first]);
+    copy(S.begin(),   S.begin()+NN,   &weights->d_shape[first]);
+    copy(d_S.begin(), d_S.begin()+NN, &weights->d_shapeGrad[first]);
+    weights->d_NN[idx] = NN;
+  }
+
+  std::lock_guard<Uintah::MasterLock> guard(d_lock);
+
+  // An older DW (i.e. another level of a subcycled AMR timestep) is
+  // computed, not cached.
+  if (generation == d_generation) {
+    d_weights[key] = weights;
+  }
+
+  return weights;
+}
+
+//______________________________________________________________________
+//
+void
+ParticleWeightCache::clear()
+{
+  std::lock_guard<Uintah::MasterLock> guard(d_lock);
+  d_weights.clear();
+  d_generation = -1;
+}
@@ -0,0 +1,134 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __MPM_PARTICLE_WEIGHT_CACHE_H__
+#define __MPM_PARTICLE_WEIGHT_CACHE_H__
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Geometry/Point.h>
+#include <Core/Geometry/Vector.h>
+#include <Core/Grid/ParticleInterpolator.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
+#include <Core/Math/Matrix3.h>
+#include <Core/Parallel/MasterLock.h>
+
+#include <map>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace Uintah {
+
+  /////////////////////////////////////////////////////////////////////////////
+  /*!
+    \class ParticleWeightCache
+    \brief Node indices, weights and shape function derivatives of the
+           particles of a patch, shared by the MPM tasks of a timestep.
+
+    interpolateParticlesToGrid, computeInternalForce,
+    interpolateToParticlesAndUpdate and computeParticleGradients all
+    evaluate the shape functions at the same particle positions (pX of
+    the old DW) with the same particle sizes (pCurSize).  With
+    <cache_particle_weights> the first of them that visits a
+    (patch, material, particle subset) stores the result of
+    findCellAndWeightsAndShapeDerivatives for every particle and the
+    others read it back.  The two scatter tasks use the subset with the
+    ghost particles, the two gather tasks the one without, so there are
+    two entries per patch and material.
+
+    An entry is only valid for the old DW it was computed from; when a
+    new old DW shows up all of the entries of the previous one are
+    dropped, so the cache holds at most one timestep's worth of weights
+    (interpolator size * 44 bytes per particle).
+
+    getWeights() may be called by several threads at once.
+  */
+  /////////////////////////////////////////////////////////////////////////////
+
+  class ParticleWeightCache {
+
+  public:
+
+    class Weights {
+
+    public:
+
+      int findCellAndWeights(particleIndex idx,
+                             std::vector<IntVector>& ni,
+                             std::vector<double>& S) const;
+
+      int findCellAndShapeDerivatives(particleIndex idx,
+                                      std::vector<IntVector>& ni,
+                                      std::vector<Vector>& d_S) const;
+
+      int findCellAndWeightsAndShapeDerivatives(particleIndex idx,
+                                                std::vector<IntVector>& ni,
+                                                std::vector<double>& S,
+                                                std::vector<Vector>& d_S) const;
+
+    private:
+
+      friend class ParticleWeightCache;
+
+      int                    d_generation;
+      unsigned int           d_numParticles;
+      IntVector              d_low;
+      IntVector              d_high;
+      int                    d_stride;     // interpolator size
+      std::vector<int>       d_NN;         // indexed by particleIndex
+      std::vector<IntVector> d_ni;         // d_stride per particle
+      std::vector<double>    d_shape;
+      std::vector<Vector>    d_shapeGrad;
+    };
+
+    typedef std::shared_ptr<const Weights> WeightsP;
+
+    ParticleWeightCache() {}
+
+    //! Returns the weights of the particles of pset, computing them
+    //! with interpolator if the old DW (generation) has changed.
+    WeightsP getWeights(ParticleInterpolator* interpolator,
+                        int generation,
+                        ParticleSubset* pset,
+                        constParticleVariable<Point>& px,
+                        constParticleVariable<Matrix3>& psize);
+
+    void clear();
+
+  private:
+
+    // (patch id, material, subset includes ghost particles)
+    typedef std::tuple<int, int, bool> Key;
+
+    ParticleWeightCache(const ParticleWeightCache&);
+    ParticleWeightCache& operator=(const ParticleWeightCache&);
+
+    Uintah::MasterLock       d_lock;
+    int                      d_generation{-1};
+    std::map<Key, WeightsP>  d_weights;
+  };
+
+} // End namespace Uintah
+
+#endif  // __MPM_PARTICLE_WEIGHT_CACHE_H__
@@ -0,0 +1,156 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <CCA/Components/MPM/Core/ThreadedParticleScatter.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Patch.h>
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+//______________________________________________________________________
+//
+ThreadedParticleScatter::ThreadedParticleScatter(int numThreads, int reach)
+  : d_numThreads(max(numThreads, 1)), d_reach(max(reach, 0))
+{
+}
+
+//______________________________________________________________________
+//
+void
+ThreadedParticleScatter::run(ParticleInterpolator* interpolator,
+                             ParticleSubset* pset,
+                             constParticleVariable<Point>& px,
+                             const Body& body) const
+{
+  const Patch* patch = pset->getPatch();
+  const IntVector low  = patch->getCellLowIndex();
+  const IntVector size = patch->getCellHighIndex() - low;
+
+  const int width = 2*d_reach + 1;
+
+  // Cut along z if that gives at least 8 slabs, as the particles of a
+  // z slab are together in memory when they are sorted
+  // (<particleSortInterval>), otherwise along y, x or the longest
+  // direction.  This does not depend on the number of threads.
+  int axis = -1;
+  for (int d = 2; d >= 0 && axis < 0; d--) {
+    if (size[d]/width >= 8) {
+      axis = d;
+    }
+  }
+  if (axis < 0) {
+    axis = 0;
+    for (int d = 1; d < 3; d++) {
+      if (size[d] > size[axis]) {
+        axis = d;
+      }
+    }
+  }
+
+  const int numSlabs = size[axis]/width;
+
+  if (d_numThreads == 1 || numSlabs < 3 || pset->numParticles() == 0) {
+    body(interpolator, pset->begin(), pset->end());
+    return;
+  }
+
+  // Bin the particles by slab, keeping their order within a slab.  The
+  // last slab also gets the leftover cells, particles outside of the
+  // patch (ghosts) go with the first or last slab.
+  const Level* level = patch->getLevel();
+  vector<int> slab(pset->numParticles());
+  vector<int> start(numSlabs + 1, 0);
+
+  int i = 0;
+  for (ParticleSubset::iterator iter = pset->begin();
+       iter != pset->end(); iter++, i++) {
+    const int c = level->getCellIndex(px[*iter])[axis] - low[axis];
+    slab[i] = c < 0 ? 0 : min(c/width, numSlabs - 1);
+    start[slab[i] + 1]++;
+  }
+  for (int s = 0; s < numSlabs; s++) {
+    start[s + 1] += start[s];
+  }
+
+  vector<particleIndex> particles(pset->numParticles());
+  vector<int> next(start.begin(), start.end() - 1);
+  i = 0;
+  for (ParticleSubset::iterator iter = pset->begin();
+       iter != pset->end(); iter++, i++) {
+    particles[next[slab[i]]++] = *iter;
+  }
+
+  // Even slabs, then odd slabs
+  for (int color = 0; color < 2; color++) {
+    const int slabsOfColor = (numSlabs - color + 1)/2;
+    const int numThreads   = min(d_numThreads, slabsOfColor);
+
+    atomic<int>        nextSlab(0);
+    exception_ptr      error;
+    mutex              errorLock;
+
+    auto work = [&](ParticleInterpolator* interp) {
+      try {
+        int k;
+        while ((k = nextSlab++) < slabsOfColor) {
+          const int s = color + 2*k;
+          body(interp, &particles[0] + start[s], &particles[0] + start[s + 1]);
+        }
+      }
+      catch (...) {
+        lock_guard<mutex> guard(errorLock);
+        if (!error) {
+          error = current_exception();
+        }
+      }
+    };
+
+    vector<ParticleInterpolator*> interpolators;
+    vector<thread>                threads;
+    for (int t = 1; t < numThreads; t++) {
+      interpolators.push_back(interpolator->clone(patch));
+      threads.emplace_back(work, interpolators.back());
+    }
+    work(interpolator);
+
+    for (auto& t : threads) {
+      t.join();
+    }
+    for (auto interp : interpolators) {
+      delete interp;
+    }
+
+    if (error) {
+      rethrow_exception(error);
+    }
+  }
+}
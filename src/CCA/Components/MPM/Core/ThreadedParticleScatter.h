@@ -0,0 +1,91 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __MPM_THREADED_PARTICLE_SCATTER_H__
+#define __MPM_THREADED_PARTICLE_SCATTER_H__
+
+#include <Core/Geometry/Point.h>
+#include <Core/Grid/ParticleInterpolator.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
+
+#include <functional>
+
+namespace Uintah {
+
+  /////////////////////////////////////////////////////////////////////////////
+  /*!
+    \class ThreadedParticleScatter
+    \brief Runs a particle to grid loop of one patch on several threads.
+
+    The cells of the patch are cut into slabs along its longest
+    direction, each at least 2*reach+1 cells thick, where reach is the
+    number of nodes beyond its own cell a particle can interpolate to
+    (NGN).  The particles of two slabs with another slab between them
+    then never write to the same node, so all of the even slabs are run
+    at the same time, followed by all of the odd ones, each slab by one
+    thread in particle order.
+
+    The sum at a node therefore does not depend on the number of
+    threads (it differs from the one of a plain loop over the subset in
+    the last bits).  With one thread, or a patch too thin for three
+    slabs, the body is called once with the whole subset.
+
+    The threads are started for each call, which is meant for patches
+    large enough for the loop to take much longer than that, i.e. one
+    MPI rank per socket with the MPI scheduler.
+  */
+  /////////////////////////////////////////////////////////////////////////////
+
+  class ThreadedParticleScatter {
+
+  public:
+
+    //! body(interpolator, begin, end) scatters the particles [begin, end).
+    //! interpolator is private to the calling thread.
+    typedef std::function<void(ParticleInterpolator*,
+                               ParticleSubset::iterator,
+                               ParticleSubset::iterator)> Body;
+
+    ThreadedParticleScatter(int numThreads, int reach);
+
+    int numThreads() const { return d_numThreads; }
+
+    void run(ParticleInterpolator* interpolator,
+             ParticleSubset* pset,
+             constParticleVariable<Point>& px,
+             const Body& body) const;
+
+  private:
+
+    ThreadedParticleScatter(const ThreadedParticleScatter&);
+    ThreadedParticleScatter& operator=(const ThreadedParticleScatter&);
+
+    int d_numThreads;
+    int d_reach;
+  };
+
+} // End namespace Uintah
+
+#endif  // __MPM_THREADED_PARTICLE_SCATTER_H__
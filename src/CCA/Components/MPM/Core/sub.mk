@@ -37,7 +37,9 @@ SRCS     += \
 	$(SRCDIR)/CZLabel.cc           \
 	$(SRCDIR)/AMRMPMLabel.cc       \
 	$(SRCDIR)/HydroMPMLabel.cc     \
-	$(SRCDIR)/ImpMPMFlags.cc
+	$(SRCDIR)/ImpMPMFlags.cc       \
+	$(SRCDIR)/ParticleWeightCache.cc \
+	$(SRCDIR)/ThreadedParticleScatter.cc
 
 PSELIBS := \
 	Core/Disclosure     \
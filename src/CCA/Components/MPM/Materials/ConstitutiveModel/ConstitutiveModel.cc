@@ -190,6 +190,12 @@ ConstitutiveModel::computeStressTensor(const PatchSubset*,
   throw InternalError("Stub Task: ConstitutiveModel::computeStressTensor ", __FILE__, __LINE__);
 }
 
+void
+ConstitutiveModel::computeStressBlock(ParticleStressBlock&, int, bool) const
+{
+  throw InternalError("Stub Task: ConstitutiveModel::computeStressBlock ", __FILE__, __LINE__);
+}
+
 void
 ConstitutiveModel::computeStressTensorImplicit(const PatchSubset*,
                                                const MPMMaterial*,
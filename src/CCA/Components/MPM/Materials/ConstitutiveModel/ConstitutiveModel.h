@@ -38,6 +38,7 @@
 #include <Core/Math/FastMatrix.h>
 #include <Core/ProblemSpec/ProblemSpecP.h>
 #include <CCA/Components/MPM/Core/MPMFlags.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/ParticleBlock.h>
 
 
 namespace Uintah {
@@ -84,6 +85,21 @@ namespace Uintah {
                                      DataWarehouse* old_dw,
                                      DataWarehouse* new_dw);
 
+    ///////////////////////////////////////////////////////////////////////
+    /*! Whether computeStressTensor updates the particles a block at a
+        time with computeStressBlock (<batched_stress_update>). */
+    ///////////////////////////////////////////////////////////////////////
+    virtual bool hasBatchedStressUpdate() const { return false; }
+
+    ///////////////////////////////////////////////////////////////////////
+    /*! Stress update of the first n particles of a block (see
+        ParticleBlock.h), the whole block at a time (batched) or particle
+        by particle.  b is the model's own block, derived from
+        ParticleStressBlock. */
+    ///////////////////////////////////////////////////////////////////////
+    virtual void computeStressBlock(ParticleStressBlock& b,
+                                    int n, bool batched) const;
+
     virtual void computeStressTensorImplicit(const PatchSubset* patches,
                                              const MPMMaterial* matl,
                                              DataWarehouse* old_dw,
@@ -0,0 +1,275 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef __MPM_PARTICLE_BLOCK_H__
+#define __MPM_PARTICLE_BLOCK_H__
+
+#include <Core/Grid/Variables/ParticleSubset.h>
+#include <Core/Math/Matrix3.h>
+
+namespace Uintah {
+
+  /////////////////////////////////////////////////////////////////////////////
+  /*!
+    \file ParticleBlock.h
+    \brief Fixed size blocks of particles for the batched stress update
+           of the constitutive models (<batched_stress_update>).
+
+    A model that supports it (ConstitutiveModel::hasBatchedStressUpdate)
+    copies the variables of PARTICLE_BLOCK_SIZE particles at a time into
+    structure of arrays scratch buffers (one array per tensor component,
+    indexed by the position of the particle in the block, its lane) and
+    updates the whole block with the kernels below.  A block is small
+    enough to stay in the L1 cache.  Every kernel is a loop over all of the lanes of a
+    block with a fixed number of operations per lane, which the compiler
+    vectorizes (also with the very cheap cost model of -O2).  The lanes
+    past the particles of the last block hold values of an earlier
+    block, or the identity, so they are computed along, but only the
+    first n lanes are checked for errors.
+
+    The kernels do the same floating point operations, in the same
+    order, as the Matrix3 member functions they are named after, so the
+    batched update gives the same stresses as the particle by particle
+    one.  Lanes with a singular matrix are handed to Matrix3, which
+    reports the error as before.
+
+    A model's block holds the variables of ParticleStressBlock and its
+    own history variables, and is updated by its override of
+    ConstitutiveModel::computeStressBlock.
+  */
+  /////////////////////////////////////////////////////////////////////////////
+
+  const int PARTICLE_BLOCK_SIZE = 16;
+
+  //______________________________________________________________________
+  //
+  class ParticleBlock {
+
+  public:
+
+    ParticleBlock() : d_size(0) {}
+
+    //! Takes the next (up to) PARTICLE_BLOCK_SIZE particles from
+    //! [iter, end), false when there are none left.
+    bool next(ParticleSubset::iterator& iter, ParticleSubset::iterator end)
+    {
+      d_size = 0;
+      while (iter != end && d_size < PARTICLE_BLOCK_SIZE) {
+        d_idx[d_size++] = *iter++;
+      }
+      return d_size > 0;
+    }
+
+    int size() const { return d_size; }
+
+    particleIndex operator[](int lane) const { return d_idx[lane]; }
+
+  private:
+
+    int           d_size;
+    particleIndex d_idx[PARTICLE_BLOCK_SIZE];
+  };
+
+  //______________________________________________________________________
+  //
+  struct Matrix3Block {
+
+    double m[3][3][PARTICLE_BLOCK_SIZE];
+
+    Matrix3Block()
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+            m[i][j][l] = (i == j) ? 1.0 : 0.0;
+          }
+        }
+      }
+    }
+
+    void set(int lane, const Matrix3& M)
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          m[i][j][lane] = M(i,j);
+        }
+      }
+    }
+
+    Matrix3 get(int lane) const
+    {
+      return Matrix3(m[0][0][lane], m[0][1][lane], m[0][2][lane],
+                     m[1][0][lane], m[1][1][lane], m[1][2][lane],
+                     m[2][0][lane], m[2][1][lane], m[2][2][lane]);
+    }
+  };
+
+  //______________________________________________________________________
+  // The variables every model's block has, a model derives its block from
+  // this one and adds its history variables.
+  struct ParticleStressBlock {
+
+    Matrix3Block defGrad;                        // F at t_n
+    Matrix3Block defGrad_new;                    // F at t_n+1
+    Matrix3Block stress;                         // out
+    double       J[PARTICLE_BLOCK_SIZE];         // det(F_n+1) > 0
+    double       energy[PARTICLE_BLOCK_SIZE];    // out, per unit initial volume
+
+    ParticleStressBlock()
+    {
+      for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+        J[l]      = 1.0;
+        energy[l] = 0.0;
+      }
+    }
+
+    virtual ~ParticleStressBlock() {}
+  };
+
+  //______________________________________________________________________
+  // An output block must not be one of the input blocks.
+  namespace ParticleBlockOps {
+
+    const int N = PARTICLE_BLOCK_SIZE;
+
+    // C = A*B
+    inline void multiply(const Matrix3Block& __restrict__ A,
+                         const Matrix3Block& __restrict__ B,
+                               Matrix3Block& __restrict__ C)
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          for (int l = 0; l < N; l++) {
+            C.m[i][j][l] = A.m[i][0][l]*B.m[0][j][l] +
+                           A.m[i][1][l]*B.m[1][j][l] +
+                           A.m[i][2][l]*B.m[2][j][l];
+          }
+        }
+      }
+    }
+
+    // C = A*B^T
+    inline void multiplyTranspose(const Matrix3Block& __restrict__ A,
+                                  const Matrix3Block& __restrict__ B,
+                                        Matrix3Block& __restrict__ C)
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          for (int l = 0; l < N; l++) {
+            C.m[i][j][l] = A.m[i][0][l]*B.m[j][0][l] +
+                           A.m[i][1][l]*B.m[j][1][l] +
+                           A.m[i][2][l]*B.m[j][2][l];
+          }
+        }
+      }
+    }
+
+    // C = A^T*B
+    inline void transposeMultiply(const Matrix3Block& __restrict__ A,
+                                  const Matrix3Block& __restrict__ B,
+                                        Matrix3Block& __restrict__ C)
+    {
+      for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+          for (int l = 0; l < N; l++) {
+            C.m[i][j][l] = A.m[0][i][l]*B.m[0][j][l] +
+                           A.m[1][i][l]*B.m[1][j][l] +
+                           A.m[2][i][l]*B.m[2][j][l];
+          }
+        }
+      }
+    }
+
+    inline void determinant(const Matrix3Block& __restrict__ A,
+                                  double*       __restrict__ det)
+    {
+      for (int l = 0; l < N; l++) {
+        det[l] = A.m[0][0][l]*A.m[1][1][l]*A.m[2][2][l] +
+                 A.m[0][1][l]*A.m[1][2][l]*A.m[2][0][l] +
+                 A.m[0][2][l]*A.m[1][0][l]*A.m[2][1][l] -
+                 A.m[0][2][l]*A.m[1][1][l]*A.m[2][0][l] -
+                 A.m[0][1][l]*A.m[1][0][l]*A.m[2][2][l] -
+                 A.m[0][0][l]*A.m[1][2][l]*A.m[2][1][l];
+      }
+    }
+
+    inline void trace(const Matrix3Block& __restrict__ A,
+                            double*       __restrict__ tr)
+    {
+      for (int l = 0; l < N; l++) {
+        tr[l] = 0.0 + A.m[0][0][l] + A.m[1][1][l] + A.m[2][2][l];
+      }
+    }
+
+    // A:A
+    inline void normSquared(const Matrix3Block& __restrict__ A,
+                                  double*       __restrict__ norm2)
+    {
+      for (int l = 0; l < N; l++) {
+        double norm = 0.0;
+        for (int i = 0; i < 3; i++) {
+          for (int j = 0; j < 3; j++) {
+            norm += A.m[i][j][l]*A.m[i][j][l];
+          }
+        }
+        norm2[l] = norm;
+      }
+    }
+
+    // Matrix3::Inverse
+    inline void inverse(const Matrix3Block& __restrict__ A,
+                              Matrix3Block& __restrict__ Ainv, int n)
+    {
+      double det[N];
+      determinant(A, det);
+
+      for (int l = 0; l < n; l++) {
+        if (det[l] == 0.0) {
+          A.get(l).Inverse();        // reports the singular matrix
+        }
+      }
+
+      for (int l = 0; l < N; l++) {
+        const double a00 = A.m[0][0][l], a01 = A.m[0][1][l], a02 = A.m[0][2][l];
+        const double a10 = A.m[1][0][l], a11 = A.m[1][1][l], a12 = A.m[1][2][l];
+        const double a20 = A.m[2][0][l], a21 = A.m[2][1][l], a22 = A.m[2][2][l];
+        const double idet = 1.0/det[l];
+
+        Ainv.m[0][0][l] = (a11*a22 - a12*a21)*idet;
+        Ainv.m[0][1][l] = (-a01*a22 + a21*a02)*idet;
+        Ainv.m[0][2][l] = (a01*a12 - a11*a02)*idet;
+        Ainv.m[1][0][l] = (-a10*a22 + a20*a12)*idet;
+        Ainv.m[1][1][l] = (a00*a22 - a02*a20)*idet;
+        Ainv.m[1][2][l] = (-a00*a12 + a10*a02)*idet;
+        Ainv.m[2][0][l] = (a10*a21 - a20*a11)*idet;
+        Ainv.m[2][1][l] = (-a00*a21 + a20*a01)*idet;
+        Ainv.m[2][2][l] = (a00*a11 - a01*a10)*idet;
+      }
+    }
+
+  } // End namespace ParticleBlockOps
+
+} // End namespace Uintah
+
+#endif  // __MPM_PARTICLE_BLOCK_H__
@@ -591,16 +591,10 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
                                 DataWarehouse* old_dw,
                                 DataWarehouse* new_dw)
 {
-  // Constants
-  double onethird = (1.0/3.0), sqtwthds = sqrt(2.0/3.0);
-  Matrix3 Identity; Identity.Identity();
-
   // Grab initial data
   double shear    = d_initialData.tauDev;
   double bulk     = d_initialData.Bulk;
   double rho_orig = matl->getInitialDensity();
-  double flow     = 0.0;
-  double K        = 0.0;
 
   Ghost::GhostType  gan = Ghost::AroundNodes;
 
@@ -651,10 +645,6 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
 
       pPlasticStrain.copyData(pPlasticStrain_old);
       pYieldStress.copyData(pYieldStress_old);
-
-      // Copy initial data
-      flow  = d_initialData.FlowStress;
-      K     = d_initialData.K;
     }
 
     // Universal Gets
@@ -671,36 +661,124 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
     new_dw->allocateAndPut(pdTdt,       lb->pdTdtLabel,            pset);
     new_dw->allocateAndPut(p_q,         lb->p_qLabel_preReloc,     pset);
 
+    StressBlock   b;
+    ParticleBlock block;
     ParticleSubset::iterator iter = pset->begin();
-    for(; iter != pset->end(); iter++){
-      particleIndex idx = *iter;
-      // Assign zero internal heating by default - modify if necessary.
-      pdTdt[idx] = 0.0;
-
-      Matrix3 pDefGradInc = pDefGrad_new[idx]*pDefGrad[idx].Inverse();
-      double Jinc         = pDefGradInc.Determinant();
-
-      // 1) Get the volumetric part of the deformation
-      // 2) Compute the deformed volume and new density
-      double J        = pDefGrad_new[idx].Determinant();
-      double rho_cur  = rho_orig/J;
-
-      // Check 1: Look at Jacobian
-      if (!(J > 0.0)) {
-        cerr << "matl = "  << dwi              << endl;
-        cerr << "F_old = " << pDefGrad[idx]     << endl;
-        cerr << "F_inc = " << pDefGradInc       << endl;
-        cerr << "F_new = " << pDefGrad_new[idx] << endl;
-        cerr << "J = "     << J                 << endl;
-        constParticleVariable<long64> pParticleID;
-        old_dw->get(pParticleID, lb->pParticleIDLabel, pset);
-        cerr << "ParticleID = " << pParticleID[idx] << endl;
-        cerr << "**ERROR** Negative Jacobian of deformation gradient"
-             << " in particle " << pParticleID[idx]  << " which has mass "
-             << pMass[idx] << endl;
-        throw InvalidValue("**ERROR**:Negative Jacobian in UCNH",
-                            __FILE__, __LINE__);
+    while (block.next(iter, pset->end())) {
+      const int n = block.size();
+
+      for (int l = 0; l < n; l++) {
+        particleIndex idx = block[l];
+        // Assign zero internal heating by default - modify if necessary.
+        pdTdt[idx] = 0.0;
+
+        b.defGrad.set(l,     pDefGrad[idx]);
+        b.defGrad_new.set(l, pDefGrad_new[idx]);
+        if (d_usePlasticity) {
+          b.bElBar.set(l, bElBar[idx]);
+          b.yieldStress[l]   = pYieldStress[idx];
+          b.plasticStrain[l] = pPlasticStrain[idx];
+        }
+
+        // 1) Get the volumetric part of the deformation
+        double J = pDefGrad_new[idx].Determinant();
+        b.J[l]   = J;
+
+        // Check 1: Look at Jacobian
+        if (!(J > 0.0)) {
+          Matrix3 pDefGradInc = pDefGrad_new[idx]*pDefGrad[idx].Inverse();
+          cerr << "matl = "  << dwi              << endl;
+          cerr << "F_old = " << pDefGrad[idx]     << endl;
+          cerr << "F_inc = " << pDefGradInc       << endl;
+          cerr << "F_new = " << pDefGrad_new[idx] << endl;
+          cerr << "J = "     << J                 << endl;
+          constParticleVariable<long64> pParticleID;
+          old_dw->get(pParticleID, lb->pParticleIDLabel, pset);
+          cerr << "ParticleID = " << pParticleID[idx] << endl;
+          cerr << "**ERROR** Negative Jacobian of deformation gradient"
+               << " in particle " << pParticleID[idx]  << " which has mass "
+               << pMass[idx] << endl;
+          throw InvalidValue("**ERROR**:Negative Jacobian in UCNH",
+                              __FILE__, __LINE__);
+        }
+      }
+
+      computeStressBlock(b, n, flag->d_batchedStressUpdate);
+
+      for (int l = 0; l < n; l++) {
+        particleIndex idx = block[l];
+
+        // 2) Compute the deformed volume and new density
+        double J        = b.J[l];
+        double rho_cur  = rho_orig/J;
+
+        pStress[idx] = b.stress.get(l);
+        if (d_usePlasticity) {
+          bElBar_new[idx]     = b.bElBar.get(l);
+          pPlasticStrain[idx] = b.plasticStrain[l];
+        }
+
+        //__________________________________
+        // Compute the strain energy for non-localized particles
+        // Note this calculation is lagging by a timestep.
+        if(pLocalizedOld[idx] == 0){
+          double e = b.energy[l]*pVolume_new[idx]/J;
+          se += e;
+        }
+
+        // Compute the local sound speed (uniaxial strain, p-wave modulus)
+        double c_dil = sqrt((bulk + 4.*shear/3.)/rho_cur);
+
+        // Compute wave speed at each particle, store the maximum
+        Vector pvel = pVelocity[idx];
+        WaveSpeed=Vector(Max(c_dil+fabs(pvel.x()),WaveSpeed.x()),
+                         Max(c_dil+fabs(pvel.y()),WaveSpeed.y()),
+                         Max(c_dil+fabs(pvel.z()),WaveSpeed.z()));
+
+        // Compute artificial viscosity term
+        if (flag->d_artificial_viscosity) {
+          double dx_ave = (dx.x() + dx.y() + dx.z())/3.0;
+          double c_bulk = sqrt(bulk/rho_cur);
+          Matrix3 pDeformRate = (velGrad[idx] + velGrad[idx].Transpose())*0.5;
+          p_q[idx] = artificialBulkViscosity(pDeformRate.Trace(), c_bulk,
+                                             rho_cur, dx_ave);
+        } else {
+          p_q[idx] = 0.;
+        }
       }
+    } // end loop over particle blocks
+
+    WaveSpeed = dx/WaveSpeed;
+    double delT_new = WaveSpeed.minComponent();
+
+    new_dw->put(delt_vartype(delT_new), lb->delTLabel, patch->getLevel());
+    if (flag->d_reductionVars->accStrainEnergy ||
+        flag->d_reductionVars->strainEnergy) {
+      new_dw->put(sum_vartype(se),        lb->StrainEnergyLabel);
+    }
+  }
+}
+//______________________________________________________________________
+//
+void UCNH::computeStressBlock(ParticleStressBlock& block, int n,
+                              bool batched) const
+{
+  StressBlock& b = static_cast<StressBlock&>(block);
+
+  // Constants
+  double onethird = (1.0/3.0), sqtwthds = sqrt(2.0/3.0);
+  Matrix3 Identity; Identity.Identity();
+
+  double shear = d_initialData.tauDev;
+  double bulk  = d_initialData.Bulk;
+  double K     = d_initialData.K;
+
+  if (!batched) {
+    for (int l = 0; l < n; l++) {
+      Matrix3 pDefGrad_new = b.defGrad_new.get(l);
+      Matrix3 pDefGradInc  = pDefGrad_new*b.defGrad.get(l).Inverse();
+      double Jinc          = pDefGradInc.Determinant();
+      double J             = b.J[l];
 
       // Get the volume preserving part of the deformation gradient increment
       Matrix3 fBar = pDefGradInc/cbrt(Jinc);
@@ -709,11 +787,11 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
       // part of the left Cauchy-Green deformation tensor
       Matrix3 bElBarTrial, tauDev;
       if(d_usePlasticity){
-        bElBarTrial = fBar*bElBar[idx]*fBar.Transpose();
+        bElBarTrial = fBar*b.bElBar.get(l)*fBar.Transpose();
       } else {
         double cubeRootJ      = cbrt(J);
         double Jtothetwothirds= cubeRootJ*cubeRootJ;
-        bElBarTrial           = pDefGrad_new[idx]* pDefGrad_new[idx].Transpose()
+        bElBarTrial           = pDefGrad_new* pDefGrad_new.Transpose()
                                  /Jtothetwothirds;
       }
       double IEl   = onethird*bElBarTrial.Trace();
@@ -725,13 +803,11 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
       double sTnorm      = tauDevTrial.Norm();
 
       // Check for plastic loading
-      double alpha;
       if(d_usePlasticity) {
-        flow = pYieldStress[idx];
-        alpha  = pPlasticStrain[idx];
+        double flow   = b.yieldStress[l];
+        double alpha  = b.plasticStrain[l];
         double fTrial = sTnorm - sqtwthds*(K*alpha + flow);
-        bElBar_new[idx] = bElBarTrial;
-        tauDev          = tauDevTrial;
+        tauDev        = tauDevTrial;
         if (fTrial > 0.0){
           // plastic
           // Compute increment of slip in the direction of flow
@@ -742,10 +818,10 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
           tauDev = tauDevTrial - normal*2.0*muBar*delgamma;
 
           // Deal with history variables
-          pPlasticStrain[idx] = alpha + sqtwthds*delgamma;
-          bElBar_new[idx]     = tauDev/shear + Identity*IEl;
-          bElBarTrial = bElBar_new[idx];
+          b.plasticStrain[l] = alpha + sqtwthds*delgamma;
+          bElBarTrial        = tauDev/shear + Identity*IEl;
         }
+        b.bElBar.set(l, bElBarTrial);
       } else {
         // The actual shear stress
         tauDev          = tauDevTrial;
@@ -755,48 +831,131 @@ void UCNH::computeStressTensor(const PatchSubset* patches,
       double p = 0.5*bulk*(J - 1.0/J);
 
       // compute the total stress (volumetric + deviatoric)
-      pStress[idx] = Identity*p + tauDev/J;
-
-      //__________________________________
-      // Compute the strain energy for non-localized particles
-      // Note this calculation is lagging by a timestep.
-      if(pLocalizedOld[idx] == 0){
-        double U = .5*bulk*(.5*(J*J - 1.0) - log(J));
-        double W = .5*shear*(bElBarTrial.Trace() - 3.0);
-        double e = (U + W)*pVolume_new[idx]/J;
-        se += e;
-      }
+      b.stress.set(l, Identity*p + tauDev/J);
 
-      // Compute the local sound speed (uniaxial strain, p-wave modulus)
-      double c_dil = sqrt((bulk + 4.*shear/3.)/rho_cur);
-
-      // Compute wave speed at each particle, store the maximum
-      Vector pvel = pVelocity[idx];
-      WaveSpeed=Vector(Max(c_dil+fabs(pvel.x()),WaveSpeed.x()),
-                       Max(c_dil+fabs(pvel.y()),WaveSpeed.y()),
-                       Max(c_dil+fabs(pvel.z()),WaveSpeed.z()));
-
-      // Compute artificial viscosity term
-      if (flag->d_artificial_viscosity) {
-        double dx_ave = (dx.x() + dx.y() + dx.z())/3.0;
-        double c_bulk = sqrt(bulk/rho_cur);
-        Matrix3 pDeformRate = (velGrad[idx] + velGrad[idx].Transpose())*0.5;
-        p_q[idx] = artificialBulkViscosity(pDeformRate.Trace(), c_bulk,
-                                           rho_cur, dx_ave);
-      } else {
-        p_q[idx] = 0.;
+      // strain energy
+      double U = .5*bulk*(.5*(J*J - 1.0) - log(J));
+      double W = .5*shear*(bElBarTrial.Trace() - 3.0);
+      b.energy[l] = U + W;
+    }
+    return;
+  }
+
+  // The same update on all of the lanes at once, the plastic return is
+  // computed everywhere and selected with a mask.  The lanes past n are
+  // computed along, with the values left in the block.
+  using namespace ParticleBlockOps;
+
+  Matrix3Block bElBarTrial, tmp;
+  double IEl[PARTICLE_BLOCK_SIZE], norm2[PARTICLE_BLOCK_SIZE];
+
+  if (d_usePlasticity) {
+    // fBar = F_inc/cbrt(J_inc) with F_inc = F_n+1*F_n^-1
+    Matrix3Block fBar;
+    double Jinc[PARTICLE_BLOCK_SIZE];
+    inverse(b.defGrad, tmp, n);
+    multiply(b.defGrad_new, tmp, fBar);
+    determinant(fBar, Jinc);
+    for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+      Jinc[l] = 1.0/cbrt(Jinc[l]);
+    }
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+          fBar.m[i][j][l] *= Jinc[l];
+        }
       }
-    } // end loop over particles
+    }
+    multiply(fBar, b.bElBar, tmp);
+    multiplyTranspose(tmp, fBar, bElBarTrial);
+  } else {
+    double Jm23[PARTICLE_BLOCK_SIZE];
+    for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+      double cubeRootJ = cbrt(b.J[l]);
+      Jm23[l] = 1.0/(cubeRootJ*cubeRootJ);
+    }
+    multiplyTranspose(b.defGrad_new, b.defGrad_new, bElBarTrial);
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+          bElBarTrial.m[i][j][l] *= Jm23[l];
+        }
+      }
+    }
+  }
 
-    WaveSpeed = dx/WaveSpeed;
-    double delT_new = WaveSpeed.minComponent();
+  // tauDevTrial = shear*dev(bElBarTrial), into tmp
+  trace(bElBarTrial, IEl);
+  for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+    IEl[l] = onethird*IEl[l];
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+        tmp.m[i][j][l] = (bElBarTrial.m[i][j][l] - Identity(i,j)*IEl[l])*shear;
+      }
+    }
+  }
+  normSquared(tmp, norm2);
+
+  if (d_usePlasticity) {
+    double delgamma[PARTICLE_BLOCK_SIZE], scale[PARTICLE_BLOCK_SIZE];
+    bool   plastic[PARTICLE_BLOCK_SIZE];
+    for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+      double muBar  = IEl[l]*shear;
+      double sTnorm = sqrt(norm2[l]);
+      double alpha  = b.plasticStrain[l];
+      double fTrial = sTnorm - sqtwthds*(K*alpha + b.yieldStress[l]);
+      plastic[l]    = fTrial > 0.0;
+      delgamma[l]   = (fTrial/(2.0*muBar)) / (1.0 + (K/(3.0*muBar)));
+      scale[l]      = 1.0/sTnorm;
+      b.plasticStrain[l] = plastic[l] ? alpha + sqtwthds*delgamma[l] : alpha;
+    }
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+          double normal = tmp.m[i][j][l]*scale[l];
+          double tauDev = tmp.m[i][j][l]
+                        - normal*2.0*(IEl[l]*shear)*delgamma[l];
+          if (plastic[l]) {
+            tmp.m[i][j][l]         = tauDev;
+            bElBarTrial.m[i][j][l] = tauDev*(1.0/shear) + Identity(i,j)*IEl[l];
+          }
+        }
+      }
+    }
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+          b.bElBar.m[i][j][l] = bElBarTrial.m[i][j][l];
+        }
+      }
+    }
+  }
 
-    new_dw->put(delt_vartype(delT_new), lb->delTLabel, patch->getLevel());
-    if (flag->d_reductionVars->accStrainEnergy ||
-        flag->d_reductionVars->strainEnergy) {
-      new_dw->put(sum_vartype(se),        lb->StrainEnergyLabel);
+  // stress = p*I + tauDev/J, tauDev is in tmp
+  double p[PARTICLE_BLOCK_SIZE], Jinv[PARTICLE_BLOCK_SIZE];
+  for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+    double J = b.J[l];
+    p[l]     = 0.5*bulk*(J - 1.0/J);
+    Jinv[l]  = 1.0/J;
+  }
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+        b.stress.m[i][j][l] = Identity(i,j)*p[l] + tmp.m[i][j][l]*Jinv[l];
+      }
     }
   }
+
+  // strain energy
+  trace(bElBarTrial, norm2);
+  for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+    double J = b.J[l];
+    double U = .5*bulk*(.5*(J*J - 1.0) - log(J));
+    double W = .5*shear*(norm2[l] - 3.0);
+    b.energy[l] = U + W;
+  }
 }
 //______________________________________________________________________
 //
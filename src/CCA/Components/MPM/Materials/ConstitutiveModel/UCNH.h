@@ -53,6 +53,7 @@ namespace Uintah {
 
 #include "ConstitutiveModel.h"
 #include "ImplicitCM.h"
+#include "ParticleBlock.h"
 #include "PlasticityModels/MPMEquationOfState.h"
 #include <CCA/Ports/DataWarehouseP.h>
 #include <Core/Disclosure/TypeDescription.h>
@@ -89,6 +90,20 @@ namespace Uintah {
       int seed;
     };
 
+    // Scratch buffers of computeStressBlock
+    struct StressBlock : public ParticleStressBlock {
+      Matrix3Block bElBar;                             // in/out, plasticity
+      double       yieldStress[PARTICLE_BLOCK_SIZE];   // plasticity
+      double       plasticStrain[PARTICLE_BLOCK_SIZE]; // in/out, plasticity
+
+      StressBlock()
+      {
+        for (int l = 0; l < PARTICLE_BLOCK_SIZE; l++) {
+          yieldStress[l] = plasticStrain[l] = 0.0;
+        }
+      }
+    };
+
     const VarLabel* bElBarLabel;
     const VarLabel* bElBarLabel_preReloc;
 
@@ -218,6 +233,12 @@ namespace Uintah {
                                      DataWarehouse* old_dw,
                                      DataWarehouse* new_dw);
 
+    virtual bool hasBatchedStressUpdate() const { return true; }
+
+    // b is a UCNH::StressBlock
+    virtual void computeStressBlock(ParticleStressBlock& b,
+                                    int n, bool batched) const;
+
     // Damage specific CST for solver
     virtual void computeStressTensorImplicit(const PatchSubset* patches,
                                              const MPMMaterial* matl,
@@ -107,7 +107,13 @@ MPMMaterial::standardInitialization(ProblemSpecP& ps,
          << " either Jim, John or Todd "<< endl; 
     throw ParameterNotFound(desc.str(), __FILE__, __LINE__);
   }
-  
+
+  if(flags->d_batchedStressUpdate && !d_cm->hasBatchedStressUpdate() &&
+     flags->d_myworld->myRank() == 0){
+    cerr << "WARNING:MPM: batched_stress_update is ignored by the "
+         << "constitutive model of material " << getName() << endl;
+  }
+
   // Step 2 -- create the damage/erosion gmodel.
   d_damageModel = DamageModelFactory::create(ps,flags,ss.get_rep() );
   
@@ -128,6 +128,8 @@ SerialMPM::SerialMPM( const ProcessorGroup* myworld,
   NGN     = 1;
   d_loadCurveIndex=0;
   d_switchCriteria = nullptr;
+  d_weightCache    = nullptr;
+  d_particleScatter = nullptr;
 
 //  d_fracture = false;
 
@@ -144,6 +146,8 @@ SerialMPM::~SerialMPM()
   delete d_fluxBC;
   delete d_sdInterfaceModel;
   delete flags;
+  delete d_weightCache;
+  delete d_particleScatter;
   delete d_switchCriteria;
   delete Cl;
   delete cohesiveZoneTasks;
@@ -197,6 +201,10 @@ void SerialMPM::problemSetup(const ProblemSpecP& prob_spec,
                                  __FILE__, __LINE__);
   }
 
+  if (flags->d_cacheParticleWeights){
+    d_weightCache = scinew ParticleWeightCache();
+  }
+
   // convert text representation of face into FaceType
   for(std::vector<std::string>::const_iterator ftit(flags->d_bndy_face_txt_list.begin());
       ftit!=flags->d_bndy_face_txt_list.end();ftit++) {
@@ -275,6 +283,8 @@ void SerialMPM::problemSetup(const ProblemSpecP& prob_spec,
     NGN=2;
   }
 
+  d_particleScatter = scinew ThreadedParticleScatter(flags->d_numP2GThreads,NGN);
+
   if (flags->d_prescribeDeformation){
     readPrescribedDeformations(flags->d_prescribedDeformationFile);
   }
@@ -2528,8 +2538,6 @@ void SerialMPM::interpolateParticlesToGrid(const ProcessorGroup*,
 
     unsigned int numMatls = m_materialManager->getNumMatls( "MPM" );
     ParticleInterpolator* interpolator = flags->d_interpolator->clone(patch);
-    vector<IntVector> ni(interpolator->size());
-    vector<double> S(interpolator->size());
 
     ParticleInterpolator* linear_interpolator=scinew LinearInterpolator(patch);
 
@@ -2672,103 +2680,113 @@ void SerialMPM::interpolateParticlesToGrid(const ProcessorGroup*,
       // Vector from the individual mass matrix and velocity vector
       // GridMass * GridVelocity =  S^T*M_D*ParticleVelocity
      if(mpm_matl->getIsActive()){
-      Vector total_mom(0.0,0.0,0.0);
       double pSp_vol = 1./mpm_matl->getInitialDensity();
-      //loop over all particles in the patch:
-      for (ParticleSubset::iterator iter = pset->begin();
-           iter != pset->end();
-           iter++){
-        particleIndex idx = *iter;
-        int NN =
-           interpolator->findCellAndWeights(px[idx],ni,S,psize[idx]);
-        Vector pmom = pvelocity[idx]*pmass[idx];
-        double ptemp_ext = pTemperature[idx];
-        total_mom += pmom;
-
-        // Add each particles contribution to the local mass & velocity
-        // Must use the node indices
-        IntVector node;
-        // Iterate through the nodes that receive data from the current particle
-        for(int k = 0; k < NN; k++) {
-          node = ni[k];
-          if(patch->containsNode(node)) {
-            if (flags->d_GEVelProj){
-              Point gpos = patch->getNodePosition(node);
-              Vector distance = px[idx] - gpos;
-              Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
-              pmom = pvel_ext*pmass[idx];
-              ptemp_ext = pTemperature[idx] - Dot(pTempGrad[idx],distance);
-            }
-            gmass[node]          += pmass[idx]                     * S[k];
-            gvelocity[node]      += pmom                           * S[k];
-            gvolume[node]        += pvolume[idx]                   * S[k];
-            if (flags->d_with_color) {
-              gColor[node]       += pColor[idx]*pmass[idx]         * S[k];
-            }
-            if (!flags->d_useCBDI) {
-              gexternalforce[node] += pexternalforce[idx]          * S[k];
-            }
-            gTemperature[node]   += ptemp_ext * pmass[idx] * S[k];
-            gSp_vol[node]        += pSp_vol   * pmass[idx] * S[k];
-            //gexternalheatrate[node] += pexternalheatrate[idx]      * S[k];
-          }
-        }
-        if (flags->d_doScalarDiffusion) {
-          double one_third = 1./3.;
-          double pHydroStress = one_third*pStress[idx].Trace();
-          double pConc_Ext = pConcentration[idx];
-          for (int k = 0; k < NN; ++k) {
+      ParticleWeightCache::WeightsP weights =
+                  getParticleWeights(interpolator, old_dw, pset, px, psize);
+
+      // With <p2g_threads> the particles that can add to the same node
+      // are never run at the same time, see ThreadedParticleScatter
+      auto scatter = [&](ParticleInterpolator* interp,
+                         ParticleSubset::iterator begin,
+                         ParticleSubset::iterator end){
+        vector<IntVector> ni(interp->size());
+        vector<double> S(interp->size());
+
+        //loop over all particles in the slab:
+        for (ParticleSubset::iterator iter = begin; iter != end; iter++){
+          particleIndex idx = *iter;
+          int NN = weights ? weights->findCellAndWeights(idx,ni,S) :
+             interp->findCellAndWeights(px[idx],ni,S,psize[idx]);
+          Vector pmom = pvelocity[idx]*pmass[idx];
+          double ptemp_ext = pTemperature[idx];
+
+          // Add each particles contribution to the local mass & velocity
+          // Must use the node indices
+          IntVector node;
+          // Iterate through the nodes that receive data from the current particle
+          for(int k = 0; k < NN; k++) {
             node = ni[k];
-            if (patch->containsNode(node)) {
-              if (flags->d_GEVelProj) {
+            if(patch->containsNode(node)) {
+              if (flags->d_GEVelProj){
                 Point gpos = patch->getNodePosition(node);
-                Vector pointOffset = px[idx]-gpos;
-                pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                Vector distance = px[idx] - gpos;
+                Vector pvel_ext = pvelocity[idx] - pVelGrad[idx]*distance;
+                pmom = pvel_ext*pmass[idx];
+                ptemp_ext = pTemperature[idx] - Dot(pTempGrad[idx],distance);
+              }
+              gmass[node]          += pmass[idx]                     * S[k];
+              gvelocity[node]      += pmom                           * S[k];
+              gvolume[node]        += pvolume[idx]                   * S[k];
+              if (flags->d_with_color) {
+                gColor[node]       += pColor[idx]*pmass[idx]         * S[k];
               }
-              double massWeight = pmass[idx]*S[k];
-              gHydrostaticStress[node]  += pHydroStress             *massWeight;
-              gConcentration[node]      += pConc_Ext                *massWeight;
-              gExtScalarFlux[node]      += pExternalScalarFlux[idx] *massWeight;
+              if (!flags->d_useCBDI) {
+                gexternalforce[node] += pexternalforce[idx]          * S[k];
+              }
+              gTemperature[node]   += ptemp_ext * pmass[idx] * S[k];
+              gSp_vol[node]        += pSp_vol   * pmass[idx] * S[k];
+              //gexternalheatrate[node] += pexternalheatrate[idx]      * S[k];
             }
           }
-        }
-        if (flags->d_useCBDI && pLoadCurveID[idx].x()>0) {
-          vector<IntVector> niCorner1(linear_interpolator->size());
-          vector<IntVector> niCorner2(linear_interpolator->size());
-          vector<IntVector> niCorner3(linear_interpolator->size());
-          vector<IntVector> niCorner4(linear_interpolator->size());
-          vector<double> SCorner1(linear_interpolator->size());
-          vector<double> SCorner2(linear_interpolator->size());
-          vector<double> SCorner3(linear_interpolator->size());
-          vector<double> SCorner4(linear_interpolator->size());
-          linear_interpolator->findCellAndWeights(pExternalForceCorner1[idx],
-                                 niCorner1,SCorner1,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner2[idx],
-                                 niCorner2,SCorner2,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner3[idx],
-                                 niCorner3,SCorner3,psize[idx]);
-          linear_interpolator->findCellAndWeights(pExternalForceCorner4[idx],
-                                 niCorner4,SCorner4,psize[idx]);
-          for(int k = 0; k < 8; k++) { // Iterates through the nodes which receive information from the current particle
-            node = niCorner1[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner1[k];
-            }
-            node = niCorner2[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner2[k];
-            }
-            node = niCorner3[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner3[k];
+          if (flags->d_doScalarDiffusion) {
+            double one_third = 1./3.;
+            double pHydroStress = one_third*pStress[idx].Trace();
+            double pConc_Ext = pConcentration[idx];
+            for (int k = 0; k < NN; ++k) {
+              node = ni[k];
+              if (patch->containsNode(node)) {
+                if (flags->d_GEVelProj) {
+                  Point gpos = patch->getNodePosition(node);
+                  Vector pointOffset = px[idx]-gpos;
+                  pConc_Ext -= Dot(pConcGrad[idx],pointOffset);
+                }
+                double massWeight = pmass[idx]*S[k];
+                gHydrostaticStress[node]  += pHydroStress             *massWeight;
+                gConcentration[node]      += pConc_Ext                *massWeight;
+                gExtScalarFlux[node]      += pExternalScalarFlux[idx] *massWeight;
+              }
             }
-            node = niCorner4[k];
-            if(patch->containsNode(node)) {
-              gexternalforce[node] += pexternalforce[idx] * SCorner4[k];
+          }
+          if (flags->d_useCBDI && pLoadCurveID[idx].x()>0) {
+            vector<IntVector> niCorner1(linear_interpolator->size());
+            vector<IntVector> niCorner2(linear_interpolator->size());
+            vector<IntVector> niCorner3(linear_interpolator->size());
+            vector<IntVector> niCorner4(linear_interpolator->size());
+            vector<double> SCorner1(linear_interpolator->size());
+            vector<double> SCorner2(linear_interpolator->size());
+            vector<double> SCorner3(linear_interpolator->size());
+            vector<double> SCorner4(linear_interpolator->size());
+            linear_interpolator->findCellAndWeights(pExternalForceCorner1[idx],
+                                   niCorner1,SCorner1,psize[idx]);
+            linear_interpolator->findCellAndWeights(pExternalForceCorner2[idx],
+                                   niCorner2,SCorner2,psize[idx]);
+            linear_interpolator->findCellAndWeights(pExternalForceCorner3[idx],
+                                   niCorner3,SCorner3,psize[idx]);
+            linear_interpolator->findCellAndWeights(pExternalForceCorner4[idx],
+                                   niCorner4,SCorner4,psize[idx]);
+            for(int k = 0; k < 8; k++) { // Iterates through the nodes which receive information from the current particle
+              node = niCorner1[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner1[k];
+              }
+              node = niCorner2[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner2[k];
+              }
+              node = niCorner3[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner3[k];
+              }
+              node = niCorner4[k];
+              if(patch->containsNode(node)) {
+                gexternalforce[node] += pexternalforce[idx] * SCorner4[k];
+              }
             }
           }
-        }
-      } // End of particle loop
+        } // End of particle loop
+      };
+
+      d_particleScatter->run(interpolator, pset, px, scatter);
 
       for(NodeIterator iter=patch->getExtraNodeIterator();
                        !iter.done();iter++){
@@ -3180,13 +3198,16 @@ void SerialMPM::computeInternalForce(const ProcessorGroup*,
       if(!mpm_matl->getIsRigid() && mpm_matl->getIsActive()){
         // for the non axisymmetric case:
         if(!flags->d_axisymmetric){
+          ParticleWeightCache::WeightsP weights =
+                  getParticleWeights(interpolator, old_dw, pset, px, psize);
           for (ParticleSubset::iterator iter = pset->begin();
                iter != pset->end();
                iter++){
             particleIndex idx = *iter;
 
             // Get the node indices that surround the cell
-            int NN =
+            int NN = weights ?
+              weights->findCellAndWeightsAndShapeDerivatives(idx,ni,S,d_S) :
               interpolator->findCellAndWeightsAndShapeDerivatives(px[idx],ni,S,
                                                      d_S,psize[idx]);
             stressvol  = pstress[idx]*pvol[idx];
@@ -4198,6 +4219,9 @@ void SerialMPM::interpolateToParticlesAndUpdate(const ProcessorGroup*,
                                   lb->diffusion->pConcPrevious_preReloc,  pset);
       }
 
+      ParticleWeightCache::WeightsP weights =
+                  getParticleWeights(interpolator, old_dw, pset, px, pcursize);
+
       if(flags->d_XPIC2 && !mpm_matl->getIsRigid()){
         // Loop over particles
         for(ParticleSubset::iterator iter = pset->begin();
@@ -4205,7 +4229,8 @@ void SerialMPM::interpolateToParticlesAndUpdate(const ProcessorGroup*,
           particleIndex idx = *iter;
 
           // Get the node indices that surround the cell
-          int NN = interpolator->findCellAndWeights(px[idx], ni, S,
+          int NN = weights ? weights->findCellAndWeights(idx, ni, S) :
+                   interpolator->findCellAndWeights(px[idx], ni, S,
                                                     pcursize[idx]);
           Vector vel(0.0,0.0,0.0);
           Vector velSSPSSP(0.0,0.0,0.0);
@@ -4298,7 +4323,8 @@ void SerialMPM::interpolateToParticlesAndUpdate(const ProcessorGroup*,
           particleIndex idx = *iter;
 
           // Get the node indices that surround the cell
-          int NN = interpolator->findCellAndWeights(px[idx], ni, S,
+          int NN = weights ? weights->findCellAndWeights(idx, ni, S) :
+                   interpolator->findCellAndWeights(px[idx], ni, S,
                                                     pcursize[idx]);
           Vector vel(0.0,0.0,0.0);
           Vector acc(0.0,0.0,0.0);
@@ -4482,6 +4508,9 @@ void SerialMPM::computeParticleGradients(const ProcessorGroup*,
       Matrix3 Identity;
       Identity.Identity();
 
+      ParticleWeightCache::WeightsP weights =
+                  getParticleWeights(interpolator, old_dw, pset, px, psize);
+
       // JBH -- Scalar diffusion related variables
       constParticleVariable<Vector> pArea;
       constNCVariable<double>       gConcStar;
@@ -4505,7 +4534,8 @@ void SerialMPM::computeParticleGradients(const ProcessorGroup*,
         Matrix3 tensorL(0.0);
         if(!flags->d_axisymmetric){
          // Get the node indices that surround the cell
-         NN =interpolator->findCellAndShapeDerivatives(px[idx],ni,
+         NN = weights ? weights->findCellAndShapeDerivatives(idx,ni,d_S) :
+              interpolator->findCellAndShapeDerivatives(px[idx],ni,
                                                      d_S,psize[idx]);
          computeVelocityGradient(tensorL,ni,d_S, oodx, gvelocity_star,NN);
         } else {  // axi-symmetric kinematics
@@ -6447,3 +6477,19 @@ double SerialMPM::recomputeDelT( const double delT )
 {
   return delT * 0.1;
 }
+
+//______________________________________________________________________
+//
+ParticleWeightCache::WeightsP
+SerialMPM::getParticleWeights(ParticleInterpolator* interpolator,
+                              DataWarehouse* old_dw,
+                              ParticleSubset* pset,
+                              constParticleVariable<Point>& px,
+                              constParticleVariable<Matrix3>& psize)
+{
+  if (!d_weightCache){
+    return ParticleWeightCache::WeightsP();
+  }
+  return d_weightCache->getWeights(interpolator, old_dw->getID(), pset,
+                                   px, psize);
+}
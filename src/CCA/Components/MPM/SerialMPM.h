@@ -41,6 +41,8 @@
 #include <CCA/Components/MPM/MPMCommon.h>
 #include <Core/Geometry/Vector.h>
 #include <CCA/Components/MPM/Core/MPMFlags.h>
+#include <CCA/Components/MPM/Core/ParticleWeightCache.h>
+#include <CCA/Components/MPM/Core/ThreadedParticleScatter.h>
 #include <CCA/Components/MPM/PhysicalBC/MPMPhysicalBC.h>
 #include <CCA/Components/MPM/PhysicalBC/LoadCurve.h>
 #include <CCA/Components/OnTheFlyAnalysis/AnalysisModule.h>
@@ -604,6 +606,15 @@ protected:
   
   virtual void scheduleSwitchTest(const LevelP& level, SchedulerP& sched);
 
+  //! Cached shape functions of the particles of pset, nullptr unless
+  //! cache_particle_weights is on
+  ParticleWeightCache::WeightsP getParticleWeights(
+                                   ParticleInterpolator* interpolator,
+                                   DataWarehouse* old_dw,
+                                   ParticleSubset* pset,
+                                   constParticleVariable<Point>& px,
+                                   constParticleVariable<Matrix3>& psize);
+
   //__________________________________
   // refinement criteria threshold knobs
   struct thresholdVar {
@@ -653,6 +664,8 @@ protected:
   };
   
   MPMFlags* flags;
+  ParticleWeightCache* d_weightCache;
+  ThreadedParticleScatter* d_particleScatter;
 
   double           d_nextOutputTime;
   double           d_SMALL_NUM_MPM;
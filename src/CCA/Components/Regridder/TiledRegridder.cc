@@ -36,6 +36,7 @@
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/Timers/Timers.hpp>
 
+#include <algorithm>
 #include <iomanip>
 #include <cstdio>
 
@@ -194,7 +195,12 @@ Grid* TiledRegridder::regrid(Grid* oldGrid, const int timeStep)
     rtimes[1] += timer().seconds();
     timer.reset( true );
 
-    GatherTiles(mytiles,tiles[l+1]);
+    if(d_bitmap_exchange) {
+      ExchangeTiles(mytiles, d_numCells[l+1]/d_minTileSize[l+1], tiles[l+1]);
+    }
+    else {
+      GatherTiles(mytiles,tiles[l+1]);
+    }
 
     if(l>0) {
       //add flags to the coarser level to ensure that boundary layers exist and that fine patches have a coarse patches above them.
@@ -427,6 +433,11 @@ void TiledRegridder::problemSetup(const ProblemSpecP& params,
     }
     target_patches_=patches_per_proc*d_myworld->nRanks();
   }
+
+  regrid_spec->getWithDefault("bitmap_tile_exchange", d_bitmap_exchange, false);
+  if(d_bitmap_exchange && d_myworld->myRank() == 0) {
+    cout << "  Regridder: combining the flagged tiles with bitmap reductions\n";
+  }
   
   for (int k = 0; k < d_maxLevels; k++) {
     if (k < (d_maxLevels)) {
@@ -577,24 +588,23 @@ bool TiledRegridder::verifyGrid(Grid *grid)
     return true;
 
   vector<int> checksums;
-  vector<int> their_checksums;
   vector<string> labels;
 
+  //the grids are the same if the minimum and maximum of each checksum over all ranks are,
+  //which takes two reductions instead of gathering the checksums of every rank on rank 0
   int num_levels=grid->numLevels();
   regrider_dbg << d_myworld->myRank() << " Grid number of levels:" << num_levels << endl;
-  their_checksums.resize(d_myworld->nRanks());
-  Uintah::MPI::Gather(&num_levels,1,MPI_INT,&their_checksums[0],1,MPI_INT,0,d_myworld->getComm());
+  int min_levels, max_levels;
+  Uintah::MPI::Allreduce(&num_levels,&min_levels,1,MPI_INT,MPI_MIN,d_myworld->getComm());
+  Uintah::MPI::Allreduce(&num_levels,&max_levels,1,MPI_INT,MPI_MAX,d_myworld->getComm());
 
-  if(d_myworld->myRank()==0)
+  if(min_levels!=max_levels)
   {
-    for(int i=0;i<d_myworld->nRanks();i++)
+    if(d_myworld->myRank()==0)
     {
-      if(num_levels!=their_checksums[i])
-      {
-        cout << d_myworld->myRank() << " Error number of levels does not match on rank " << i << " my levels:" << num_levels << " their levels:" << their_checksums[i] << endl;
-        return false;
-      }
+      cout << d_myworld->myRank() << " Error number of levels does not match on all ranks, min levels:" << min_levels << " max levels:" << max_levels << endl;
     }
+    return false;
   }
   
   for(int i=0;i<num_levels;i++)
@@ -623,21 +633,19 @@ bool TiledRegridder::verifyGrid(Grid *grid)
     checksums[i]+=(sum+diff);
   }
 
-  their_checksums.resize(checksums.size()*d_myworld->nRanks());
-  Uintah::MPI::Gather(&checksums[0],checksums.size(),MPI_INT,&their_checksums[0],checksums.size(),MPI_INT,0,d_myworld->getComm());
+  vector<int> min_checksums(checksums.size()), max_checksums(checksums.size());
+  Uintah::MPI::Allreduce(&checksums[0],&min_checksums[0],checksums.size(),MPI_INT,MPI_MIN,d_myworld->getComm());
+  Uintah::MPI::Allreduce(&checksums[0],&max_checksums[0],checksums.size(),MPI_INT,MPI_MAX,d_myworld->getComm());
  
-  if(d_myworld->myRank()==0)
+  for(unsigned int i=0;i<checksums.size();i++)
   {
-    for(int p=0;p<d_myworld->nRanks();p++)
+    if(min_checksums[i]!=max_checksums[i])
     {
-      for(unsigned int i=0;i<checksums.size();i++)
+      if(d_myworld->myRank()==0)
       {
-        if(checksums[i]!=their_checksums[p*checksums.size()+i])
-        {
-          cout << d_myworld->myRank() << " Error grid inconsistency: " << labels[i] << " does not match on rank:" << p << endl;
-          return false;
-        }
+        cout << d_myworld->myRank() << " Error grid inconsistency: " << labels[i] << " does not match on all ranks" << endl;
       }
+      return false;
     }
   }
   //if(d_myworld->myRank()==0)
@@ -750,3 +758,110 @@ void TiledRegridder::GatherTiles(vector<IntVector>& mytiles, vector<IntVector> &
   gatheredTiles.assign(settiles.begin(),settiles.end());
 
 }
+//______________________________________________________________________
+//
+// Combines the tiles flagged by all ranks without gathering them: the
+// tile lattice is split into blocks of up to 8x8x8 tiles, a bitmap of
+// the blocks holding a flagged tile is OR-reduced first, then the tile
+// bitmaps of just those blocks.  The first message is one bit per block
+// of the whole lattice however little is refined, the second 512 bits per
+// block holding a flagged tile.  Neither depends on the number of ranks,
+// and duplicate tiles are merged by the reduction.  The result is the
+// same as GatherTiles.
+void TiledRegridder::ExchangeTiles(vector<IntVector>& mytiles, const IntVector& numTiles, vector<IntVector> &gatheredTiles )
+{
+  typedef unsigned long long Bits;
+  const int BITS = 64;
+
+  IntVector blockSize = Min(numTiles, IntVector(8,8,8));
+  IntVector numBlocks = (numTiles + blockSize - IntVector(1,1,1)) / blockSize;
+  size_t    nblocks   = size_t(numBlocks.x()) * numBlocks.y() * numBlocks.z();
+  int       blockBits = Product(blockSize);
+  int       blockWords= (blockBits + BITS - 1) / BITS;
+
+  vector<size_t> block(mytiles.size());
+  vector<int>    bit(mytiles.size());
+
+  //which block and bit of the block each of my tiles is
+  for(size_t i=0;i<mytiles.size();i++)
+  {
+    const IntVector& t=mytiles[i];
+    if(!(IntVector(0,0,0) <= t && t+IntVector(1,1,1) <= numTiles))
+    {
+      ostringstream msg;
+      msg << "TiledRegridder: tile " << t << " is outside of the tile lattice " << numTiles;
+      throw InternalError(msg.str(),__FILE__,__LINE__);
+    }
+    IntVector b=t/blockSize;
+    IntVector o=t-b*blockSize;
+    block[i]=(size_t(b.z())*numBlocks.y()+b.y())*numBlocks.x()+b.x();
+    bit[i]  =(o.z()*blockSize.y()+o.y())*blockSize.x()+o.x();
+  }
+
+  //blocks with flagged tiles on any rank
+  size_t nwords=(nblocks+BITS-1)/BITS;
+  vector<Bits> myblocks(nwords,0), blocks(nwords,0);
+  for(size_t i=0;i<block.size();i++)
+  {
+    myblocks[block[i]/BITS] |= Bits(1) << (block[i]%BITS);
+  }
+
+  if(d_myworld->nRanks()>1)
+  {
+    Uintah::MPI::Allreduce(&myblocks[0],&blocks[0],nwords,MPI_UNSIGNED_LONG_LONG,MPI_BOR,d_myworld->getComm());
+  }
+  else
+  {
+    blocks.swap(myblocks);
+  }
+
+  //position of each flagged block in the tile bitmaps (the count of flagged blocks before it)
+  vector<size_t> before(nwords+1,0);
+  for(size_t w=0;w<nwords;w++)
+  {
+    before[w+1]=before[w]+__builtin_popcountll(blocks[w]);
+  }
+  size_t nflagged=before[nwords];
+
+  vector<Bits> mybits(nflagged*blockWords,0), bits(nflagged*blockWords,0);
+  for(size_t i=0;i<block.size();i++)
+  {
+    size_t w=block[i]/BITS;
+    Bits   lower=blocks[w] & ((Bits(1) << (block[i]%BITS)) - 1);
+    size_t pos=(before[w]+__builtin_popcountll(lower))*blockWords;
+    mybits[pos+bit[i]/BITS] |= Bits(1) << (bit[i]%BITS);
+  }
+
+  if(d_myworld->nRanks()>1 && nflagged>0)
+  {
+    Uintah::MPI::Allreduce(&mybits[0],&bits[0],nflagged*blockWords,MPI_UNSIGNED_LONG_LONG,MPI_BOR,d_myworld->getComm());
+  }
+  else
+  {
+    bits.swap(mybits);
+  }
+
+  //decode the tiles
+  gatheredTiles.clear();
+  size_t pos=0;
+  for(size_t w=0;w<nwords;w++)
+  {
+    for(Bits word=blocks[w]; word!=0; word &= word-1)
+    {
+      size_t    b=w*BITS+__builtin_ctzll(word);
+      IntVector blockLow=IntVector(b%numBlocks.x(), (b/numBlocks.x())%numBlocks.y(), b/(size_t(numBlocks.x())*numBlocks.y()))*blockSize;
+
+      for(int i=0;i<blockBits;i++)
+      {
+        if(bits[pos*blockWords+i/BITS] & (Bits(1) << (i%BITS)))
+        {
+          gatheredTiles.push_back(blockLow+IntVector(i%blockSize.x(), (i/blockSize.x())%blockSize.y(), i/(blockSize.x()*blockSize.y())));
+        }
+      }
+      pos++;
+    }
+  }
+
+  //same order as the set of GatherTiles
+  sort(gatheredTiles.begin(),gatheredTiles.end());
+}
@@ -55,6 +55,11 @@ DESCRIPTION
          Creates a patchset from refinement flags by tiling the grid with patches
    and taking any tiles that have refinement flags within them.
 
+   The flagged tiles of all ranks are either gathered to every rank
+   (GatherTiles) or, with <bitmap_tile_exchange>, OR-reduced as a two
+   level bitmap of the tile lattice (ExchangeTiles), whose size does not
+   depend on the number of ranks.
+
 WARNING
   
 ****************************************/
@@ -85,6 +90,7 @@ WARNING
     void OutputGridStats(Grid* newGrid);
     void ComputeTiles(std::vector<IntVector> &tiles, const LevelP level, IntVector tile_size, IntVector cellRefinementRatio);
     void GatherTiles(std::vector<IntVector>& mytiles, std::vector<IntVector> &gatheredTiles );
+    void ExchangeTiles(std::vector<IntVector>& mytiles, const IntVector& numTiles, std::vector<IntVector> &gatheredTiles );
     
     //maps a cell index to a tile index
     IntVector computeTileIndex(const IntVector& cellIndex, 
@@ -108,6 +114,7 @@ WARNING
     SizeList d_numCells;            //the maximum number of cells in each dimension for each level
 
     bool     d_dynamic_size;        //dynamically grow or shrink the tile size
+    bool     d_bitmap_exchange{false};  //combine the flagged tiles with bitmap reductions instead of gathering them
   };
 
 } // End namespace Uintah
@@ -25,6 +25,7 @@
 #ifndef CCA_COMPONENTS_SCHEDULERS_DWDATABASE_H
 #define CCA_COMPONENTS_SCHEDULERS_DWDATABASE_H
 
+#include <CCA/Components/Schedulers/EpochReclaim.h>
 #include <CCA/Components/Schedulers/MemoryLog.h>
 
 #include <Core/Grid/UnknownVariable.h>
@@ -40,6 +41,9 @@
 #include <Core/Util/FancyAssert.h>
 #include <Core/Util/DOUT.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <memory>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -68,16 +72,21 @@
 
   DESCRIPTION
 
+    Concurrent variable database. Lookups (exists, get, getlist) take no
+    lock: keys are found in an open-addressing index whose slots are only
+    ever filled, never moved, and variables live in fixed-size chunks of
+    atomic slots that never move once allocated. Inserting new keys and
+    growing the storage (put with init, doReserve) serialize on a
+    per-database lock; put itself locks one of a set of shards.
 
-****************************************/
-
-
-namespace {
+    A key may be visible in the KeyDatabase before a given DWDatabase has
+    grown its storage for it, so slot lookups are bounds checked. Items
+    removed from a slot (replace, putReduce, scrub, cleanForeign) are
+    retired rather than deleted and are freed once the readers that were
+    running when they were removed are done (see EpochReclaim.h).
 
-Uintah::MasterLock g_keyDB_lock{};
-Uintah::MasterLock g_mvars_lock{};
+****************************************/
 
-}
 
 namespace Uintah {
 
@@ -103,7 +112,7 @@ public:
   int lookup( const VarLabel   * label
             ,       int          matlIndex
             , const DomainType * dom
-            );
+            ) const;
 
   void merge( const KeyDatabase<DomainType>& newDB );
 
@@ -112,9 +121,45 @@ public:
 private:
 
   using keyDBtype = std::unordered_map<VarLabelMatl<DomainType>, int>;
+
+  struct KeyEntry {
+    KeyEntry( const VarLabelMatl<DomainType> & key, int index ) : m_key{key}, m_index{index} {}
+
+    VarLabelMatl<DomainType> m_key;
+    int                      m_index;
+  };
+
+  // open-addressing (linear probing) index, capacity is a power of two
+  struct KeyTable {
+    explicit KeyTable( size_t capacity )
+      : m_mask{capacity - 1}
+      , m_slots{new std::atomic<KeyEntry*>[capacity]}
+    {
+      for (size_t i = 0; i < capacity; ++i) {
+        m_slots[i].store(nullptr, std::memory_order_relaxed);
+      }
+    }
+
+    size_t                                    m_mask;
+    std::unique_ptr<std::atomic<KeyEntry*>[]> m_slots;
+  };
+
+  void insertKey( const VarLabelMatl<DomainType> & key );
+
+  static size_t hashKey( const VarLabelMatl<DomainType> & key );
+
+  static void placeEntry( KeyTable * table, KeyEntry * entry );
+
+  // authoritative key -> index map, used for iteration; guarded by m_insert_lock
   keyDBtype m_keys;
 
-  int m_key_count { 0 };
+  std::atomic<int> m_key_count { 0 };
+
+  std::atomic<KeyTable*>                 m_table { nullptr };
+  std::vector<std::unique_ptr<KeyTable>> m_tables;   // current and retired indices, kept for concurrent readers until clear()
+  std::vector<std::unique_ptr<KeyEntry>> m_entries;
+
+  mutable Uintah::MasterLock             m_insert_lock {};
 
 };
 
@@ -248,6 +293,62 @@ class DWDatabase {
         struct DataItem * m_next { nullptr };
     };
 
+    // One variable slot per key index. Whoever atomically removes a DataItem
+    // from a slot (exchange/CAS) owns it and is responsible for deleting it.
+    struct VarSlot {
+      std::atomic<DataItem*> m_item  { nullptr };
+      std::atomic<int>       m_scrub { 0 };
+    };
+
+    static const int s_chunk_bits = 10;
+    static const int s_chunk_size = 1 << s_chunk_bits;
+    static const int s_num_shards = 32;
+
+    // chunk directory, replaced (never modified) when the database grows
+    struct ChunkDirectory {
+      std::vector<VarSlot*> m_chunks;
+    };
+
+    // nullptr if this database has not (yet) grown its storage to idx
+    VarSlot* findVarSlot( int idx ) const
+    {
+      const ChunkDirectory* dir = m_directory.load(std::memory_order_acquire);
+      if (dir == nullptr || static_cast<size_t>(idx >> s_chunk_bits) >= dir->m_chunks.size()) {
+        return nullptr;
+      }
+      return &dir->m_chunks[idx >> s_chunk_bits][idx & (s_chunk_size - 1)];
+    }
+
+    // used by the put paths, grows the storage if the key was published by another database
+    VarSlot& getVarSlot( int idx )
+    {
+      VarSlot* slot = findVarSlot(idx);
+      if (slot == nullptr) {
+        reserveSlots(idx + 1);
+        slot = findVarSlot(idx);
+      }
+      return *slot;
+    }
+
+    void reserveSlots( int num_slots );
+
+    // Readers hold a ReadGuard while they dereference a DataItem loaded from
+    // a slot; retire() frees unlinked items once the readers that could
+    // have loaded them have left their guards.
+    using ReadGuard = EpochReclaim::Guard;
+
+    // the retired items are checked for reclamation every this many retires
+    static const int s_reclaim_batch = 32;
+
+    struct RetiredItem {
+      DataItem * m_item;
+      uint64_t   m_epoch;
+    };
+
+    void retire( DataItem * item );
+
+    void reclaimRetired();
+
     DataItem* getDataItem( const VarLabel   * label
                          ,       int          matlindex
                          , const DomainType * dom
@@ -255,11 +356,17 @@ class DWDatabase {
 
     KeyDatabase<DomainType>* m_keyDB { nullptr };
 
-    using varDBtype = std::vector<DataItem*>;
-    varDBtype m_vars {};
+    std::atomic<ChunkDirectory*>                 m_directory   { nullptr };
+    std::vector<std::unique_ptr<ChunkDirectory>> m_directories {};   // current and retired, kept for concurrent readers until clear()
+    std::vector<std::unique_ptr<VarSlot[]>>      m_chunk_storage {};
+    int                                          m_num_slots   { 0 };
+
+    Uintah::MasterLock                           m_reserve_lock {};
+    Uintah::MasterLock                           m_put_locks[s_num_shards];
 
-    using scrubDBtype = std::vector<int>;
-    scrubDBtype m_scrubs {};
+    std::vector<RetiredItem>                     m_retired     {};   // unlinked, waiting for the readers that may hold them
+    size_t                                       m_reclaim_at  { s_reclaim_batch };
+    Uintah::MasterLock                           m_retire_lock {};
 
     // eliminate copy, assignment and move
     DWDatabase( const DWDatabase & )            = delete;
@@ -281,13 +388,20 @@ DWDatabase<DomainType>::~DWDatabase()
 template<class DomainType>
 void DWDatabase<DomainType>::clear()
 {
-  for (auto iter = m_vars.begin(); iter != m_vars.end(); ++iter) {
-    if (*iter) {
-      delete *iter;
+  for (int idx = 0; idx < m_num_slots; ++idx) {
+    DataItem* item = findVarSlot(idx)->m_item.exchange(nullptr, std::memory_order_acq_rel);
+    if (item) {
+      delete item;
     }
-    *iter = nullptr;
   }
-  m_vars.clear();
+
+  // the database is no longer shared at this point
+  reclaimRetired();
+
+  m_directory.store(nullptr, std::memory_order_release);
+  m_directories.clear();
+  m_chunk_storage.clear();
+  m_num_slots = 0;
 }
 
 //______________________________________________________________________
@@ -296,14 +410,74 @@ template<class DomainType>
 void
 DWDatabase<DomainType>::cleanForeign()
 {
-  for (auto iter = m_vars.begin(); iter != m_vars.end(); ++iter) {
-    if (*iter && (*iter)->m_var->isForeign()) {
-      delete (*iter);
-      (*iter) = nullptr;
+  for (int idx = 0; idx < m_num_slots; ++idx) {
+    VarSlot& slot = *findVarSlot(idx);
+    DataItem* item = nullptr;
+    {
+      ReadGuard read_guard;
+      item = slot.m_item.load(std::memory_order_acquire);
+      if (item == nullptr || !item->m_var->isForeign() ||
+          !slot.m_item.compare_exchange_strong(item, nullptr, std::memory_order_acq_rel)) {
+        continue;
+      }
     }
+    retire(item);
   }
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::retire( DataItem * item )
+{
+  if (item == nullptr) {
+    return;
+  }
+
+  const uint64_t epoch = EpochReclaim::retireEpoch();
+
+  std::vector<DataItem*> reclaim;
+  {
+    std::lock_guard<Uintah::MasterLock> retire_lock(m_retire_lock);
+    m_retired.push_back(RetiredItem{item, epoch});
+
+    if (m_retired.size() >= m_reclaim_at) {
+      EpochReclaim::tryAdvance();
+
+      size_t kept = 0;
+      for (auto & retired : m_retired) {
+        if (EpochReclaim::isSafe(retired.m_epoch)) {
+          reclaim.push_back(retired.m_item);
+        }
+        else {
+          m_retired[kept++] = retired;
+        }
+      }
+      m_retired.resize(kept);
+      m_reclaim_at = kept + s_reclaim_batch;
+    }
+  }
+
+  for (auto di : reclaim) {
+    delete di;
+  }
+}
+
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::reclaimRetired()
+{
+  std::lock_guard<Uintah::MasterLock> retire_lock(m_retire_lock);
+  for (auto & retired : m_retired) {
+    delete retired.m_item;
+  }
+  m_retired.clear();
+  m_reclaim_at = s_reclaim_batch;
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -321,20 +495,19 @@ DWDatabase<DomainType>::decrementScrubCount( const VarLabel   * label
 
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> decrement_scrub_count_lock(g_keyDB_lock);
-
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     return 0;
   }
-  if (!m_vars[idx]) {
+
+  VarSlot* slot = findVarSlot(idx);
+  if (slot == nullptr || slot->m_item.load(std::memory_order_acquire) == nullptr) {
     return 0;
   }
 
-  int rt = __sync_sub_and_fetch(&(m_scrubs[idx]), 1);
+  int rt = slot->m_scrub.fetch_sub(1, std::memory_order_acq_rel) - 1;
   if (rt == 0) {
-    delete m_vars[idx];
-    m_vars[idx] = nullptr;
+    retire(slot->m_item.exchange(nullptr, std::memory_order_acq_rel));
   }
 
   return rt;
@@ -350,13 +523,12 @@ DWDatabase<DomainType>::setScrubCount( const VarLabel   * label
                                      ,       int          count
                                      )
 {
-  std::lock_guard<Uintah::MasterLock> set_scrub_count_lock(g_keyDB_lock);
-
   int idx = m_keyDB->lookup(label, matlIndex, dom);
-  if (idx == -1) {
+  VarSlot* slot = (idx == -1) ? nullptr : findVarSlot(idx);
+  if (slot == nullptr) {
     SCI_THROW(UnknownVariable(label->getName(), -99, dom, matlIndex, "DWDatabase::setScrubCount", __FILE__, __LINE__));
   }
-  m_scrubs[idx] = count;
+  slot->m_scrub.store(count, std::memory_order_release);
 }
 
 //______________________________________________________________________
@@ -370,12 +542,10 @@ DWDatabase<DomainType>::scrub( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> scrub_lock(g_keyDB_lock);
-
   int idx = m_keyDB->lookup(label, matlIndex, dom);
-  if (idx != -1 && m_vars[idx]) {
-    delete m_vars[idx];
-    m_vars[idx] = nullptr;
+  VarSlot* slot = (idx == -1) ? nullptr : findVarSlot(idx);
+  if (slot) {
+    retire(slot->m_item.exchange(nullptr, std::memory_order_acq_rel));
   }
 }
 
@@ -390,36 +560,63 @@ DWDatabase<DomainType>::initializeScrubs(       int                        dwid
 {
   // loop over each variable, probing the scrubcount map. Set the scrubcount appropriately.
   // If the variable has no entry in the scrubcount map, delete it
-  for (auto keyiter = m_keyDB->m_keys.begin(); keyiter != m_keyDB->m_keys.end();) {
-    if (m_vars[keyiter->second]) {
+  std::lock_guard<Uintah::MasterLock> initialize_scrubs_lock(m_keyDB->m_insert_lock);
+
+  for (auto keyiter = m_keyDB->m_keys.begin(); keyiter != m_keyDB->m_keys.end(); ++keyiter) {
+    VarSlot* slot = findVarSlot(keyiter->second);
+    if (slot && slot->m_item.load(std::memory_order_acquire)) {
       VarLabelMatl<DomainType> vlm = keyiter->first;
       // See if it is in the scrubcounts map.
       ScrubItem key(vlm.m_label, vlm.m_matl_index, vlm.m_domain, dwid);
       ScrubItem* result = scrubcounts->lookup(&key);
       if (!result && !add) {
-        delete m_vars[keyiter->second];
-        m_vars[keyiter->second] = nullptr;
+        retire(slot->m_item.exchange(nullptr, std::memory_order_acq_rel));
       }
-      else {
-        if (result) {
-          if (add) {
-            __sync_add_and_fetch(&(m_scrubs[keyiter->second]), result->m_count);
-          }
-          else {
-            if (!__sync_bool_compare_and_swap(&(m_scrubs[keyiter->second]), 0, result->m_count)) {
-              SCI_THROW(InternalError("initializing non-zero scrub counter", __FILE__, __LINE__));
-            }
+      else if (result) {
+        if (add) {
+          slot->m_scrub.fetch_add(result->m_count, std::memory_order_acq_rel);
+        }
+        else {
+          int expected = 0;
+          if (!slot->m_scrub.compare_exchange_strong(expected, result->m_count, std::memory_order_acq_rel)) {
+            SCI_THROW(InternalError("initializing non-zero scrub counter", __FILE__, __LINE__));
           }
         }
-        ++keyiter;
       }
     }
-    else {
-      ++keyiter;
-    }
   }
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+size_t
+KeyDatabase<DomainType>::hashKey( const VarLabelMatl<DomainType> & key )
+{
+  // the std::hash below only mixes pointers, finish it (splitmix64) so the
+  //   low bits used by the power-of-two index are well distributed
+  uint64_t h = static_cast<uint64_t>(std::hash<VarLabelMatl<DomainType> >()(key));
+  h ^= h >> 30;
+  h *= 0xbf58476d1ce4e5b9ULL;
+  h ^= h >> 27;
+  h *= 0x94d049bb133111ebULL;
+  h ^= h >> 31;
+  return static_cast<size_t>(h);
+}
+
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+KeyDatabase<DomainType>::placeEntry( KeyTable * table, KeyEntry * entry )
+{
+  size_t slot = hashKey(entry->m_key) & table->m_mask;
+  while (table->m_slots[slot].load(std::memory_order_relaxed) != nullptr) {
+    slot = (slot + 1) & table->m_mask;
+  }
+  table->m_slots[slot].store(entry, std::memory_order_release);
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -427,15 +624,62 @@ int
 KeyDatabase<DomainType>::lookup( const VarLabel   * label
                                ,       int          matlIndex
                                , const DomainType * dom
-                               )
+                               ) const
 {
-  VarLabelMatl<DomainType> v(label, matlIndex, getRealDomain(dom));
-  typename keyDBtype::const_iterator const_iter = m_keys.find(v);
-  if (const_iter == m_keys.end()) {
+  const KeyTable* table = m_table.load(std::memory_order_acquire);
+  if (table == nullptr) {
     return -1;
   }
+
+  VarLabelMatl<DomainType> v(label, matlIndex, getRealDomain(dom));
+  size_t slot = hashKey(v) & table->m_mask;
+  while (true) {
+    const KeyEntry* entry = table->m_slots[slot].load(std::memory_order_acquire);
+    if (entry == nullptr) {
+      return -1;
+    }
+    if (entry->m_key == v) {
+      return entry->m_index;
+    }
+    slot = (slot + 1) & table->m_mask;
+  }
+}
+
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+KeyDatabase<DomainType>::insertKey( const VarLabelMatl<DomainType> & key )
+{
+  // caller holds m_insert_lock
+  if (m_keys.find(key) != m_keys.end()) {
+    return;
+  }
+
+  const int index = m_key_count.load(std::memory_order_relaxed);
+  m_entries.push_back(std::unique_ptr<KeyEntry>(scinew KeyEntry(key, index)));
+  m_keys.insert(std::pair<VarLabelMatl<DomainType>, int>(key, index));
+  m_key_count.store(index + 1, std::memory_order_release);
+
+  const size_t num_keys = index + 1;
+  KeyTable* table = m_table.load(std::memory_order_relaxed);
+
+  // keep the load factor at or below 1/2, readers of the old index are never disturbed
+  if (table == nullptr || num_keys * 2 > table->m_mask + 1) {
+    size_t capacity = 64;
+    while (capacity < num_keys * 4) {
+      capacity <<= 1;
+    }
+
+    KeyTable* new_table = scinew KeyTable(capacity);
+    for (auto & entry : m_entries) {
+      placeEntry(new_table, entry.get());
+    }
+    m_tables.push_back(std::unique_ptr<KeyTable>(new_table));
+    m_table.store(new_table, std::memory_order_release);
+  }
   else {
-    return const_iter->second;
+    placeEntry(table, m_entries.back().get());
   }
 }
 
@@ -445,11 +689,10 @@ template<class DomainType>
 void
 KeyDatabase<DomainType>::merge( const KeyDatabase<DomainType> & newDB )
 {
+  std::lock_guard<Uintah::MasterLock> merge_lock(m_insert_lock);
+
   for (typename keyDBtype::const_iterator const_keyiter = newDB.m_keys.cbegin(); const_keyiter != newDB.m_keys.cend(); ++const_keyiter) {
-    typename keyDBtype::const_iterator const_db_iter = m_keys.find(const_keyiter->first);
-    if (const_db_iter == m_keys.end()) {
-      m_keys.insert(std::pair<VarLabelMatl<DomainType>, int>(const_keyiter->first, m_key_count++));
-    }
+    insertKey(const_keyiter->first);
   }
 }
 
@@ -462,11 +705,13 @@ KeyDatabase<DomainType>::insert( const VarLabel   * label
                                , const DomainType * dom
                                )
 {
-  VarLabelMatl<DomainType> v(label, matlIndex, getRealDomain(dom));
-  typename keyDBtype::const_iterator const_iter = m_keys.find(v);
-  if (const_iter == m_keys.end()) {
-    m_keys.insert(std::pair<VarLabelMatl<DomainType>, int>(v, m_key_count++));
+  // most inserts during execution are for keys that already exist
+  if (lookup(label, matlIndex, dom) != -1) {
+    return;
   }
+
+  std::lock_guard<Uintah::MasterLock> insert_lock(m_insert_lock);
+  insertKey(VarLabelMatl<DomainType>(label, matlIndex, getRealDomain(dom)));
 }
 
 //______________________________________________________________________
@@ -475,8 +720,13 @@ template<class DomainType>
 void
 KeyDatabase<DomainType>::clear()
 {
+  std::lock_guard<Uintah::MasterLock> clear_lock(m_insert_lock);
+
+  m_table.store(nullptr, std::memory_order_release);
+  m_tables.clear();
+  m_entries.clear();
   m_keys.clear();
-  m_key_count = 0;
+  m_key_count.store(0, std::memory_order_release);
 }
 
 //______________________________________________________________________
@@ -485,6 +735,8 @@ template<class DomainType>
 void
 KeyDatabase<DomainType>::print( const int rank ) const
 {
+  std::lock_guard<Uintah::MasterLock> print_lock(m_insert_lock);
+
   DOUT( true, "Rank-"<<rank<< " __________________________________KeyDatabase ")
   for (auto keyiter = m_keys.begin(); keyiter != m_keys.end(); ++keyiter) {
     const VarLabelMatl<DomainType>& vlm = keyiter->first;
@@ -499,6 +751,37 @@ KeyDatabase<DomainType>::print( const int rank ) const
   DOUT( true, "Rank-"<<rank<< " __________________________________")
 }
 
+//______________________________________________________________________
+//
+template<class DomainType>
+void
+DWDatabase<DomainType>::reserveSlots( int num_slots )
+{
+  std::lock_guard<Uintah::MasterLock> reserve_lock(m_reserve_lock);
+
+  if (num_slots <= m_num_slots) {
+    return;
+  }
+
+  const ChunkDirectory* old_dir = m_directory.load(std::memory_order_relaxed);
+  const size_t num_chunks = (num_slots + s_chunk_size - 1) >> s_chunk_bits;
+
+  if (old_dir == nullptr || num_chunks > old_dir->m_chunks.size()) {
+    ChunkDirectory* new_dir = scinew ChunkDirectory();
+    if (old_dir) {
+      new_dir->m_chunks = old_dir->m_chunks;
+    }
+    while (new_dir->m_chunks.size() < num_chunks) {
+      m_chunk_storage.push_back(std::unique_ptr<VarSlot[]>(scinew VarSlot[s_chunk_size]));
+      new_dir->m_chunks.push_back(m_chunk_storage.back().get());
+    }
+    m_directories.push_back(std::unique_ptr<ChunkDirectory>(new_dir));
+    m_directory.store(new_dir, std::memory_order_release);
+  }
+
+  m_num_slots = static_cast<int>(num_chunks) << s_chunk_bits;
+}
+
 //______________________________________________________________________
 //
 template<class DomainType>
@@ -506,8 +789,7 @@ void
 DWDatabase<DomainType>::doReserve( KeyDatabase<DomainType> * keydb )
 {
   m_keyDB = keydb;
-  m_vars.resize(m_keyDB->m_key_count + 1, (DataItem*)nullptr);
-  m_scrubs.resize(m_keyDB->m_key_count + 1, 0);
+  reserveSlots(m_keyDB->m_key_count.load(std::memory_order_acquire) + 1);
 }
 
 //______________________________________________________________________
@@ -519,13 +801,12 @@ DWDatabase<DomainType>::exists( const VarLabel   * label
                               , const DomainType * dom
                               ) const
 {
-  std::lock_guard<Uintah::MasterLock> exists_lock(g_keyDB_lock);
-
   int idx = m_keyDB->lookup(label, matlIndex, dom);
   if (idx == -1) {
     return false;
   }
-  if (m_vars[idx] == nullptr) {
+  const VarSlot* slot = findVarSlot(idx);
+  if (slot == nullptr || slot->m_item.load(std::memory_order_acquire) == nullptr) {
     return false;
   }
   return true;
@@ -545,8 +826,6 @@ DWDatabase<DomainType>::put( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_lock(g_keyDB_lock);
-
   if (init) {
     m_keyDB->insert(label, matlIndex, dom);
     this->doReserve(m_keyDB);
@@ -557,20 +836,27 @@ DWDatabase<DomainType>::put( const VarLabel   * label
     SCI_THROW(UnknownVariable(label->getName(), -1, dom, matlIndex, "DWDatabase::put", __FILE__, __LINE__));
   }
 
-  if (m_vars[idx]) {
-    if (m_vars[idx]->m_next) {
-      SCI_THROW(InternalError("More than one vars on this label", __FILE__, __LINE__));
-    }
-    if (!replace) {
-      SCI_THROW(InternalError("Put replacing old vars", __FILE__, __LINE__));
+  std::lock_guard<Uintah::MasterLock> put_lock(m_put_locks[idx % s_num_shards]);
+
+  VarSlot& slot = getVarSlot(idx);
+  {
+    // scrub may unlink the current item concurrently
+    ReadGuard read_guard;
+    DataItem* olddi = slot.m_item.load(std::memory_order_acquire);
+    if (olddi) {
+      if (olddi->m_next) {
+        SCI_THROW(InternalError("More than one vars on this label", __FILE__, __LINE__));
+      }
+      if (!replace) {
+        SCI_THROW(InternalError("Put replacing old vars", __FILE__, __LINE__));
+      }
+      ASSERT(olddi->m_var != var);
     }
-    ASSERT(m_vars[idx]->m_var != var);
-    delete m_vars[idx];
   }
 
   DataItem* newdi = new DataItem();
   newdi->m_var = var;
-  m_vars[idx] = newdi;
+  retire(slot.m_item.exchange(newdi, std::memory_order_acq_rel));
 }
 
 //______________________________________________________________________
@@ -586,8 +872,6 @@ DWDatabase<DomainType>::putReduce( const VarLabel              * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_reduce_lock(g_keyDB_lock);
-
   if (init) {
     m_keyDB->insert(label, matlIndex, dom);
     this->doReserve(m_keyDB);
@@ -598,22 +882,39 @@ DWDatabase<DomainType>::putReduce( const VarLabel              * label
     SCI_THROW(UnknownVariable(label->getName(), -1, dom, matlIndex, "DWDatabase::putReduce", __FILE__, __LINE__));
   }
 
+  VarSlot& slot = getVarSlot(idx);
+
+  // The reduced value is built in a new item that replaces the current one,
+  //   so the slot is never empty and the current value is never modified
+  //   while other threads may be reading it.
   DataItem* newdi = new DataItem();
-  newdi->m_var = var;
-  do {
-    DataItem* olddi = __sync_lock_test_and_set(&m_vars[idx], 0);
-    if (olddi == nullptr) {
-      olddi = newdi;
-    }
-    else {
-      ReductionVariableBase* oldvar = dynamic_cast<ReductionVariableBase*>(olddi->m_var);
-      ReductionVariableBase* newvar = dynamic_cast<ReductionVariableBase*>(newdi->m_var);
-      oldvar->reduce(*newvar);
-      delete newdi;
+  DataItem* olddi = nullptr;
+  {
+    ReadGuard read_guard;
+    olddi = slot.m_item.load(std::memory_order_acquire);
+    while (true) {
+      ReductionVariableBase* reduced = var;
+      if (olddi) {
+        reduced = dynamic_cast<ReductionVariableBase*>(olddi->m_var)->clone();
+        reduced->reduce(*var);
+      }
+      newdi->m_var = reduced;
+
+      if (slot.m_item.compare_exchange_weak(olddi, newdi, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        break;
+      }
+
+      // olddi has been reloaded with the item another thread put
+      if (reduced != var) {
+        delete reduced;
+      }
     }
-    newdi = __sync_lock_test_and_set(&m_vars[idx], olddi);
   }
-  while (newdi != nullptr);
+
+  if (olddi) {
+    delete var;
+    retire(olddi);
+  }
 }
 
 //______________________________________________________________________
@@ -629,8 +930,6 @@ DWDatabase<DomainType>::putForeign( const VarLabel   * label
 {
   ASSERT(matlIndex >= -1);
 
-  std::lock_guard<Uintah::MasterLock> put_foreign_lock(g_keyDB_lock);
-
   if (init) {
     m_keyDB->insert(label, matlIndex, dom);
     this->doReserve(m_keyDB);
@@ -641,12 +940,14 @@ DWDatabase<DomainType>::putForeign( const VarLabel   * label
     SCI_THROW(UnknownVariable(label->getName(), -1, dom, matlIndex, "DWDatabase::putForeign", __FILE__, __LINE__));
   }
 
+  VarSlot& slot = getVarSlot(idx);
+
   DataItem* newdi = new DataItem();
   newdi->m_var = var;
-  do {
-    newdi->m_next = m_vars[idx];
+  newdi->m_next = slot.m_item.load(std::memory_order_acquire);
+  while (!slot.m_item.compare_exchange_weak(newdi->m_next, newdi, std::memory_order_acq_rel)) {
+    // newdi->m_next has been reloaded with the current head
   }
-  while (!__sync_bool_compare_and_swap(&m_vars[idx], newdi->m_next, newdi));  // vars[iter->second] = newdi;
 }
 
 //______________________________________________________________________
@@ -661,10 +962,11 @@ DWDatabase<DomainType>::getDataItem( const VarLabel   * label
   ASSERT(matlIndex >= -1);
 
   int idx = m_keyDB->lookup(label, matlIndex, dom);
-  if (idx == -1) {
+  const VarSlot* slot = (idx == -1) ? nullptr : findVarSlot(idx);
+  if (slot == nullptr) {
     SCI_THROW(UnknownVariable(label->getName(), -99, dom, matlIndex, "DWDatabase::getDataItem", __FILE__, __LINE__));
   }
-  return m_vars[idx];
+  return slot->m_item.load(std::memory_order_acquire);
 }
 
 //______________________________________________________________________
@@ -677,8 +979,7 @@ DWDatabase<DomainType>::get( const VarLabel   * label
                            , const DomainType * dom
                            ) const
 {
-  std::lock_guard<Uintah::MasterLock> get_lock(g_keyDB_lock);
-
+  ReadGuard read_guard;
   const DataItem* dataItem = getDataItem(label, matlIndex, dom);
   ASSERT(dataItem != nullptr);          // should have thrown an exception before
   ASSERT(dataItem->m_next == nullptr);  // should call getlist()
@@ -695,6 +996,7 @@ DWDatabase<DomainType>::get( const VarLabel   * label
                            ,       Variable   & var
                            ) const
 {
+  ReadGuard read_guard;
   Variable* tmp = get(label, matlIndex, dom);
   var.copyPointer(*tmp);
 }
@@ -709,8 +1011,7 @@ DWDatabase<DomainType>::getlist( const VarLabel               * label
                                ,       std::vector<Variable*> & varlist
                                ) const
 {
-  std::lock_guard<Uintah::MasterLock> get_list_lock(g_keyDB_lock);
-
+  ReadGuard read_guard;
   for (DataItem* dataItem = getDataItem(label, matlIndex, dom); dataItem != nullptr; dataItem = dataItem->m_next) {
     varlist.push_back(dataItem->m_var);
   }
@@ -722,10 +1023,13 @@ template<class DomainType>
 void
 DWDatabase<DomainType>::print( const int rank ) const
 {
+  std::lock_guard<Uintah::MasterLock> print_lock(m_keyDB->m_insert_lock);
+
   DOUT( true, "Rank-"<<rank<< " __________________________________DWDatabase ")
 
   for (auto keyiter = m_keyDB->m_keys.begin(); keyiter != m_keyDB->m_keys.end(); ++keyiter) {
-    if (m_vars[keyiter->second]) {
+    const VarSlot* slot = findVarSlot(keyiter->second);
+    if (slot && slot->m_item.load(std::memory_order_acquire)) {
       const VarLabelMatl<DomainType>& vlm = keyiter->first;
       const DomainType* dom = vlm.m_domain;
 
@@ -750,9 +1054,14 @@ DWDatabase<DomainType>::logMemoryUse(       std::ostream  & out
                                     ,       int             dwid
                                     )
 {
+  std::lock_guard<Uintah::MasterLock> log_memory_use_lock(m_keyDB->m_insert_lock);
+  ReadGuard read_guard;
+
   for (auto keyiter = m_keyDB->m_keys.begin(); keyiter != m_keyDB->m_keys.end(); ++keyiter) {
-    if (m_vars[keyiter->second]) {
-      Variable* var = m_vars[keyiter->second]->m_var;
+    const VarSlot* slot = findVarSlot(keyiter->second);
+    DataItem* item = slot ? slot->m_item.load(std::memory_order_acquire) : nullptr;
+    if (item) {
+      Variable* var = item->m_var;
       VarLabelMatl<DomainType> vlm = keyiter->first;
       const VarLabel* label = vlm.m_label;
       std::string elems;
@@ -773,11 +1082,12 @@ template<class DomainType>
 void
 DWDatabase<DomainType>::getVarLabelMatlTriples( std::vector<VarLabelMatl<DomainType> > & v) const
 {
-  std::lock_guard<Uintah::MasterLock> get_var_label_mat_triples_lock(g_keyDB_lock);
+  std::lock_guard<Uintah::MasterLock> get_var_label_mat_triples_lock(m_keyDB->m_insert_lock);
 
   for (auto keyiter = m_keyDB->m_keys.begin(); keyiter != m_keyDB->m_keys.end(); ++keyiter) {
     const VarLabelMatl<DomainType>& vlm = keyiter->first;
-    if (m_vars[keyiter->second]) {
+    const VarSlot* slot = findVarSlot(keyiter->second);
+    if (slot && slot->m_item.load(std::memory_order_acquire)) {
       v.push_back(vlm);
     }
   }
@@ -41,6 +41,8 @@
 #include <sci_defs/config_defs.h>
 #include <sci_defs/cuda_defs.h>
 
+#include <algorithm>
+#include <map>
 #include <sstream>
 #include <string>
 
@@ -421,6 +423,22 @@ DetailedTask::addInternalRequires( DependencyBatch * req )
 void
 DetailedTask::checkExternalDepCount()
 {
+  // work stealing - the per-worker queues are locked individually, so only the
+  //   transition to externally ready needs to be made atomic here
+  if (m_task_group->usingWorkStealing()) {
+    if ((m_external_dependency_count.load(std::memory_order_acquire) == 0) && m_task_group->m_sched_common->useInternalDeps() &&
+         m_initiated.load(std::memory_order_acquire) && !m_task->usesMPI()) {
+
+      bool expected = false;
+      if (m_externally_ready.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+        DOUTR(g_external_deps_dbg, "    Task " << this->getTask()->getName()
+                                   << " MPI requirements satisfied, placing into worker ready queue");
+        m_task_group->addExternalReadyTask(this);
+      }
+    }
+    return;
+  }
+
   std::lock_guard<Uintah::MasterLock> external_ready_guard(g_external_ready_mutex);
 
   DOUTR(g_external_deps_dbg, "  DetailedTask::checkExternalDepCoun Task " << this->getTask()->getName() << " external deps: "
@@ -496,6 +514,9 @@ DetailedTask::done( std::vector<OnDemandDataWarehouseP> & dws )
                  <<"  which has (" << m_internal_dependents.size() << ") tasks waiting on it:" );
   }
 
+  // a dependent made ready here may be fused behind this task
+  m_task_group->setFusionPrerequisite(this);
+
   for (auto iter = m_internal_dependents.begin(); iter != m_internal_dependents.end(); ++iter) {
     InternalDependency* dep = (*iter).second;
     dep->m_dependent_task->dependencySatisfied(dep);
@@ -503,7 +524,13 @@ DetailedTask::done( std::vector<OnDemandDataWarehouseP> & dws )
     DOUTR(g_internal_deps_dbg, "    Dependency satisfied between " << *dep->m_dependent_task << " and " << *this );
   }
 
+  m_task_group->setFusionPrerequisite(nullptr);
+
   m_exec_timer.stop();
+
+  // exponential average, the most recent timestep counts half
+  double seconds = task_exec_time();
+  m_cost_estimate = (m_cost_estimate < 0.0) ? seconds : 0.5 * (m_cost_estimate + seconds);
 }
 
 //_____________________________________________________________________________
@@ -534,6 +561,35 @@ DetailedTask::dependencySatisfied( InternalDependency * dep )
   }
 }
 
+//_____________________________________________________________________________
+//
+double
+DetailedTask::computeCriticalPathLength( const std::map<const Task*, double> & taskPathLength )
+{
+  // tasks that have not run yet count as a unit cost, so the path length is
+  //   the number of tasks on the path until they have been measured
+  const double unitCost = 1.0e-6;
+
+  double successors = 0.0;
+
+  for (auto iter = m_internal_dependents.begin(); iter != m_internal_dependents.end(); ++iter) {
+    successors = std::max(successors, iter->first->m_critical_path_length);
+  }
+
+  for (DependencyBatch* batch = m_comp_head; batch != nullptr; batch = batch->m_comp_next) {
+    for (auto iter = batch->m_to_tasks.begin(); iter != batch->m_to_tasks.end(); ++iter) {
+      auto found = taskPathLength.find((*iter)->getTask());
+      if (found != taskPathLength.end()) {
+        successors = std::max(successors, found->second);
+      }
+    }
+  }
+
+  m_critical_path_length = ((m_cost_estimate < 0.0) ? unitCost : m_cost_estimate) + successors;
+
+  return m_critical_path_length;
+}
+
 //_____________________________________________________________________________
 //
 void
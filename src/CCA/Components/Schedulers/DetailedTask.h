@@ -191,6 +191,18 @@ public:
   double task_wait_time() const { return m_wait_timer().seconds(); }
   double task_exec_time() const { return m_exec_timer().seconds(); }
 
+  // Running average of this task's measured execution time (seconds).
+  double getCostEstimate() const { return m_cost_estimate; }
+
+  // Longest chain of estimated costs from the start of this task to the end of the
+  // task graph (bottom level), used by the CriticalPath QueueAlg.
+  double getCriticalPathLength() const { return m_critical_path_length; }
+
+  // Recomputes the critical path length from those of the internal dependents and,
+  // for the receivers of this task's MPI messages, from 'taskPathLength' (longest
+  // path of any local instance of their Task).
+  double computeCriticalPathLength( const std::map<const Task*, double> & taskPathLength );
+
 //-----------------------------------------------------------------------------
 #ifdef HAVE_CUDA
 
@@ -291,6 +303,10 @@ private:
   int m_resource_index { -1 };
   int m_static_order   { -1 };
 
+  // measured cost (< 0 until the task has run) and critical path length
+  double m_cost_estimate        { -1.0 };
+  double m_critical_path_length { 0.0 };
+
   // specifies the type of task this is:
   //   * Normal executes on either the patches cells or the patches coarse cells
   //   * Fine   executes on the patches fine cells (for example coarsening)
@@ -44,7 +44,9 @@
   #include <Core/Parallel/CrowdMonitor.hpp>
 #endif
 
+#include <algorithm>
 #include <atomic>
+#include <map>
 #include <sstream>
 #include <string>
 
@@ -74,6 +76,13 @@ namespace {
 #ifdef HAVE_VISIT
   Dout g_message_tags_task_stats_dbg("MessageTagTaskStats", "DetailedTasks", "stats on MPI message tag task assignment", false);
 #endif  
+  Dout g_task_fusion_dbg(           "TaskFusion",          "DetailedTasks", "report tasks run fused behind their prerequisite", false);
+
+  // task fusion - the task whose done() this thread is running, and the dependent
+  //   it made ready that this thread runs next (owned by t_fused_owner)
+  thread_local Uintah::DetailedTask  * t_fusion_prerequisite { nullptr };
+  thread_local Uintah::DetailedTask  * t_fused_task          { nullptr };
+  thread_local Uintah::DetailedTasks * t_fused_owner         { nullptr };
 
 #ifdef HAVE_CUDA
   struct device_transfer_complete_queue_tag{};
@@ -930,17 +939,92 @@ DetailedTasks::getOldDWSendTask( int proc )
 void
 DetailedTasks::internalDependenciesSatisfied( DetailedTask * dtask )
 {
+  if (m_task_fusion && t_fusion_prerequisite != nullptr && t_fused_task == nullptr && canFuse(t_fusion_prerequisite, dtask)) {
+    DOUTR(g_task_fusion_dbg, " Fusing task " << *dtask << " behind " << *t_fusion_prerequisite);
+
+    t_fused_task  = dtask;
+    t_fused_owner = this;
+    return;
+  }
+
   std::lock_guard<Uintah::MasterLock> internal_deps_satisfied_guard(g_internal_ready_mutex);
 
   m_ready_tasks.push(dtask);
   m_atomic_initial_ready_tasks_size.fetch_add(1, std::memory_order_relaxed);
 }
 
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::setFusionPrerequisite( DetailedTask * dtask )
+{
+  t_fusion_prerequisite = m_task_fusion ? dtask : nullptr;
+}
+
+//_____________________________________________________________________________
+//
+bool
+DetailedTasks::canFuse( const DetailedTask * prerequisite
+                      ,       DetailedTask * dtask
+                      ) const
+{
+  const Task* task = dtask->getTask();
+
+  if (!task->isFusible() || task->getType() != Task::Normal || task->usesMPI() || task->usesDevice()) {
+    return false;
+  }
+
+  if (prerequisite->getTask()->getType() != Task::Normal || prerequisite->getTask()->usesDevice()) {
+    return false;
+  }
+
+  // the task must not wait on MPI messages
+  if (!dtask->getRequires().empty()) {
+    return false;
+  }
+
+  const PatchSubset* patches       = dtask->getPatches();
+  const PatchSubset* prereqPatches = prerequisite->getPatches();
+
+  if (patches == nullptr || prereqPatches == nullptr || patches->size() != prereqPatches->size()) {
+    return false;
+  }
+
+  for (int i = 0; i < patches->size(); i++) {
+    if (patches->get(i) != prereqPatches->get(i)) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+//_____________________________________________________________________________
+//
+DetailedTask*
+DetailedTasks::getNextFusedTask()
+{
+  DetailedTask* nextTask = nullptr;
+  if (t_fused_task != nullptr && t_fused_owner == this) {
+    nextTask      = t_fused_task;
+    t_fused_task  = nullptr;
+    t_fused_owner = nullptr;
+  }
+
+  return nextTask;
+}
+
 //_____________________________________________________________________________
 //
 DetailedTask*
 DetailedTasks::getNextInternalReadyTask()
 {
+  // a task fused behind the one this thread just finished goes first
+  DetailedTask* fusedTask = getNextFusedTask();
+  if (fusedTask != nullptr) {
+    return fusedTask;
+  }
+
   std::lock_guard<Uintah::MasterLock> internal_ready_guard(g_internal_ready_mutex);
 
   DetailedTask* nextTask = nullptr;
@@ -987,20 +1071,125 @@ DetailedTasks::getNextExternalReadyTask()
 int
 DetailedTasks::numExternalReadyTasks()
 {
+  if (m_num_workers > 0) {
+    int num_ready = 0;
+    for (int i = 0; i < m_num_workers; ++i) {
+      num_ready += m_worker_queues[i]->m_size.load(std::memory_order_seq_cst);
+    }
+    return num_ready;
+  }
+
   return m_atomic_mpi_completed_tasks_size.load(std::memory_order_seq_cst);
 }
 
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::initWorkStealing( int num_workers )
+{
+  if (num_workers == m_num_workers) {
+    return;
+  }
+
+  m_worker_queues.clear();
+  for (int i = 0; i < num_workers; ++i) {
+    m_worker_queues.push_back(std::unique_ptr<WorkerReadyQueue>(scinew WorkerReadyQueue()));
+  }
+  m_num_workers = num_workers;
+}
+
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::addExternalReadyTask( DetailedTask * dtask )
+{
+  // home the task on the worker that owns its (first) patch so successive tasks on
+  //   the same patch tend to run on the same core; patchless tasks go by static order
+  const PatchSubset* patches = dtask->getPatches();
+  int key = (patches != nullptr && patches->size() > 0) ? patches->get(0)->getID() : dtask->getStaticOrder();
+  int home = (key < 0 ? -key : key) % m_num_workers;
+
+  WorkerReadyQueue& queue = *m_worker_queues[home];
+  std::lock_guard<Uintah::MasterLock> worker_queue_guard(queue.m_lock);
+  queue.m_tasks.push(dtask);
+  queue.m_size.fetch_add(1, std::memory_order_release);
+}
+
+//_____________________________________________________________________________
+//
+DetailedTask*
+DetailedTasks::getNextExternalReadyTask( int worker_id, bool & stolen )
+{
+  stolen = false;
+
+  // visit the own queue first, then neighbours at increasing distance: w+1, w-1, w+2, w-2, ...
+  for (int dist = 0; dist < m_num_workers; ++dist) {
+    for (int sign = 0; sign < ((dist == 0) ? 1 : 2); ++sign) {
+      int victim = (sign == 0) ? worker_id + dist : worker_id - dist;
+      victim = ((victim % m_num_workers) + m_num_workers) % m_num_workers;
+
+      WorkerReadyQueue& queue = *m_worker_queues[victim];
+
+      // avoid taking the lock of an empty queue
+      if (queue.m_size.load(std::memory_order_acquire) > 0) {
+        std::lock_guard<Uintah::MasterLock> worker_queue_guard(queue.m_lock);
+        if (!queue.m_tasks.empty()) {
+          DetailedTask* nextTask = queue.m_tasks.top();
+          queue.m_tasks.pop();
+          queue.m_size.fetch_sub(1, std::memory_order_relaxed);
+          stolen = (dist != 0);
+          return nextTask;
+        }
+      }
+    }
+  }
+
+  return nullptr;
+}
+
 //_____________________________________________________________________________
 //
 void
 DetailedTasks::initTimestep()
 {
+  if (m_task_priority_alg == CriticalPath) {
+    computeCriticalPaths();
+  }
+
   m_ready_tasks = m_initial_ready_tasks;
   m_atomic_initial_ready_tasks_size.store(m_initial_ready_tasks.size(), std::memory_order_release);
   incrementDependencyGeneration();
   initializeBatches();
 }
 
+//_____________________________________________________________________________
+//
+void
+DetailedTasks::computeCriticalPaths()
+{
+  // Local tasks in reverse topological order: a task's internal dependents, and the
+  // local instances of the tasks receiving its MPI messages, come before it.
+  std::vector<DetailedTask*> tasks(m_local_tasks);
+  std::stable_sort(tasks.begin(), tasks.end(), [](const DetailedTask* a, const DetailedTask* b) {
+    return a->getTask()->getSortedOrder() > b->getTask()->getSortedOrder();
+  });
+
+  // Longest path of the local instances of each Task, used for the (remote) receivers
+  // of a task's MPI messages as all ranks run the same task graph.
+  std::map<const Task*, double> taskPathLength;
+  double maxLength = 0.0;
+
+  for (auto dtask : tasks) {
+    double length = dtask->computeCriticalPathLength(taskPathLength);
+
+    double & taskLength = taskPathLength[dtask->getTask()];
+    taskLength = std::max(taskLength, length);
+    maxLength  = std::max(maxLength, length);
+  }
+
+  DOUTR(g_detailed_tasks_dbg, " Critical path length: " << maxLength << " seconds over " << tasks.size() << " local tasks");
+}
+
 //_____________________________________________________________________________
 //
 void
@@ -1162,6 +1351,10 @@ DetailedTaskPriorityComparison::operator()( DetailedTask *& ltask
     }
   }
 
+  else if (alg == CriticalPath) {  // longest estimated path to the end of the task graph first
+    return ltask->getCriticalPathLength() < rtask->getCriticalPathLength();
+  }
+
   else if (alg == PatchOrderRandom) {  // smaller level, larger size, smaller patchID, smaller tasksortID
     const PatchSubset* lpatches = ltask->getPatches();
     const PatchSubset* rpatches = rtask->getPatches();
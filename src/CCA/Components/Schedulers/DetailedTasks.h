@@ -39,6 +39,7 @@
 #include <Core/Grid/Variables/ScrubItem.h>
 
 #include <Core/Lockfree/Lockfree_Pool.hpp>
+#include <Core/Parallel/MasterLock.h>
 
 
 #ifdef HAVE_CUDA
@@ -54,6 +55,7 @@
 #include <vector>
 #include <atomic>
 #include <list>
+#include <memory>
 
 namespace Uintah {
 
@@ -85,6 +87,7 @@ enum QueueAlg {
   , LeastL2Children
   , PatchOrder
   , PatchOrderRandom
+  , CriticalPath
 };
 
 
@@ -182,6 +185,28 @@ public:
 
   int numExternalReadyTasks();
 
+  // work stealing - per-worker external-ready queues, num_workers == 0 disables
+  void initWorkStealing( int num_workers );
+
+  bool usingWorkStealing() const
+  {
+    return m_num_workers > 0;
+  }
+
+  DetailedTask* getNextExternalReadyTask( int worker_id, bool & stolen );
+
+  // task fusion - a fusible dependent made ready by a task's done() is kept for the
+  //   thread that ran that task instead of being queued, see Task::setFusible()
+  void setTaskFusion( bool state ) { m_task_fusion = state; }
+
+  bool usingTaskFusion() const
+  {
+    return m_task_fusion;
+  }
+
+  // The task fused behind the last task this thread finished, if any.
+  DetailedTask* getNextFusedTask();
+
   void createScrubCounts();
 
   bool mustConsiderInternalDependencies()
@@ -304,6 +329,11 @@ protected:
 
   void internalDependenciesSatisfied( DetailedTask * dtask );
 
+  // Set by DetailedTask::done() while it satisfies its dependents.
+  void setFusionPrerequisite( DetailedTask * dtask );
+
+  void addExternalReadyTask( DetailedTask * dtask );
+
   SchedulerCommon* getSchedulerCommon()
   {
     return m_sched_common;
@@ -315,6 +345,11 @@ private:
 
   void incrementDependencyGeneration();
 
+  // CriticalPath - recompute every local task's critical path length from the measured costs
+  void computeCriticalPaths();
+
+  bool canFuse( const DetailedTask * prerequisite, DetailedTask * dtask ) const;
+
   // helper of possiblyCreateDependency
   DetailedDep* findMatchingDetailedDep(       DependencyBatch  * batch
                                       ,       DetailedTask     * toTask
@@ -375,6 +410,20 @@ private:
   std::atomic<int> m_atomic_initial_ready_tasks_size { 0 };
   std::atomic<int> m_atomic_mpi_completed_tasks_size { 0 };
 
+  // Work stealing: each worker owns a priority queue (ordered by the active QueueAlg)
+  // guarded by its own lock. A task is homed on the worker owning its first patch,
+  // and an idle worker steals from its nearest neighbours (adjacent cores) first.
+  struct WorkerReadyQueue {
+    Uintah::MasterLock m_lock{};
+    TaskPQueue         m_tasks{};
+    std::atomic<int>   m_size{0};
+  };
+
+  int                                            m_num_workers { 0 };
+  std::vector<std::unique_ptr<WorkerReadyQueue>> m_worker_queues;
+
+  bool m_task_fusion { false };
+
   // This "generation" number is to keep track of which InternalDependency
   // links have been satisfied in the current timestep and avoids the
   // need to traverse all InternalDependency links to reset values.
@@ -121,6 +121,9 @@ DynamicMPIScheduler::problemSetup( const ProblemSpecP&     prob_spec
     else if (taskQueueAlg == "PatchOrderRandom") {
       m_task_queue_alg = PatchOrderRandom;
     }
+    else if (taskQueueAlg == "CriticalPath") {
+      m_task_queue_alg = CriticalPath;
+    }
     else {
       throw ProblemSetupException("Unknown task ready queue algorithm", __FILE__, __LINE__);
     }
@@ -128,6 +131,8 @@ DynamicMPIScheduler::problemSetup( const ProblemSpecP&     prob_spec
 
   proc0cout << "Using \"" << taskQueueAlg << "\" task queue priority algorithm" << std::endl;
 
+  readCommPlanOptions(prob_spec);
+
   SchedulerCommon::problemSetup(prob_spec, materialManager);
 }
 
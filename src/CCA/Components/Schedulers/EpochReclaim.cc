@@ -0,0 +1,135 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <CCA/Components/Schedulers/EpochReclaim.h>
+
+using namespace Uintah;
+
+std::atomic<uint64_t>                    EpochReclaim::s_epoch   { 0 };
+std::atomic<EpochReclaim::ThreadRecord*> EpochReclaim::s_records { nullptr };
+
+namespace Uintah {
+
+  // hands the record of a thread back when the thread exits
+  struct ThreadRecordOwner {
+    EpochReclaim::ThreadRecord * m_record { nullptr };
+
+    ~ThreadRecordOwner()
+    {
+      if (m_record) {
+        m_record->m_in_use.store(false, std::memory_order_release);
+      }
+    }
+  };
+
+}
+
+namespace {
+
+  thread_local ThreadRecordOwner t_record_owner;
+
+}
+
+//______________________________________________________________________
+//
+EpochReclaim::ThreadRecord*
+EpochReclaim::threadRecord()
+{
+  ThreadRecord* record = t_record_owner.m_record;
+  if (record) {
+    return record;
+  }
+
+  // reuse the record of a thread that has exited
+  for (record = s_records.load(std::memory_order_acquire); record != nullptr; record = record->m_next) {
+    bool in_use = false;
+    if (!record->m_in_use.load(std::memory_order_relaxed) &&
+        record->m_in_use.compare_exchange_strong(in_use, true, std::memory_order_acq_rel)) {
+      break;
+    }
+  }
+
+  if (record == nullptr) {
+    record = new ThreadRecord();
+    record->m_in_use.store(true, std::memory_order_relaxed);
+    record->m_next = s_records.load(std::memory_order_relaxed);
+    while (!s_records.compare_exchange_weak(record->m_next, record, std::memory_order_acq_rel)) {
+      // record->m_next has been reloaded with the current head
+    }
+  }
+
+  t_record_owner.m_record = record;
+  return record;
+}
+
+//______________________________________________________________________
+//
+EpochReclaim::Guard::Guard()
+{
+  ThreadRecord* record = threadRecord();
+  if (record->m_depth++ == 0) {
+    record->m_epoch.store(s_epoch.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+    // the slots are read after the pinned epoch is visible to tryAdvance
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+//______________________________________________________________________
+//
+EpochReclaim::Guard::~Guard()
+{
+  ThreadRecord* record = t_record_owner.m_record;
+  if (--record->m_depth == 0) {
+    record->m_epoch.store(QUIESCENT, std::memory_order_release);
+  }
+}
+
+//______________________________________________________________________
+//
+uint64_t
+EpochReclaim::retireEpoch()
+{
+  // the item was unlinked before the epoch is read
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  return s_epoch.load(std::memory_order_seq_cst);
+}
+
+//______________________________________________________________________
+//
+void
+EpochReclaim::tryAdvance()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  uint64_t epoch = s_epoch.load(std::memory_order_seq_cst);
+  for (ThreadRecord* record = s_records.load(std::memory_order_acquire); record != nullptr; record = record->m_next) {
+    uint64_t pinned = record->m_epoch.load(std::memory_order_seq_cst);
+    if (pinned != QUIESCENT && pinned != epoch) {
+      return;
+    }
+  }
+
+  s_epoch.compare_exchange_strong(epoch, epoch + 1, std::memory_order_acq_rel);
+}
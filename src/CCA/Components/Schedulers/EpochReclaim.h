@@ -0,0 +1,110 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CCA_COMPONENTS_SCHEDULERS_EPOCHRECLAIM_H
+#define CCA_COMPONENTS_SCHEDULERS_EPOCHRECLAIM_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace Uintah {
+
+/**************************************
+
+CLASS
+   EpochReclaim
+
+   Epoch based reclamation of the items DWDatabase unlinks from its
+   slots while other threads may still be reading them.
+
+GENERAL INFORMATION
+
+   EpochReclaim.h
+
+KEYWORDS
+   DWDatabase, lock free, memory reclamation
+
+DESCRIPTION
+   Every thread that reads a shared slot holds a Guard, which pins the
+   thread to the current global epoch.  The epoch is written to a
+   record of the thread's own, on its own cache line, so readers do not
+   share a counter.  Guards nest; only the outermost one pins.
+
+   A writer that unlinks an item stamps it with retireEpoch() and frees
+   it once isSafe() says so.  The global epoch is only advanced by
+   tryAdvance(), once every pinned thread has seen its current value,
+   and an item is safe two epochs after its stamp: by then every thread
+   that was pinned when it was unlinked has left its Guard.  So an item
+   waits for the read sections that were running when it was retired,
+   not for a moment without any reader.
+
+****************************************/
+
+class EpochReclaim {
+
+public:
+
+  class Guard {
+  public:
+    Guard();
+    ~Guard();
+
+    Guard( const Guard & )            = delete;
+    Guard& operator=( const Guard & ) = delete;
+  };
+
+  // Epoch to stamp an item with, called after the item has been unlinked
+  static uint64_t retireEpoch();
+
+  // Advances the global epoch if every pinned thread has seen it
+  static void tryAdvance();
+
+  // Whether no reader can still hold an item stamped with epoch
+  static bool isSafe( uint64_t epoch )
+  {
+    return s_epoch.load(std::memory_order_acquire) >= epoch + 2;
+  }
+
+private:
+
+  static const uint64_t QUIESCENT = ~uint64_t(0);
+
+  struct alignas(64) ThreadRecord {
+    std::atomic<uint64_t>  m_epoch  { QUIESCENT };  // pinned epoch, QUIESCENT outside of a Guard
+    std::atomic<bool>      m_in_use { false };      // owned by a live thread
+    int                    m_depth  { 0 };          // nesting of the Guards, owner thread only
+    ThreadRecord         * m_next   { nullptr };    // records are never freed
+  };
+
+  static ThreadRecord* threadRecord();
+
+  static std::atomic<uint64_t>      s_epoch;
+  static std::atomic<ThreadRecord*> s_records;
+
+  friend struct ThreadRecordOwner;
+};
+
+} // namespace Uintah
+
+#endif // CCA_COMPONENTS_SCHEDULERS_EPOCHRECLAIM_H
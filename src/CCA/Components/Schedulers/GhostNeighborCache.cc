@@ -0,0 +1,352 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <CCA/Components/Schedulers/GhostNeighborCache.h>
+
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Grid/Variables/VarLabel.h>
+
+#include <algorithm>
+#include <mutex>
+
+using namespace Uintah;
+
+namespace {
+
+  // patches whose halo was not checked in this many compiles are forgotten
+  const int MAX_UNCHECKED_COMPILES = 4;
+
+  bool
+  neighborLess( const GhostNeighborCache::Neighbor & a
+              , const GhostNeighborCache::Neighbor & b
+              )
+  {
+    return a.m_patch->getID() < b.m_patch->getID();
+  }
+
+}
+
+//______________________________________________________________________
+//
+bool
+GhostNeighborCache::PatchBox::operator==( const PatchBox & rhs ) const
+{
+  return m_level == rhs.m_level && m_low == rhs.m_low && m_high == rhs.m_high;
+}
+
+//______________________________________________________________________
+//
+size_t
+GhostNeighborCache::PatchBoxHash::operator()( const PatchBox & box ) const
+{
+  size_t hash = box.m_level;
+  hash = hash * 31 + box.m_low.x();
+  hash = hash * 31 + box.m_low.y();
+  hash = hash * 31 + box.m_low.z();
+  hash = hash * 31 + box.m_high.x();
+  hash = hash * 31 + box.m_high.y();
+  hash = hash * 31 + box.m_high.z();
+  return hash;
+}
+
+//______________________________________________________________________
+//
+bool
+GhostNeighborCache::PatchInfo::operator==( const PatchInfo & rhs ) const
+{
+  return m_low            == rhs.m_low            &&
+         m_high           == rhs.m_high           &&
+         m_extra_low      == rhs.m_extra_low      &&
+         m_extra_high     == rhs.m_extra_high     &&
+         m_virtual_offset == rhs.m_virtual_offset &&
+         m_bc_types       == rhs.m_bc_types;
+}
+
+//______________________________________________________________________
+//
+bool
+GhostNeighborCache::Key::operator==( const Key & rhs ) const
+{
+  return m_patch           == rhs.m_patch           &&
+         m_type            == rhs.m_type            &&
+         m_gtype           == rhs.m_gtype           &&
+         m_num_ghost_cells == rhs.m_num_ghost_cells &&
+         m_boundary_layer  == rhs.m_boundary_layer;
+}
+
+//______________________________________________________________________
+//
+size_t
+GhostNeighborCache::KeyHash::operator()( const Key & key ) const
+{
+  size_t hash = PatchBoxHash()(key.m_patch);
+  hash = hash * 31 + key.m_type;
+  hash = hash * 31 + key.m_gtype;
+  hash = hash * 31 + key.m_num_ghost_cells;
+  hash = hash * 31 + key.m_boundary_layer.x();
+  hash = hash * 31 + key.m_boundary_layer.y();
+  hash = hash * 31 + key.m_boundary_layer.z();
+  return hash;
+}
+
+//______________________________________________________________________
+//
+void
+GhostNeighborCache::beginCompile( int halo_width )
+{
+  ++m_compile;
+
+  // a wider halo changes every patch description, start over
+  if (halo_width > m_halo_width) {
+    m_halo_width = halo_width;
+    m_patches.clear();
+    m_entries.clear();
+  }
+
+  m_num_reused          = 0;
+  m_num_found           = 0;
+  m_num_changed_patches = 0;
+  m_num_patches         = 0;
+}
+
+//______________________________________________________________________
+//
+void
+GhostNeighborCache::endCompile()
+{
+  for (auto iter = m_patches.begin(); iter != m_patches.end();) {
+    if (m_compile - iter->second.m_checked >= MAX_UNCHECKED_COMPILES) {
+      iter = m_patches.erase(iter);
+    }
+    else {
+      ++iter;
+    }
+  }
+
+  // Keep the neighbors that may be reused: found in or after the compile
+  // the halo of their patch was last changed in.
+  for (auto iter = m_entries.begin(); iter != m_entries.end();) {
+    auto state = m_patches.find(iter->first.m_patch);
+
+    if (!iter->second.m_reusable || state == m_patches.end() || iter->second.m_compile < state->second.m_valid_since) {
+      iter = m_entries.erase(iter);
+    }
+    else {
+      ++iter;
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+GhostNeighborCache::PatchBox
+GhostNeighborCache::makeBox( const Patch * patch )
+{
+  PatchBox box;
+  box.m_level = patch->getLevel()->getIndex();
+  box.m_low   = patch->getCellLowIndex();
+  box.m_high  = patch->getCellHighIndex();
+  return box;
+}
+
+//______________________________________________________________________
+//
+GhostNeighborCache::Key
+GhostNeighborCache::makeKey( const Patch            * patch
+                           , const Task::Dependency * req
+                           ) const
+{
+  Key key;
+  key.m_patch           = makeBox(patch);
+  key.m_type            = req->m_var->typeDescription()->getType();
+  key.m_gtype           = req->m_gtype;
+  key.m_num_ghost_cells = req->m_num_ghost_cells;
+  key.m_boundary_layer  = req->m_var->getBoundaryLayer();
+  return key;
+}
+
+//______________________________________________________________________
+//
+GhostNeighborCache::PatchState &
+GhostNeighborCache::checkHalo( const Patch * patch )
+{
+  PatchState & state = m_patches[makeBox(patch)];
+
+  if (state.m_checked == m_compile) {
+    return state;
+  }
+
+  const Level * level = patch->getLevel();
+  const IntVector halo(m_halo_width, m_halo_width, m_halo_width);
+
+  const IntVector halo_low  = patch->getExtraCellLowIndex()  - halo;
+  const IntVector halo_high = patch->getExtraCellHighIndex() + halo;
+
+  std::vector<const Patch*> halo_patches;
+  level->selectPatches(halo_low, halo_high, halo_patches);
+
+  std::vector<PatchInfo> halo_info(halo_patches.size());
+  for (size_t i = 0; i < halo_patches.size(); ++i) {
+    const Patch * neighbor = halo_patches[i];
+    PatchInfo   & info     = halo_info[i];
+
+    info.m_low            = neighbor->getCellLowIndex();
+    info.m_high           = neighbor->getCellHighIndex();
+    info.m_extra_low      = neighbor->getExtraCellLowIndex();
+    info.m_extra_high     = neighbor->getExtraCellHighIndex();
+    info.m_virtual_offset = neighbor->getVirtualOffset();
+    info.m_bc_types       = 0;
+    for (int face = Patch::startFace; face <= Patch::endFace; ++face) {
+      info.m_bc_types |= neighbor->getBCType(Patch::FaceType(face)) << (2 * face);
+    }
+  }
+
+  // The ghost regions of patches on non cubic levels are clamped to the
+  // extents of the level.
+  IntVector level_low(0, 0, 0);
+  IntVector level_high(0, 0, 0);
+  const bool non_cubic = level->isNonCubic();
+  if (non_cubic) {
+    level->findCellIndexRange(level_low, level_high);
+  }
+
+  const bool changed = state.m_checked < 0          ||
+                       state.m_non_cubic  != non_cubic  ||
+                       state.m_level_low  != level_low  ||
+                       state.m_level_high != level_high ||
+                       state.m_halo_info  != halo_info;
+
+  if (changed) {
+    state.m_valid_since = m_compile;
+    state.m_non_cubic   = non_cubic;
+    state.m_level_low   = level_low;
+    state.m_level_high  = level_high;
+    state.m_halo_low    = halo_low;
+    state.m_halo_high   = halo_high;
+    state.m_halo_info.swap(halo_info);
+    ++m_num_changed_patches;
+  }
+
+  state.m_halo.swap(halo_patches);
+  state.m_checked = m_compile;
+  ++m_num_patches;
+
+  return state;
+}
+
+//______________________________________________________________________
+//
+const GhostNeighborCache::Neighbors *
+GhostNeighborCache::find( const Patch            * patch
+                        , const Task::Dependency * req
+                        )
+{
+  std::lock_guard<Uintah::MasterLock> cache_lock(m_mutex);
+
+  auto iter = m_entries.find(makeKey(patch, req));
+  if (iter == m_entries.end()) {
+    return nullptr;
+  }
+
+  Entry & entry = iter->second;
+
+  if (entry.m_compile != m_compile) {
+    if (!entry.m_reusable) {
+      return nullptr;
+    }
+
+    const PatchState & state = checkHalo(patch);
+    if (entry.m_compile < state.m_valid_since) {
+      return nullptr;
+    }
+
+    // same halo as when the neighbors were found, use the patches of the
+    // current grid, in the order the dependencies are created for them
+    for (auto & neighbor : entry.m_neighbors) {
+      neighbor.m_patch = state.m_halo[neighbor.m_halo];
+    }
+    std::sort(entry.m_neighbors.begin(), entry.m_neighbors.end(), neighborLess);
+    entry.m_compile = m_compile;
+  }
+
+  ++m_num_reused;
+
+  return &entry.m_neighbors;
+}
+
+//______________________________________________________________________
+//
+const GhostNeighborCache::Neighbors &
+GhostNeighborCache::insert( const Patch            * patch
+                          , const Task::Dependency * req
+                          , const IntVector        & low
+                          , const IntVector        & high
+                          ,       Neighbors        & neighbors
+                          )
+{
+  std::lock_guard<Uintah::MasterLock> cache_lock(m_mutex);
+
+  Entry & entry = m_entries[makeKey(patch, req)];
+
+  // another thread found them first
+  if (entry.m_compile == m_compile) {
+    return entry.m_neighbors;
+  }
+
+  const PatchState & state = checkHalo(patch);
+
+  // The neighbors can be reused by later compiles if they were selected
+  // from within the halo, so any change to them changes the halo.
+  bool reusable = (low  == Max(low,  state.m_halo_low) &&
+                   high == Min(high, state.m_halo_high));
+
+  for (size_t i = 0; i < neighbors.size(); ++i) {
+    Neighbor & neighbor = neighbors[i];
+
+    // The order of patches with the same id (virtual patches of the same
+    // real patch) cannot be restored in another grid.
+    if (i > 0 && neighbor.m_patch->getID() == neighbors[i-1].m_patch->getID()) {
+      reusable = false;
+    }
+
+    auto pos = std::find(state.m_halo.begin(), state.m_halo.end(), neighbor.m_patch);
+
+    if (pos == state.m_halo.end()) {
+      neighbor.m_halo = -1;
+      reusable = false;
+    }
+    else {
+      neighbor.m_halo = pos - state.m_halo.begin();
+    }
+  }
+
+  entry.m_compile  = m_compile;
+  entry.m_reusable = reusable;
+  entry.m_neighbors.swap(neighbors);
+
+  ++m_num_found;
+
+  return entry.m_neighbors;
+}
@@ -0,0 +1,215 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CCA_COMPONENTS_SCHEDULERS_GHOSTNEIGHBORCACHE_H
+#define CCA_COMPONENTS_SCHEDULERS_GHOSTNEIGHBORCACHE_H
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Task.h>
+#include <Core/Parallel/MasterLock.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace Uintah {
+
+class Patch;
+
+/**************************************
+
+CLASS
+   GhostNeighborCache
+
+   Keeps the ghost cell neighbors found by
+   TaskGraph::createDetailedDependencies between task graph compiles.
+
+GENERAL INFORMATION
+
+   GhostNeighborCache.h
+
+KEYWORDS
+   TaskGraph, ghost neighbors, regrid
+
+DESCRIPTION
+   For every (patch, requires) pair createDetailedDependencies computes
+   the ghost region of the requires, selects the patches overlapping
+   it and intersects the region with each of them.  The result only
+   depends on the grid around the patch and on the basis, boundary
+   layer and ghost cells of the variable, so it is shared by all the
+   requires with the same ghost specification and, as long as the
+   patches around the patch do not change, by the following compiles.
+
+   Each patch keeps a description (extents, extra cells, face boundary
+   types) of the patches within a halo of "halo width" cells around it.
+   Patches of different grids are matched by their cells, as a regrid
+   renumbers all of them.  When the description is the same as in the
+   compile the neighbors were found in, they are reused (with the
+   patches of the new grid, in patch id order as Level::selectPatches
+   returns them); otherwise they are found again.  So after a regrid
+   only the patches in and next to the refined/coarsened regions are
+   searched again, and after a load balancer change none of them (which
+   patches are in the neighborhood of this rank is checked by the
+   caller on every compile).
+
+   Requires on the coarser or finer level are not cached.
+
+   find() and insert() may be called by several threads at once; the
+   neighbors they return do not change until endCompile().
+
+****************************************/
+
+class GhostNeighborCache {
+
+  public:
+
+    struct Neighbor {
+      const Patch * m_patch;  // patch selected for the ghost cells, may be virtual
+      IntVector     m_low;    // region needed, in the index space of the real patch
+      IntVector     m_high;
+      int           m_halo;   // position of m_patch in the halo of the patch, -1 if outside
+    };
+
+    using Neighbors = std::vector<Neighbor>;
+
+    GhostNeighborCache() = default;
+    ~GhostNeighborCache() = default;
+
+    /// Starts a compile of a task graph on the current grid.  The halo
+    /// width must cover the ghost cells of the requires that are to be
+    /// reused by later compiles; it only grows.
+    void beginCompile( int halo_width );
+
+    /// Drops the neighbors that cannot be reused anymore.
+    void endCompile();
+
+    /// The neighbors of patch for the ghost cells of req, nullptr if they
+    /// have to be found.
+    const Neighbors * find( const Patch            * patch
+                          , const Task::Dependency * req
+                          );
+
+    /// Stores the neighbors found for patch and req.  low and high are
+    /// the ghost region the neighbors were selected with.
+    const Neighbors & insert( const Patch            * patch
+                            , const Task::Dependency * req
+                            , const IntVector        & low
+                            , const IntVector        & high
+                            ,       Neighbors        & neighbors
+                            );
+
+    // statistics of the last compile
+    int numReused()         const { return m_num_reused; }
+    int numFound()          const { return m_num_found; }
+    int numChangedPatches() const { return m_num_changed_patches; }
+    int numPatches()        const { return m_num_patches; }
+
+  private:
+
+    // eliminate copy, assignment and move
+    GhostNeighborCache( const GhostNeighborCache & )            = delete;
+    GhostNeighborCache& operator=( const GhostNeighborCache & ) = delete;
+    GhostNeighborCache( GhostNeighborCache && )                 = delete;
+    GhostNeighborCache& operator=( GhostNeighborCache && )      = delete;
+
+    // A regrid gives new ids to all of the patches, the patches of two
+    // grids are matched by their level and cells.
+    struct PatchBox {
+      int       m_level;
+      IntVector m_low;
+      IntVector m_high;
+
+      bool operator==( const PatchBox & rhs ) const;
+    };
+
+    struct PatchBoxHash {
+      size_t operator()( const PatchBox & box ) const;
+    };
+
+    // what createDetailedDependencies needs to know about a patch in the halo
+    struct PatchInfo {
+      IntVector m_low;
+      IntVector m_high;
+      IntVector m_extra_low;
+      IntVector m_extra_high;
+      IntVector m_virtual_offset;
+      int       m_bc_types;
+
+      bool operator==( const PatchInfo & rhs ) const;
+    };
+
+    struct PatchState {
+      int                         m_checked{-1};      // compile the halo was last checked in
+      int                         m_valid_since{-1};  // first compile with the current halo
+      bool                        m_non_cubic{false};
+      IntVector                   m_level_low;
+      IntVector                   m_level_high;
+      IntVector                   m_halo_low;
+      IntVector                   m_halo_high;
+      std::vector<PatchInfo>      m_halo_info;
+      std::vector<const Patch*>   m_halo;             // patches of the current grid
+    };
+
+    struct Key {
+      PatchBox  m_patch;
+      int       m_type;
+      int       m_gtype;
+      int       m_num_ghost_cells;
+      IntVector m_boundary_layer;
+
+      bool operator==( const Key & rhs ) const;
+    };
+
+    struct KeyHash {
+      size_t operator()( const Key & key ) const;
+    };
+
+    struct Entry {
+      int       m_compile{-1};
+      bool      m_reusable{false};
+      Neighbors m_neighbors;
+    };
+
+    PatchState & checkHalo( const Patch * patch );
+
+    static PatchBox makeBox( const Patch * patch );
+
+    Key makeKey( const Patch * patch, const Task::Dependency * req ) const;
+
+    std::unordered_map<PatchBox, PatchState, PatchBoxHash> m_patches;
+    std::unordered_map<Key, Entry, KeyHash>                m_entries;
+
+    Uintah::MasterLock m_mutex{};
+
+    int m_compile{0};
+    int m_halo_width{0};
+
+    int m_num_reused{0};
+    int m_num_found{0};
+    int m_num_changed_patches{0};
+    int m_num_patches{0};
+};
+
+} // namespace Uintah
+
+#endif // CCA_COMPONENTS_SCHEDULERS_GHOSTNEIGHBORCACHE_H
@@ -146,6 +146,9 @@ KokkosOpenMPScheduler::problemSetup( const ProblemSpecP     & prob_spec
     else if (taskQueueAlg == "PatchOrderRandom") {
       m_task_queue_alg = PatchOrderRandom;
     }
+    else if (taskQueueAlg == "CriticalPath") {
+      m_task_queue_alg = CriticalPath;
+    }
     else {
       throw ProblemSetupException("Unknown task ready queue algorithm", __FILE__, __LINE__);
     }
@@ -157,6 +160,8 @@ KokkosOpenMPScheduler::problemSetup( const ProblemSpecP     & prob_spec
     std::cout << "   WARNING: Kokkos-OpenMP Scheduler is EXPERIMENTAL, not all tasks are Kokkos-enabled yet." << std::endl;
   }
 
+  readCommPlanOptions(prob_spec);
+
   SchedulerCommon::problemSetup(prob_spec, materialManager);
 }
 
@@ -39,6 +39,7 @@
 #include <Core/Malloc/Allocator.h>
 #include <Core/Parallel/CommunicationList.hpp>
 #include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/Parallel.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/Parallel/UintahMPI.h>
 #include <Core/Util/DOUT.hpp>
@@ -103,6 +104,7 @@ namespace {
   Dout g_reductions(   "ReductionTasks"         , "MPIScheduler", "rank-0 reports each reduction task", false );
   Dout g_time_out(     "MPIScheduler_TimingsOut", "MPIScheduler", "write MPI timing files: timingstats.avg, timingstats.max", false );
   Dout g_task_level(   "TaskLevel"              , "MPIScheduler", "output task name and each level's beginning patch when done", false );
+  Dout g_comm_plan_stats( "MPIScheduler_CommPlanStats", "MPIScheduler", "persistent communication plan restarts, rebuilds and MPI post times", false );
 
 }
 
@@ -159,6 +161,8 @@ MPIScheduler::~MPIScheduler()
     m_max_stats.close();
   }
 
+  clearCommPlans();
+
 #ifdef UINTAH_ENABLE_KOKKOS
   Kokkos::finalize();
 #endif //UINTAH_ENABLE_KOKKOS
@@ -172,9 +176,54 @@ MPIScheduler::problemSetup( const ProblemSpecP     & prob_spec
                           , const MaterialManagerP & materialManager
                           )
 {
+  readCommPlanOptions(prob_spec);
+  readTaskFusionOptions(prob_spec);
+
   SchedulerCommon::problemSetup(prob_spec, materialManager);
 }
 
+//______________________________________________________________________
+//
+void
+MPIScheduler::readCommPlanOptions( const ProblemSpecP & prob_spec )
+{
+  ProblemSpecP params = prob_spec->findBlock("Scheduler");
+  if (params) {
+    params->getWithDefault("persistentComm", m_persistent_comm, false);
+  }
+
+#ifndef USE_PACKING
+  if (m_persistent_comm) {
+    proc0cout << "WARNING: persistent communication plans require packed MPI messages (USE_PACKING), ignoring <persistentComm>\n";
+    m_persistent_comm = false;
+  }
+#endif
+
+  if (m_persistent_comm) {
+    proc0cout << "Using persistent MPI communication plans" << std::endl;
+  }
+}
+
+//______________________________________________________________________
+//
+void
+MPIScheduler::readTaskFusionOptions( const ProblemSpecP & prob_spec )
+{
+  ProblemSpecP params = prob_spec->findBlock("Scheduler");
+  if (params) {
+    params->getWithDefault("taskFusion", m_task_fusion, false);
+  }
+
+  if (m_task_fusion && Uintah::Parallel::usingDevice()) {
+    proc0cout << "WARNING: task fusion is not supported with GPU tasks, ignoring <taskFusion>\n";
+    m_task_fusion = false;
+  }
+
+  if (m_task_fusion) {
+    proc0cout << "Running fusible tasks fused behind their prerequisite" << std::endl;
+  }
+}
+
 //______________________________________________________________________
 //
 SchedulerP
@@ -184,6 +233,7 @@ MPIScheduler::createSubScheduler()
 
   newsched->setComponents( this );
   newsched->m_materialManager = m_materialManager;
+  newsched->m_persistent_comm = m_persistent_comm;
   
   newsched->m_num_schedulers +=1;
   m_num_schedulers +=1;
@@ -389,8 +439,15 @@ MPIScheduler::postMPISends( DetailedTask * dtask
     // Prepare to send a message
 #ifdef USE_PACKING
     PackBufferInfo mpibuff;
+
+    // with a persistent plan the batch's previous buffer is packed again
+    CommChannel* channel = m_persistent_comm ? getCommChannel(batch, true) : nullptr;
+    if (channel) {
+      mpibuff.setPackedBuffer(channel->m_buffer);
+    }
 #else
     BufferInfo mpibuff;
+    CommChannel* channel = nullptr;
 #endif
 
     // Create the MPI type
@@ -505,7 +562,12 @@ MPIScheduler::postMPISends( DetailedTask * dtask
       // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
       //---------------------------------------------------------------------------
       CommRequestPool::iterator comm_sends_iter = m_sends.emplace(new SendHandle(mpibuff.takeSendlist()));
-      Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+      if (channel) {
+        startCommChannel(channel, true, mpibuff, buf, count, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+      }
+      else {
+        Uintah::MPI::Isend(buf, count, datatype, to, batch->m_message_tag, my_comm, comm_sends_iter->request());
+      }
       comm_sends_iter.clear();
       //---------------------------------------------------------------------------
 
@@ -599,8 +661,15 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
 #ifdef USE_PACKING
       p_mpibuff = scinew PackBufferInfo();
       PackBufferInfo& mpibuff = *p_mpibuff;
+
+      // with a persistent plan the batch's previous buffer is received into again
+      CommChannel* channel = m_persistent_comm ? getCommChannel(batch, false) : nullptr;
+      if (channel) {
+        mpibuff.setPackedBuffer(channel->m_buffer);
+      }
 #else
         BufferInfo mpibuff;
+        CommChannel* channel = nullptr;
 #endif
 
       // Create the MPI type
@@ -705,7 +774,12 @@ void MPIScheduler::postMPIRecvs( DetailedTask * dtask
         // New way of managing single MPI requests - avoids MPI_Waitsome & MPI_Donesome - APH 07/20/16
         //---------------------------------------------------------------------------
         CommRequestPool::iterator comm_recvs_iter = m_recvs.emplace(new RecvHandle(p_mpibuff, pBatchRecvHandler));
-        Uintah::MPI::Irecv(buf, count, datatype, from, batch->m_message_tag, my_comm, comm_recvs_iter->request());
+        if (channel) {
+          startCommChannel(channel, false, mpibuff, buf, count, from, batch->m_message_tag, my_comm, comm_recvs_iter->request());
+        }
+        else {
+          Uintah::MPI::Irecv(buf, count, datatype, from, batch->m_message_tag, my_comm, comm_recvs_iter->request());
+        }
         comm_recvs_iter.clear();
         //---------------------------------------------------------------------------
 
@@ -847,6 +921,7 @@ MPIScheduler::execute( int tgnum     /* = 0 */
     (*m_runtimeStats)[NumTasks] += ntasks;
                    
   dts->initializeScrubs(m_dws, m_dwmap);
+  dts->setTaskFusion(m_task_fusion);
   dts->initTimestep();
 
   for (int i = 0; i < ntasks; i++) {
@@ -993,6 +1068,10 @@ MPIScheduler::execute( int tgnum     /* = 0 */
     outputTimingStats( "MPIScheduler" );
   }
 
+  if (m_parent_scheduler == nullptr) {
+    reportCommPlanStats();
+  }
+
   RuntimeStats::report(d_myworld->getComm());
 
 } // end execute()
@@ -1201,6 +1280,147 @@ MPIScheduler::outputTimingStats( const char* label )
   }
 }
 
+//______________________________________________________________________
+//  The persistent channel of a batch, created on first use.  Channels
+//  live in std::maps so the pointers stay valid until clearCommPlans().
+MPIScheduler::CommChannel*
+MPIScheduler::getCommChannel( DependencyBatch * batch
+                            , bool              send
+                            )
+{
+  std::lock_guard<Uintah::MasterLock> plan_lock(m_comm_plan_lock);
+
+  return send ? &m_send_channels[batch] : &m_recv_channels[batch];
+}
+
+//______________________________________________________________________
+//  Restart the persistent request of a channel for the packed message
+//  in 'mpibuff', (re)creating the request when the buffer or the message
+//  size changed.  'request' is the slot of the CommRequestPool entry.
+void
+MPIScheduler::startCommChannel( CommChannel    * channel
+                              , bool             send
+                              , PackBufferInfo & mpibuff
+                              , void           * buf
+                              , int              count
+                              , int              peer
+                              , int              tag
+                              , MPI_Comm         comm
+                              , MPI_Request    * request
+                              )
+{
+  PackedBuffer* buffer = mpibuff.getPackedBuffer();
+
+  // sub-scheduler plans are counted by the top level scheduler
+  MPIScheduler* top = this;
+  while (top->m_parent_scheduler) {
+    top = top->m_parent_scheduler;
+  }
+
+  if (channel->m_request == MPI_REQUEST_NULL || channel->m_buffer != buffer || channel->m_count != count) {
+    Timers::Simple setup_timer;
+    setup_timer.start();
+
+    if (channel->m_request != MPI_REQUEST_NULL) {
+      Uintah::MPI::Request_free(&channel->m_request);
+    }
+
+    if (channel->m_buffer != buffer) {
+      buffer->addReference();
+      if (channel->m_buffer && channel->m_buffer->removeReference()) {
+        delete channel->m_buffer;
+      }
+      channel->m_buffer = buffer;
+    }
+
+    channel->m_count = count;
+
+    if (send) {
+      Uintah::MPI::Send_init(buf, count, MPI_PACKED, peer, tag, comm, &channel->m_request);
+    }
+    else {
+      Uintah::MPI::Recv_init(buf, count, MPI_PACKED, peer, tag, comm, &channel->m_request);
+    }
+
+    top->m_comm_plan_rebuilds++;
+    top->m_comm_plan_setup_time += static_cast<int64_t>(setup_timer());
+  }
+  else {
+    top->m_comm_plan_starts++;
+  }
+
+  // MPI handles are references - the pool's copy tests/waits on the
+  // same (persistent) request, which stays allocated once complete.
+  *request = channel->m_request;
+  Uintah::MPI::Start(request);
+}
+
+//______________________________________________________________________
+//  Free all persistent requests and their buffers.  No request may be
+//  active, i.e. this is called between task graph executions.
+void
+MPIScheduler::clearCommPlans()
+{
+  std::lock_guard<Uintah::MasterLock> plan_lock(m_comm_plan_lock);
+
+  for (auto channels : { &m_send_channels, &m_recv_channels }) {
+    for (auto & entry : *channels) {
+      CommChannel & channel = entry.second;
+
+      if (channel.m_request != MPI_REQUEST_NULL) {
+        Uintah::MPI::Request_free(&channel.m_request);
+      }
+      if (channel.m_buffer && channel.m_buffer->removeReference()) {
+        delete channel.m_buffer;
+      }
+    }
+    channels->clear();
+  }
+}
+
+//______________________________________________________________________
+//  Report the plan counters with the time spent posting sends and
+//  receives, to compare runs with and without persistent plans.
+void
+MPIScheduler::reportCommPlanStats()
+{
+  if (!g_comm_plan_stats) {
+    return;
+  }
+
+  const int64_t num_starts   = m_comm_plan_starts.exchange(0);
+  const int64_t num_rebuilds = m_comm_plan_rebuilds.exchange(0);
+  const int64_t setup_time   = m_comm_plan_setup_time.exchange(0);
+  const int64_t send_time    = static_cast<int64_t>(m_mpi_info[TotalSend] * 1.0e9);
+  const int64_t recv_time    = static_cast<int64_t>(m_mpi_info[TotalRecv] * 1.0e9);
+
+  RuntimeStats::register_report( g_comm_plan_stats
+                               , "Count: PlanStarts"
+                               , RuntimeStats::Count
+                               , [num_starts]() { return num_starts; }
+                               );
+  RuntimeStats::register_report( g_comm_plan_stats
+                               , "Count: PlanRebuilds"
+                               , RuntimeStats::Count
+                               , [num_rebuilds]() { return num_rebuilds; }
+                               );
+  RuntimeStats::register_report( g_comm_plan_stats
+                               , "Time: PlanSetup"
+                               , RuntimeStats::Time
+                               , [setup_time]() { return setup_time; }
+                               );
+  RuntimeStats::register_report( g_comm_plan_stats
+                               , "Time: PostSends"
+                               , RuntimeStats::Time
+                               , [send_time]() { return send_time; }
+                               );
+  RuntimeStats::register_report( g_comm_plan_stats
+                               , "Time: PostRecvs"
+                               , RuntimeStats::Time
+                               , [recv_time]() { return recv_time; }
+                               );
+}
+
 //______________________________________________________________________
 //  Take the various timers and compute the net results
 void MPIScheduler::computeNetRuntimeStats()
@@ -31,10 +31,14 @@
 #include <CCA/Ports/DataWarehouseP.h>
 
 #include <Core/Parallel/CommunicationList.hpp>
+#include <Core/Parallel/MasterLock.h>
+#include <Core/Parallel/PackBufferInfo.h>
 #include <Core/Util/InfoMapper.h>
 #include <Core/Util/Timers/Timers.hpp>
 
+#include <atomic>
 #include <fstream>
+#include <map>
 #include <vector>
 
 namespace Uintah {
@@ -91,6 +95,10 @@ class MPIScheduler : public SchedulerCommon {
     void compile() {
       m_num_messages   = 0;
       m_message_volume = 0;
+
+      // the dependency batches are rebuilt - drop their persistent requests
+      clearCommPlans();
+
       SchedulerCommon::compile();
     }
 
@@ -130,6 +138,55 @@ class MPIScheduler : public SchedulerCommon {
 
     void outputTimingStats( const char* label );
 
+    // Persistent communication plans - <persistentComm>true</persistentComm>
+    //
+    // The messages of a DependencyBatch are the same each time a compiled
+    // task graph executes, so instead of posting a fresh Isend/Irecv the
+    // packed buffer and an MPI persistent request are kept per batch and
+    // restarted.  A channel is rebuilt when its message size changes
+    // (particles, output timesteps, first vs. subsequent iterations) and
+    // all are dropped when the task graphs are recompiled (regrid, load
+    // balancing).
+    struct CommChannel {
+      MPI_Request    m_request{MPI_REQUEST_NULL};
+      PackedBuffer * m_buffer{nullptr};
+      int            m_count{0};
+    };
+
+    void readCommPlanOptions( const ProblemSpecP & prob_spec );
+
+    CommChannel * getCommChannel( DependencyBatch * batch, bool send );
+
+    void startCommChannel( CommChannel    * channel
+                         , bool             send
+                         , PackBufferInfo & mpibuff
+                         , void           * buf
+                         , int              count
+                         , int              peer
+                         , int              tag
+                         , MPI_Comm         comm
+                         , MPI_Request    * request
+                         );
+
+    void clearCommPlans();
+
+    void reportCommPlanStats();
+
+    bool                        m_persistent_comm{false};
+
+    std::map<const DependencyBatch*, CommChannel> m_send_channels;
+    std::map<const DependencyBatch*, CommChannel> m_recv_channels;
+    Uintah::MasterLock                            m_comm_plan_lock{};
+
+    // Task fusion (<taskFusion>), see Task::setFusible()
+    void readTaskFusionOptions( const ProblemSpecP & prob_spec );
+
+    bool                        m_task_fusion{false};
+
+    std::atomic<int64_t>        m_comm_plan_starts{0};    // restarted persistent requests
+    std::atomic<int64_t>        m_comm_plan_rebuilds{0};  // (re)created persistent requests
+    std::atomic<int64_t>        m_comm_plan_setup_time{0};  // ns
+
     CommRequestPool             m_sends{};
     CommRequestPool             m_recvs{};
 
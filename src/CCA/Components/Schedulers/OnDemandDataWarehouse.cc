@@ -2791,7 +2791,14 @@ OnDemandDataWarehouse::emit(       OutputContext & oc
         break;
       }
 
-      case TypeDescription::ParticleVariable :
+      case TypeDescription::ParticleVariable : {
+        if (m_var_DB.exists(label, matlIndex, patch)) {
+          var = m_var_DB.get(label, matlIndex, patch);
+          oc.numParticles = dynamic_cast<ParticleVariableBase*>(var)->getParticleSubset()->numParticles();
+        }
+        break;
+      }
+
       case TypeDescription::PerPatch :
       default : {
         if (m_var_DB.exists(label, matlIndex, patch)) {
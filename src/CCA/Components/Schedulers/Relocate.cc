@@ -31,7 +31,9 @@
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/ProgressiveWarning.h>
 
+#include <algorithm>
 #include <map>
+#include <numeric>
 #include <set>
 
 #define RELOCATE_TAG            0x3fff
@@ -60,6 +62,120 @@ Relocate::~Relocate()
   }
 }
 
+//______________________________________________________________________
+//
+namespace {
+
+  // Spreads the low 21 bits of x over every third bit
+  uint64_t spreadBits( uint64_t x )
+  {
+    x &= 0x1fffff;
+    x = (x | x << 32) & 0x1f00000000ffffULL;
+    x = (x | x << 16) & 0x1f0000ff0000ffULL;
+    x = (x | x <<  8) & 0x100f00f00f00f00fULL;
+    x = (x | x <<  4) & 0x10c30c30c30c30c3ULL;
+    x = (x | x <<  2) & 0x1249249249249249ULL;
+    return x;
+  }
+}
+
+//______________________________________________________________________
+//
+bool
+Relocate::findParticleOrder( const Patch                      * patch,
+                             const ParticleVariable<Point>    & pos,
+                                   SortOrder                    sortOrder,
+                                   std::vector<particleIndex> & order )
+{
+  ParticleSubset* pset = pos.getParticleSubset();
+  // pset is the subset relocation created for the patch, the particles
+  // are 0, 1, ..., numParticles-1
+  const int numParticles = pset->numParticles();
+
+  const Level* level = patch->getLevel();
+  const IntVector low  = patch->getExtraCellLowIndex();
+  const IntVector high = patch->getExtraCellHighIndex() - IntVector(1,1,1);
+  const IntVector size = high - low + IntVector(1,1,1);
+
+  std::vector<uint64_t> keys(numParticles);
+  bool sorted = true;
+
+  for (int i = 0; i < numParticles; i++) {
+    // Particles just outside of the patch (extra cells) go with the nearest cell
+    IntVector c = Max(Min(level->getCellIndex(pos[i]), high), low) - low;
+
+    if (sortOrder == MortonOrder) {
+      keys[i] = spreadBits(c.x()) | spreadBits(c.y()) << 1 | spreadBits(c.z()) << 2;
+    }
+    else {
+      keys[i] = ((uint64_t)c.z() * size.y() + c.y()) * size.x() + c.x();
+    }
+
+    if (i > 0 && keys[i] < keys[i-1]) {
+      sorted = false;
+    }
+  }
+
+  if (sorted) {
+    return false;
+  }
+
+  // The particles of a cell keep their relative order
+  order.resize(numParticles);
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&keys](particleIndex a, particleIndex b) { return keys[a] < keys[b]; });
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+Relocate::sortParticles( const Patch                              * patch,
+                               int                                  matl,
+                               ParticleSubset                     * pset,
+                               ParticleVariableBase              *& pos,
+                               std::vector<ParticleVariableBase*> & vars ) const
+{
+  ParticleVariable<Point>* px = dynamic_cast<ParticleVariable<Point>*>(pos);
+  if (px == nullptr) {
+    return;
+  }
+
+  std::vector<particleIndex> order;
+  if (!findParticleOrder(patch, *px, m_sort_order, order)) {
+    return;
+  }
+
+  // Gather every variable through the permutation
+  ParticleSubset* orderset = scinew ParticleSubset(0, matl, patch);
+  orderset->resize(order.size());
+  for (size_t i = 0; i < order.size(); i++) {
+    orderset->set(i, order[i]);
+  }
+
+  std::vector<ParticleSubset*>       subsets(1, orderset);
+  std::vector<ParticleVariableBase*> srcs(1);
+
+  srcs[0] = pos;
+  ParticleVariableBase* sortedpos = pos->clone();
+  sortedpos->gather(pset, subsets, srcs);
+  delete pos;
+  pos = sortedpos;
+
+  for (size_t v = 0; v < vars.size(); v++) {
+    srcs[0] = vars[v];
+    ParticleVariableBase* sortedvar = vars[v]->clone();
+    sortedvar->gather(pset, subsets, srcs);
+    delete vars[v];
+    vars[v] = sortedvar;
+  }
+
+  delete orderset;
+
+  DOUTR(g_reloc_dbg1, "Relocate: sorted " << order.size() << " particles of patch " << patch->getID() << " matl " << matl);
+}
+
 //______________________________________________________________________
 //
 namespace Uintah {
@@ -954,6 +1070,10 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
     printTask(patches, patches->get(0),g_reloc,"Relocate::relocateParticlesModifies");
     int me = pg->myRank();
 
+    // Put the particles in spatial order every m_sort_interval relocations
+    const int relocation = ++m_num_relocations;
+    bool sortNow = m_sort_interval > 0 && relocation % m_sort_interval == 0;
+
     // First pass: For each of the patches we own, look for particles
     // that left the patch.  Create a scatter record for each one.
     MPIScatterRecords scatter_records;
@@ -1169,7 +1289,7 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
 
         //__________________________________
         // Particles haven't moved, carry the old data forward
-        if(recvs == 0 && subsets.size() == 1 && keep_pset == orig_pset && !adding_new_particles){
+        if(recvs == 0 && subsets.size() == 1 && keep_pset == orig_pset && !adding_new_particles && !sortNow){
           // carry forward old data
           new_dw->saveParticleSubset(orig_pset, matl, toPatch);
 
@@ -1310,6 +1430,10 @@ Relocate::relocateParticlesModifies( const ProcessorGroup* pg,
           newsubset->sort(vars[v] /* particleID variable */);
 #endif
 
+          if(sortNow){
+            sortParticles(toPatch, matl, newsubset, newpos, vars);
+          }
+
           // Put the data back in the data warehouse
           new_dw->put(*newpos, m_reloc_new_posLabel);
 
@@ -1368,6 +1492,10 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
     printTask(patches, patches->get(0),g_reloc,"Relocate::relocateParticles");
     int me = pg->myRank();
 
+    // Put the particles in spatial order every m_sort_interval relocations
+    const int relocation = ++m_num_relocations;
+    bool sortNow = m_sort_interval > 0 && relocation % m_sort_interval == 0;
+
     // First pass: For each of the patches we own, look for particles
     // that left the patch.  Create a scatter record for each of the patches
     MPIScatterRecords scatter_records;
@@ -1594,7 +1722,7 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
         //__________________________________
         // Particles haven't moved, carry the old data forward
         if(recvs == 0 && subsets.size() == 1 &&
-           keep_pset == orig_pset && !adding_new_particles){
+           keep_pset == orig_pset && !adding_new_particles && !sortNow){
           // carry forward old data
           new_dw->saveParticleSubset(orig_pset, matl, toPatch);
 
@@ -1745,6 +1873,10 @@ Relocate::relocateParticles(const ProcessorGroup* pg,
           newsubset->sort(vars[v] /* particleID variable */);
 #endif
 
+          if(sortNow){
+            sortParticles(toPatch, matl, newsubset, newpos, vars);
+          }
+
           // Put the data back in the data warehouse
           new_dw->put(*newpos, m_reloc_new_posLabel);
 
@@ -28,8 +28,10 @@
 #include <Core/Grid/LevelP.h>
 #include <Core/Grid/Patch.h>
 #include <Core/Grid/Variables/ComputeSet.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
 #include <Core/Parallel/UintahMPI.h>
 
+#include <atomic>
 #include <vector>
 
 namespace Uintah {
@@ -62,6 +64,12 @@ KEYWORDS
 
 DESCRIPTION
    Long description...
+
+   Every "particle sort interval" relocations the merged particles of
+   each patch and material are also put in spatial order (by cell, or
+   by the Morton key of the cell), so that the particle loops of the
+   following timesteps visit the grid in order.  The permutation is
+   applied to all of the relocated variables while they are merged.
   
 WARNING
   
@@ -73,6 +81,12 @@ class Relocate {
 
   public:
 
+    // Order of the particles of a patch after a sort
+    enum SortOrder {
+      CellOrder,       // cell index, x fastest as in the grid variables
+      MortonOrder      // Morton (Z-order) key of the cell index
+    };
+
     Relocate(){};
 
     virtual ~Relocate();
@@ -102,6 +116,22 @@ class Relocate {
 
     const MaterialSet* getMaterialSet() const { return m_reloc_matls;}
 
+    //////////
+    // Sort the particles every 'interval' relocations (0 = never)
+    void setParticleSort( int interval, SortOrder order )
+    {
+      m_sort_interval = interval;
+      m_sort_order    = order;
+    }
+
+    //////////
+    // Fills 'order' with the indices of the particles of 'pos' (all of the
+    // particles of 'patch') in sorted order, returns false if they already are.
+    static bool findParticleOrder( const Patch                      * patch,
+                                   const ParticleVariable<Point>    & pos,
+                                         SortOrder                    sortOrder,
+                                         std::vector<particleIndex> & order );
+
 
   private:
 
@@ -140,6 +170,12 @@ class Relocate {
    
     void finalizeCommunication();
 
+    void sortParticles( const Patch                              * patch,
+                              int                                  matl,
+                              ParticleSubset                     * pset,
+                              ParticleVariableBase              *& pos,
+                              std::vector<ParticleVariableBase*> & vars ) const;
+
     const VarLabel                             * m_reloc_old_posLabel{ nullptr };
     std::vector<std::vector<const VarLabel*> >   m_reloc_old_labels;
     const VarLabel                             * m_reloc_new_posLabel{ nullptr };
@@ -151,6 +187,10 @@ class Relocate {
     std::vector<char*>                          m_send_buffers;
     std::vector<MPI_Request>                    m_send_requests;
 
+    int                                         m_sort_interval{ 0 };
+    SortOrder                                   m_sort_order{ MortonOrder };
+    std::atomic<int>                            m_num_relocations{ 0 };
+
 };
 
 } // End namespace Uintah
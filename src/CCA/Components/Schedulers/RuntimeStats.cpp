@@ -101,7 +101,7 @@ void RuntimeStats::register_report( Dout const& dout
                                   , std::function<void()>    clear_value
                                   )
 {
-  if (mpi_stats || exec_times || wait_times || task_stats) {
+  if (dout || mpi_stats || exec_times || wait_times || task_stats) {
     std::unique_lock<Uintah::MasterLock> lock(g_report_lock);
     ReportValue value { type, get_value, clear_value };
     g_report_values[dout][name] = value;
@@ -277,7 +277,8 @@ MPI_Op rank_sum_min_max_op;
 
 void RuntimeStats::report( MPI_Comm comm )
 {
-  if (!(mpi_stats || exec_times || wait_times || task_stats)) {
+  // values may also be registered by the schedulers under their own Douts
+  if (!(mpi_stats || exec_times || wait_times || task_stats) && g_report_values.empty()) {
     return;
   }
 
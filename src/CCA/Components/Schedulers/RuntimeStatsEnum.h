@@ -65,11 +65,17 @@ namespace Uintah {
     , TaskReduceCommTime
     , TaskWaitThreadTime
 
+    // Breakdown of the (regridding) compilation time.
+    , CompilationDetailedTasksTime
+    , CompilationDependenciesTime
+    , CompilationNeighborSearches
+
     , XMLIOTime
     , OutputIOTime
     , OutputGlobalIOTime
     , CheckpointIOTime
     , CheckpointGlobalIOTime
+    , OutputAsyncWaitTime
     , TotalIOTime
 
     , OutputIORate
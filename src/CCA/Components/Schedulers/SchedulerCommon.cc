@@ -25,6 +25,8 @@
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 
 #include <CCA/Components/Schedulers/DetailedTasks.h>
+#include <CCA/Components/Schedulers/GhostNeighborCache.h>
+#include <CCA/Components/Schedulers/MemoryLog.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouseP.h>
 #include <CCA/Components/Schedulers/TaskGraph.h>
@@ -47,6 +49,7 @@
 #include <Core/Grid/Variables/SFCXVariable.h>
 #include <Core/Grid/Variables/SFCYVariable.h>
 #include <Core/Grid/Variables/SFCZVariable.h>
+#include <Core/Grid/Variables/VariableMemoryPool.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
@@ -123,6 +126,10 @@ SchedulerCommon::~SchedulerCommon()
     delete m_locallyComputedPatchVarMap;
   }
 
+  if (m_ghost_neighbor_cache) {
+    delete m_ghost_neighbor_cache;
+  }
+
   // Task monitoring variables.
   if (m_monitoring) {
     if (m_dummy_matl && m_dummy_matl->removeReference()) {
@@ -366,6 +373,60 @@ SchedulerCommon::problemSetup( const ProblemSpecP     & prob_spec
       proc0cout << "Using large, combined MPI messages\n";
     }
 
+    // Recycle the grid and particle variable storage between timesteps.
+    bool memoryPool = false;
+    params->getWithDefault("memoryPool", memoryPool, false);
+    VariableMemoryPool::setEnabled(memoryPool);
+
+    if (memoryPool) {
+      proc0cout << "Using the variable memory pool\n";
+    }
+
+    // Keep the ghost cell neighbors of the patches between task graph
+    // compiles, only the patches around a regridded region are searched again.
+    // The detailed tasks and their dependencies are still rebuilt in full.
+    bool cacheGhostNeighbors = false;
+    params->getWithDefault("cacheGhostNeighbors", cacheGhostNeighbors, false);
+
+    if (cacheGhostNeighbors) {
+      m_ghost_neighbor_cache = scinew GhostNeighborCache();
+      proc0cout << "Caching the ghost cell neighbors between task graph compiles\n";
+    }
+
+    // Find the dependencies of the detailed tasks on the worker threads
+    // of the threaded schedulers.
+    params->getWithDefault("parallelCompile", m_parallel_compile, false);
+
+    // Search the dependencies found by the threads again on the main thread
+    // and stop if they differ (regression testing of parallelCompile).
+    params->getWithDefault("verifyParallelCompile", m_verify_parallel_compile, false);
+
+    if (m_parallel_compile && m_verify_parallel_compile) {
+      proc0cout << "Verifying the threaded task graph compiles against a serial dependency search\n";
+    }
+
+    // Put the particles of each patch in spatial order during every
+    // particleSortInterval'th relocation.
+    int particleSortInterval = 0;
+    std::string particleSortOrder = "morton";
+    params->getWithDefault("particleSortInterval", particleSortInterval, 0);
+    params->getWithDefault("particleSortOrder", particleSortOrder, "morton");
+
+    if (particleSortInterval > 0) {
+      Relocate::SortOrder order;
+      if (particleSortOrder == "cell") {
+        order = Relocate::CellOrder;
+      }
+      else if (particleSortOrder == "morton") {
+        order = Relocate::MortonOrder;
+      }
+      else {
+        throw ProblemSetupException("Unknown particleSortOrder '" + particleSortOrder + "', use 'cell' or 'morton'", __FILE__, __LINE__);
+      }
+      m_relocate_1.setParticleSort(particleSortInterval, order);
+      proc0cout << "Sorting the particles by " << particleSortOrder << " every " << particleSortInterval << " relocations\n";
+    }
+
     ProblemSpecP track = params->findBlock("VarTracker");
     if (track) {
       track->require("start_time", m_tracking_start_time);
@@ -1216,6 +1277,10 @@ SchedulerCommon::advanceDataWarehouse( const GridP & grid
       replaceDataWarehouse(i, grid, initialization);
     }
   }
+
+  // The old data warehouse storage is now back in the pool, release
+  // what the last timestep did not need.
+  VariableMemoryPool::trim();
 }
 
 //______________________________________________________________________
@@ -1356,6 +1421,15 @@ SchedulerCommon::logMemoryUse()
     }
   }
 
+  if (VariableMemoryPool::isEnabled()) {
+    VariableMemoryPool::Stats stats = VariableMemoryPool::getStats();
+
+    std::ostringstream elems;
+    elems << stats.numBlocksCached << " blocks cached, " << stats.reused << "/" << stats.requests << " reused, peak "
+          << stats.peakBytesInUse << ", released " << stats.bytesReleased;
+    logMemory(*m_mem_logfile, total, "MemoryPool", "cached", "VariableMemoryPool", nullptr, -1, elems.str(), stats.bytesCached, 0);
+  }
+
   *m_mem_logfile << "Total: " << total << '\n';
   m_mem_logfile->flush();
 }
@@ -1415,12 +1489,24 @@ SchedulerCommon::compile()
       // NOTE: this single call is where all the TG compilation complexity arises (dependency analysis for auto MPI mesgs)
       m_task_graphs[i]->createDetailedTasks( useInternalDeps(), grid, oldGrid, has_distal_reqs );
 
-      double compile_time = tg_compile_timer().seconds();
+      double compile_time      = tg_compile_timer().seconds();
+      double detailed_time     = m_task_graphs[i]->getDetailedTasksTime();
+      double dependencies_time = m_task_graphs[i]->getDependenciesTime();
+
+      if (m_runtimeStats) {
+        (*m_runtimeStats)[CompilationDetailedTasksTime] += detailed_time;
+        (*m_runtimeStats)[CompilationDependenciesTime]  += dependencies_time;
+
+        if (m_ghost_neighbor_cache) {
+          (*m_runtimeStats)[CompilationNeighborSearches] += m_ghost_neighbor_cache->numFound();
+        }
+      }
 
       bool is_init = m_is_init_timestep || m_is_restart_init_timestep;
 
       DOUT(g_task_graph_compile, "Rank-" << std::left << std::setw(5) << d_myworld->myRank() << " time to compile TG-" << std::setw(4)
-                                         << (is_init ? "init-tg" : std::to_string(m_task_graphs[i]->getIndex())) << ": " << compile_time << " (sec)");
+                                         << (is_init ? "init-tg" : std::to_string(m_task_graphs[i]->getIndex())) << ": " << compile_time << " (sec)"
+                                         << " detailed tasks: " << detailed_time << " dependencies: " << dependencies_time);
     }
 
     // check scheduler at runtime, that all ranks are executing the same size TG (excluding spatial tasks)
@@ -38,6 +38,7 @@
 #include <Core/Parallel/UintahParallelComponent.h>
 #include <Core/Util/Timers/Timers.hpp>
 
+#include <functional>
 #include <iosfwd>
 #include <map>
 #include <set>
@@ -50,6 +51,7 @@ class LoadBalancer;
 class Output;
 class DetailedTask;
 class DetailedTasks;
+class GhostNeighborCache;
 class TaskGraph;
 class LocallyComputedPatchVarMap;
   
@@ -271,6 +273,15 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
 
     virtual bool useInternalDeps();
 
+    /// Number of threads TaskGraph::createDetailedDependencies runs on,
+    /// 1 unless the scheduler has a pool of worker threads and
+    /// <parallelCompile> is set.
+    virtual int numCompileThreads() { return 1; }
+
+    /// Runs work( thread ) on each of the numCompileThreads() threads,
+    /// thread 0 being the calling thread, and returns when all are done.
+    virtual void runOnCompileThreads( const std::function<void(int)> & work ) { work(0); }
+
     int getMaxGhost() { return m_max_ghost_cells; }
 
     int getMaxDistalGhost() { return m_max_distal_ghost_cells; }
@@ -334,6 +345,12 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     int                                 m_generation{0};
     int                                 m_dwmap[Task::TotalDWs];
 
+    // find the dependencies of the task graphs on the worker threads - <parallelCompile>true</parallelCompile>
+    bool                                m_parallel_compile{false};
+
+    // compare them with a serial search - <verifyParallelCompile>true</verifyParallelCompile>
+    bool                                m_verify_parallel_compile{false};
+
     ApplicationInterface * m_application  {nullptr};
     LoadBalancer         * m_loadBalancer {nullptr};
     Output               * m_output       {nullptr};
@@ -441,6 +458,9 @@ class SchedulerCommon : public Scheduler, public UintahParallelComponent {
     // max level offset of all tasks - will be used for loadbalancer to create neighborhood
     int m_max_level_offset{0};
 
+    // ghost cell neighbors kept between compiles - <cacheGhostNeighbors>true</cacheGhostNeighbors>
+    GhostNeighborCache* m_ghost_neighbor_cache{nullptr};
+
     // task-graph needs access to reduction task map, etc
     friend class TaskGraph;
 
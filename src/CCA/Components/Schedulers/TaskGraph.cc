@@ -24,6 +24,7 @@
 
 #include <CCA/Components/Schedulers/TaskGraph.h>
 #include <CCA/Components/Schedulers/DetailedTasks.h>
+#include <CCA/Components/Schedulers/GhostNeighborCache.h>
 #include <CCA/Components/Schedulers/SchedulerCommon.h>
 #include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
 #include <CCA/Ports/DataWarehouse.h>
@@ -42,7 +43,11 @@
 #include <Core/Util/DOUT.hpp>
 #include <Core/Util/FancyAssert.h>
 #include <Core/Util/ProgressiveWarning.h>
+#include <Core/Util/Timers/Timers.hpp>
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -61,6 +66,10 @@ namespace {
   Dout g_detailed_task_dbg(     "TaskGraphDetailedTasks" , "TaskGraph", "high-level info on creation of DetailedTasks"        , false);
   Dout g_detailed_deps_dbg(     "TaskGraphDetailedDeps"  , "TaskGraph", "detailed dep info for each DetailedTask"             , false);
   Dout g_topological_deps_dbg(  "TopologicalDetailedDeps", "TaskGraph", "topologiocal sort detailed dependnecy info"          , false);
+  Dout g_ghost_neighbor_cache_dbg("GhostNeighborCache"  , "TaskGraph", "ghost neighbors reused from the last compile"       , false);
+
+  // tasks whose dependencies are kept at once, per compile thread
+  const int TASKS_PER_COMPILE_THREAD = 64;
 
 }
 
@@ -215,6 +224,9 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
                               , const bool    hasDistalReqs /* = false */
                               )
 {
+  Timers::Simple timer;
+  timer.start();
+
   std::vector<Task*> sorted_tasks;
 
   nullSort(sorted_tasks);
@@ -648,9 +660,13 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
 
   m_load_balancer->assignResources(*m_detailed_tasks);
 
+  m_detailed_tasks_time = timer.lap().seconds();
+
   // scrub counts are created via addScrubCount() through this call ( via possiblyCreateDependency() )
   createDetailedDependencies();
 
+  m_dependencies_time = timer.lap().seconds();
+
   if (m_detailed_tasks->getExtraCommunication() > 0 && m_proc_group->myRank() == 0) {
     std::cout << m_proc_group->myRank() << "  Warning: Extra communication.  This taskgraph on this rank overcommunicates about "
               << m_detailed_tasks->getExtraCommunication() << " cells\n";
@@ -672,6 +688,13 @@ TaskGraph::createDetailedTasks(       bool    useInternalDeps
 void
 TaskGraph::createDetailedDependencies()
 {
+  // Reuse the ghost cell neighbors of the patches the last compile found
+  // them for if the grid around the patches did not change.
+  m_neighbor_cache = m_scheduler->m_ghost_neighbor_cache;
+  if (m_neighbor_cache) {
+    m_neighbor_cache->beginCompile(m_scheduler->getMaxGhost() + 1);
+  }
+
   // Collect all of the computes
   CompTable ct;
   const int num_tasks = m_detailed_tasks->numTasks();
@@ -722,23 +745,104 @@ TaskGraph::createDetailedDependencies()
   m_proc_group->setGlobalComm(curr_num_comms);
   m_num_task_phases = currphase + 1;
 
-  // Go through the modifies/requires and create data dependencies as appropriate
-  for (int i = 0; i < m_detailed_tasks->numTasks(); i++) {
-    DetailedTask* dtask = m_detailed_tasks->getTask(i);
-
+  // Go through the modifies/requires and find the data dependencies of each task
+  auto find_dependencies = [&](DetailedTask* dtask, FoundDependencies& found) {
     // debug
     if (g_detailed_deps_dbg && (dtask->m_task->getRequires() != nullptr)) {
       DOUTR(true,  " Looking at requires of detailed task: " << *dtask);
     }
 
-    createDetailedDependencies(dtask, dtask->m_task->getRequires(), ct, false);
+    createDetailedDependencies(dtask, dtask->m_task->getRequires(), ct, false, found);
 
     // debug
     if (g_detailed_deps_dbg && (dtask->m_task->getModifies() != nullptr)) {
       DOUTR(true,  " Looking at modifies of detailed task: " << *dtask);
     }
 
-    createDetailedDependencies(dtask, dtask->m_task->getModifies(), ct, true);
+    createDetailedDependencies(dtask, dtask->m_task->getModifies(), ct, true, found);
+  };
+
+  // Finding the dependencies only reads the CompTable, the grid and the load balancer, the
+  // scheduler's threads find them for blocks of tasks.  They are created in task order by the
+  // main thread, so every rank creates the same dependencies (and message tags) in the same order
+  // no matter how many threads found them.
+  const int num_threads = m_scheduler->numCompileThreads();
+
+  // With <verifyParallelCompile> the main thread searches the dependencies of every task again
+  // before creating them.  Identical dependencies, created in the same order, give the same
+  // dependency batches and message tags as the serial compile.
+  const bool verify = (num_threads > 1) && m_scheduler->m_verify_parallel_compile;
+  FoundDependencies serial_found;
+
+  if (num_threads > 1) {
+    const int block_size = TASKS_PER_COMPILE_THREAD * num_threads;
+
+    std::vector<FoundDependencies>  found(block_size);
+    std::vector<std::exception_ptr> errors(block_size);
+
+    for (int first = 0; first < num_tasks; first += block_size) {
+      const int num_block_tasks = std::min(block_size, num_tasks - first);
+      std::atomic<int> next{0};
+
+      m_scheduler->runOnCompileThreads([&](int /*thread*/) {
+        for (int i = next.fetch_add(1); i < num_block_tasks; i = next.fetch_add(1)) {
+          found[i].clear();
+          errors[i] = nullptr;
+          try {
+            find_dependencies(m_detailed_tasks->getTask(first + i), found[i]);
+          }
+          catch (...) {
+            errors[i] = std::current_exception();
+          }
+        }
+      });
+
+      for (int i = 0; i < num_block_tasks; i++) {
+        if (errors[i]) {
+          std::rethrow_exception(errors[i]);
+        }
+
+        DetailedTask* dtask = m_detailed_tasks->getTask(first + i);
+
+        if (verify) {
+          serial_found.clear();
+          find_dependencies(dtask, serial_found);
+
+          if (!(serial_found == found[i])) {
+            std::ostringstream desc;
+            desc << "TG-" << m_index << ": the " << found[i].size() << " dependencies of task " << *dtask
+                 << " found on " << num_threads << " threads differ from the " << serial_found.size()
+                 << " found by the serial search";
+            SCI_THROW(InternalError(desc.str(), __FILE__, __LINE__));
+          }
+        }
+
+        addDetailedDependencies(dtask, found[i]);
+      }
+    }
+  }
+  else {
+    FoundDependencies found;
+    for (int i = 0; i < num_tasks; i++) {
+      DetailedTask* dtask = m_detailed_tasks->getTask(i);
+
+      found.clear();
+      find_dependencies(dtask, found);
+      addDetailedDependencies(dtask, found);
+    }
+  }
+
+  if (m_neighbor_cache) {
+    m_neighbor_cache->endCompile();
+
+    DOUTR(g_ghost_neighbor_cache_dbg, " TG-" << m_index << ": ghost neighbors of " << m_neighbor_cache->numChangedPatches()
+                                     << " of " << m_neighbor_cache->numPatches() << " patches changed, "
+                                     << m_neighbor_cache->numReused() << " reused, " << m_neighbor_cache->numFound() << " searched");
+  }
+
+  if (verify) {
+    DOUTR(g_detailed_task_dbg, " TG-" << m_index << ": dependencies of " << num_tasks << " tasks found on "
+                               << num_threads << " threads match the serial search");
   }
 
   DOUTR(g_detailed_task_dbg, " Done creating detailed tasks");
@@ -848,10 +952,11 @@ TaskGraph::remapTaskDWs( int dwmap[] )
 //______________________________________________________________________
 //
 void
-TaskGraph::createDetailedDependencies( DetailedTask     * dtask
-                                     , Task::Dependency * req
-                                     , CompTable        & ct
-                                     , bool               modifies
+TaskGraph::createDetailedDependencies( DetailedTask      * dtask
+                                     , Task::Dependency  * req
+                                     , CompTable         & ct
+                                     , bool                modifies
+                                     , FoundDependencies & found
                                      )
 {
   int my_rank = m_proc_group->myRank();
@@ -964,72 +1069,100 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
       for (auto i = 0; i < patches->size(); ++i) {
         const Patch* patch = patches->get(i);
 
-        static Patch::selectType neighbors;
-        neighbors.resize(0);
+        // The neighbors of the patch and the region needed from each of them only depend on the
+        // grid, reuse them from the last compile (or another requires) if the grid around the patch
+        // is the same.
+        const bool use_cache = m_neighbor_cache && !patch->isVirtual() &&
+                               req->m_patches_dom != Task::CoarseLevel && req->m_patches_dom != Task::FineLevel;
 
-        IntVector low  = IntVector(-9, -9, -9);
-        IntVector high = IntVector(-9, -9, -9);
+        const GhostNeighborCache::Neighbors* ghost_neighbors = use_cache ? m_neighbor_cache->find(patch, req) : nullptr;
 
         Patch::VariableBasis basis = Patch::translateTypeToBasis(req->m_var->typeDescription()->getType(), false);
 
-        if (uses_SHRT_MAX) {
-          patch->getLevel()->computeVariableExtents(req->m_var->typeDescription()->getType(), low, high);
-        }
-        else {
-          patch->computeVariableExtentsWithBoundaryCheck(req->m_var->typeDescription()->getType(),
-                                                         req->m_var->getBoundaryLayer(),
-                                                         req->m_gtype,
-                                                         req->m_num_ghost_cells,
-                                                         low, high);
-        }
+        if (!ghost_neighbors) {
+          thread_local Patch::selectType neighbors;
+          neighbors.resize(0);
+
+          thread_local GhostNeighborCache::Neighbors found_neighbors;
+          found_neighbors.resize(0);
+
+          IntVector low  = IntVector(-9, -9, -9);
+          IntVector high = IntVector(-9, -9, -9);
 
-        if (req->m_patches_dom == Task::CoarseLevel || req->m_patches_dom == Task::FineLevel) {
-          // make sure the bounds of the dep are limited to the original patch's (see above)
-          // also limit to current patch, as patches already loops over all patches
-          IntVector origlow  = low;
-          IntVector orighigh = high;
-          if (req->m_patches_dom == Task::FineLevel) {
-            // don't coarsen the extra cells
-            low  = patch->getExtraLowIndex(basis,  req->m_var->getBoundaryLayer());
-            high = patch->getExtraHighIndex(basis, req->m_var->getBoundaryLayer());
+          if (uses_SHRT_MAX) {
+            patch->getLevel()->computeVariableExtents(req->m_var->typeDescription()->getType(), low, high);
           }
           else {
-            low  = Max(low, otherLevelLow);
-            high = Min(high, otherLevelHigh);
+            patch->computeVariableExtentsWithBoundaryCheck(req->m_var->typeDescription()->getType(),
+                                                           req->m_var->getBoundaryLayer(),
+                                                           req->m_gtype,
+                                                           req->m_num_ghost_cells,
+                                                           low, high);
           }
 
-          if (high.x() <= low.x() || high.y() <= low.y() || high.z() <= low.z()) {
-            continue;
-          }
+          if (req->m_patches_dom == Task::CoarseLevel || req->m_patches_dom == Task::FineLevel) {
+            // make sure the bounds of the dep are limited to the original patch's (see above)
+            // also limit to current patch, as patches already loops over all patches
+            IntVector origlow  = low;
+            IntVector orighigh = high;
+            if (req->m_patches_dom == Task::FineLevel) {
+              // don't coarsen the extra cells
+              low  = patch->getExtraLowIndex(basis,  req->m_var->getBoundaryLayer());
+              high = patch->getExtraHighIndex(basis, req->m_var->getBoundaryLayer());
+            }
+            else {
+              low  = Max(low, otherLevelLow);
+              high = Min(high, otherLevelHigh);
+            }
 
-          // don't need to selectPatches, just use current patch, as we're already looping over required patches
-          neighbors.push_back(patch);
-        }
-        else {
-          origPatch = patch;
-          if (req->m_num_ghost_cells > 0) {
-            patch->getLevel()->selectPatches(low, high, neighbors);
+            if (high.x() <= low.x() || high.y() <= low.y() || high.z() <= low.z()) {
+              continue;
+            }
+
+            // don't need to selectPatches, just use current patch, as we're already looping over required patches
+            neighbors.push_back(patch);
           }
           else {
-            neighbors.push_back(patch);
+            origPatch = patch;
+            if (req->m_num_ghost_cells > 0) {
+              patch->getLevel()->selectPatches(low, high, neighbors);
+            }
+            else {
+              neighbors.push_back(patch);
+            }
           }
-        }
 
-        ASSERT(std::is_sorted(neighbors.begin(), neighbors.end(), Patch::Compare()));
+          ASSERT(std::is_sorted(neighbors.begin(), neighbors.end(), Patch::Compare()));
 
-        size_t num_neighbors = neighbors.size();
+          size_t num_neighbors = neighbors.size();
 
-        DOUTR(g_detailed_deps_dbg,    "    Creating detailed dependency on " << num_neighbors
-                                   << " neighboring patch" << (num_neighbors > 1 ? "es " : "   ") << neighbors
-                                   << "   Low=" << low << ", high=" << high << ", dw= " << req->mapDataWarehouse()
-                                   << ", var=" << req->m_var->getName() );
+          DOUTR(g_detailed_deps_dbg,    "    Creating detailed dependency on " << num_neighbors
+                                     << " neighboring patch" << (num_neighbors > 1 ? "es " : "   ") << neighbors
+                                     << "   Low=" << low << ", high=" << high << ", dw= " << req->mapDataWarehouse()
+                                     << ", var=" << req->m_var->getName() );
 
+          for (auto i = 0u; i < num_neighbors; ++i) {
+            const Patch* neighbor = neighbors[i];
+
+            IntVector l = Max(neighbor->getExtraLowIndex(basis, req->m_var->getBoundaryLayer()), low);
+            IntVector h = Min(neighbor->getExtraHighIndex(basis, req->m_var->getBoundaryLayer()), high);
+
+            if (neighbor->isVirtual()) {
+              l -= neighbor->getVirtualOffset();
+              h -= neighbor->getVirtualOffset();
+            }
+
+            found_neighbors.push_back({neighbor, l, h, -1});
+          }
+
+          ghost_neighbors = use_cache ? &m_neighbor_cache->insert(patch, req, low, high, found_neighbors) : &found_neighbors;
+        }
 
         //------------------------------------------------------------------------
         //           for all neighbors - find and store from neighbors
         //------------------------------------------------------------------------
-        for (auto i = 0u; i < num_neighbors; ++i) {
-          const Patch* neighbor = neighbors[i];
+        for (const auto & ghost_neighbor : *ghost_neighbors) {
+          const Patch* neighbor = ghost_neighbor.m_patch->getRealPatch();
 
           // if neighbor is not in my neighborhood just continue as its dependencies are not important to this processor
           DOUTR(g_proc_neighborhood_dbg, "    In detailed task: " << dtask->getName() << " checking if " << *req << " is in neighborhood on level: " << trueLevel);
@@ -1053,23 +1186,17 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
                      << " levelOffset " << levelOffset );
           }
 
-          if (!m_load_balancer->inNeighborhood(neighbor->getRealPatch(), search_distal_reqs)) {
+          if (!m_load_balancer->inNeighborhood(neighbor, search_distal_reqs)) {
             DOUTR(g_proc_neighborhood_dbg, "    No");
             continue;
           }
           DOUTR(g_proc_neighborhood_dbg, "    Yes");
 
-          static Patch::selectType fromNeighbors;
+          thread_local Patch::selectType fromNeighbors;
           fromNeighbors.resize(0);
 
-          IntVector l = Max(neighbor->getExtraLowIndex(basis, req->m_var->getBoundaryLayer()), low);
-          IntVector h = Min(neighbor->getExtraHighIndex(basis, req->m_var->getBoundaryLayer()), high);
-
-          if (neighbor->isVirtual()) {
-            l -= neighbor->getVirtualOffset();
-            h -= neighbor->getVirtualOffset();
-            neighbor = neighbor->getRealPatch();
-          }
+          const IntVector & l = ghost_neighbor.m_low;
+          const IntVector & h = ghost_neighbor.m_high;
 
           if (req->m_patches_dom == Task::OtherGridDomain) {
             // this is when we are copying data between two grids (currently between timesteps)
@@ -1151,7 +1278,6 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
               if (m_scheduler->isOldDW(req->mapDataWarehouse())) {
                 ASSERT(!modifies);
                 proc = findVariableLocation(req, fromNeighbor, matl, 0);
-                creator = m_detailed_tasks->getOldDWSendTask(proc);
                 comp = nullptr;
               }
               else {
@@ -1162,7 +1288,6 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
                     // findcomp first, as this is a "if you don't find
                     // it here, assign it from the old TG" dependency
                     proc = findVariableLocation(req, fromNeighbor, matl, 0);
-                    creator = m_detailed_tasks->getOldDWSendTask(proc);
                     comp = nullptr;
                   }
                   else {
@@ -1188,86 +1313,8 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
                 }
               }
 
-              if (modifies && comp) {  // comp means NOT send-old-data tasks
-
-                // find the tasks that up to this point require the variable that we are modifying (i.e., the ones that
-                // use the computed variable before we modify it), and put a dependency between those tasks and this task
-
-                // i.e., the task that requires data computed by a task on this processor needs to finish its task
-                // before this task, which modifies the data computed by the same task
-                std::list<DetailedTask*> requireBeforeModifiedTasks;
-                creator->findRequiringTasks(req->m_var, requireBeforeModifiedTasks);
-
-                std::list<DetailedTask*>::iterator reqTaskIter;
-                for (reqTaskIter = requireBeforeModifiedTasks.begin(); reqTaskIter != requireBeforeModifiedTasks.end(); ++reqTaskIter) {
-                  DetailedTask* prevReqTask = *reqTaskIter;
-                  if (prevReqTask == dtask) {
-                    continue;
-                  }
-                  if (prevReqTask->m_task == dtask->m_task) {
-                    if (!dtask->m_task->getHasSubScheduler()) {
-
-#if SCI_ASSERTION_LEVEL>0                             // remove this #if after spatial scheduling works in the Arches sweeps radiation code. 07/06/17
-                      std::ostringstream message;
-                      message << " WARNING - task (" << dtask->getName()
-                              << ") requires with Ghost cells *and* modifies and may not be correct" << std::endl;
-                      static ProgressiveWarning warn(message.str(), 10);
-                      warn.invoke();
-#endif
-
-                      DOUTR(g_detailed_deps_dbg, " Task that requires with ghost cells and modifies  RGM: var: " << *req->m_var << " compute: "
-                                                  << *creator << " mod " << *dtask << " PRT " << *prevReqTask << " " << from_l << " " << from_h);
-                    }
-                  }
-                  else {
-                    // dep requires what is to be modified before it is to be modified so create a dependency between them
-                    // so the modifying won't conflict with the previous require.
-                    DOUTR(g_detailed_deps_dbg,  "       Requires to modifies dependency from " << prevReqTask->getName()
-                                                << " to " << dtask->getName() << " (created by " << creator->getName() << ")");
-
-                    if (creator->getPatches() && creator->getPatches()->size() > 1) {
-                      // if the creator works on many patches, then don't create links between patches that don't touch
-                      const PatchSubset* psub = dtask->getPatches();
-                      const PatchSubset* req_sub = prevReqTask->getPatches();
-                      if (psub->size() == 1 && req_sub->size() == 1) {
-                        const Patch* p = psub->get(0);
-                        const Patch* req_patch = req_sub->get(0);
-                        Patch::selectType n;
-                        IntVector low, high;
-
-                        req_patch->computeVariableExtents(req->m_var->typeDescription()->getType(), req->m_var->getBoundaryLayer(), Ghost::AroundCells, 2, low, high);
-
-                        req_patch->getLevel()->selectPatches(low, high, n);
-                        bool found = false;
-                        for (unsigned int i = 0; i < n.size(); i++) {
-                          if (n[i]->getID() == p->getID()) {
-                            found = true;
-                            break;
-                          }
-                        }
-                        if (!found) {
-                          continue;
-                        }
-                      }
-                    }
-                    m_detailed_tasks->possiblyCreateDependency(prevReqTask, nullptr, nullptr, dtask, req, nullptr, matl, from_l, from_h, DetailedDep::Always);
-                  }
-                }
-              }
-
-              DetailedDep::CommCondition cond = DetailedDep::Always;
-              if (proc != -1 && req->m_patches_dom != Task::OtherGridDomain) {
-                // for OldDW tasks - see comment in class DetailedDep by CommCondition
-                int subsequentProc = findVariableLocation(req, fromNeighbor, matl, 1);
-                if (subsequentProc != proc) {
-                  cond = DetailedDep::FirstIteration;  // change outer cond from always to first-only
-                  DetailedTask* subsequentCreator = m_detailed_tasks->getOldDWSendTask(subsequentProc);
-                  m_detailed_tasks->possiblyCreateDependency(subsequentCreator, comp, fromNeighbor, dtask, req, patch, matl, from_l,
-                                                             from_h, DetailedDep::SubsequentIterations);
-                  DOUTR(g_detailed_deps_dbg, "   Adding condition reqs for " << *req->m_var << " task : " << *creator << "  to " << *dtask);
-                }
-              }
-              m_detailed_tasks->possiblyCreateDependency(creator, comp, fromNeighbor, dtask, req, patch, matl, from_l, from_h, cond);
+              // the send old data task of proc is looked up when the dependency is created
+              found.push_back({creator, comp, req, fromNeighbor, patch, matl, proc, from_l, from_h, modifies, false});
 
             } // forall materials
 
@@ -1283,7 +1330,7 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
       // requiring reduction variables
       for (int m = 0; m < matls->size(); m++) {
         int matl = matls->get(m);
-        static std::vector<DetailedTask*> creators;
+        thread_local std::vector<DetailedTask*> creators;
         creators.resize(0);
 
         ct.findReductionComps(req, nullptr, matl, creators, m_proc_group);
@@ -1297,8 +1344,7 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
         for (unsigned i = 0; i < creators.size(); i++) {
           DetailedTask* creator = creators[i];
           if (dtask->getAssignedResourceIndex() == creator->getAssignedResourceIndex() && dtask->getAssignedResourceIndex() == my_rank ) {
-            dtask->addInternalDependency(creator, req->m_var);
-            DOUTR(g_detailed_deps_dbg,  "    Created reduction dependency between " << *dtask << " and " << *creator);
+            found.push_back({creator, nullptr, req, nullptr, nullptr, matl, -1, IntVector(0, 0, 0), IntVector(0, 0, 0), modifies, true});
           }
         }
       }
@@ -1364,6 +1410,119 @@ TaskGraph::createDetailedDependencies( DetailedTask     * dtask
   }
 }
 
+//______________________________________________________________________
+//
+void
+TaskGraph::addDetailedDependencies(       DetailedTask      * dtask
+                                  , const FoundDependencies & found
+                                  )
+{
+  for (const FoundDependency & dep : found) {
+    Task::Dependency * req     = dep.m_req;
+    Task::Dependency * comp    = dep.m_comp;
+    DetailedTask     * creator = dep.m_creator;
+
+    if (dep.m_reduction) {
+      dtask->addInternalDependency(creator, req->m_var);
+      DOUTR(g_detailed_deps_dbg,  "    Created reduction dependency between " << *dtask << " and " << *creator);
+      continue;
+    }
+
+    const Patch     * fromNeighbor = dep.m_from_patch;
+    const Patch     * patch        = dep.m_to_patch;
+    const int         matl         = dep.m_matl;
+    const int         proc         = dep.m_proc;
+    const bool        modifies     = dep.m_modifies;
+    const IntVector & from_l       = dep.m_low;
+    const IntVector & from_h       = dep.m_high;
+
+    if (proc != -1) {
+      creator = m_detailed_tasks->getOldDWSendTask(proc);
+    }
+
+    if (modifies && comp) {  // comp means NOT send-old-data tasks
+
+      // find the tasks that up to this point require the variable that we are modifying (i.e., the ones that
+      // use the computed variable before we modify it), and put a dependency between those tasks and this task
+
+      // i.e., the task that requires data computed by a task on this processor needs to finish its task
+      // before this task, which modifies the data computed by the same task
+      std::list<DetailedTask*> requireBeforeModifiedTasks;
+      creator->findRequiringTasks(req->m_var, requireBeforeModifiedTasks);
+
+      std::list<DetailedTask*>::iterator reqTaskIter;
+      for (reqTaskIter = requireBeforeModifiedTasks.begin(); reqTaskIter != requireBeforeModifiedTasks.end(); ++reqTaskIter) {
+        DetailedTask* prevReqTask = *reqTaskIter;
+        if (prevReqTask == dtask) {
+          continue;
+        }
+        if (prevReqTask->m_task == dtask->m_task) {
+          if (!dtask->m_task->getHasSubScheduler()) {
+
+#if SCI_ASSERTION_LEVEL>0                             // remove this #if after spatial scheduling works in the Arches sweeps radiation code. 07/06/17
+            std::ostringstream message;
+            message << " WARNING - task (" << dtask->getName()
+                    << ") requires with Ghost cells *and* modifies and may not be correct" << std::endl;
+            static ProgressiveWarning warn(message.str(), 10);
+            warn.invoke();
+#endif
+
+            DOUTR(g_detailed_deps_dbg, " Task that requires with ghost cells and modifies  RGM: var: " << *req->m_var << " compute: "
+                                        << *creator << " mod " << *dtask << " PRT " << *prevReqTask << " " << from_l << " " << from_h);
+          }
+        }
+        else {
+          // dep requires what is to be modified before it is to be modified so create a dependency between them
+          // so the modifying won't conflict with the previous require.
+          DOUTR(g_detailed_deps_dbg,  "       Requires to modifies dependency from " << prevReqTask->getName()
+                                      << " to " << dtask->getName() << " (created by " << creator->getName() << ")");
+
+          if (creator->getPatches() && creator->getPatches()->size() > 1) {
+            // if the creator works on many patches, then don't create links between patches that don't touch
+            const PatchSubset* psub = dtask->getPatches();
+            const PatchSubset* req_sub = prevReqTask->getPatches();
+            if (psub->size() == 1 && req_sub->size() == 1) {
+              const Patch* p = psub->get(0);
+              const Patch* req_patch = req_sub->get(0);
+              Patch::selectType n;
+              IntVector low, high;
+
+              req_patch->computeVariableExtents(req->m_var->typeDescription()->getType(), req->m_var->getBoundaryLayer(), Ghost::AroundCells, 2, low, high);
+
+              req_patch->getLevel()->selectPatches(low, high, n);
+              bool found = false;
+              for (unsigned int i = 0; i < n.size(); i++) {
+                if (n[i]->getID() == p->getID()) {
+                  found = true;
+                  break;
+                }
+              }
+              if (!found) {
+                continue;
+              }
+            }
+          }
+          m_detailed_tasks->possiblyCreateDependency(prevReqTask, nullptr, nullptr, dtask, req, nullptr, matl, from_l, from_h, DetailedDep::Always);
+        }
+      }
+    }
+
+    DetailedDep::CommCondition cond = DetailedDep::Always;
+    if (proc != -1 && req->m_patches_dom != Task::OtherGridDomain) {
+      // for OldDW tasks - see comment in class DetailedDep by CommCondition
+      int subsequentProc = findVariableLocation(req, fromNeighbor, matl, 1);
+      if (subsequentProc != proc) {
+        cond = DetailedDep::FirstIteration;  // change outer cond from always to first-only
+        DetailedTask* subsequentCreator = m_detailed_tasks->getOldDWSendTask(subsequentProc);
+        m_detailed_tasks->possiblyCreateDependency(subsequentCreator, comp, fromNeighbor, dtask, req, patch, matl, from_l,
+                                                   from_h, DetailedDep::SubsequentIterations);
+        DOUTR(g_detailed_deps_dbg, "   Adding condition reqs for " << *req->m_var << " task : " << *creator << "  to " << *dtask);
+      }
+    }
+    m_detailed_tasks->possiblyCreateDependency(creator, comp, fromNeighbor, dtask, req, patch, matl, from_l, from_h, cond);
+  }
+}
+
 //______________________________________________________________________
 //
 int
@@ -40,6 +40,7 @@ namespace Uintah {
 
   class DetailedTask;
   class DetailedTasks;
+  class GhostNeighborCache;
   class Patch;
   class LoadBalancer;
 
@@ -67,6 +68,7 @@ CLASS
      createDetailedDependencies (public)
        remembercomps
        createDetailedDependencies (private)
+         GhostNeighborCache::find/insert (with <cacheGhostNeighbors>)
          DetailedTasks::possiblyCreateDependency or Task::addInternalDependency
 
    Then at the and:
@@ -232,7 +234,8 @@ class TaskGraph {
     /// This will go through the detailed tasks and create the
     /// dependencies needed to communicate data across separate
     /// processors.  Calls the private createDetailedDependencies
-    /// for each task as a helper.
+    /// for each task as a helper, on the scheduler's compile threads
+    /// (see SchedulerCommon::runOnCompileThreads).
     void createDetailedDependencies();
 
     /// Connects the tasks, but does not sort them.
@@ -277,6 +280,18 @@ class TaskGraph {
       return m_has_distal_requires;
     }
 
+    /// Time the last createDetailedTasks spent creating the DetailedTasks
+    /// and their dependencies (seconds).
+    inline double getDetailedTasksTime() const
+    {
+      return m_detailed_tasks_time;
+    }
+
+    inline double getDependenciesTime() const
+    {
+      return m_dependencies_time;
+    }
+
     /// Makes and returns a map that associates VarLabel names with
     /// the materials the variable is computed for.
     using VarLabelMaterialMap = std::map<std::string, std::list<int> >;
@@ -298,17 +313,51 @@ class TaskGraph {
                       , CompTable        & ct
                       );
 
+    /// A dependency of a detailed task found by the private
+    /// createDetailedDependencies, created by addDetailedDependencies.
+    struct FoundDependency {
+      DetailedTask     * m_creator;     // nullptr for the send old data task of m_proc
+      Task::Dependency * m_comp;
+      Task::Dependency * m_req;
+      const Patch      * m_from_patch;
+      const Patch      * m_to_patch;
+      int                m_matl;
+      int                m_proc;        // rank holding the old data, -1 if computed
+      IntVector          m_low;
+      IntVector          m_high;
+      bool               m_modifies;
+      bool               m_reduction;   // internal dependency on the reduction m_creator
+
+      bool operator==( const FoundDependency & d ) const
+      {
+        return m_creator    == d.m_creator    && m_comp     == d.m_comp     && m_req  == d.m_req  &&
+               m_from_patch == d.m_from_patch && m_to_patch == d.m_to_patch && m_matl == d.m_matl &&
+               m_proc       == d.m_proc       && m_low      == d.m_low      && m_high == d.m_high &&
+               m_modifies   == d.m_modifies   && m_reduction == d.m_reduction;
+      }
+    };
+
+    using FoundDependencies = std::vector<FoundDependency>;
+
     /// This is the "detailed" version of addDependencyEdges (removed).  It does for
     /// the public createDetailedDependencies member function essentially
     /// what addDependencyEdges (removed) did for setupTaskConnections.
-    /// This will set up the data dependencies that need to be communicated
-    /// between processors.
-    void createDetailedDependencies( DetailedTask     * dtask
-                                   , Task::Dependency * req
-                                   , CompTable        & ct
-                                   , bool               modifies
+    /// This will find the data dependencies that need to be communicated
+    /// between processors and append them to found.  Only reads the
+    /// CompTable, the grid and the load balancer, so it can run for
+    /// different tasks on different threads.
+    void createDetailedDependencies( DetailedTask      * dtask
+                                   , Task::Dependency  * req
+                                   , CompTable         & ct
+                                   , bool                modifies
+                                   , FoundDependencies & found
                                    );
 
+    /// Creates the dependencies found for dtask, in the order they were found.
+    void addDetailedDependencies(       DetailedTask      * dtask
+                                , const FoundDependencies & found
+                                );
+
     /// Makes a DetailedTask from task with given PatchSubset and MaterialSubset.
     void createDetailedTask(       Task           * task
                            , const PatchSubset    * patches
@@ -352,6 +401,7 @@ class TaskGraph {
     const ProcessorGroup * m_proc_group{nullptr};
     Scheduler::tgType      m_type{};
     DetailedTasks        * m_detailed_tasks{nullptr};
+    GhostNeighborCache   * m_neighbor_cache{nullptr};
 
     // how many times this taskgraph has executed this timestep
     int m_current_iteration{0};
@@ -364,6 +414,10 @@ class TaskGraph {
     // does this TG contain requires with halo > MAX_HALO_DEPTH
     bool m_has_distal_requires{false};
 
+    // time spent in the last compile
+    double m_detailed_tasks_time{0};
+    double m_dependencies_time{0};
+
     std::vector<std::shared_ptr<Task> > m_tasks{};
 
 
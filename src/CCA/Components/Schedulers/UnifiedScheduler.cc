@@ -50,6 +50,7 @@
 
 #include <atomic>
 #include <cstring>
+#include <functional>
 #include <iomanip>
 #include <thread>
 
@@ -76,6 +77,7 @@ namespace {
 
   Dout g_thread_stats     ( "Unified_ThreadStats",    "UnifiedScheduler", "Aggregated MPI thread stats for the UnifiedScheduler", false );
   Dout g_thread_indv_stats( "Unified_IndvThreadStats","UnifiedScheduler", "Individual MPI thread stats for the UnifiedScheduler", false );
+  Dout g_steal_stats      ( "Unified_StealStats",     "UnifiedScheduler", "Work stealing steal/idle counters for the UnifiedScheduler", false );
 
   Uintah::MasterLock g_scheduler_mutex{};           // main scheduler lock for multi-threaded task selection
   Uintah::MasterLock g_mark_task_consumed_mutex{};  // allow only one task at a time to enter the task consumed section
@@ -131,6 +133,19 @@ int                        g_num_threads                 = 0;
 
 std::atomic<int> g_run_tasks{0};
 
+// set while the TaskRunners find the dependencies of a task graph
+std::atomic<const std::function<void(int)>*> g_compile_work{nullptr};
+
+// per-thread work stealing counters, each written only by its owning thread
+// and kept on its own cache line
+struct alignas(64) StealCounters
+{
+  int64_t m_num_steals{0};
+  int64_t m_num_idle_polls{0};
+};
+
+StealCounters              g_steal_counters[MAX_THREADS] = {};
+
 
 //______________________________________________________________________
 //
@@ -369,13 +384,23 @@ UnifiedScheduler::problemSetup( const ProblemSpecP     & prob_spec
     else if (taskQueueAlg == "PatchOrderRandom") {
       m_task_queue_alg = PatchOrderRandom;
     }
+    else if (taskQueueAlg == "CriticalPath") {
+      m_task_queue_alg = CriticalPath;
+    }
     else {
       throw ProblemSetupException("Unknown task ready queue algorithm", __FILE__, __LINE__);
     }
+
+    // per-thread ready queues with locality-aware stealing
+    params->getWithDefault("workStealing", m_work_stealing, false);
   }
 
   proc0cout << "Using \"" << taskQueueAlg << "\" task queue priority algorithm" << std::endl;
 
+  if (m_work_stealing) {
+    proc0cout << "Using per-thread work stealing task ready queues" << std::endl;
+  }
+
   int num_threads = Uintah::Parallel::getNumThreads() - 1;
 
   if ( (num_threads < 1) &&  Uintah::Parallel::usingDevice() ) {
@@ -444,12 +469,19 @@ UnifiedScheduler::problemSetup( const ProblemSpecP     & prob_spec
   }
 #endif
 
+  readCommPlanOptions(prob_spec);
+  readTaskFusionOptions(prob_spec);
+
   SchedulerCommon::problemSetup(prob_spec, materialManager);
 
 
   // this spawns threads, sets affinity, etc
   init_threads(this, num_threads);
 
+  if (m_parallel_compile) {
+    proc0cout << "Using " << Impl::g_num_threads << " threads to compile task graphs" << std::endl;
+  }
+
   // Setup the thread info mapper
   if( g_thread_stats || g_thread_indv_stats ) {
     m_thread_info.resize( Impl::g_num_threads );
@@ -459,12 +491,58 @@ UnifiedScheduler::problemSetup( const ProblemSpecP     & prob_spec
     m_thread_info.insert( Affinity  , std::string("Affinity")  , "CPU"     );
     m_thread_info.insert( NumTasks  , std::string("NumTasks")  , "tasks"   );
     m_thread_info.insert( NumPatches, std::string("NumPatches"), "patches" );
+    m_thread_info.insert( NumSteals,    std::string("NumSteals"),    "tasks" );
+    m_thread_info.insert( NumIdlePolls, std::string("NumIdlePolls"), "polls" );
 
     m_thread_info.calculateMinimum(true);
     m_thread_info.calculateStdDev (true);
   }
 }
 
+//______________________________________________________________________
+//
+int
+UnifiedScheduler::numCompileThreads()
+{
+  // the TaskRunners are only free between executes (not when a task compiles a sub-scheduler)
+  if (!m_parallel_compile || Impl::t_tid != 0 || Impl::g_run_tasks.load(std::memory_order_relaxed) == 1) {
+    return 1;
+  }
+  return Impl::g_num_threads;
+}
+
+//______________________________________________________________________
+//
+void
+UnifiedScheduler::runOnCompileThreads( const std::function<void(int)> & work )
+{
+  if (numCompileThreads() == 1) {
+    work(0);
+    return;
+  }
+
+  //------------------------------------------------------------------------------------------------
+  // activate TaskRunners, they run the work instead of runTasks()
+  //------------------------------------------------------------------------------------------------
+  Impl::g_compile_work.store(&work, std::memory_order_seq_cst);
+  for (int i = 1; i < Impl::g_num_threads; ++i) {
+    Impl::g_thread_states[i] = Impl::ThreadState::Active;
+  }
+
+  // main thread also does its share
+  work(Impl::t_tid);
+
+  //------------------------------------------------------------------------------------------------
+  // deactivate TaskRunners
+  //------------------------------------------------------------------------------------------------
+  Impl::thread_fence();
+
+  for (int i = 1; i < Impl::g_num_threads; ++i) {
+    Impl::g_thread_states[i] = Impl::ThreadState::Inactive;
+  }
+  Impl::g_compile_work.store(nullptr, std::memory_order_seq_cst);
+}
+
 //______________________________________________________________________
 //
 SchedulerP
@@ -709,6 +787,13 @@ UnifiedScheduler::execute( int tgnum       /* = 0 */
   m_phase_sync_task.clear();
   m_phase_sync_task.resize(m_num_phases, nullptr);
   m_detailed_tasks->setTaskPriorityAlg(m_task_queue_alg);
+  m_detailed_tasks->initWorkStealing(m_work_stealing ? Impl::g_num_threads : 0);
+  m_detailed_tasks->setTaskFusion(m_task_fusion);
+
+  for (int i = 0; i < Impl::g_num_threads; ++i) {
+    Impl::g_steal_counters[i].m_num_steals     = 0;
+    Impl::g_steal_counters[i].m_num_idle_polls = 0;
+  }
 
   // get the number of tasks in each task phase
   for (int i = 0; i < m_num_tasks; i++) {
@@ -814,6 +899,13 @@ UnifiedScheduler::execute( int tgnum       /* = 0 */
       }
     }
 
+    if( g_thread_stats || g_thread_indv_stats ) {
+      for (int i = 0; i < Impl::g_num_threads; ++i) {
+        m_thread_info[i][NumSteals]    = Impl::g_steal_counters[i].m_num_steals;
+        m_thread_info[i][NumIdlePolls] = Impl::g_steal_counters[i].m_num_idle_polls;
+      }
+    }
+
     MPIScheduler::computeNetRuntimeStats();
   }
 
@@ -844,11 +936,63 @@ UnifiedScheduler::execute( int tgnum       /* = 0 */
     MPIScheduler::outputTimingStats("UnifiedScheduler");
   }
 
+  if (g_steal_stats) {
+    reportStealStats();
+  }
+
+  if (m_parent_scheduler == nullptr) {
+    reportCommPlanStats();
+  }
+
   RuntimeStats::report(d_myworld->getComm());
 
 } // end execute()
 
 
+//______________________________________________________________________
+//
+void
+UnifiedScheduler::reportStealStats()
+{
+  int64_t num_steals     = 0;
+  int64_t num_idle_polls = 0;
+  for (int i = 0; i < Impl::g_num_threads; ++i) {
+    num_steals     += Impl::g_steal_counters[i].m_num_steals;
+    num_idle_polls += Impl::g_steal_counters[i].m_num_idle_polls;
+  }
+
+  RuntimeStats::register_report( g_steal_stats
+                               , "Count: Steals"
+                               , RuntimeStats::Count
+                               , [num_steals]() { return num_steals; }
+                               );
+  RuntimeStats::register_report( g_steal_stats
+                               , "Count: IdlePolls"
+                               , RuntimeStats::Count
+                               , [num_idle_polls]() { return num_idle_polls; }
+                               );
+}
+
+
+//______________________________________________________________________
+//
+DetailedTask*
+UnifiedScheduler::getNextExternalReadyTask( int thread_id )
+{
+  if (!m_detailed_tasks->usingWorkStealing()) {
+    return m_detailed_tasks->getNextExternalReadyTask();
+  }
+
+  bool stolen = false;
+  DetailedTask* dtask = m_detailed_tasks->getNextExternalReadyTask(thread_id, stolen);
+  if (stolen) {
+    ++Impl::g_steal_counters[thread_id].m_num_steals;
+  }
+
+  return dtask;
+}
+
+
 //______________________________________________________________________
 //
 void
@@ -890,6 +1034,24 @@ UnifiedScheduler::markTaskConsumed( int          & numTasksDone
   }
 }
 
+//______________________________________________________________________
+//
+void
+UnifiedScheduler::runFusedTasks( int thread_id )
+{
+  // A fused task's internal dependencies are satisfied and it has no external
+  // ones, so it skips the ready queues and runs here on this thread.
+  DetailedTask* fusedTask = nullptr;
+  while ((fusedTask = m_detailed_tasks->getNextFusedTask()) != nullptr) {
+
+    DOUT(g_task_dbg, myRankThread() << " Task fused " << *fusedTask);
+
+    fusedTask->markInitiated();
+    markTaskConsumed(m_num_tasks_done, m_curr_phase, m_num_phases, fusedTask);
+    runTask(fusedTask, m_curr_iteration, thread_id, Task::CPU);
+  }
+}
+
 //______________________________________________________________________
 //
 void
@@ -926,6 +1088,9 @@ UnifiedScheduler::runTasks( int thread_id )
     // ----------------------------------------------------------------------------------
     //g_scheduler_mutex.lock();
     while (!havework) {
+      // false once this pass has initiated a task
+      bool idle_pass = true;
+
       /*
        * (1.1)
        *
@@ -957,7 +1122,7 @@ UnifiedScheduler::runTasks( int thread_id )
        * NOTE: This is also where a GPU-enabled task gets into the GPU initially-ready queue
        *
        */
-      else if ((readyTask = m_detailed_tasks->getNextExternalReadyTask())) {
+      else if ((readyTask = getNextExternalReadyTask(thread_id))) {
         havework = true;
 #ifdef HAVE_CUDA
         /*
@@ -1002,6 +1167,7 @@ UnifiedScheduler::runTasks( int thread_id )
        *
        */
       else if ((initTask = m_detailed_tasks->getNextInternalReadyTask())) {
+        idle_pass = false;
         if (initTask->getTask()->getType() == Task::Reduction || initTask->getTask()->usesMPI()) {
           DOUT(g_task_dbg, myRankThread() <<  " Task internal ready 1 " << *initTask);
           m_phase_sync_task[initTask->getTask()->m_phase] = initTask;
@@ -1174,6 +1340,10 @@ UnifiedScheduler::runTasks( int thread_id )
           break;
         }
       }
+      if (!havework && idle_pass) {
+        ++Impl::g_steal_counters[thread_id].m_num_idle_polls;
+      }
+
       if (m_num_tasks_done == m_num_tasks) {
         break;
       }
@@ -1352,6 +1522,9 @@ UnifiedScheduler::runTasks( int thread_id )
 #endif
           // run CPU task.
           runTask(readyTask, m_curr_iteration, thread_id, Task::CPU);
+
+          // and then the tasks fused behind it
+          runFusedTasks(thread_id);
 #ifdef HAVE_CUDA
           //See note above near cpuInitReady.  Some CPU tasks may internally interact
           //with GPUs without modifying the structure of the data warehouse.
@@ -4872,6 +5045,13 @@ UnifiedSchedulerWorker::UnifiedSchedulerWorker( UnifiedScheduler * scheduler, in
 void
 UnifiedSchedulerWorker::run()
 {
+  // finding the dependencies of a task graph (see UnifiedScheduler::runOnCompileThreads)
+  const std::function<void(int)> * compile_work = Impl::g_compile_work.load(std::memory_order_seq_cst);
+  if (compile_work) {
+    (*compile_work)(Impl::t_tid);
+    return;
+  }
+
   while( Impl::g_run_tasks.load(std::memory_order_relaxed) == 1 ) {
     try {
       resetWaitTime();
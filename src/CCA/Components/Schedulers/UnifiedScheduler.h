@@ -100,6 +100,10 @@ class UnifiedScheduler : public MPIScheduler  {
     virtual void execute( int tgnum = 0, int iteration = 0 );
     
     virtual bool useInternalDeps() { return !m_is_copy_data_timestep; }
+
+    virtual int numCompileThreads();
+
+    virtual void runOnCompileThreads( const std::function<void(int)> & work );
     
     void runTask( DetailedTask * dtask , int iteration , int thread_id , Task::CallBackEvent event );
 
@@ -117,6 +121,8 @@ class UnifiedScheduler : public MPIScheduler  {
       , Affinity
       , NumTasks
       , NumPatches
+      , NumSteals
+      , NumIdlePolls
     };
     
     VectorInfoMapper< ThreadStatsEnum, double > m_thread_info;
@@ -135,6 +141,12 @@ class UnifiedScheduler : public MPIScheduler  {
 
     void markTaskConsumed( int & numTasksDone, int & currphase, int numPhases, DetailedTask * dtask );
 
+    void runFusedTasks( int thread_id );
+
+    DetailedTask* getNextExternalReadyTask( int thread_id );
+
+    void reportStealStats();
+
     static void init_threads( UnifiedScheduler * scheduler, int num_threads );
 
     // thread shared data, needs lock protection when accessed
@@ -145,6 +157,7 @@ class UnifiedScheduler : public MPIScheduler  {
     DetailedTasks              * m_detailed_tasks{nullptr};
 
     QueueAlg m_task_queue_alg{MostMessages};
+    bool     m_work_stealing{false};
     int      m_curr_iteration{0};
     int      m_num_tasks_done{0};
     int      m_num_tasks{0};
@@ -36,6 +36,8 @@ SRCS += \
         $(SRCDIR)/DetailedTask.cc             \
         $(SRCDIR)/DetailedTasks.cc            \
         $(SRCDIR)/DynamicMPIScheduler.cc      \
+        $(SRCDIR)/EpochReclaim.cc             \
+        $(SRCDIR)/GhostNeighborCache.cc       \
         $(SRCDIR)/KokkosOpenMPScheduler.cc    \
         $(SRCDIR)/MemoryLog.cc                \
         $(SRCDIR)/MPIScheduler.cc             \
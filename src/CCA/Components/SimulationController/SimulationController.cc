@@ -132,11 +132,16 @@ SimulationController::SimulationController( const ProcessorGroup * myworld
   m_runtime_stats.insert( TaskReduceCommTime,        std::string("TaskReduceCommTime"),    timeStr );
   m_runtime_stats.insert( TaskWaitThreadTime,        std::string("TaskWaitThread"),        timeStr );
 
+  m_runtime_stats.insert( CompilationDetailedTasksTime, std::string("CompilationDetailedTasks"), timeStr );
+  m_runtime_stats.insert( CompilationDependenciesTime,  std::string("CompilationDependencies"),  timeStr );
+  m_runtime_stats.insert( CompilationNeighborSearches,  std::string("CompilationNeighborSearches"), "searches" );
+
   m_runtime_stats.insert( XMLIOTime,                 std::string("XMLIO"),                 timeStr );
   m_runtime_stats.insert( OutputIOTime,              std::string("OutputIO"),              timeStr );
   m_runtime_stats.insert( OutputGlobalIOTime,        std::string("OutputGlobalIO"),        timeStr );
   m_runtime_stats.insert( CheckpointIOTime,          std::string("CheckpointIO"),          timeStr );
   m_runtime_stats.insert( CheckpointGlobalIOTime,    std::string("CheckpointGlobalIO"),    timeStr );
+  m_runtime_stats.insert( OutputAsyncWaitTime,       std::string("OutputAsyncWait"),       timeStr );
   m_runtime_stats.insert( TotalIOTime,               std::string("TotalIO"),               timeStr );
 
   m_runtime_stats.insert( OutputIORate,              std::string("OutputIORate"),           "MBytes/sec" );
@@ -24,6 +24,7 @@
 
 #include <CCA/Components/Solvers/CGSolver.h>
 #include <CCA/Components/Solvers/MatrixUtil.h>
+#include <CCA/Components/Solvers/PatchMultigrid.h>
 #include <Core/Grid/Variables/CCVariable.h>
 #include <Core/Grid/Grid.h>
 #include <Core/Grid/Level.h>
@@ -47,6 +48,8 @@
 #include <Core/Util/DebugStream.h>
 #include <Core/Util/Timers/Timers.hpp>
 #include <iomanip>
+#include <map>
+#include <mutex>
 
 using namespace std;
 using namespace Uintah;
@@ -217,6 +220,34 @@ void ScMult_Add(Array3<double>& r, double s,
   memrefs += diff.x()*diff.y()*diff.z()*3L*8L;
 }
 
+// Pipelined CG: the dot products of an iteration in a single pass,
+// gamma = (r,u), delta = (w,u), the L1 and LInfinity norms of u, and
+// with the Jacobi preconditioner m = diag*w.
+static void PipeDots(Array3<double>& m, const Array3<double>& r,
+                     const Array3<double>& u, const Array3<double>& w,
+                     const Array3<double>& diag, bool jacobi, CellIterator iter,
+                     double& gamma, double& delta, double& l1, double& linf,
+                     long64& flops, long64& memrefs)
+{
+  if(cout_doing.active())
+    cout_doing << "CGSolver::PipeDots" << endl;
+
+  gamma = delta = l1 = linf = 0;
+  for(; !iter.done(); ++iter){
+    IntVector idx = *iter;
+    double uu = u[idx];
+    gamma += r[idx]*uu;
+    delta += w[idx]*uu;
+    l1    += Abs(uu);
+    linf   = Max(linf, Abs(uu));
+    if(jacobi)
+      m[idx] = diag[idx]*w[idx];
+  }
+  IntVector diff = iter.end()-iter.begin();
+  flops += (jacobi?9:8)*diff.x()*diff.y()*diff.z();
+  memrefs += diff.x()*diff.y()*diff.z()*(jacobi?5L:3L)*8L;
+}
+
 namespace Uintah {
 
 
@@ -287,6 +318,16 @@ public:
     tmp_memref_label->schedReductionTask(false);
     memref_label = tmp_memref_label;
 
+    if(params->algorithm == CGSolverParams::Pipelined){
+      W_label    = VarLabel::create(A->getName()+" W", double_type::getTypeDescription());
+      M_label    = VarLabel::create(A->getName()+" M", double_type::getTypeDescription());
+      N_label    = VarLabel::create(A->getName()+" N", double_type::getTypeDescription());
+      Z_label    = VarLabel::create(A->getName()+" Z", double_type::getTypeDescription());
+      S_label    = VarLabel::create(A->getName()+" S", double_type::getTypeDescription());
+      P_label    = VarLabel::create(A->getName()+" P", double_type::getTypeDescription());
+      dots_label = VarLabel::create(A->getName()+" dots", sumvec_vartype::getTypeDescription());
+    }
+
     switch(params->norm){
     case CGSolverParams::L1:
       err_label = VarLabel::create(A->getName()+" err", sum_vartype::getTypeDescription());
@@ -314,6 +355,55 @@ public:
       VarLabel::destroy(err_label);
     }
     VarLabel::destroy(aden_label);
+
+    if(dots_label){
+      VarLabel::destroy(W_label);
+      VarLabel::destroy(M_label);
+      VarLabel::destroy(N_label);
+      VarLabel::destroy(Z_label);
+      VarLabel::destroy(S_label);
+      VarLabel::destroy(P_label);
+      VarLabel::destroy(dots_label);
+    }
+
+    for(auto& iter : multigrids){
+      delete iter.second;
+    }
+  }
+
+//______________________________________________________________________
+//  Builds the V-cycle of (patch, matl) from the current matrix.
+  void setupMultigrid(const Patch* patch, int matl,
+                      const Array3<Stencil7>& A, const CellIterator& iter)
+  {
+    PatchMultigrid* mg = scinew PatchMultigrid(A, iter.begin(), iter.end(),
+                                               params->mg_npre, params->mg_npost,
+                                               params->mg_maxlevels);
+
+    std::lock_guard<std::mutex> guard(multigrids_lock);
+    PatchMultigrid*& entry = multigrids[std::make_pair(patch->getID(), matl)];
+    delete entry;
+    entry = mg;
+  }
+
+//______________________________________________________________________
+//  Z = M^-1 R
+  void precondition(const Patch* patch, int matl,
+                    Array3<double>& Z, const Array3<double>& R,
+                    const Array3<double>& diagonal, const CellIterator& iter,
+                    long64& flops, long64& memrefs)
+  {
+    if(params->preconditioner == CGSolverParams::Multigrid){
+      const PatchMultigrid* mg;
+      {
+        std::lock_guard<std::mutex> guard(multigrids_lock);
+        mg = multigrids[std::make_pair(patch->getID(), matl)];
+      }
+      ASSERT(mg != nullptr);
+      mg->apply(Z, R, flops, memrefs);
+    } else {
+      ::Mult(Z, R, diagonal, iter, flops, memrefs);
+    }
   }
 //______________________________________________________________________
 //
@@ -439,8 +529,8 @@ public:
         // R = -a*Q+R
         ::ScMult_Add(Rnew, -a, Q, R, iter, flops, memrefs);
 
-        // Simple Preconditioning...
-        ::Mult(Q, Rnew, diagonal, iter, flops, memrefs);
+        // Preconditioning...
+        precondition(patch, matl, Q, Rnew, diagonal, iter, flops, memrefs);
 
         // Calculate coefficient bk and direction vectors p and pp
         double dnew = ::Dot(Q, Rnew, iter, flops, memrefs);
@@ -524,6 +614,258 @@ public:
       }
     }
   }
+//______________________________________________________________________
+//  Pipelined CG (P. Ghysels, W. Vanroose, "Hiding global synchronization
+//  latency in the preconditioned Conjugate Gradient algorithm").  D
+//  holds u = diag*r.  Each iteration is
+//
+//    pipeDots:   gamma = (r,u), delta = (w,u), m = diag*w  -> one reduction
+//    pipeMatvec: n = A*m                    (needs m, not the reduced dots)
+//    pipeUpdate: z = n + b*z,  q = m + b*q,  s = w + b*s,  p = u + b*p
+//                x = x + a*p,  r = r - a*s,  u = u - a*q,  w = w - a*z
+//
+//  pipeMatvec depends on pipeDots through M_label, but not on the
+//  reduction of the dots, so once pipeDots has run on a patch the
+//  scheduler can overlap the reduction with the ghost exchange of m and
+//  the stencil application.
+
+  // alpha and beta of the current iteration from its (reduced) dots.
+  void pipeCoefficients(const Vector& dots, double& alpha, double& beta) const
+  {
+    double gamma = dots.x();
+    double delta = dots.y();
+    if(pipe_first){
+      beta  = 0;
+      alpha = gamma/delta;
+    } else {
+      beta  = gamma/pipe_gamma_old;
+      alpha = gamma/(delta - beta*gamma/pipe_alpha_old);
+    }
+  }
+
+  CellIterator getIterator(const Patch* patch) const
+  {
+    typedef typename GridVarType::double_type double_type;
+    Patch::VariableBasis basis = Patch::translateTypeToBasis(double_type::getTypeDescription()->getType(), true);
+
+    if(params->getSolveOnExtraCells()){
+      return CellIterator(patch->getExtraLowIndex(basis, IntVector(0,0,0)),
+                          patch->getExtraHighIndex(basis, IntVector(0,0,0)));
+    }
+    return CellIterator(patch->getLowIndex(basis), patch->getHighIndex(basis));
+  }
+
+  // B = A*X on iter, X has one layer of ghosts towards the neighbors.
+  void stencilMult(const Patch* patch, Array3<double>& B, const Array3<Stencil7>& A,
+                   const Array3<double>& X, const CellIterator& iter,
+                   long64& flops, long64& memrefs) const
+  {
+    IntVector ll(iter.begin());
+    IntVector hh(iter.end());
+    ll -= IntVector(patch->getBCType(Patch::xminus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::yminus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::zminus) == Patch::Neighbor?1:0);
+
+    hh += IntVector(patch->getBCType(Patch::xplus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::yplus) == Patch::Neighbor?1:0,
+                    patch->getBCType(Patch::zplus) == Patch::Neighbor?1:0);
+    hh -= IntVector(1,1,1);
+
+    ::Mult(B, A, X, iter, ll, hh, flops, memrefs);
+  }
+
+//______________________________________________________________________
+//  requires A(parent), D(new, 1 ghost)  computes W, Z, Q, S, P
+  void pipeSetup(const ProcessorGroup *,
+                 const PatchSubset    * patches,
+                 const MaterialSubset * matls,
+                 DataWarehouse        *,
+                 DataWarehouse        * new_dw)
+  {
+    DataWarehouse* A_dw = new_dw->getOtherDataWarehouse(parent_which_A_dw);
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "CGSolver::pipeSetup on patch " << patch->getID()<< endl;
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+        CellIterator iter = getIterator(patch);
+
+        typename GridVarType::matrix_type A;
+        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::const_double_type U;
+        new_dw->get(U, D_label, matl, patch, Around, 1);
+
+        typename GridVarType::double_type W, Z, Q, S, P;
+        new_dw->allocateAndPut(W, W_label, matl, patch);
+        new_dw->allocateAndPut(Z, Z_label, matl, patch);
+        new_dw->allocateAndPut(Q, Q_label, matl, patch);
+        new_dw->allocateAndPut(S, S_label, matl, patch);
+        new_dw->allocateAndPut(P, P_label, matl, patch);
+        Z.initialize(0);
+        Q.initialize(0);
+        S.initialize(0);
+        P.initialize(0);
+
+        // W = A*U
+        long64 flops = 0;
+        long64 memrefs = 0;
+        stencilMult(patch, W, A, U, iter, flops, memrefs);
+
+        new_dw->put(sumlong_vartype(flops), flop_label);
+        new_dw->put(sumlong_vartype(memrefs), memref_label);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  requires R, D, W, diag(old)  computes M, dots, err (LInfinity)
+  void pipeDots(const ProcessorGroup *,
+                const PatchSubset    * patches,
+                const MaterialSubset * matls,
+                DataWarehouse        * old_dw,
+                DataWarehouse        * new_dw)
+  {
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "CGSolver::pipeDots on patch " << patch->getID()<< endl;
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+        CellIterator iter = getIterator(patch);
+
+        typename GridVarType::const_double_type R, U, W, diagonal;
+        old_dw->get(R,        R_label,    matl, patch, Ghost::None, 0);
+        old_dw->get(U,        D_label,    matl, patch, Ghost::None, 0);
+        old_dw->get(W,        W_label,    matl, patch, Ghost::None, 0);
+        old_dw->get(diagonal, diag_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::double_type M;
+        new_dw->allocateAndPut(M, M_label, matl, patch);
+
+        long64 flops = 0;
+        long64 memrefs = 0;
+        double gamma, delta, l1, linf;
+        bool jacobi = params->preconditioner == CGSolverParams::Jacobi;
+        ::PipeDots(M, R, U, W, diagonal, jacobi, iter, gamma, delta, l1, linf, flops, memrefs);
+        if(!jacobi){
+          precondition(patch, matl, M, W, diagonal, iter, flops, memrefs);
+        }
+
+        new_dw->put(sumvec_vartype(Vector(gamma, delta, l1)), dots_label);
+        if(params->norm == CGSolverParams::LInfinity){
+          new_dw->put(max_vartype(linf), err_label);
+        }
+        new_dw->put(sumlong_vartype(flops), flop_label);
+        new_dw->put(sumlong_vartype(memrefs), memref_label);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  requires A(parent), M(new, 1 ghost)  computes N
+  void pipeMatvec(const ProcessorGroup *,
+                  const PatchSubset    * patches,
+                  const MaterialSubset * matls,
+                  DataWarehouse        *,
+                  DataWarehouse        * new_dw)
+  {
+    DataWarehouse* A_dw = new_dw->getOtherDataWarehouse(parent_which_A_dw);
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "CGSolver::pipeMatvec on patch " << patch->getID()<< endl;
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+        CellIterator iter = getIterator(patch);
+
+        typename GridVarType::matrix_type A;
+        A_dw->get(A, A_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::const_double_type M;
+        new_dw->get(M, M_label, matl, patch, Around, 1);
+
+        typename GridVarType::double_type N;
+        new_dw->allocateAndPut(N, N_label, matl, patch);
+
+        // N = A*M
+        long64 flops = 0;
+        long64 memrefs = 0;
+        stencilMult(patch, N, A, M, iter, flops, memrefs);
+
+        new_dw->put(sumlong_vartype(flops), flop_label);
+        new_dw->put(sumlong_vartype(memrefs), memref_label);
+      }
+    }
+  }
+
+//______________________________________________________________________
+//  requires dots, N, M(new), X, R, D, W, Z, Q, S, P, diag(old)
+//  computes X, R, D, W, Z, Q, S, P, diag
+  void pipeUpdate(const ProcessorGroup *,
+                  const PatchSubset    * patches,
+                  const MaterialSubset * matls,
+                  DataWarehouse        * old_dw,
+                  DataWarehouse        * new_dw)
+  {
+    sumvec_vartype dots;
+    new_dw->get(dots, dots_label);
+
+    double a, b;
+    pipeCoefficients(dots, a, b);
+
+    for(int p=0;p<patches->size();p++){
+      const Patch* patch = patches->get(p);
+      if(cout_doing.active())
+        cout_doing << "CGSolver::pipeUpdate on patch " << patch->getID()<< endl;
+      for(int m = 0;m<matls->size();m++){
+        int matl = matls->get(m);
+        CellIterator iter = getIterator(patch);
+
+        typename GridVarType::const_double_type N, M;
+        new_dw->get(N, N_label, matl, patch, Ghost::None, 0);
+        new_dw->get(M, M_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::const_double_type X, R, U, W, Z, Q, S, P;
+        old_dw->get(X, X_label, matl, patch, Ghost::None, 0);
+        old_dw->get(R, R_label, matl, patch, Ghost::None, 0);
+        old_dw->get(U, D_label, matl, patch, Ghost::None, 0);
+        old_dw->get(W, W_label, matl, patch, Ghost::None, 0);
+        old_dw->get(Z, Z_label, matl, patch, Ghost::None, 0);
+        old_dw->get(Q, Q_label, matl, patch, Ghost::None, 0);
+        old_dw->get(S, S_label, matl, patch, Ghost::None, 0);
+        old_dw->get(P, P_label, matl, patch, Ghost::None, 0);
+
+        typename GridVarType::double_type Xnew, Rnew, Unew, Wnew, Znew, Qnew, Snew, Pnew;
+        new_dw->allocateAndPut(Xnew, X_label, matl, patch);
+        new_dw->allocateAndPut(Rnew, R_label, matl, patch);
+        new_dw->allocateAndPut(Unew, D_label, matl, patch);
+        new_dw->allocateAndPut(Wnew, W_label, matl, patch);
+        new_dw->allocateAndPut(Znew, Z_label, matl, patch);
+        new_dw->allocateAndPut(Qnew, Q_label, matl, patch);
+        new_dw->allocateAndPut(Snew, S_label, matl, patch);
+        new_dw->allocateAndPut(Pnew, P_label, matl, patch);
+
+        long64 flops = 0;
+        long64 memrefs = 0;
+        ::ScMult_Add(Znew, b, Z, N, iter, flops, memrefs);
+        ::ScMult_Add(Qnew, b, Q, M, iter, flops, memrefs);
+        ::ScMult_Add(Snew, b, S, W, iter, flops, memrefs);
+        ::ScMult_Add(Pnew, b, P, U, iter, flops, memrefs);
+
+        ::ScMult_Add(Xnew,  a, Pnew, X, iter, flops, memrefs);
+        ::ScMult_Add(Rnew, -a, Snew, R, iter, flops, memrefs);
+        ::ScMult_Add(Unew, -a, Qnew, U, iter, flops, memrefs);
+        ::ScMult_Add(Wnew, -a, Znew, W, iter, flops, memrefs);
+
+        new_dw->put(sumlong_vartype(flops), flop_label);
+        new_dw->put(sumlong_vartype(memrefs), memref_label);
+      }
+    }
+    new_dw->transferFrom(old_dw, diag_label, patches, matls);
+  }
+
 //______________________________________________________________________
   void setup(const ProcessorGroup *, 
              const PatchSubset    * patches,
@@ -599,7 +941,10 @@ public:
         new_dw->allocateAndPut(D, D_label, matl, patch);
 
         ::InverseDiagonal(diagonal, A, iter, flops, memrefs);
-        ::Mult(D, R, diagonal, iter, flops, memrefs);
+        if(params->preconditioner == CGSolverParams::Multigrid){
+          setupMultigrid(patch, matl, A, iter);
+        }
+        precondition(patch, matl, D, R, diagonal, iter, flops, memrefs);
 
         double dnew = ::Dot(R, D, iter, flops, memrefs);
         new_dw->put(sum_vartype(dnew), d_label);
@@ -635,6 +980,99 @@ public:
     }
   }
 
+  //______________________________________________________________________
+  //  pipeDots computes both m and the local dots; pipeMatvec requires m
+  //  (with ghosts) from it, only pipeUpdate requires the reduced dots.
+  //  The dots reduction is therefore in flight while pipeMatvec
+  //  exchanges the ghost cells of m and applies the stencil.
+  void schedulePipelinedIteration(SchedulerP& subsched)
+  {
+    if(cout_doing.active())
+      cout_doing << "CGSolver::schedule pipelined iteration" << endl;
+
+    Task* task = scinew Task("CGSolver:pipeDots", this, &CGStencil7<GridVarType>::pipeDots);
+    task->requires(Task::OldDW, R_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, D_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, W_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, diag_label, Ghost::None, 0);
+    task->computes(M_label);
+    task->computes(dots_label);
+    if(params->norm == CGSolverParams::LInfinity){
+      task->computes(err_label);
+    }
+    task->computes(flop_label);
+    task->computes(memref_label);
+    subsched->addTask(task, level->eachPatch(), matlset);
+
+    task = scinew Task("CGSolver:pipeMatvec", this, &CGStencil7<GridVarType>::pipeMatvec);
+    task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+    task->requires(Task::NewDW,       M_label, Around, 1);
+    task->computes(N_label);
+    task->computes(flop_label);
+    task->modifies(memref_label);
+    subsched->addTask(task, level->eachPatch(), matlset);
+
+    task = scinew Task("CGSolver:pipeUpdate", this, &CGStencil7<GridVarType>::pipeUpdate);
+    task->requires(Task::NewDW, dots_label);
+    task->requires(Task::NewDW, N_label,    Ghost::None, 0);
+    task->requires(Task::NewDW, M_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, X_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, R_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, D_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, W_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, Z_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, Q_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, S_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, P_label,    Ghost::None, 0);
+    task->requires(Task::OldDW, diag_label, Ghost::None, 0);
+    task->computes(X_label);
+    task->computes(R_label);
+    task->computes(D_label);
+    task->computes(W_label);
+    task->computes(Z_label);
+    task->computes(Q_label);
+    task->computes(S_label);
+    task->computes(P_label);
+    task->computes(diag_label);
+    task->computes(flop_label);
+    task->modifies(memref_label);
+    subsched->addTask(task, level->eachPatch(), matlset);
+  }
+
+  //______________________________________________________________________
+  //  Error of the residual the dots were computed from (one iteration
+  //  behind X) and advance the recurrence state used by pipeUpdate.
+  double pipeError(DataWarehouse* subNewDW)
+  {
+    sumvec_vartype dotsVar;
+    subNewDW->get(dotsVar, dots_label);
+    Vector dots = dotsVar;
+
+    double e = 0;
+    switch(params->norm){
+    case CGSolverParams::L1:
+      e = dots.z();
+      break;
+    case CGSolverParams::L2:
+      e = dots.x();
+      break;
+    case CGSolverParams::LInfinity:
+      {
+        max_vartype err;
+        subNewDW->get(err, err_label);
+        e = err;
+      }
+      break;
+    }
+
+    double alpha, beta;
+    pipeCoefficients(dots, alpha, beta);
+    pipe_gamma_old = dots.x();
+    pipe_alpha_old = alpha;
+    pipe_first     = false;
+    return e;
+  }
+
   //______________________________________________________________________
   void solve(const ProcessorGroup * pg, 
              const PatchSubset    * patches,
@@ -693,6 +1131,22 @@ public:
     task->computes(flop_label);
     subsched->addTask(task, level->eachPatch(), matlset);
 
+    if(params->algorithm == CGSolverParams::Pipelined){
+      pipe_first = true;
+
+      task = scinew Task("CGSolver:pipeSetup", this, &CGStencil7<GridVarType>::pipeSetup);
+      task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+      task->requires(Task::NewDW,       D_label, Around, 1);
+      task->computes(W_label);
+      task->computes(Z_label);
+      task->computes(Q_label);
+      task->computes(S_label);
+      task->computes(P_label);
+      task->computes(flop_label);
+      task->modifies(memref_label);
+      subsched->addTask(task, level->eachPatch(), matlset);
+    }
+
     subsched->compile();
     
     DataWarehouse* subNewDW = subsched->get_dw(3);
@@ -743,59 +1197,63 @@ public:
       subsched->mapDataWarehouse(Task::OldDW, 2);
       subsched->mapDataWarehouse(Task::NewDW, 3);
 
-      //__________________________________
-      // Step 1 - requires A(parent), D(old, 1 ghost) computes aden(new)
-      if(cout_doing.active())
-        cout_doing << "CGSolver::schedule Step 1" << endl;
-      task = scinew Task("CGSolver:step1", this, &CGStencil7<GridVarType>::step1);
-      task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
-      task->requires(Task::OldDW,       D_label, Around, 1);
-      task->computes(aden_label);
-      task->computes(Q_label);
-      task->computes(flop_label);
-      task->computes(memref_label);
-      subsched->addTask(task, level->eachPatch(), matlset);
+      if(params->algorithm == CGSolverParams::Pipelined){
+        schedulePipelinedIteration(subsched);
+      } else {
+        //__________________________________
+        // Step 1 - requires A(parent), D(old, 1 ghost) computes aden(new)
+        if(cout_doing.active())
+          cout_doing << "CGSolver::schedule Step 1" << endl;
+        task = scinew Task("CGSolver:step1", this, &CGStencil7<GridVarType>::step1);
+        task->requires(parent_which_A_dw, A_label, Ghost::None, 0);
+        task->requires(Task::OldDW,       D_label, Around, 1);
+        task->computes(aden_label);
+        task->computes(Q_label);
+        task->computes(flop_label);
+        task->computes(memref_label);
+        subsched->addTask(task, level->eachPatch(), matlset);
 
-      //__________________________________
-      // schedule
-      // Step 2 - requires d(old), aden(new) D(old), X(old) R(old)  computes X, R, Q, d
-      if(cout_doing.active())
-        cout_doing << "CGSolver::schedule Step 2" << endl;
-      task = scinew Task("CGSolver:step2", this, &CGStencil7<GridVarType>::step2);
-      task->requires(Task::OldDW, d_label);
-      task->requires(Task::NewDW, aden_label);
-      task->requires(Task::OldDW, D_label,    Ghost::None, 0);
-      task->requires(Task::OldDW, X_label,    Ghost::None, 0);
-      task->requires(Task::OldDW, R_label,    Ghost::None, 0);
-      task->requires(Task::OldDW, diag_label, Ghost::None, 0);
-      task->computes(X_label);
-      task->computes(R_label);
-      task->modifies(Q_label);
-      task->computes(d_label);
-      task->computes(diag_label);
-      task->computes(flop_label);
-      task->modifies(memref_label);
+        //__________________________________
+        // schedule
+        // Step 2 - requires d(old), aden(new) D(old), X(old) R(old)  computes X, R, Q, d
+        if(cout_doing.active())
+          cout_doing << "CGSolver::schedule Step 2" << endl;
+        task = scinew Task("CGSolver:step2", this, &CGStencil7<GridVarType>::step2);
+        task->requires(Task::OldDW, d_label);
+        task->requires(Task::NewDW, aden_label);
+        task->requires(Task::OldDW, D_label,    Ghost::None, 0);
+        task->requires(Task::OldDW, X_label,    Ghost::None, 0);
+        task->requires(Task::OldDW, R_label,    Ghost::None, 0);
+        task->requires(Task::OldDW, diag_label, Ghost::None, 0);
+        task->computes(X_label);
+        task->computes(R_label);
+        task->modifies(Q_label);
+        task->computes(d_label);
+        task->computes(diag_label);
+        task->computes(flop_label);
+        task->modifies(memref_label);
       
-      if(params->norm != CGSolverParams::L2) {
-        task->computes(err_label);
-      }
-      subsched->addTask(task, level->eachPatch(), matlset);
+        if(params->norm != CGSolverParams::L2) {
+          task->computes(err_label);
+        }
+        subsched->addTask(task, level->eachPatch(), matlset);
 
 
-      //__________________________________
-      // schedule
-      // Step 3 - requires D(old), Q(new), d(new), d(old), computes D
-      if(cout_doing.active())
-        cout_doing << "CGSolver::schedule Step 3" << endl;
-      task = scinew Task("CGSolver:step3", this, &CGStencil7<GridVarType>::step3);
-      task->requires(Task::OldDW, D_label, Ghost::None, 0);
-      task->requires(Task::NewDW, Q_label, Ghost::None, 0);
-      task->requires(Task::NewDW, d_label);
-      task->requires(Task::OldDW, d_label);
-      task->computes(D_label);
-      task->computes(flop_label);
-      task->modifies(memref_label);
-      subsched->addTask(task, level->eachPatch(), matlset);
+        //__________________________________
+        // schedule
+        // Step 3 - requires D(old), Q(new), d(new), d(old), computes D
+        if(cout_doing.active())
+          cout_doing << "CGSolver::schedule Step 3" << endl;
+        task = scinew Task("CGSolver:step3", this, &CGStencil7<GridVarType>::step3);
+        task->requires(Task::OldDW, D_label, Ghost::None, 0);
+        task->requires(Task::NewDW, Q_label, Ghost::None, 0);
+        task->requires(Task::NewDW, d_label);
+        task->requires(Task::OldDW, d_label);
+        task->computes(D_label);
+        task->computes(flop_label);
+        task->modifies(memref_label);
+        subsched->addTask(task, level->eachPatch(), matlset);
+      }
       subsched->compile();
 
       //__________________________________
@@ -812,22 +1270,26 @@ public:
         subsched->execute();
 
         //__________________________________
-        switch(params->norm){
-        case CGSolverParams::L1:
-        case CGSolverParams::L2:
-          {
-            sum_vartype err;
-            subNewDW->get(err, err_label);
-            e=err;
-          }
-          break;
-        case CGSolverParams::LInfinity:
-          {
-            max_vartype err;
-            subNewDW->get(err, err_label);
-            e=err;
+        if(params->algorithm == CGSolverParams::Pipelined){
+          e = pipeError(subNewDW);
+        } else {
+          switch(params->norm){
+          case CGSolverParams::L1:
+          case CGSolverParams::L2:
+            {
+              sum_vartype err;
+              subNewDW->get(err, err_label);
+              e=err;
+            }
+            break;
+          case CGSolverParams::LInfinity:
+            {
+              max_vartype err;
+              subNewDW->get(err, err_label);
+              e=err;
+            }
+            break;
           }
-          break;
         }
         if(params->criteria == CGSolverParams::Relative){
           e/=err0;
@@ -931,6 +1393,24 @@ private:
   const VarLabel* memref_label;
   const VarLabel* tolerance_label;
 
+  // Pipelined CG only
+  const VarLabel* W_label{nullptr};     // A*U, U is stored in D_label
+  const VarLabel* M_label{nullptr};     // diag*W
+  const VarLabel* N_label{nullptr};     // A*M
+  const VarLabel* Z_label{nullptr};
+  const VarLabel* S_label{nullptr};
+  const VarLabel* P_label{nullptr};
+  const VarLabel* dots_label{nullptr};  // (gamma, delta, L1 norm of U)
+
+  // gamma and alpha of the previous iteration, identical on all ranks
+  bool   pipe_first{true};
+  double pipe_gamma_old{0};
+  double pipe_alpha_old{0};
+
+  // Multigrid preconditioner of each (patch, matl), rebuilt by setup.
+  std::map<std::pair<int,int>, PatchMultigrid*> multigrids;
+  std::mutex multigrids_lock;
+
   const CGSolverParams* params;
   bool modifies_x;
 };
@@ -977,6 +1457,29 @@ void CGSolver::readParameters(ProblemSpecP& params_ps,
           throw ProblemSetupException("Unknown norm type: "+norm, __FILE__, __LINE__);
         }
       }
+      // <solver> is shared with the hypre solvers, only the pipelined
+      // variant is recognized here.
+      string solver;
+      if(param_ps->get("solver", solver)){
+        if(solver == "pipecg" || solver == "PipeCG" || solver == "pipelined") {
+          m_params->algorithm = CGSolverParams::Pipelined;
+        } else {
+          m_params->algorithm = CGSolverParams::Standard;
+        }
+      }
+      // <preconditioner> is shared with the hypre solvers as well.
+      string precond;
+      if(param_ps->get("preconditioner", precond)){
+        if(precond == "mg" || precond == "MG" || precond == "multigrid") {
+          m_params->preconditioner = CGSolverParams::Multigrid;
+        } else {
+          m_params->preconditioner = CGSolverParams::Jacobi;
+        }
+      }
+      param_ps->get("npre",         m_params->mg_npre);
+      param_ps->get("npost",        m_params->mg_npost);
+      param_ps->get("mg_maxlevels", m_params->mg_maxlevels);
+
       string criteria;
       if(param_ps->get("criteria", criteria)){
         if(criteria == "Absolute" || criteria == "absolute") {
@@ -993,6 +1496,18 @@ void CGSolver::readParameters(ProblemSpecP& params_ps,
   if(m_params->norm == CGSolverParams::L2){
     m_params->tolerance *= m_params->tolerance;
   }
+
+  // Forward Gauss-Seidel before and backward Gauss-Seidel after the
+  // coarse grid correction keep the V-cycle symmetric only if both
+  // do the same number of sweeps.
+  if(m_params->preconditioner == CGSolverParams::Multigrid){
+    if(m_params->mg_npre != m_params->mg_npost || m_params->mg_npre < 1){
+      throw ProblemSetupException("CGSolver: the multigrid preconditioner requires npre == npost >= 1", __FILE__, __LINE__);
+    }
+    if(m_params->mg_maxlevels < 1){
+      throw ProblemSetupException("CGSolver: mg_maxlevels must be positive", __FILE__, __LINE__);
+    }
+  }
 }
 
 //______________________________________________________________________
@@ -1019,6 +1534,10 @@ void CGSolver::scheduleSolve(const LevelP       & level,
   ASSERTEQ(domtype, x->typeDescription()->getType());
   ASSERTEQ(domtype, b->typeDescription()->getType());
   
+  if(m_params->preconditioner == CGSolverParams::Multigrid && domtype != TypeDescription::CCVariable){
+    throw ProblemSetupException("CGSolver: the multigrid preconditioner is only available for CC variables", __FILE__, __LINE__);
+  }
+
   Ghost::GhostType Around;
 
   switch(domtype){
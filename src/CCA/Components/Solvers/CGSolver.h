@@ -49,12 +49,38 @@ namespace Uintah {
     };
     
     Criteria criteria;
+
+    // Standard: Jacobi preconditioned CG, three reductions per iteration.
+    // Pipelined: Ghysels-Vanroose pipelined CG, the dot products of an
+    // iteration are fused into one reduction that does not depend on
+    // the stencil application of the same iteration.
+    enum Algorithm {
+      Standard, Pipelined
+    };
+
+    Algorithm algorithm;
+
+    // Jacobi: inverse of the diagonal.
+    // Multigrid: one geometric multigrid V-cycle per patch (CC only).
+    enum Preconditioner {
+      Jacobi, Multigrid
+    };
+
+    Preconditioner preconditioner;
+    int mg_npre;
+    int mg_npost;
+    int mg_maxlevels;
     
     CGSolverParams()
       : tolerance(1.e-8)
       , initial_tolerance(1.e-15)
       , norm(L2)
       , criteria(Relative)
+      , algorithm(Standard)
+      , preconditioner(Jacobi)
+      , mg_npre(1)
+      , mg_npost(1)
+      , mg_maxlevels(20)
     {}
     
     ~CGSolverParams() {}
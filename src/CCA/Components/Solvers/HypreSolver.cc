@@ -42,6 +42,7 @@
 #include <Core/Exceptions/ConvergenceFailure.h>
 #include <Core/Parallel/ProcessorGroup.h>
 #include <Core/ProblemSpec/ProblemSpec.h>
+#include <CCA/Ports/ApplicationInterface.h>
 #include <CCA/Ports/Scheduler.h>
 #include <CCA/Ports/LoadBalancer.h>
 #include <Core/Geometry/IntVector.h>
@@ -102,6 +103,7 @@ namespace Uintah {
                  ,       Task::WhichDW    which_guess_dw_in
                  , const HypreParams    * params_in
                  ,       bool             isFirstSolve_in
+                 ,       ApplicationInterface * application_in
                  )
       : m_level(level_in)
       , m_matlset(matlset_in)
@@ -115,6 +117,7 @@ namespace Uintah {
       , m_which_guess_dw(which_guess_dw_in)
       , m_params(params_in)
       , m_isFirstSolve(isFirstSolve_in)
+      , m_application(application_in)
     {
       // Time Step
       m_timeStepLabel    = VarLabel::create(timeStep_name, timeStep_vartype::getTypeDescription() );
@@ -217,6 +220,35 @@ namespace Uintah {
       return *HQ;
     }
 
+    //---------------------------------------------------------------------------------------------
+    //   Compare the local boxes with the ones the cached hypre objects
+    //   were built on.  A regrid or a new load balance recompiles the
+    //   task graph on every rank, so this is called collectively.
+    bool structureChanged( const ProcessorGroup       * pg
+                         , const PatchSubset          * patches
+                         , struct hypre_solver_struct * hypre_solver_s )
+    {
+      std::vector<int> structure;
+      structure.push_back( m_level->getIndex() );
+
+      for(int p=0;p<patches->size();p++){
+        IntVector lo;
+        IntVector hi;
+        getPatchExtents( patches->get(p), lo, hi );
+        for(int i=0;i<3;i++){
+          structure.push_back( lo[i] );
+          structure.push_back( hi[i] );
+        }
+      }
+
+      int changed = ( !hypre_solver_s->structure.empty() && hypre_solver_s->structure != structure );
+      hypre_solver_s->structure.swap( structure );
+
+      int anyChanged = 0;
+      Uintah::MPI::Allreduce( &changed, &anyChanged, 1, MPI_INT, MPI_LOR, pg->getComm() );
+      return anyChanged;
+    }
+
     //---------------------------------------------------------------------------------------------
 
     void solve( const ProcessorGroup * pg
@@ -295,6 +327,22 @@ namespace Uintah {
         do_setup    = false;
       }
 
+      // The grid of the cached objects is stale after a regrid or load balance
+      if( m_firstPassThrough && structureChanged( pg, patches, hypre_solver_s ) ){
+        do_setup = ( timeStep != 1 && !recompute );
+      }
+
+      //________________________________________________________
+      // Solver/preconditioner setup reuse - with a cached matrix the setup
+      // is recomputed from the current coefficients every solverSetupReuse solves
+      //
+      const bool newStructure  = ( timeStep == 1 || recompute || do_setup );
+      const int  setupReuse    = m_params->solverSetupReuse;
+      const bool refreshSolver = ( !newStructure && setupReuse > 0 &&
+                                   hypre_solver_s->solvesSinceSetup >= setupReuse );
+      const bool destroySolver = ( do_setup || refreshSolver );
+      const bool createSolver  = ( newStructure || refreshSolver );
+
       //std::cout << "      HypreSolve  timestep: " << timeStep << " recompute: " << recompute << " m_firstPassThrough: " << m_firstPassThrough <<  " m_isFirstSolve: " << m_isFirstSolve <<" do_setup: " << do_setup << " updateCoefs: " << updateCoefs << std::endl;
 
       DataWarehouse* A_dw     = new_dw->getOtherDataWarehouse( m_which_A_dw );
@@ -310,6 +358,8 @@ namespace Uintah {
         int matl = matls->get(m);
 
         hypre_BeginTiming(m_tMatVecSetup);
+        Timers::Simple setup_timer;
+        setup_timer.start();
         //__________________________________
         // Setup grid
         HYPRE_StructGrid grid;
@@ -523,9 +573,12 @@ namespace Uintah {
         HX = createPopulateHypreVector(  timeStep, recompute, do_setup, pg, grid, patches, matl, m_guess_label, guess_dw, hypre_solver_s->HX_p);
 
         hypre_EndTiming( m_tMatVecSetup );
+        setup_timer.stop();
 
         //__________________________________
+        // solve_timer includes the solver setup, which is also added to setup_timer
         Timers::Simple solve_timer;
+        Timers::Simple solverSetup_timer;
         solve_timer.start();
 
         hypre_BeginTiming(m_tSolveOnly);
@@ -541,11 +594,12 @@ namespace Uintah {
         case smg: {
           HYPRE_StructSolver * solver  = hypre_solver_s->solver_p;
 
-          if ( do_setup ){
+          if ( destroySolver ){
             HYPRE_StructSMGDestroy( *solver );
           }
 
-          if (timeStep == 1 || recompute || do_setup) {
+          if ( createSolver ) {
+            solverSetup_timer.start();
 
             HYPRE_StructSMGCreate         (pg->getComm(), solver);
             HYPRE_StructSMGSetMemoryUse   (*solver,  0);
@@ -557,6 +611,7 @@ namespace Uintah {
             HYPRE_StructSMGSetLogging     (*solver,  m_params->logging);
 
             HYPRE_StructSMGSetup (*solver,  *HA, HB, HX);
+            solverSetup_timer.stop();
           }
 
           HYPRE_StructSMGSolve(*solver, *HA, HB, HX);
@@ -571,11 +626,12 @@ namespace Uintah {
 
           HYPRE_StructSolver* solver =  hypre_solver_s->solver_p;
 
-          if ( do_setup ){
+          if ( destroySolver ){
             HYPRE_StructPFMGDestroy( *solver );
           }
 
-          if ( timeStep == 1 || recompute || do_setup ) {
+          if ( createSolver ) {
+            solverSetup_timer.start();
 
             HYPRE_StructPFMGCreate        ( pg->getComm(), solver );
             HYPRE_StructPFMGSetMaxIter    (*solver,   m_params->maxiterations);
@@ -590,6 +646,7 @@ namespace Uintah {
             HYPRE_StructPFMGSetLogging     (*solver,  m_params->logging);
 
             HYPRE_StructPFMGSetup          (*solver,  *HA, HB,  HX);
+            solverSetup_timer.stop();
           }
 
           HYPRE_StructPFMGSolve(*solver, *HA, HB, HX);
@@ -604,11 +661,12 @@ namespace Uintah {
         case sparsemsg:{
 
           HYPRE_StructSolver* solver = hypre_solver_s->solver_p;
-          if ( do_setup ){
+          if ( destroySolver ){
             HYPRE_StructSparseMSGDestroy(*solver);
           }
 
-          if ( timeStep == 1 || recompute || do_setup ) {
+          if ( createSolver ) {
+            solverSetup_timer.start();
 
             HYPRE_StructSparseMSGCreate      (pg->getComm(), solver);
             HYPRE_StructSparseMSGSetMaxIter  (*solver, m_params->maxiterations);
@@ -623,6 +681,7 @@ namespace Uintah {
             HYPRE_StructSparseMSGSetLogging     (*solver,  m_params->logging);
 
             HYPRE_StructSparseMSGSetup(*solver, *HA, HB,  HX);
+            solverSetup_timer.stop();
           }
 
           HYPRE_StructSparseMSGSolve(*solver, *HA, HB, HX);
@@ -639,12 +698,13 @@ namespace Uintah {
           HYPRE_StructSolver * solver         = hypre_solver_s->solver_p;
           HYPRE_StructSolver * precond_solver = hypre_solver_s->precond_solver_p;
 
-          if( do_setup ){
+          if ( destroySolver ){
             destroyPrecond( hypre_solver_s, *precond_solver );
             HYPRE_StructPCGDestroy(*solver);
           }
 
-          if (timeStep == 1 || recompute || do_setup) {
+          if ( createSolver ) {
+            solverSetup_timer.start();
             HYPRE_StructPCGCreate(pg->getComm(),solver);
 
             HYPRE_PtrToStructSolverFcn precond;
@@ -660,6 +720,7 @@ namespace Uintah {
             HYPRE_StructPCGSetLogging   (*solver,  m_params->logging);
 
             HYPRE_StructPCGSetup        (*solver, *HA,HB, HX);
+            solverSetup_timer.stop();
           }
 
           HYPRE_StructPCGSolve(*solver, *HA, HB, HX);
@@ -676,12 +737,13 @@ namespace Uintah {
           HYPRE_StructSolver * solver         = hypre_solver_s->solver_p;
           HYPRE_StructSolver * precond_solver = hypre_solver_s->precond_solver_p;
 
-          if ( do_setup ){
+          if ( destroySolver ){
             destroyPrecond( hypre_solver_s, *precond_solver );
             HYPRE_StructHybridDestroy( *solver );
           }
 
-          if ( timeStep == 1 || recompute || do_setup ) {
+          if ( createSolver ) {
+            solverSetup_timer.start();
             HYPRE_StructHybridCreate(pg->getComm(), solver);
 
             HYPRE_PtrToStructSolverFcn precond;
@@ -699,6 +761,7 @@ namespace Uintah {
             HYPRE_StructHybridSetLogging        (*solver, m_params->logging);
 
             HYPRE_StructHybridSetup             (*solver, *HA, HB, HX);
+            solverSetup_timer.stop();
           }
 
           HYPRE_StructHybridSolve(*solver, *HA, HB, HX);
@@ -714,11 +777,12 @@ namespace Uintah {
           HYPRE_StructSolver * solver         = hypre_solver_s->solver_p;
           HYPRE_StructSolver * precond_solver = hypre_solver_s->precond_solver_p;
 
-          if ( do_setup ){
+          if ( destroySolver ){
             destroyPrecond( hypre_solver_s, *precond_solver );
             HYPRE_StructGMRESDestroy(*solver);
           }
-          if (timeStep == 1 || recompute || do_setup ) {
+          if ( createSolver ) {
+            solverSetup_timer.start();
             HYPRE_StructGMRESCreate(pg->getComm(),solver);
 
             HYPRE_PtrToStructSolverFcn precond;
@@ -733,6 +797,7 @@ namespace Uintah {
             HYPRE_StructGMRESSetLogging  (*solver, m_params->logging);
 
             HYPRE_StructGMRESSetup       (*solver,*HA,HB,HX);
+            solverSetup_timer.stop();
           }
 
           HYPRE_StructGMRESSolve(*solver,*HA,HB,HX);
@@ -762,6 +827,24 @@ namespace Uintah {
         solve_timer.stop();
         hypre_EndTiming ( m_tSolveOnly );
 
+        if( createSolver ){
+          hypre_solver_s->solvesSinceSetup = 0;
+        }
+        hypre_solver_s->solvesSinceSetup++;
+
+        const double setupTime = setup_timer().seconds() + solverSetup_timer().seconds();
+        const double solveTime = solve_timer().seconds() - solverSetup_timer().seconds();
+
+        if( m_application ){
+          ReductionInfoMapper< ApplicationInterface::ApplicationStatsEnum, double > & stats = m_application->getApplicationStats();
+          stats[ (ApplicationInterface::ApplicationStatsEnum) HypreSetupTime  ] += setupTime;
+          stats[ (ApplicationInterface::ApplicationStatsEnum) HypreSolveTime  ] += solveTime;
+          stats[ (ApplicationInterface::ApplicationStatsEnum) HypreIterations ] += num_iterations;
+          if( createSolver ){
+            stats[ (ApplicationInterface::ApplicationStatsEnum) HypreSolverSetups ] += 1;
+          }
+        }
+
         //__________________________________
         // Push the solution into Uintah data structure
         hypre_BeginTiming( m_tCopySolution );
@@ -825,13 +908,13 @@ namespace Uintah {
           cout << "Solve of " << m_X_label->getName()
                << " on level " << m_level->getIndex()
                << " completed in " << timer().seconds()
-               << " s (solve only: " << solve_timer().seconds() << " s, ";
+               << " s (setup: " << setupTime << " s, solve only: " << solveTime << " s, ";
 
           if (timeStep > 2) {
             // alpha = 2/(N+1)
             // averaging window is 10 timeSteps.
             double alpha   = 2.0/(std::min( int(timeStep) - 2, 10) + 1);
-            m_movingAverage = alpha*solve_timer().seconds() + (1-alpha) * m_movingAverage;
+            m_movingAverage = alpha*solveTime + (1-alpha) * m_movingAverage;
 
             cout << "mean: " <<  m_movingAverage << " s, ";
           }
@@ -1013,6 +1096,7 @@ namespace Uintah {
     Task::WhichDW      m_which_guess_dw;
     const HypreParams* m_params;
     bool               m_isFirstSolve;
+    ApplicationInterface* m_application;
 
     const VarLabel*    m_timeStepLabel;
     const VarLabel*    m_hypre_solver_label;
@@ -1093,6 +1177,7 @@ namespace Uintah {
         param_ps->getWithDefault ("updateCoefFrequency",  coefFreq,             1);
         param_ps->getWithDefault ("solveFrequency",  m_params->solveFrequency, 1);
         param_ps->getWithDefault ("relax_type",      m_params->relax_type,     1);
+        param_ps->getWithDefault ("solverSetupReuse", m_params->solverSetupReuse, 0);
 
         // change to lowercase
         m_params->solvertype  = string_tolower( str_solver );
@@ -1131,6 +1216,10 @@ namespace Uintah {
       m_params->setUpdateCoefFrequency(1);
       m_params->solveFrequency = 1;
       m_params->relax_type = 1;
+      m_params->solverSetupReuse = 0;
+    }
+    if( m_params->solverSetupReuse < 0 ){
+      throw ProblemSetupException("HypreSolver: solverSetupReuse must be >= 0", __FILE__, __LINE__);
     }
   }
 
@@ -1264,35 +1353,35 @@ namespace Uintah {
     switch(domtype){
     case TypeDescription::SFCXVariable:
       {
-        HypreStencil7<SFCXTypes>* that = scinew HypreStencil7<SFCXTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve);
+        HypreStencil7<SFCXTypes>* that = scinew HypreStencil7<SFCXTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve, m_application);
         Handle<HypreStencil7<SFCXTypes> > handle = that;
         task = scinew Task("Hypre:Matrix solve (SFCX)", that, &HypreStencil7<SFCXTypes>::solve, handle);
       }
       break;
     case TypeDescription::SFCYVariable:
       {
-        HypreStencil7<SFCYTypes>* that = scinew HypreStencil7<SFCYTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve);
+        HypreStencil7<SFCYTypes>* that = scinew HypreStencil7<SFCYTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve, m_application);
         Handle<HypreStencil7<SFCYTypes> > handle = that;
         task = scinew Task("Hypre:Matrix solve (SFCY)", that, &HypreStencil7<SFCYTypes>::solve, handle);
       }
       break;
     case TypeDescription::SFCZVariable:
       {
-        HypreStencil7<SFCZTypes>* that = scinew HypreStencil7<SFCZTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve);
+        HypreStencil7<SFCZTypes>* that = scinew HypreStencil7<SFCZTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve, m_application);
         Handle<HypreStencil7<SFCZTypes> > handle = that;
         task = scinew Task("Hypre:Matrix solve (SFCZ)", that, &HypreStencil7<SFCZTypes>::solve, handle);
       }
       break;
     case TypeDescription::CCVariable:
       {
-        HypreStencil7<CCTypes>* that = scinew HypreStencil7<CCTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve);
+        HypreStencil7<CCTypes>* that = scinew HypreStencil7<CCTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve, m_application);
         Handle<HypreStencil7<CCTypes> > handle = that;
         task = scinew Task("Hypre:Matrix solve (CC)", that, &HypreStencil7<CCTypes>::solve, handle);
       }
       break;
     case TypeDescription::NCVariable:
       {
-        HypreStencil7<NCTypes>* that = scinew HypreStencil7<NCTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve);
+        HypreStencil7<NCTypes>* that = scinew HypreStencil7<NCTypes>(level.get_rep(), matls, A_label, which_A_dw, x_label, modifies_X, b_label, which_b_dw, guess_label, which_guess_dw, m_params, isFirstSolve, m_application);
         Handle<HypreStencil7<NCTypes> > handle = that;
         task = scinew Task("Hypre:Matrix solve (NC)", that, &HypreStencil7<NCTypes>::solve, handle);
       }
@@ -1351,6 +1440,22 @@ namespace Uintah {
 
   //---------------------------------------------------------------------------------------------
 
+  void HypreSolver2::getComponents()
+  {
+    SolverCommon::getComponents();
+
+    ReductionInfoMapper< ApplicationInterface::ApplicationStatsEnum, double > & stats = m_application->getApplicationStats();
+
+    if( !stats.exists( (ApplicationInterface::ApplicationStatsEnum) HypreSetupTime ) ){
+      stats.insert( (ApplicationInterface::ApplicationStatsEnum) HypreSetupTime,    std::string("Hypre_Setup_Time"),    "seconds"    );
+      stats.insert( (ApplicationInterface::ApplicationStatsEnum) HypreSolveTime,    std::string("Hypre_Solve_Time"),    "seconds"    );
+      stats.insert( (ApplicationInterface::ApplicationStatsEnum) HypreIterations,   std::string("Hypre_Iterations"),    "iterations" );
+      stats.insert( (ApplicationInterface::ApplicationStatsEnum) HypreSolverSetups, std::string("Hypre_Solver_Setups"), "setups"     );
+    }
+  }
+
+  //---------------------------------------------------------------------------------------------
+
   string HypreSolver2::getName(){
     return "hypre";
   }
@@ -37,6 +37,7 @@
 #include <HYPRE_krylov.h>
 
 #include <iostream>
+#include <vector>
 
 /**
  *  @class  HypreSolver2
@@ -72,6 +73,7 @@ namespace Uintah {
     int         logging;            // Log Hypre solver (using Hypre options)
     int         solveFrequency;     // Frequency for solving the linear system. timestep % solveFrequency
     int         relax_type;         // relaxation type
+    int         solverSetupReuse;   // # solves sharing one solver/preconditioner setup, 0 = until the next matrix setup
     
     // SMG parameters
     int    npre;               // # pre relaxations for Hypre SMG solver
@@ -97,6 +99,16 @@ namespace Uintah {
     diagonal
   };
 
+  //______________________________________________________________________
+  //  Hypre stats, reported with the application stats.  The values
+  //  start past the range used by the applications.
+  enum HypreStatsEnum {
+    HypreSetupTime = 1000,
+    HypreSolveTime,
+    HypreIterations,
+    HypreSolverSetups
+  };
+
   //______________________________________________________________________
   //
   struct hypre_solver_struct : public RefCounted {
@@ -104,6 +116,12 @@ namespace Uintah {
     SolverType           solver_type;
     SolverType           precond_solver_type;
     bool                 isRecomputeTimeStep;
+
+    // Local boxes of the hypre grid the cached objects were built on.
+    std::vector<int>     structure;
+
+    // # solves done with the current solver/preconditioner setup.
+    int                  solvesSinceSetup{0};
     
     //  *_p = pointer
     HYPRE_StructSolver * solver_p = nullptr;
@@ -292,6 +310,8 @@ namespace Uintah {
 
     virtual std::string getName();
 
+    virtual void getComponents();
+
     void allocateHypreMatrices(       DataWarehouse * new_dw,
                                 const bool            isRestart );
 
@@ -0,0 +1,296 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <CCA/Components/Solvers/PatchMultigrid.h>
+
+#include <algorithm>
+
+using namespace Uintah;
+
+namespace {
+
+  // Symmetric Gauss-Seidel sweeps on the coarsest level.
+  const int COARSEST_SWEEPS = 8;
+
+  // Stencil7 order: -x +x -y +y -z +z
+  const int OFFSET[6][3] = { {-1, 0, 0}, {1, 0, 0},
+                             { 0,-1, 0}, {0, 1, 0},
+                             { 0, 0,-1}, {0, 0, 1} };
+}
+
+//______________________________________________________________________
+//
+PatchMultigrid::PatchMultigrid( const Array3<Stencil7> & A,
+                                const IntVector        & low,
+                                const IntVector        & high,
+                                      int                nPre,
+                                      int                nPost,
+                                      int                maxLevels )
+  : m_low( low ), m_high( high ), m_nPre( nPre ), m_nPost( nPost )
+{
+  m_levels.resize( 1 );
+
+  GridLevel & fine = m_levels[0];
+  fine.size = high - low;
+  fine.A.resize( fine.numCells() );
+
+  for( int k = 0; k < fine.size.z(); ++k ) {
+    for( int j = 0; j < fine.size.y(); ++j ) {
+      for( int i = 0; i < fine.size.x(); ++i ) {
+        fine.A[ fine.index( i, j, k ) ] = A[ low + IntVector( i, j, k ) ];
+      }
+    }
+  }
+
+  while( (int) m_levels.size() < maxLevels ) {
+    const IntVector size = m_levels.back().size;
+    if( std::max( size.x(), std::max( size.y(), size.z() ) ) <= 2 ) {
+      break;
+    }
+
+    GridLevel coarse;
+    coarsen( m_levels.back(), coarse );
+    m_levels.push_back( coarse );
+  }
+}
+
+//______________________________________________________________________
+//  Galerkin coarse operator for piecewise constant prolongation: the
+//  couplings between two children of the same coarse cell go into the
+//  diagonal, all others into the coarse coupling in the same direction.
+void
+PatchMultigrid::coarsen( const GridLevel & fine, GridLevel & coarse ) const
+{
+  const IntVector ratio( fine.size.x() > 1 ? 2 : 1,
+                         fine.size.y() > 1 ? 2 : 1,
+                         fine.size.z() > 1 ? 2 : 1 );
+
+  coarse.size = ( fine.size + ratio - IntVector( 1, 1, 1 ) ) / ratio;
+  coarse.A.assign( coarse.numCells(), Stencil7( 0.0 ) );
+
+  for( int k = 0; k < fine.size.z(); ++k ) {
+    for( int j = 0; j < fine.size.y(); ++j ) {
+      for( int i = 0; i < fine.size.x(); ++i ) {
+        const Stencil7 & a = fine.A[ fine.index( i, j, k ) ];
+        Stencil7       & c = coarse.A[ coarse.index( i / ratio.x(), j / ratio.y(), k / ratio.z() ) ];
+
+        c.p += a.p;
+
+        for( int d = 0; d < 6; ++d ) {
+          const int ii = i + OFFSET[d][0];
+          const int jj = j + OFFSET[d][1];
+          const int kk = k + OFFSET[d][2];
+
+          if( ii < 0 || jj < 0 || kk < 0 || ii >= fine.size.x() || jj >= fine.size.y() || kk >= fine.size.z() ) {
+            continue;
+          }
+
+          const bool sameParent = ( ii / ratio.x() == i / ratio.x() ) &&
+                                  ( jj / ratio.y() == j / ratio.y() ) &&
+                                  ( kk / ratio.z() == k / ratio.z() );
+          if( sameParent ) {
+            c.p += a[d];
+          }
+          else {
+            c[d] += a[d];
+          }
+        }
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+PatchMultigrid::smooth( const GridLevel           & grid,
+                              std::vector<double> & x,
+                        const std::vector<double> & b,
+                              bool                  forward ) const
+{
+  const int nx = grid.size.x();
+  const int ny = grid.size.y();
+  const int nz = grid.size.z();
+  const int n  = grid.numCells();
+
+  for( int c = 0; c < n; ++c ) {
+    const int idx = forward ? c : n - 1 - c;
+    const int i   = idx % nx;
+    const int j   = ( idx / nx ) % ny;
+    const int k   = idx / ( nx * ny );
+
+    const Stencil7 & a = grid.A[idx];
+    if( a.p == 0 ) {
+      continue;
+    }
+
+    double sum = b[idx];
+    if( i > 0 )      sum -= a.w * x[idx - 1];
+    if( i < nx - 1 ) sum -= a.e * x[idx + 1];
+    if( j > 0 )      sum -= a.s * x[idx - nx];
+    if( j < ny - 1 ) sum -= a.n * x[idx + nx];
+    if( k > 0 )      sum -= a.b * x[idx - nx * ny];
+    if( k < nz - 1 ) sum -= a.t * x[idx + nx * ny];
+
+    x[idx] = sum / a.p;
+  }
+}
+
+//______________________________________________________________________
+//
+void
+PatchMultigrid::residual( const GridLevel           & grid,
+                          const std::vector<double> & x,
+                          const std::vector<double> & b,
+                                std::vector<double> & r ) const
+{
+  const int nx = grid.size.x();
+  const int ny = grid.size.y();
+  const int nz = grid.size.z();
+
+  for( int k = 0; k < nz; ++k ) {
+    for( int j = 0; j < ny; ++j ) {
+      for( int i = 0; i < nx; ++i ) {
+        const int        idx = grid.index( i, j, k );
+        const Stencil7 & a   = grid.A[idx];
+
+        double ax = a.p * x[idx];
+        if( i > 0 )      ax += a.w * x[idx - 1];
+        if( i < nx - 1 ) ax += a.e * x[idx + 1];
+        if( j > 0 )      ax += a.s * x[idx - nx];
+        if( j < ny - 1 ) ax += a.n * x[idx + nx];
+        if( k > 0 )      ax += a.b * x[idx - nx * ny];
+        if( k < nz - 1 ) ax += a.t * x[idx + nx * ny];
+
+        r[idx] = b[idx] - ax;
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//  One V-cycle with a zero initial guess for A_level x = b.
+void
+PatchMultigrid::vcycle( int                                  level,
+                        std::vector< std::vector<double> > & x,
+                        std::vector< std::vector<double> > & b,
+                        std::vector<double>                & r ) const
+{
+  const GridLevel & grid = m_levels[level];
+
+  std::fill( x[level].begin(), x[level].end(), 0.0 );
+
+  if( level == (int) m_levels.size() - 1 ) {
+    for( int s = 0; s < COARSEST_SWEEPS; ++s ) {
+      smooth( grid, x[level], b[level], true );
+      smooth( grid, x[level], b[level], false );
+    }
+    return;
+  }
+
+  for( int s = 0; s < m_nPre; ++s ) {
+    smooth( grid, x[level], b[level], true );
+  }
+
+  residual( grid, x[level], b[level], r );
+
+  // Restrict (sum of the children) and correct (injection).
+  const GridLevel & coarse = m_levels[level + 1];
+  const IntVector   ratio( grid.size.x() > 1 ? 2 : 1,
+                           grid.size.y() > 1 ? 2 : 1,
+                           grid.size.z() > 1 ? 2 : 1 );
+
+  std::fill( b[level + 1].begin(), b[level + 1].end(), 0.0 );
+
+  for( int k = 0; k < grid.size.z(); ++k ) {
+    for( int j = 0; j < grid.size.y(); ++j ) {
+      for( int i = 0; i < grid.size.x(); ++i ) {
+        b[level + 1][ coarse.index( i / ratio.x(), j / ratio.y(), k / ratio.z() ) ] += r[ grid.index( i, j, k ) ];
+      }
+    }
+  }
+
+  vcycle( level + 1, x, b, r );
+
+  for( int k = 0; k < grid.size.z(); ++k ) {
+    for( int j = 0; j < grid.size.y(); ++j ) {
+      for( int i = 0; i < grid.size.x(); ++i ) {
+        x[level][ grid.index( i, j, k ) ] += x[level + 1][ coarse.index( i / ratio.x(), j / ratio.y(), k / ratio.z() ) ];
+      }
+    }
+  }
+
+  for( int s = 0; s < m_nPost; ++s ) {
+    smooth( grid, x[level], b[level], false );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+PatchMultigrid::apply(       Array3<double> & Z,
+                       const Array3<double> & R,
+                             long64         & flops,
+                             long64         & memrefs ) const
+{
+  const int nLevels = (int) m_levels.size();
+  const GridLevel & fine = m_levels[0];
+
+  std::vector< std::vector<double> > x( nLevels );
+  std::vector< std::vector<double> > b( nLevels );
+  std::vector<double>                r( fine.numCells() );
+
+  for( int l = 0; l < nLevels; ++l ) {
+    x[l].resize( m_levels[l].numCells() );
+    b[l].resize( m_levels[l].numCells() );
+  }
+
+  for( int k = 0; k < fine.size.z(); ++k ) {
+    for( int j = 0; j < fine.size.y(); ++j ) {
+      for( int i = 0; i < fine.size.x(); ++i ) {
+        b[0][ fine.index( i, j, k ) ] = R[ m_low + IntVector( i, j, k ) ];
+      }
+    }
+  }
+
+  vcycle( 0, x, b, r );
+
+  for( int k = 0; k < fine.size.z(); ++k ) {
+    for( int j = 0; j < fine.size.y(); ++j ) {
+      for( int i = 0; i < fine.size.x(); ++i ) {
+        Z[ m_low + IntVector( i, j, k ) ] = x[0][ fine.index( i, j, k ) ];
+      }
+    }
+  }
+
+  // A smoothing sweep or residual is 13 flops and 10 words per cell.
+  for( int l = 0; l < nLevels; ++l ) {
+    const long64 cells  = m_levels[l].numCells();
+    const long64 sweeps = ( l == nLevels - 1 ) ? 2 * COARSEST_SWEEPS : m_nPre + m_nPost + 1;
+
+    flops   += cells * ( 13 * sweeps + 2 );
+    memrefs += cells * ( 10 * sweeps + 3 ) * 8L;
+  }
+}
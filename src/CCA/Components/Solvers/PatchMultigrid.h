@@ -0,0 +1,123 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef Packages_Uintah_CCA_Components_Solvers_PatchMultigrid_h
+#define Packages_Uintah_CCA_Components_Solvers_PatchMultigrid_h
+
+#include <Core/Disclosure/TypeUtils.h>
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Variables/Array3.h>
+#include <Core/Grid/Variables/Stencil7.h>
+
+#include <vector>
+
+namespace Uintah {
+
+  /**************************************
+
+     CLASS
+       PatchMultigrid
+
+       Geometric multigrid V-cycle on the cells of one patch, used by
+       the CGSolver as a preconditioner.
+
+     GENERAL INFORMATION
+
+       PatchMultigrid.h
+
+     KEYWORDS
+       CGSolver, multigrid, preconditioner
+
+     DESCRIPTION
+       The fine operator is the Stencil7 matrix restricted to the box
+       [low, high); the couplings to cells outside of the box are
+       dropped, so the preconditioner of the whole level is block
+       Jacobi with one V-cycle per patch and needs no communication.
+
+       The coarse levels are built by 2x coarsening in every direction
+       that still has more than one cell.  Restriction sums the 2x2x2
+       children, prolongation injects, and the coarse operators are the
+       Galerkin products P^T A P, which for a Stencil7 matrix are again
+       Stencil7 matrices.  Pre-smoothing is forward Gauss-Seidel and
+       post-smoothing backward Gauss-Seidel, so the V-cycle is a
+       symmetric positive definite operator and can be used with CG.
+
+     WARNING
+       apply() is const and allocates its work vectors, several threads
+       can precondition different patches concurrently.
+
+  ****************************************/
+
+  class PatchMultigrid {
+
+  public:
+
+    PatchMultigrid( const Array3<Stencil7> & A,
+                    const IntVector        & low,
+                    const IntVector        & high,
+                          int                nPre,
+                          int                nPost,
+                          int                maxLevels );
+
+    // Z = M^-1 R on [low, high).
+    void apply(       Array3<double> & Z,
+                const Array3<double> & R,
+                      long64         & flops,
+                      long64         & memrefs ) const;
+
+    int numLevels() const { return (int) m_levels.size(); }
+
+  private:
+
+    struct GridLevel {
+      IntVector             size;
+      std::vector<Stencil7> A;
+
+      int index( int i, int j, int k ) const { return i + size.x() * ( j + size.y() * k ); }
+      int numCells() const { return size.x() * size.y() * size.z(); }
+    };
+
+    void coarsen( const GridLevel & fine, GridLevel & coarse ) const;
+
+    void vcycle( int level, std::vector< std::vector<double> > & x,
+                 std::vector< std::vector<double> > & b,
+                 std::vector<double> & r ) const;
+
+    void smooth( const GridLevel & grid, std::vector<double> & x,
+                 const std::vector<double> & b, bool forward ) const;
+
+    void residual( const GridLevel & grid, const std::vector<double> & x,
+                   const std::vector<double> & b, std::vector<double> & r ) const;
+
+    IntVector              m_low;
+    IntVector              m_high;
+    int                    m_nPre;
+    int                    m_nPost;
+    std::vector<GridLevel> m_levels;
+  };
+
+} // End namespace Uintah
+
+#endif // Packages_Uintah_CCA_Components_Solvers_PatchMultigrid_h
@@ -33,8 +33,9 @@ include $(SCIRUN_SCRIPTS)/smallso_prologue.mk
 SRCDIR := CCA/Components/Solvers
 
 SRCS += \
-	$(SRCDIR)/SolverCommon.cc  \
-	$(SRCDIR)/CGSolver.cc      \
+	$(SRCDIR)/SolverCommon.cc   \
+	$(SRCDIR)/CGSolver.cc       \
+	$(SRCDIR)/PatchMultigrid.cc \
 	$(SRCDIR)/SolverFactory.cc
 
 PSELIBS := \
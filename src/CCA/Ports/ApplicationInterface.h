@@ -103,6 +103,7 @@ WARNING
     friend class LoadBalancersCommon;
     friend class DynamicLoadBalancer;
     friend class ParticleLoadBalancer;
+    friend class ParallelSFCLoadBalancer;
 
     friend class RegridderCommon;
 
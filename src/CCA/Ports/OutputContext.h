@@ -27,6 +27,8 @@
 
 #include <Core/ProblemSpec/ProblemSpec.h>
 
+#include <string>
+
 namespace Uintah {
    /**************************************
      
@@ -62,6 +64,14 @@ namespace Uintah {
 	: fd(fd), filename(filename), cur(cur), varnode(varnode), outputDoubleAsFloat(outputDoubleAsFloat)
       {
       }
+
+      // Stage the data in memory instead of writing it to a file
+      // descriptor.  Emitted bytes are appended to 'buffer' and 'cur'
+      // is advanced as if they had been written to the file.
+      OutputContext(std::string* buffer, const char* filename, long cur, ProblemSpecP varnode, bool outputDoubleAsFloat = false)
+	: fd(-1), filename(filename), cur(cur), varnode(varnode), outputDoubleAsFloat(outputDoubleAsFloat), buffer(buffer)
+      {
+      }
       ~OutputContext() {}
 
       int fd;
@@ -69,6 +79,15 @@ namespace Uintah {
       long cur;
       ProblemSpecP varnode;
       bool outputDoubleAsFloat;
+      std::string* buffer{nullptr};
+      // Checkpoint data must be preserved exactly, lossy compression is replaced.
+      bool checkpoint{false};
+
+      // Reported by emit(): the codec actually used ("" if none) and,
+      // for particle variables, the number of particles (-1 otherwise).
+      // varnode may be null when only these are needed.
+      std::string compression;
+      int numParticles{-1};
    private:
       OutputContext(const OutputContext&);
       OutputContext& operator=(const OutputContext&);
@@ -0,0 +1,423 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <Core/DataArchive/BinaryIndex.h>
+
+#include <Core/Exceptions/ErrnoException.h>
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Util/Endian.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+using namespace Uintah;
+
+const uint32_t BinaryIndex::MAGIC_NUMBER;
+const int32_t  BinaryIndex::VERSION;
+
+namespace {
+
+  static_assert( sizeof(BinaryIndex::Record) == 32, "BinaryIndex::Record must not be padded" );
+
+  //______________________________________________________________________
+  //
+  template <typename T>
+  void
+  put( std::string & bytes, const T & value )
+  {
+    bytes.append( reinterpret_cast<const char*>( &value ), sizeof(T) );
+  }
+
+  void
+  putString( std::string & bytes, const std::string & value )
+  {
+    put( bytes, (int32_t) value.size() );
+    bytes.append( value );
+  }
+
+  //______________________________________________________________________
+  //  Sequential reader over a byte stream with optional byte swapping.
+  class Cursor {
+  public:
+    Cursor( const std::string & bytes, const std::string & source )
+      : m_bytes( bytes ), m_source( source ) {}
+
+    template <typename T>
+    T get()
+    {
+      T value;
+      check( sizeof(T) );
+      memcpy( &value, m_bytes.data() + m_pos, sizeof(T) );
+      m_pos += sizeof(T);
+      if( m_swap ) {
+        swapbytes( value );
+      }
+      return value;
+    }
+
+    std::string getString()
+    {
+      int32_t length = get<int32_t>();
+      if( length < 0 ) {
+        corrupt();
+      }
+      check( length );
+      std::string value( m_bytes, m_pos, length );
+      m_pos += length;
+      return value;
+    }
+
+    // Written so that a huge size from a corrupt index cannot wrap around.
+    void check( size_t size ) const
+    {
+      if( size > remaining() ) {
+        corrupt();
+      }
+    }
+
+    size_t remaining() const
+    {
+      return m_bytes.size() - m_pos;
+    }
+
+    void corrupt() const
+    {
+      throw InternalError( "BinaryIndex: truncated or corrupt index " + m_source, __FILE__, __LINE__ );
+    }
+
+    const std::string & m_bytes;
+    const std::string & m_source;
+    size_t              m_pos{ 0 };
+    bool                m_swap{ false };
+  };
+
+  bool
+  recordLess( const BinaryIndex::Record & a, const BinaryIndex::Record & b )
+  {
+    if( a.variable != b.variable ) {
+      return a.variable < b.variable;
+    }
+    if( a.matl != b.matl ) {
+      return a.matl < b.matl;
+    }
+    return a.patch < b.patch;
+  }
+}
+
+//______________________________________________________________________
+//
+int
+BinaryIndex::addVariable( const Variable & var )
+{
+  std::map<std::string, int>::iterator iter = m_variableIndex.find( var.name );
+
+  if( iter != m_variableIndex.end() ) {
+    Variable & existing = m_variables[ iter->second ];
+
+    // A particle variable with no particles does not report its
+    // compression, take it from any other material/patch that does.
+    if( existing.compression.empty() ) {
+      existing.compression = var.compression;
+    }
+    return iter->second;
+  }
+
+  int index = (int) m_variables.size();
+  m_variables.push_back( var );
+  m_variableIndex[ var.name ] = index;
+  return index;
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::add( const std::string & name,
+                  const std::string & type,
+                  const std::string & compression,
+                  const IntVector   & boundaryLayer,
+                        int           matl,
+                        int           patch,
+                        int           numParticles,
+                        long          start,
+                        long          end )
+{
+  Variable var;
+  var.name          = name;
+  var.type          = type;
+  var.compression   = compression;
+  var.boundaryLayer = boundaryLayer;
+
+  Record record;
+  record.variable     = addVariable( var );
+  record.matl         = matl;
+  record.patch        = patch;
+  record.numParticles = numParticles;
+  record.start        = start;
+  record.end          = end;
+
+  m_records.push_back( record );
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::append( const BinaryIndex & other, long offset )
+{
+  std::vector<int> remap( other.m_variables.size() );
+
+  for( unsigned int i = 0; i < other.m_variables.size(); ++i ) {
+    remap[i] = addVariable( other.m_variables[i] );
+  }
+
+  m_records.reserve( m_records.size() + other.m_records.size() );
+
+  for( unsigned int i = 0; i < other.m_records.size(); ++i ) {
+    Record record    = other.m_records[i];
+    record.variable  = remap[ record.variable ];
+    record.start    += offset;
+    record.end      += offset;
+    m_records.push_back( record );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::clear()
+{
+  m_dataFilename.clear();
+  m_variables.clear();
+  m_records.clear();
+  m_variableIndex.clear();
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::swap( BinaryIndex & other )
+{
+  m_dataFilename.swap( other.m_dataFilename );
+  m_variables.swap( other.m_variables );
+  m_records.swap( other.m_records );
+  m_variableIndex.swap( other.m_variableIndex );
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::sort()
+{
+  // Order the variable table by name (m_variableIndex is already sorted).
+  std::vector<Variable> variables;
+  std::vector<int>      remap( m_variables.size() );
+
+  variables.reserve( m_variables.size() );
+
+  for( std::map<std::string, int>::iterator iter = m_variableIndex.begin(); iter != m_variableIndex.end(); ++iter ) {
+    const int oldIndex = iter->second;
+
+    remap[ oldIndex ] = (int) variables.size();
+    iter->second      = (int) variables.size();
+    variables.push_back( m_variables[ oldIndex ] );
+  }
+
+  m_variables.swap( variables );
+
+  for( unsigned int i = 0; i < m_records.size(); ++i ) {
+    m_records[i].variable = remap[ m_records[i].variable ];
+  }
+
+  std::sort( m_records.begin(), m_records.end(), recordLess );
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::serialize( std::string & bytes ) const
+{
+  bytes.clear();
+  bytes.reserve( 64 + m_variables.size() * 64 + m_records.size() * sizeof(Record) );
+
+  put( bytes, MAGIC_NUMBER );
+  put( bytes, VERSION );
+  put( bytes, (int32_t) m_variables.size() );
+  put( bytes, (int64_t) m_records.size() );
+
+  putString( bytes, m_dataFilename );
+
+  for( unsigned int i = 0; i < m_variables.size(); ++i ) {
+    const Variable & var = m_variables[i];
+
+    putString( bytes, var.name );
+    putString( bytes, var.type );
+    putString( bytes, var.compression );
+    put( bytes, (int32_t) var.boundaryLayer.x() );
+    put( bytes, (int32_t) var.boundaryLayer.y() );
+    put( bytes, (int32_t) var.boundaryLayer.z() );
+  }
+
+  if( !m_records.empty() ) {
+    bytes.append( reinterpret_cast<const char*>( m_records.data() ), m_records.size() * sizeof(Record) );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::deserialize( const std::string & bytes, const std::string & source /* = "" */ )
+{
+  clear();
+
+  Cursor cursor( bytes, source );
+
+  uint32_t magic = cursor.get<uint32_t>();
+  if( magic != MAGIC_NUMBER ) {
+    swapbytes( magic );
+    if( magic != MAGIC_NUMBER ) {
+      throw InternalError( "BinaryIndex: " + source + " is not a binary index", __FILE__, __LINE__ );
+    }
+    cursor.m_swap = true;
+  }
+
+  int32_t version = cursor.get<int32_t>();
+  if( version != VERSION ) {
+    throw InternalError( "BinaryIndex: unsupported index version in " + source, __FILE__, __LINE__ );
+  }
+
+  int32_t numVariables = cursor.get<int32_t>();
+  int64_t numRecords   = cursor.get<int64_t>();
+
+  if( numVariables < 0 || numRecords < 0 ) {
+    cursor.corrupt();
+  }
+
+  m_dataFilename = cursor.getString();
+
+  // Each variable takes at least three string lengths and the boundary
+  // layer, each record sizeof(Record) bytes.  Compare counts, not byte
+  // sizes, so the products cannot overflow.
+  const size_t minVariableSize = 3 * sizeof(int32_t) + 3 * sizeof(int32_t);
+
+  if( (uint64_t) numVariables > cursor.remaining() / minVariableSize ) {
+    cursor.corrupt();
+  }
+
+  m_variables.resize( numVariables );
+  for( int32_t i = 0; i < numVariables; ++i ) {
+    Variable & var = m_variables[i];
+
+    var.name        = cursor.getString();
+    var.type        = cursor.getString();
+    var.compression = cursor.getString();
+
+    int32_t x = cursor.get<int32_t>();
+    int32_t y = cursor.get<int32_t>();
+    int32_t z = cursor.get<int32_t>();
+    var.boundaryLayer = IntVector( x, y, z );
+
+    m_variableIndex[ var.name ] = i;
+  }
+
+  // The records are read in one block, then validated.
+  if( (uint64_t) numRecords > cursor.remaining() / sizeof(Record) ) {
+    cursor.corrupt();
+  }
+
+  m_records.resize( numRecords );
+  if( numRecords > 0 ) {
+    memcpy( m_records.data(), bytes.data() + cursor.m_pos, numRecords * sizeof(Record) );
+  }
+
+  for( int64_t i = 0; i < numRecords; ++i ) {
+    Record & record = m_records[i];
+
+    if( cursor.m_swap ) {
+      swapbytes( record.variable );
+      swapbytes( record.matl );
+      swapbytes( record.patch );
+      swapbytes( record.numParticles );
+      swapbytes( record.start );
+      swapbytes( record.end );
+    }
+
+    if( record.variable < 0 || record.variable >= numVariables ) {
+      cursor.corrupt();
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::write( const std::string & filename ) const
+{
+  std::string bytes;
+  serialize( bytes );
+
+  FILE * fp = fopen( filename.c_str(), "wb" );
+  if( fp == nullptr ) {
+    throw ErrnoException( "BinaryIndex::write(): failed to open " + filename, errno, __FILE__, __LINE__ );
+  }
+
+  size_t written = fwrite( bytes.data(), 1, bytes.size(), fp );
+  int    error   = ( written != bytes.size() ) ? errno : 0;
+
+  if( fclose( fp ) != 0 && error == 0 ) {
+    error = errno;
+  }
+
+  if( error != 0 ) {
+    throw ErrnoException( "BinaryIndex::write(): failed to write " + filename, error, __FILE__, __LINE__ );
+  }
+}
+
+//______________________________________________________________________
+//
+void
+BinaryIndex::read( const std::string & filename )
+{
+  FILE * fp = fopen( filename.c_str(), "rb" );
+  if( fp == nullptr ) {
+    throw ErrnoException( "BinaryIndex::read(): failed to open " + filename, errno, __FILE__, __LINE__ );
+  }
+
+  std::string bytes;
+  char        buffer[ 65536 ];
+  size_t      count;
+
+  while( ( count = fread( buffer, 1, sizeof(buffer), fp ) ) > 0 ) {
+    bytes.append( buffer, count );
+  }
+
+  bool failed = ferror( fp ) != 0;
+  fclose( fp );
+
+  if( failed ) {
+    throw ErrnoException( "BinaryIndex::read(): failed to read " + filename, errno, __FILE__, __LINE__ );
+  }
+
+  deserialize( bytes, filename );
+}
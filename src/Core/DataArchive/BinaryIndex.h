@@ -0,0 +1,147 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CORE_DATAARCHIVE_BINARYINDEX_H
+#define CORE_DATAARCHIVE_BINARYINDEX_H
+
+#include <Core/Geometry/IntVector.h>
+
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+  /**************************************
+
+     CLASS
+       BinaryIndex
+
+       Compact binary replacement for the <Variable> elements of the
+       per-rank l<level>/p<rank>.xml files of a timestep.
+
+     GENERAL INFORMATION
+
+       BinaryIndex.h
+
+     KEYWORDS
+       DataArchive, DataArchiver, index
+
+     DESCRIPTION
+       A BinaryIndex describes where every (variable, material, patch)
+       lives in one data file.  The per-variable information (name,
+       type, compression, boundary layer) is stored once in a variable
+       table; every saved (variable, material, patch) is a fixed-size
+       record.  On disk the variable table is sorted by name and the
+       records by (variable, material, patch):
+
+         header    - magic, version, #variables, #records,
+                     length of the data file name
+         data file name
+         variables - name, type, compression, boundary layer
+         records   - Record, #records times
+
+       The file is written in the native byte order; the reader swaps
+       the bytes if the magic number is reversed.
+
+     WARNING
+       The same byte stream is used to ship an index between ranks
+       (aggregated output), in which case the data file name is empty.
+
+  ****************************************/
+
+  class BinaryIndex {
+
+  public:
+
+    static const uint32_t MAGIC_NUMBER{ 0x49414455 };  // "UDAI"
+    static const int32_t  VERSION{ 1 };
+
+    struct Variable {
+      std::string name;
+      std::string type;
+      std::string compression;
+      IntVector   boundaryLayer{ 0, 0, 0 };
+    };
+
+    struct Record {
+      int32_t variable;       // Index into the variable table.
+      int32_t matl;
+      int32_t patch;
+      int32_t numParticles;   // -1 for non particle variables.
+      int64_t start;
+      int64_t end;
+    };
+
+    BinaryIndex() {}
+
+    void add( const std::string & name,
+              const std::string & type,
+              const std::string & compression,
+              const IntVector   & boundaryLayer,
+                    int           matl,
+                    int           patch,
+                    int           numParticles,
+                    long          start,
+                    long          end );
+
+    // Append all of the records of 'other', shifting their start/end
+    // by 'offset' bytes.
+    void append( const BinaryIndex & other, long offset );
+
+    void clear();
+    void swap( BinaryIndex & other );
+
+    bool empty() const { return m_records.empty(); }
+
+    // Sorts the variable table by name and the records by
+    // (variable, material, patch).
+    void sort();
+
+    void serialize( std::string & bytes ) const;
+    void deserialize( const std::string & bytes, const std::string & source = "" );
+
+    void write( const std::string & filename ) const;
+    void read(  const std::string & filename );
+
+    const std::string           & dataFilename() const { return m_dataFilename; }
+    void                          setDataFilename( const std::string & name ) { m_dataFilename = name; }
+
+    const std::vector<Variable> & variables() const { return m_variables; }
+    const std::vector<Record>   & records()   const { return m_records; }
+
+  private:
+
+    int addVariable( const Variable & var );
+
+    std::string                m_dataFilename;
+    std::vector<Variable>      m_variables;
+    std::vector<Record>        m_records;
+    std::map<std::string, int> m_variableIndex;
+  };
+
+} // End namespace Uintah
+
+#endif // CORE_DATAARCHIVE_BINARYINDEX_H
@@ -23,6 +23,7 @@
  */
 
 #include <Core/DataArchive/DataArchive.h>
+#include <Core/DataArchive/BinaryIndex.h>
 
 #include <CCA/Components/ProblemSpecification/ProblemSpecReader.h>
 #include <CCA/Ports/InputContext.h>
@@ -1139,8 +1140,8 @@ DataArchive::query(       Variable     & var,
     // If this is a virtual patch, grab the real patch, but only do that here - in the next query, we want
     // the data to be returned in the virtual coordinate space.
 
-    vector<VarnameMatlPatch>::iterator iter = std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), VarnameMatlPatch(name, matlIndex, patchid ) );
-    if( iter == timedata.d_datafileInfoIndex.end() ) { // Previously used the hashmap lookup( timedata.d_datafileInfo.lookup() )
+    int pos = timedata.findDatafileInfo( VarnameMatlPatch( name, matlIndex, patchid ) );
+    if( pos < 0 ) {
       cerr << "VARIABLE NOT FOUND: " << name
            << ", material index " << matlIndex
            << ", Level " << patch->getLevel()->getIndex()
@@ -1150,7 +1151,6 @@ DataArchive::query(       Variable     & var,
       throw InternalError("DataArchive::query:Variable not found", __FILE__, __LINE__);
     }
 
-    int pos = std::distance( timedata.d_datafileInfoIndex.begin(), iter );
     dfi = &timedata.d_datafileInfoValue[ pos ];
   }
 
@@ -2120,6 +2120,19 @@ DataArchive::TimeData::init()
         string filename = d_ts_directory + datafile;
         d_xmlFilenames[ level ].push_back( filename );
         d_xmlParsed[    level ].push_back( false );
+
+        // An aggregated file lists the ranks whose data it holds.
+        string procs = attributes[ "procs" ];
+        if( procs != "" ) {
+          if( level >= d_aggregatedXmlFilenames.size() ) {
+            d_aggregatedXmlFilenames.resize( level + 1 );
+          }
+
+          ConsecutiveRangeSet ranks( procs );
+          for( ConsecutiveRangeSet::iterator iter = ranks.begin(); iter != ranks.end(); ++iter ) {
+            d_aggregatedXmlFilenames[ level ][ *iter ] = filename;
+          }
+        }
       }
     }
     else {
@@ -2143,11 +2156,14 @@ DataArchive::TimeData::purgeCache()
 
   d_datafileInfoIndex.clear();
   d_datafileInfoValue.clear();
+  d_datafileInfoLookup.clear();
 
   d_patchInfo.clear();
   d_varInfo.clear();
   d_xmlFilenames.clear();
   d_xmlParsed.clear();
+  d_aggregatedXmlFilenames.clear();
+  d_aggregatedXmlParsed.clear();
   d_initialized = false;
 }
 
@@ -2156,6 +2172,24 @@ DataArchive::TimeData::purgeCache()
 void
 DataArchive::TimeData::parseFile( const string & filename, int levelNum, int basePatch )
 {
+  // Binary indices are either referenced directly (.idx) or sit next
+  // to (or in place of) the .xml file of a rank - use them when present.
+  const string::size_type dot = filename.rfind( '.' );
+
+  if( dot != string::npos && filename.compare( dot, string::npos, ".idx" ) == 0 ) {
+    parseBinaryIndex( filename, levelNum, basePatch );
+    return;
+  }
+
+  if( dot != string::npos && filename.compare( dot, string::npos, ".xml" ) == 0 && levelNum >= 0 ) {
+    const string idxFilename = filename.substr( 0, dot ) + ".idx";
+
+    if( validFile( idxFilename ) ) {
+      parseBinaryIndex( idxFilename, levelNum, basePatch );
+      return;
+    }
+  }
+
   // Parse the file.
   ProblemSpecP top = ProblemSpecReader().readInputFile( filename );
 
@@ -2179,14 +2213,6 @@ DataArchive::TimeData::parseFile( const string & filename, int levelNum, int bas
         throw InternalError( "Cannot get index", __FILE__, __LINE__ );
       }
 
-      if( addMaterials ) {
-        // Record that the material exists.  index+1 to use matl -1
-        if (index+1 >= (int)d_matlInfo[levelNum].size()) {
-          d_matlInfo[ levelNum ].resize( index + 2 );
-        }
-        d_matlInfo[ levelNum ][ index ] = true;
-      }
-
       map<string,string> attributes;
       vnode->getAttributes(attributes);
 
@@ -2216,52 +2242,8 @@ DataArchive::TimeData::parseFile( const string & filename, int levelNum, int bas
       vnode->get( "boundaryLayer", boundary );
       vnode->get( "numParticles", numParticles );
 
-      if( d_varInfo.find(varname) == d_varInfo.end() ) {
-        VarData& varinfo      = d_varInfo[varname];
-        varinfo.type          = type;
-        varinfo.compression   = compressionMode;
-        varinfo.boundaryLayer = boundary;
-        varinfo.filename      = filename;
-      }
-      else if (compressionMode != "") {
-        // For particles variables of size 0, the uda doesn't say it
-        // has a compressionMode...  (FYI, why is this?  Because it is
-        // ambiguous... if there is no data, is it compressed?)
-        //
-        // To the best of my understanding, we only look at the variables stats
-        // the first time we encounter it... even if there are multiple materials.
-        // So we run into a problem is the variable has 0 data the first time it
-        // is looked at... The problem there is that it doesn't mark it as being
-        // compressed, and therefore the next time we see that variable (eg, in
-        // another material) we (used to) assume it was not compressed... the
-        // following lines compenstate for this problem:
-        VarData& varinfo = d_varInfo[varname];
-        varinfo.compression = compressionMode;
-      }
-
-      if (levelNum == -1) { // global file (reduction vars)
-        d_globaldata = filename;
-      }
-      else {
-        ASSERTRANGE( patchid-basePatch, 0, (int)d_patchInfo[levelNum].size() );
-
-        PatchData& patchinfo = d_patchInfo[levelNum][patchid-basePatch];
-        if (!patchinfo.parsed) {
-          patchinfo.parsed = true;
-          patchinfo.datafilename = filename;
-        }
-      }
-      VarnameMatlPatch vmp(varname, index, patchid);
-      DataFileInfo     dummy;
-
-      if( std::find( d_datafileInfoIndex.begin(), d_datafileInfoIndex.end(), vmp ) != d_datafileInfoIndex.end() ) {
-        // cerr << "Duplicate variable name: " << name << endl;
-      }
-      else {
-        DataFileInfo dfi( start, end, numParticles );
-        d_datafileInfoIndex.push_back( vmp );
-        d_datafileInfoValue.push_back( dfi );
-      }
+      addVariable( varname, index, patchid, type, compressionMode, boundary, filename,
+                   start, end, numParticles, levelNum, basePatch, addMaterials );
     }
     else if( vnode->getNodeType() != ProblemSpec::TEXT_NODE ) {
       cerr << "WARNING: Unknown element in Variables section: " << vnode->getNodeName() << '\n';
@@ -2269,6 +2251,117 @@ DataArchive::TimeData::parseFile( const string & filename, int levelNum, int bas
   }
 } // end TimeData::parseFile()
 
+//______________________________________________________________________
+// Binary counterpart of parseFile() - no xml parsing, one read of the
+// whole index and fixed size records.
+void
+DataArchive::TimeData::parseBinaryIndex( const string & filename, int levelNum, int basePatch )
+{
+  BinaryIndex index;
+  index.read( filename );
+
+  bool addMaterials = levelNum >= 0 && d_matlInfo[levelNum].size() == 0;
+
+  const vector<BinaryIndex::Variable> & variables = index.variables();
+  const vector<BinaryIndex::Record>   & records   = index.records();
+
+  d_datafileInfoIndex.reserve( d_datafileInfoIndex.size() + records.size() );
+  d_datafileInfoValue.reserve( d_datafileInfoValue.size() + records.size() );
+
+  for( unsigned int i = 0; i < records.size(); ++i ) {
+    const BinaryIndex::Record   & record = records[i];
+    const BinaryIndex::Variable & var    = variables[ record.variable ];
+
+    addVariable( var.name, record.matl, record.patch, var.type, var.compression, var.boundaryLayer,
+                 index.dataFilename(), record.start, record.end, record.numParticles,
+                 levelNum, basePatch, addMaterials );
+  }
+} // end TimeData::parseBinaryIndex()
+
+//______________________________________________________________________
+//
+void
+DataArchive::TimeData::addVariable( const string    & varname,
+                                          int         index,
+                                          int         patchid,
+                                    const string    & type,
+                                    const string    & compressionMode,
+                                    const IntVector & boundary,
+                                    const string    & filename,
+                                          long        start,
+                                          long        end,
+                                          int         numParticles,
+                                          int         levelNum,
+                                          int         basePatch,
+                                          bool        addMaterials )
+{
+  if( addMaterials ) {
+    // Record that the material exists.  index+1 to use matl -1
+    if (index+1 >= (int)d_matlInfo[levelNum].size()) {
+      d_matlInfo[ levelNum ].resize( index + 2 );
+    }
+    d_matlInfo[ levelNum ][ index ] = true;
+  }
+
+  if( d_varInfo.find(varname) == d_varInfo.end() ) {
+    VarData& varinfo      = d_varInfo[varname];
+    varinfo.type          = type;
+    varinfo.compression   = compressionMode;
+    varinfo.boundaryLayer = boundary;
+    varinfo.filename      = filename;
+  }
+  else if (compressionMode != "") {
+    // For particles variables of size 0, the uda doesn't say it
+    // has a compressionMode...  (FYI, why is this?  Because it is
+    // ambiguous... if there is no data, is it compressed?)
+    //
+    // To the best of my understanding, we only look at the variables stats
+    // the first time we encounter it... even if there are multiple materials.
+    // So we run into a problem is the variable has 0 data the first time it
+    // is looked at... The problem there is that it doesn't mark it as being
+    // compressed, and therefore the next time we see that variable (eg, in
+    // another material) we (used to) assume it was not compressed... the
+    // following lines compenstate for this problem:
+    VarData& varinfo = d_varInfo[varname];
+    varinfo.compression = compressionMode;
+  }
+
+  if (levelNum == -1) { // global file (reduction vars)
+    d_globaldata = filename;
+  }
+  else {
+    ASSERTRANGE( patchid-basePatch, 0, (int)d_patchInfo[levelNum].size() );
+
+    PatchData& patchinfo = d_patchInfo[levelNum][patchid-basePatch];
+    if (!patchinfo.parsed) {
+      patchinfo.parsed = true;
+      patchinfo.datafilename = filename;
+    }
+  }
+
+  VarnameMatlPatch vmp(varname, index, patchid);
+
+  if( d_datafileInfoLookup.find( vmp ) != d_datafileInfoLookup.end() ) {
+    // cerr << "Duplicate variable name: " << name << endl;
+  }
+  else {
+    DataFileInfo dfi( start, end, numParticles );
+    d_datafileInfoLookup[ vmp ] = (int) d_datafileInfoIndex.size();
+    d_datafileInfoIndex.push_back( vmp );
+    d_datafileInfoValue.push_back( dfi );
+  }
+}
+
+//______________________________________________________________________
+//
+int
+DataArchive::TimeData::findDatafileInfo( const VarnameMatlPatch & key ) const
+{
+  auto iter = d_datafileInfoLookup.find( key );
+
+  return ( iter == d_datafileInfoLookup.end() ) ? -1 : iter->second;
+}
+
 //______________________________________________________________________
 //
 void
@@ -2303,7 +2396,18 @@ DataArchive::TimeData::parsePatch( const Patch * patch )
 
   // If this is a newer uda, the patch info in the grid will store the
   // processor where the data is.
-  if( patchinfo.proc != -1 ) {
+  if( patchinfo.proc != -1 && levelIndex < (int)d_aggregatedXmlFilenames.size() &&
+      d_aggregatedXmlFilenames[levelIndex].count( patchinfo.proc ) > 0 ) {
+    // Aggregated output - the data of the patch's rank is indexed
+    // in its group's file.  Each such file only needs to be parsed once.
+    const string & file = d_aggregatedXmlFilenames[levelIndex][patchinfo.proc];
+
+    if( !d_aggregatedXmlParsed[ file ] ) {
+      parseFile( file, levelIndex, levelBasePatchID );
+      d_aggregatedXmlParsed[ file ] = true;
+    }
+  }
+  else if( patchinfo.proc != -1 ) {
     ostringstream file;
     file << d_ts_directory << "l" << (int) real_patch->getLevel()->getIndex() << "/p" << setw(5) << setfill('0') << (int) patchinfo.proc << ".xml";
     parseFile( file.str(), levelIndex, levelBasePatchID );
@@ -2452,7 +2556,7 @@ DataArchive::queryMaterials( const string & varname,
     VarnameMatlPatch vmp( varname, i-1, patch->getRealPatch()->getID() );
     DataFileInfo dummy;
 
-    if( std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), vmp ) != timedata.d_datafileInfoIndex.end() ) {
+    if( timedata.findDatafileInfo( vmp ) >= 0 ) {
       matls.addInOrder(i-1);
     }
   }
@@ -2514,7 +2618,7 @@ DataArchive::exists( const string & varname,
     VarnameMatlPatch vmp( varname, i-1, patch->getRealPatch()->getID() );
     DataFileInfo dummy;
 
-    if( std::find( timedata.d_datafileInfoIndex.begin(), timedata.d_datafileInfoIndex.end(), vmp ) != timedata.d_datafileInfoIndex.end() ) {
+    if( timedata.findDatafileInfo( vmp ) >= 0 ) {
       d_lock.unlock();
       return true;
     }
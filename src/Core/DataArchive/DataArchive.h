@@ -49,8 +49,10 @@
 #  include <PIDX.h>
 #endif
 
+#include <climits>
 #include <list>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include <fcntl.h>
@@ -390,8 +392,32 @@ private:
     void parsePatch( const Patch* patch );
 
     // Parse an individual data file and load appropriate storage.
+    // Dispatches to parseBinaryIndex() for binary (.idx) index files.
     void parseFile( const std::string & filename, int levelNum, int basePatch );
 
+    // Parse a binary index (see BinaryIndex.h) written in place of a
+    // p*****.xml file.
+    void parseBinaryIndex( const std::string & filename, int levelNum, int basePatch );
+
+    // Records one saved (variable, material, patch) - common to the
+    // xml and binary index parsers.
+    void addVariable( const std::string & varname,
+                            int           index,
+                            int           patchid,
+                      const std::string & type,
+                      const std::string & compressionMode,
+                      const IntVector   & boundary,
+                      const std::string & filename,
+                            long          start,
+                            long          end,
+                            int           numParticles,
+                            int           levelNum,
+                            int           basePatch,
+                            bool          addMaterials );
+
+    // Returns the position of 'key' in d_datafileInfoIndex, -1 if not saved.
+    int findDatafileInfo( const VarnameMatlPatch & key ) const;
+
     // This would be private data, except we want DataArchive to have access,
     // so we would mark DataArchive as 'friend', but we're already a private
     // nested class of DataArchive...
@@ -402,6 +428,12 @@ private:
     std::vector<VarnameMatlPatch> d_datafileInfoIndex;
     std::vector<DataFileInfo>     d_datafileInfoValue;
 
+    // Position of each key in the two vectors above (avoids linear searches).
+    struct VarnameMatlPatchHash {
+      size_t operator()( const VarnameMatlPatch & key ) const { return key.hash( INT_MAX ); }
+    };
+    std::unordered_map<VarnameMatlPatch, int, VarnameMatlPatchHash> d_datafileInfoLookup;
+
     // Patch info (separate by levels) - proc, whether parsed, datafile, etc.
     // Gets expanded and proc is set during queryGrid.  Other fields are set
     // when parsed
@@ -418,6 +450,11 @@ private:
     std::vector< std::vector<std::string> > d_xmlFilenames;
     std::vector< std::vector<bool> >        d_xmlParsed;
 
+    // Aggregated output (N-to-M): one xml file indexes the data of a
+    // group of ranks.  Maps each rank to its aggregated xml file, per level.
+    std::vector< std::map<int, std::string> > d_aggregatedXmlFilenames;
+    std::map<std::string, bool>               d_aggregatedXmlParsed;
+
     std::string   d_globaldata;
 
     ConsecutiveRangeSet d_matls;  // materials available this timestep
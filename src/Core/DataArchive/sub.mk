@@ -32,7 +32,8 @@ include $(SCIRUN_SCRIPTS)/smallso_prologue.mk
 
 SRCDIR   := Core/DataArchive
 
-SRCS += $(SRCDIR)/DataArchive.cc 
+SRCS += $(SRCDIR)/BinaryIndex.cc \
+        $(SRCDIR)/DataArchive.cc 
 
 PSELIBS := \
 	CCA/Ports    \
@@ -367,6 +367,13 @@ public: // class Task
   inline void setDebugFlag( bool in ){m_debugFlag = in;}
   inline bool getDebugFlag()const {return m_debugFlag;}
 
+  // A fusible task may be run right after the task that satisfies its
+  // last internal dependency, on the same thread and without going
+  // through the ready queues, when both run on the same patches and it
+  // needs no MPI messages (see <taskFusion> in the <Scheduler> block).
+  inline void setFusible( bool state ) { m_fusible = state; }
+  inline bool isFusible() const { return m_fusible; }
+
   enum MaterialDomainSpec {
       NormalDomain  // <- Normal/default setting
     , OutOfDomain   // <- Require things from all material
@@ -870,6 +877,7 @@ protected: // class Task
   bool m_subpatch_capable{false};
   bool m_has_subscheduler{false};
   bool m_debugFlag{false};
+  bool m_fusible{false};
 
   TaskType d_tasktype;
 
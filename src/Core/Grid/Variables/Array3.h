@@ -43,6 +43,9 @@
 #include <iosfwd>
 
 #include <type_traits>
+#include <vector>
+
+#include <sys/uio.h>
 
 #include <sci_defs/kokkos_defs.h>
 
@@ -311,6 +314,29 @@ public:
     }
   }
 
+  // The rows of [l, h) that write() would output, rows that are
+  // adjacent in memory are merged into one window.
+  inline void getWindows(const IntVector& l, const IntVector& h, std::vector<iovec>& windows)
+  {
+    if (l.x() >= h.x() || l.y() >= h.y() || l.z() >= h.z()) {
+      return;
+    }
+
+    size_t linesize = sizeof(T)*(h.x()-l.x());
+    for(int z=l.z();z<h.z();z++){
+      for(int y=l.y();y<h.y();y++){
+        char* line = (char*)&(*this)[IntVector(l.x(),y,z)];
+
+        if (!windows.empty() && (char*)windows.back().iov_base + windows.back().iov_len == line) {
+          windows.back().iov_len += linesize;
+        }
+        else {
+          windows.push_back({line, linesize});
+        }
+      }
+    }
+  }
+
   inline void read(std::istream& in, bool swapBytes)
   {
     // This could be optimized...
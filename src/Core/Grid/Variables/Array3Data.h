@@ -29,6 +29,7 @@
 #include <Core/Geometry/IntVector.h>
 #include <Core/Util/Assert.h>
 #include <Core/Util/FancyAssert.h>
+#include <Core/Grid/Variables/VariableMemoryPool.h>
 #include <Core/Malloc/Allocator.h>
 
 #include <sci_defs/kokkos_defs.h>
@@ -206,9 +207,9 @@ using KokkosData = Kokkos::View<T***, Kokkos::LayoutLeft, Kokkos::MemoryTraits<K
     {
       long s=d_size.x()*d_size.y()*d_size.z();
       if(s){
-        d_data=new T[s];
-        d_data3=new T**[d_size.z()];
-        d_data3[0]=new T*[d_size.z()*d_size.y()];
+        d_data=VariableMemoryPool::allocateArray<T>(s);
+        d_data3=VariableMemoryPool::allocateArray<T**>(d_size.z());
+        d_data3[0]=VariableMemoryPool::allocateArray<T*>(d_size.z()*d_size.y());
         d_data3[0][0]=d_data;
         for(int i=1;i<d_size.z();i++){
           d_data3[i]=d_data3[i-1]+d_size.y();
@@ -226,11 +227,11 @@ using KokkosData = Kokkos::View<T***, Kokkos::LayoutLeft, Kokkos::MemoryTraits<K
     Array3Data<T>::~Array3Data()
     {
       if(d_data){
-        delete[] d_data;
+        VariableMemoryPool::deallocateArray(d_data, (long)d_size.x()*d_size.y()*d_size.z());
         d_data=0;
-        delete[] d_data3[0];
+        VariableMemoryPool::deallocateArray(d_data3[0], d_size.z()*d_size.y());
         d_data3[0]=0;
-        delete[] d_data3;
+        VariableMemoryPool::deallocateArray(d_data3, d_size.z());
         d_data3=0;
       }
     }
@@ -0,0 +1,863 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Grid/Variables/CompressionCodec.h>
+
+#include <Core/Exceptions/InternalError.h>
+#include <Core/Exceptions/InvalidCompressionMode.h>
+#include <Core/Util/Endian.h>
+#include <Core/Util/SizeTypeConvert.h>
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <zlib.h>
+
+using namespace Uintah;
+
+namespace {
+
+  std::atomic<int> g_num_threads{ 4 };
+
+  // Largest chunk handed to zlib in one call (its counters are 32 bit).
+  const size_t MAX_ZLIB_CHUNK = 1 << 30;
+
+  // Target size of the independently compressed blocks of block-zlib.
+  const size_t BLOCK_SIZE = 4 << 20;
+
+  //______________________________________________________________________
+  //
+  size_t
+  totalSize( const std::vector<iovec> & windows )
+  {
+    size_t total = 0;
+    for( const iovec & window : windows ) {
+      total += window.iov_len;
+    }
+    return total;
+  }
+
+  //______________________________________________________________________
+  //  The parts of 'windows' covering the bytes [begin, end) of their
+  //  concatenation.
+  void
+  slice( const std::vector<iovec> & windows
+       ,       size_t               begin
+       ,       size_t               end
+       ,       std::vector<iovec> & pieces
+       )
+  {
+    pieces.clear();
+
+    size_t offset = 0;
+    for( const iovec & window : windows ) {
+      const size_t lo = std::max( begin, offset );
+      const size_t hi = std::min( end, offset + window.iov_len );
+
+      if( lo < hi ) {
+        pieces.push_back( { static_cast<char*>( window.iov_base ) + ( lo - offset ), hi - lo } );
+      }
+
+      offset += window.iov_len;
+      if( offset >= end ) {
+        break;
+      }
+    }
+  }
+
+  //______________________________________________________________________
+  //  Appends the zlib stream of the concatenation of 'pieces' to 'out'.
+  void
+  deflatePieces( const std::vector<iovec> & pieces, std::string & out )
+  {
+    z_stream stream;
+    memset( &stream, 0, sizeof(stream) );
+
+    if( deflateInit( &stream, Z_DEFAULT_COMPRESSION ) != Z_OK ) {
+      throw InternalError( "CompressionCodec: deflateInit() failed", __FILE__, __LINE__ );
+    }
+
+    const size_t start = out.size();
+    out.resize( start + deflateBound( &stream, totalSize( pieces ) ) );
+
+    char * dest     = &out[ start ];
+    size_t destLeft = out.size() - start;
+
+    // The output buffer is large enough for the whole stream, only
+    // the 32 bit counters require feeding it in chunks.
+    auto run = [&]( int flush ) {
+      int result;
+      do {
+        stream.next_out  = reinterpret_cast<Bytef*>( dest );
+        stream.avail_out = (uInt) std::min( destLeft, MAX_ZLIB_CHUNK );
+
+        result = deflate( &stream, flush );
+
+        const size_t produced = std::min( destLeft, MAX_ZLIB_CHUNK ) - stream.avail_out;
+        dest     += produced;
+        destLeft -= produced;
+      } while( result == Z_OK && ( stream.avail_in > 0 || ( flush == Z_FINISH && destLeft > 0 ) ) );
+
+      return result;
+    };
+
+    int result = Z_OK;
+
+    for( const iovec & piece : pieces ) {
+      const char * src  = static_cast<const char*>( piece.iov_base );
+      size_t       left = piece.iov_len;
+
+      while( left > 0 && result == Z_OK ) {
+        const size_t chunk = std::min( left, MAX_ZLIB_CHUNK );
+
+        stream.next_in  = reinterpret_cast<Bytef*>( const_cast<char*>( src ) );
+        stream.avail_in = (uInt) chunk;
+
+        result = run( Z_NO_FLUSH );
+
+        src  += chunk;
+        left -= chunk;
+      }
+    }
+
+    if( result == Z_OK ) {
+      result = run( Z_FINISH );
+    }
+
+    deflateEnd( &stream );
+
+    if( result != Z_STREAM_END ) {
+      throw InternalError( "CompressionCodec: deflate() failed", __FILE__, __LINE__ );
+    }
+
+    out.resize( out.size() - destLeft );
+  }
+
+  //______________________________________________________________________
+  //
+  void
+  inflateInto( const char * src, size_t srcSize, char * dest, size_t destSize )
+  {
+    uLongf destLen = destSize;
+
+    int result = uncompress( reinterpret_cast<Bytef*>( dest ), &destLen,
+                             reinterpret_cast<const Bytef*>( src ), srcSize );
+
+    if( result != Z_OK || destLen != destSize ) {
+      throw InternalError( "CompressionCodec: uncompress() failed", __FILE__, __LINE__ );
+    }
+  }
+
+  //______________________________________________________________________
+  //  Writes byte b of element i of the concatenation of 'windows' to
+  //  dest[ b * numElements + i ].  Trailing bytes that do not make a
+  //  whole element are copied as they are.
+  void
+  shuffle( const std::vector<iovec> & windows, size_t elementSize, char * dest )
+  {
+    const size_t total       = totalSize( windows );
+    const size_t numElements = total / elementSize;
+
+    size_t i = 0;   // element
+    size_t b = 0;   // byte within the element
+
+    for( const iovec & window : windows ) {
+      const char * src = static_cast<const char*>( window.iov_base );
+
+      for( size_t k = 0; k < window.iov_len; ++k ) {
+        dest[ ( i < numElements ) ? b * numElements + i : i * elementSize + b ] = src[k];
+
+        if( ++b == elementSize ) {
+          b = 0;
+          ++i;
+        }
+      }
+    }
+  }
+
+  //______________________________________________________________________
+  //
+  void
+  unshuffle( const char * src, size_t total, size_t elementSize, char * dest )
+  {
+    const size_t numElements = total / elementSize;
+
+    for( size_t b = 0; b < elementSize; ++b ) {
+      const char * in  = src + b * numElements;
+      char       * out = dest + b;
+
+      for( size_t i = 0; i < numElements; ++i, out += elementSize ) {
+        *out = in[i];
+      }
+    }
+
+    const size_t tail = numElements * elementSize;
+    memcpy( dest + tail, src + tail, total - tail );
+  }
+
+  //______________________________________________________________________
+  //  Calls work(0 .. n-1) on up to CompressionCodec::getNumThreads()
+  //  threads.
+  template <typename Work>
+  void
+  parallelFor( size_t n, const Work & work )
+  {
+    const size_t numThreads = std::min( n, (size_t) std::max( 1, CompressionCodec::getNumThreads() ) );
+
+    if( numThreads <= 1 ) {
+      for( size_t i = 0; i < n; ++i ) {
+        work( i );
+      }
+      return;
+    }
+
+    std::atomic<size_t> next{ 0 };
+    std::mutex          errorLock;
+    std::string         error;
+
+    auto worker = [&]() {
+      size_t i;
+      while( ( i = next++ ) < n ) {
+        try {
+          work( i );
+        }
+        catch( const std::exception & e ) {
+          std::lock_guard<std::mutex> lock( errorLock );
+          error = e.what();
+        }
+        catch( const Exception & e ) {
+          std::lock_guard<std::mutex> lock( errorLock );
+          error = e.message();
+        }
+      }
+    };
+
+    std::vector<std::thread> threads;
+    for( size_t t = 1; t < numThreads; ++t ) {
+      threads.emplace_back( worker );
+    }
+    worker();
+
+    for( std::thread & thread : threads ) {
+      thread.join();
+    }
+
+    if( !error.empty() ) {
+      throw InternalError( "CompressionCodec: " + error, __FILE__, __LINE__ );
+    }
+  }
+
+  //______________________________________________________________________
+  //  Fixed size header fields, written in the native byte order.
+  void
+  putHeader( std::string & out, uint64_t value )
+  {
+    out.append( reinterpret_cast<const char*>( &value ), sizeof(value) );
+  }
+
+  uint64_t
+  getHeader( const char * & data, size_t & size, bool swapBytes )
+  {
+    uint64_t value;
+
+    if( size < sizeof(value) ) {
+      throw InternalError( "CompressionCodec: truncated compressed data", __FILE__, __LINE__ );
+    }
+
+    memcpy( &value, data, sizeof(value) );
+    data += sizeof(value);
+    size -= sizeof(value);
+
+    if( swapBytes ) {
+      swapbytes( value );
+    }
+    return value;
+  }
+
+  //______________________________________________________________________
+  //  [ size (size_t of the writer) | zlib stream ]
+  class GzipCodec : public CompressionCodec {
+
+  public:
+
+    GzipCodec() : CompressionCodec( "gzip" ) {}
+
+    virtual void compress( const std::vector<iovec> & windows
+                         ,       size_t               /* elementSize */
+                         ,       std::string        & out
+                         ) const
+    {
+      const size_t sourceSize = totalSize( windows );
+
+      out.assign( reinterpret_cast<const char*>( &sourceSize ), sizeof(sourceSize) );
+      deflatePieces( windows, out );
+    }
+
+    virtual void decompress( const char        * data
+                           ,       size_t        size
+                           ,       int           nByteMode
+                           ,       bool          swapBytes
+                           ,       std::string & out
+                           ) const
+    {
+      uint64_t size_64 = 0;
+
+      if( size < (size_t) nByteMode ) {
+        throw InternalError( "CompressionCodec: truncated gzip data", __FILE__, __LINE__ );
+      }
+      memcpy( &size_64, data, nByteMode );
+
+      unsigned long uncompressedSize = convertSizeType( &size_64, swapBytes, nByteMode );
+      if( uncompressedSize > 1000000000 ) {
+        std::cout << "\n";
+        std::cout << "--------------------------------------------------------------------------\n";
+        std::cout << "!!!!!!!! WARNING !!!!!!!! \n";
+        std::cout << "\n";
+        std::cout << "Size of uncompressed variable seems wrong: " << uncompressedSize << "\n";
+        std::cout << "Most likely, the UDA you are trying to read is corrupted due to a problem with\n";
+        std::cout << "libz when it was created... Also, an exception most likely is about to be thrown...\n";
+        std::cout << "--------------------------------------------------------------------------\n";
+        std::cout << "\n\n";
+      }
+
+      out.resize( uncompressedSize );
+      inflateInto( data + nByteMode, size - nByteMode, &out[0], uncompressedSize );
+    }
+  };
+
+  //______________________________________________________________________
+  //  [ size | element size | zlib stream of the shuffled bytes ]
+  class ShuffleZlibCodec : public CompressionCodec {
+
+  public:
+
+    ShuffleZlibCodec() : CompressionCodec( "shuffle-zlib" ) {}
+
+    virtual void compress( const std::vector<iovec> & windows
+                         ,       size_t               elementSize
+                         ,       std::string        & out
+                         ) const
+    {
+      const size_t total = totalSize( windows );
+
+      std::string shuffled( total, '\0' );
+      shuffle( windows, elementSize, &shuffled[0] );
+
+      out.clear();
+      putHeader( out, total );
+      putHeader( out, elementSize );
+
+      const std::vector<iovec> pieces( 1, iovec{ &shuffled[0], total } );
+      deflatePieces( pieces, out );
+    }
+
+    virtual void decompress( const char        * data
+                           ,       size_t        size
+                           ,       int           /* nByteMode */
+                           ,       bool          swapBytes
+                           ,       std::string & out
+                           ) const
+    {
+      const size_t total       = getHeader( data, size, swapBytes );
+      const size_t elementSize = getHeader( data, size, swapBytes );
+
+      if( elementSize == 0 ) {
+        throw InternalError( "CompressionCodec: corrupt shuffle-zlib data", __FILE__, __LINE__ );
+      }
+
+      std::string shuffled( total, '\0' );
+      inflateInto( data, size, &shuffled[0], total );
+
+      out.resize( total );
+      unshuffle( shuffled.data(), total, elementSize, &out[0] );
+    }
+  };
+
+  //______________________________________________________________________
+  //  [ size | element size | block size | #blocks | compressed size of
+  //    each block | shuffle-zlib stream of each block ]
+  class BlockZlibCodec : public CompressionCodec {
+
+  public:
+
+    BlockZlibCodec() : CompressionCodec( "block-zlib" ) {}
+
+    virtual void compress( const std::vector<iovec> & windows
+                         ,       size_t               elementSize
+                         ,       std::string        & out
+                         ) const
+    {
+      const size_t total     = totalSize( windows );
+      const size_t blockSize = std::max( BLOCK_SIZE / elementSize, (size_t) 1 ) * elementSize;
+      const size_t numBlocks = ( total + blockSize - 1 ) / blockSize;
+
+      std::vector<std::string> blocks( numBlocks );
+
+      parallelFor( numBlocks, [&]( size_t b ) {
+        std::vector<iovec> pieces;
+        slice( windows, b * blockSize, std::min( total, ( b + 1 ) * blockSize ), pieces );
+
+        std::string shuffled( totalSize( pieces ), '\0' );
+        shuffle( pieces, elementSize, &shuffled[0] );
+
+        const std::vector<iovec> block( 1, iovec{ &shuffled[0], shuffled.size() } );
+        deflatePieces( block, blocks[b] );
+      } );
+
+      size_t compressedSize = 0;
+      for( const std::string & block : blocks ) {
+        compressedSize += block.size();
+      }
+
+      out.clear();
+      out.reserve( ( 4 + numBlocks ) * sizeof(uint64_t) + compressedSize );
+
+      putHeader( out, total );
+      putHeader( out, elementSize );
+      putHeader( out, blockSize );
+      putHeader( out, numBlocks );
+
+      for( const std::string & block : blocks ) {
+        putHeader( out, block.size() );
+      }
+      for( std::string & block : blocks ) {
+        out.append( block );
+        std::string().swap( block );
+      }
+    }
+
+    virtual void decompress( const char        * data
+                           ,       size_t        size
+                           ,       int           /* nByteMode */
+                           ,       bool          swapBytes
+                           ,       std::string & out
+                           ) const
+    {
+      const size_t total       = getHeader( data, size, swapBytes );
+      const size_t elementSize = getHeader( data, size, swapBytes );
+      const size_t blockSize   = getHeader( data, size, swapBytes );
+      const size_t numBlocks   = getHeader( data, size, swapBytes );
+
+      if( elementSize == 0 || blockSize == 0 || numBlocks != ( total + blockSize - 1 ) / blockSize ) {
+        throw InternalError( "CompressionCodec: corrupt block-zlib data", __FILE__, __LINE__ );
+      }
+
+      std::vector<size_t> offsets( numBlocks + 1, 0 );
+      for( size_t b = 0; b < numBlocks; ++b ) {
+        offsets[b + 1] = offsets[b] + getHeader( data, size, swapBytes );
+      }
+
+      if( offsets[numBlocks] > size ) {
+        throw InternalError( "CompressionCodec: truncated block-zlib data", __FILE__, __LINE__ );
+      }
+
+      out.resize( total );
+
+      parallelFor( numBlocks, [&]( size_t b ) {
+        const size_t begin = b * blockSize;
+        const size_t bytes = std::min( total, begin + blockSize ) - begin;
+
+        std::string shuffled( bytes, '\0' );
+        inflateInto( data + offsets[b], offsets[b + 1] - offsets[b], &shuffled[0], bytes );
+        unshuffle( shuffled.data(), bytes, elementSize, &out[ begin ] );
+      } );
+    }
+  };
+
+  //______________________________________________________________________
+  //  [ #values | error bound | #outliers | size of the code stream |
+  //    zlib stream of the shuffled int32 codes |
+  //    zlib stream of the shuffled outliers ]
+  class LossyCodec : public CompressionCodec {
+
+  public:
+
+    LossyCodec() : CompressionCodec( "lossy" ) {}
+
+    LossyCodec( bool relative, double bound )
+      : CompressionCodec( "lossy" ), m_configured( true ), m_relative( relative ), m_bound( bound ) {}
+
+    virtual bool isLossless() const { return false; }
+
+    virtual const CompressionCodec * getLosslessCodec() const
+    {
+      return CompressionCodec::find( "shuffle-zlib" );
+    }
+
+    // "abs=<bound>" or "rel=<bound>"
+    virtual const CompressionCodec * configure( const std::string & options ) const
+    {
+      std::lock_guard<std::mutex> lock( m_configured_lock );
+
+      auto iter = m_configurations.find( options );
+      if( iter != m_configurations.end() ) {
+        return iter->second.get();
+      }
+
+      const std::string kind  = options.substr( 0, 4 );
+      char            * end   = nullptr;
+      const double      bound = strtod( options.c_str() + std::min( options.size(), (size_t) 4 ), &end );
+
+      if( ( kind != "abs=" && kind != "rel=" ) || end == nullptr || *end != '\0' || !( bound > 0.0 ) || !std::isfinite( bound ) ) {
+        SCI_THROW( InvalidCompressionMode( getName() + ":" + options, "", __FILE__, __LINE__ ) );
+      }
+
+      std::unique_ptr<CompressionCodec> & codec = m_configurations[ options ];
+      codec.reset( new LossyCodec( kind == "rel=", bound ) );
+      return codec.get();
+    }
+
+    virtual void compress( const std::vector<iovec> & windows
+                         ,       size_t               elementSize
+                         ,       std::string        & out
+                         ) const
+    {
+      if( !m_configured ) {
+        throw InternalError( "CompressionCodec: lossy compression requires an error bound (lossy:abs=... or lossy:rel=...)", __FILE__, __LINE__ );
+      }
+      if( elementSize != sizeof(double) || totalSize( windows ) % sizeof(double) != 0 ) {
+        throw InternalError( "CompressionCodec: lossy compression only applies to double variables", __FILE__, __LINE__ );
+      }
+
+      const size_t numValues = totalSize( windows ) / sizeof(double);
+
+      double bound = m_bound;
+
+      if( m_relative ) {
+        double lo =  std::numeric_limits<double>::max();
+        double hi = -std::numeric_limits<double>::max();
+
+        forEachValue( windows, [&]( double value ) {
+          if( std::isfinite( value ) ) {
+            lo = std::min( lo, value );
+            hi = std::max( hi, value );
+          }
+        } );
+
+        bound = ( lo <= hi ) ? m_bound * ( hi - lo ) : 0.0;
+      }
+
+      const double binWidth = 2.0 * bound;
+
+      std::vector<int32_t> codes;
+      std::vector<double>  outliers;
+      double               previous = 0.0;
+
+      codes.reserve( numValues );
+
+      forEachValue( windows, [&]( double value ) {
+        int32_t code = OUTLIER;
+
+        if( binWidth > 0.0 ) {
+          const double bins = ( value - previous ) / binWidth;
+
+          if( std::fabs( bins ) < MAX_BINS ) {
+            code = (int32_t) std::lround( bins );
+
+            const double decoded = reconstruct( previous, binWidth, code );
+
+            if( std::fabs( value - decoded ) <= bound ) {
+              previous = decoded;
+            }
+            else {
+              code = OUTLIER;
+            }
+          }
+        }
+        else if( value == previous ) {
+          code = 0;
+        }
+
+        if( code == OUTLIER ) {
+          outliers.push_back( value );
+          previous = value;
+        }
+        codes.push_back( code );
+      } );
+
+      out.clear();
+      putHeader( out, numValues );
+      putHeader( out, toBits( bound ) );
+      putHeader( out, outliers.size() );
+
+      const size_t sizePos = out.size();
+      putHeader( out, 0 );
+
+      deflateShuffled( codes.data(), codes.size(), sizeof(int32_t), out );
+
+      const uint64_t codeSize = out.size() - sizePos - sizeof(uint64_t);
+      memcpy( &out[ sizePos ], &codeSize, sizeof(codeSize) );
+
+      deflateShuffled( outliers.data(), outliers.size(), sizeof(double), out );
+    }
+
+    virtual void decompress( const char        * data
+                           ,       size_t        size
+                           ,       int           /* nByteMode */
+                           ,       bool          swapBytes
+                           ,       std::string & out
+                           ) const
+    {
+      const size_t numValues   = getHeader( data, size, swapBytes );
+      const double bound       = fromBits( getHeader( data, size, swapBytes ) );
+      const size_t numOutliers = getHeader( data, size, swapBytes );
+      const size_t codeSize    = getHeader( data, size, swapBytes );
+
+      if( codeSize > size || numOutliers > numValues ) {
+        throw InternalError( "CompressionCodec: corrupt lossy data", __FILE__, __LINE__ );
+      }
+
+      std::vector<int32_t> codes( numValues );
+      std::vector<double>  outliers( numOutliers );
+
+      inflateShuffled( data, codeSize, codes.data(), numValues, sizeof(int32_t) );
+      inflateShuffled( data + codeSize, size - codeSize, outliers.data(), numOutliers, sizeof(double) );
+
+      // The data are handed back in the byte order of the writer.
+      const double binWidth = 2.0 * bound;
+      double       previous = 0.0;
+      size_t       outlier  = 0;
+
+      out.resize( numValues * sizeof(double) );
+      char * dest = &out[0];
+
+      for( size_t i = 0; i < numValues; ++i, dest += sizeof(double) ) {
+        int32_t code = codes[i];
+        if( swapBytes ) {
+          swapbytes( code );
+        }
+
+        double value;
+
+        if( code == OUTLIER ) {
+          if( outlier == numOutliers ) {
+            throw InternalError( "CompressionCodec: corrupt lossy data", __FILE__, __LINE__ );
+          }
+          value = outliers[ outlier++ ];
+          if( swapBytes ) {
+            swapbytes( value );
+          }
+        }
+        else {
+          value = reconstruct( previous, binWidth, code );
+        }
+        previous = value;
+
+        if( swapBytes ) {
+          swapbytes( value );
+        }
+        memcpy( dest, &value, sizeof(double) );
+      }
+    }
+
+  private:
+
+    static const int32_t OUTLIER = std::numeric_limits<int32_t>::min();
+
+    // Quantized prediction errors must fit in an int32 (other than OUTLIER).
+    static constexpr double MAX_BINS = 1.0e9;
+
+    // The encoder and the decoder must reconstruct the same value.
+    static double reconstruct( double previous, double binWidth, int32_t code )
+    {
+      return previous + binWidth * (double) code;
+    }
+
+    static uint64_t toBits( double value )
+    {
+      uint64_t bits;
+      memcpy( &bits, &value, sizeof(bits) );
+      return bits;
+    }
+
+    static double fromBits( uint64_t bits )
+    {
+      double value;
+      memcpy( &value, &bits, sizeof(value) );
+      return value;
+    }
+
+    template <typename Function>
+    static void forEachValue( const std::vector<iovec> & windows, const Function & function )
+    {
+      for( const iovec & window : windows ) {
+        const char * src = static_cast<const char*>( window.iov_base );
+
+        for( size_t k = 0; k < window.iov_len; k += sizeof(double) ) {
+          double value;
+          memcpy( &value, src + k, sizeof(double) );
+          function( value );
+        }
+      }
+    }
+
+    static void deflateShuffled( const void * values, size_t count, size_t elementSize, std::string & out )
+    {
+      const std::vector<iovec> windows( 1, iovec{ const_cast<void*>( values ), count * elementSize } );
+
+      std::string shuffled( count * elementSize, '\0' );
+      shuffle( windows, elementSize, &shuffled[0] );
+
+      const std::vector<iovec> pieces( 1, iovec{ &shuffled[0], shuffled.size() } );
+      deflatePieces( pieces, out );
+    }
+
+    static void inflateShuffled( const char * data, size_t size, void * values, size_t count, size_t elementSize )
+    {
+      std::string shuffled( count * elementSize, '\0' );
+      inflateInto( data, size, &shuffled[0], shuffled.size() );
+      unshuffle( shuffled.data(), shuffled.size(), elementSize, static_cast<char*>( values ) );
+    }
+
+    bool   m_configured{ false };
+    bool   m_relative{ false };
+    double m_bound{ 0.0 };
+
+    mutable std::mutex                                                 m_configured_lock;
+    mutable std::map<std::string, std::unique_ptr<CompressionCodec> > m_configurations;
+  };
+
+  //______________________________________________________________________
+  //
+  std::mutex g_registry_lock;
+
+  std::map<std::string, std::unique_ptr<CompressionCodec> > &
+  registry()
+  {
+    static std::map<std::string, std::unique_ptr<CompressionCodec> > codecs = []() {
+      std::map<std::string, std::unique_ptr<CompressionCodec> > builtin;
+
+      for( CompressionCodec * codec : { (CompressionCodec*) new GzipCodec(),
+                                        (CompressionCodec*) new ShuffleZlibCodec(),
+                                        (CompressionCodec*) new BlockZlibCodec(),
+                                        (CompressionCodec*) new LossyCodec() } ) {
+        builtin[ codec->getName() ].reset( codec );
+      }
+      return builtin;
+    }();
+
+    return codecs;
+  }
+}
+
+//______________________________________________________________________
+//
+void
+CompressionCodec::registerCodec( CompressionCodec * codec )
+{
+  std::lock_guard<std::mutex> lock( g_registry_lock );
+  registry()[ codec->getName() ].reset( codec );
+}
+
+//______________________________________________________________________
+//
+const CompressionCodec *
+CompressionCodec::configure( const std::string & options ) const
+{
+  SCI_THROW( InvalidCompressionMode( m_name + ":" + options, "", __FILE__, __LINE__ ) );
+}
+
+//______________________________________________________________________
+//
+const CompressionCodec *
+CompressionCodec::find( const std::string & mode )
+{
+  if( mode.empty() || mode == "none" ) {
+    return nullptr;
+  }
+
+  const size_t colon = mode.find( ':' );
+
+  const CompressionCodec * codec;
+  {
+    std::lock_guard<std::mutex> lock( g_registry_lock );
+
+    auto iter = registry().find( mode.substr( 0, colon ) );
+    if( iter == registry().end() ) {
+      SCI_THROW( InvalidCompressionMode( mode, "", __FILE__, __LINE__ ) );
+    }
+    codec = iter->second.get();
+  }
+
+  if( colon != std::string::npos ) {
+    codec = codec->configure( mode.substr( colon + 1 ) );
+  }
+  return codec;
+}
+
+//______________________________________________________________________
+//
+bool
+CompressionCodec::isValid( const std::string & mode )
+{
+  try {
+    find( mode );
+  }
+  catch( const InvalidCompressionMode & ) {
+    return false;
+  }
+  return true;
+}
+
+//______________________________________________________________________
+//
+std::vector<std::string>
+CompressionCodec::getNames()
+{
+  std::lock_guard<std::mutex> lock( g_registry_lock );
+
+  std::vector<std::string> names;
+  for( auto & codec : registry() ) {
+    names.push_back( codec.first );
+  }
+  return names;
+}
+
+//______________________________________________________________________
+//
+void
+CompressionCodec::setNumThreads( int num )
+{
+  g_num_threads = std::max( 1, num );
+}
+
+//______________________________________________________________________
+//
+int
+CompressionCodec::getNumThreads()
+{
+  return g_num_threads;
+}
@@ -0,0 +1,157 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#ifndef CORE_GRID_VARIABLES_COMPRESSIONCODEC_H
+#define CORE_GRID_VARIABLES_COMPRESSIONCODEC_H
+
+#include <sys/uio.h>
+
+#include <string>
+#include <vector>
+
+namespace Uintah {
+
+  /**************************************
+
+     CLASS
+       CompressionCodec
+
+       Named compression schemes for the data of saved variables.
+
+     GENERAL INFORMATION
+
+       CompressionCodec.h
+
+     KEYWORDS
+       DataArchiver, DataArchive, compression, gzip
+
+     DESCRIPTION
+       Variable::emit hands a codec the data of a variable as a list
+       of windows into the variable's storage (see
+       Variable::emitWindows) and writes whatever the codec returns;
+       Variable::read hands the bytes read from the data file back to
+       the codec with the same name.  The name is the value of the
+       <compression> element of the variable in the uda index and of
+       the compression attribute of <save>.
+
+       The codecs that come with Uintah are:
+
+         gzip         - zlib, the format Uintah has always written.
+         shuffle-zlib - the bytes of the elements are regrouped by
+                        their position in the element (all first
+                        bytes, then all second bytes, ...) before
+                        zlib.  Floating point fields compress much
+                        better that way.
+         block-zlib   - shuffle-zlib on independent blocks that are
+                        compressed and decompressed by several
+                        threads (setNumThreads).
+         lossy        - error-bounded compression of double fields,
+                        configured as "lossy:abs=<bound>" or
+                        "lossy:rel=<bound>" (relative to the range of
+                        the values).  Each value is predicted from the
+                        previously decoded one, the prediction error is
+                        quantized to bins of twice the bound and the
+                        bin numbers are shuffled and deflated.  Values
+                        that cannot be quantized (inf, nan, huge jumps)
+                        are stored exactly.
+
+       A name may carry options after a ':', find() then returns the
+       codec configured by configure().  The options of a lossy codec
+       are stored in its data, the uda index only records the name.
+
+       Lossy codecs are never used for checkpoints, Variable::emit
+       substitutes their getLosslessCodec().
+
+       Other codecs may be added with registerCodec().
+
+  ****************************************/
+
+  class CompressionCodec {
+
+  public:
+
+    virtual ~CompressionCodec() {}
+
+    const std::string & getName() const { return m_name; }
+
+    virtual bool isLossless() const { return true; }
+
+    // The codec written instead of this one when the data must be
+    // preserved exactly (checkpoints).
+    virtual const CompressionCodec * getLosslessCodec() const { return this; }
+
+    // A codec for the options following the ':' of a compression mode,
+    // owned by the codec.  Throws InvalidCompressionMode for bad options.
+    virtual const CompressionCodec * configure( const std::string & options ) const;
+
+    // Compresses the concatenation of 'windows' into 'out'.
+    // 'elementSize' is the size in bytes of one element of the
+    // variable, all windows hold whole elements.
+    virtual void compress( const std::vector<iovec> & windows
+                         ,       size_t               elementSize
+                         ,       std::string        & out
+                         ) const = 0;
+
+    // 'nByteMode' (size of a size_t) and 'swapBytes' describe the
+    // machine that wrote the data.
+    virtual void decompress( const char        * data
+                           ,       size_t        size
+                           ,       int           nByteMode
+                           ,       bool          swapBytes
+                           ,       std::string & out
+                           ) const = 0;
+
+    // The registry takes ownership of the codec.
+    static void registerCodec( CompressionCodec * codec );
+
+    // Returns nullptr for "" and "none", throws InvalidCompressionMode
+    // for an unknown name or invalid options.
+    static const CompressionCodec * find( const std::string & mode );
+
+    static bool isValid( const std::string & mode );
+
+    static std::vector<std::string> getNames();
+
+    // Threads used by the block codecs (default 4).
+    static void setNumThreads( int num );
+    static int  getNumThreads();
+
+  protected:
+
+    CompressionCodec( const std::string & name ) : m_name( name ) {}
+
+  private:
+
+    // eliminate copy, assignment and move
+    CompressionCodec( const CompressionCodec & )            = delete;
+    CompressionCodec& operator=( const CompressionCodec & ) = delete;
+    CompressionCodec( CompressionCodec && )                 = delete;
+    CompressionCodec& operator=( CompressionCodec && )      = delete;
+
+    std::string m_name;
+  };
+
+} // End namespace Uintah
+
+#endif // CORE_GRID_VARIABLES_COMPRESSIONCODEC_H
@@ -41,6 +41,7 @@
 #include <sci_defs/pidx_defs.h>
 
 #include <cstring>
+#include <type_traits>
 
 namespace Uintah {
 
@@ -194,6 +195,22 @@ WARNING
       }
     }
 
+    virtual bool emitWindows( const IntVector& l, const IntVector& h, ProblemSpecP /*varnode*/,
+                              bool outputDoubleAsFloat, std::vector<iovec>& windows, size_t& elementSize ) {
+      const TypeDescription* td = fun_getTypeDescription( (T*)nullptr );
+      if( !td->isFlat() ) {
+        return false;
+      }
+      // doubles written as floats have to be converted, see Array3<double>::write
+      if( outputDoubleAsFloat && std::is_same<T, double>::value ) {
+        elementSize = sizeof(float);
+        return false;
+      }
+      Array3<T>::getWindows(l, h, windows);
+      elementSize = sizeof(T);
+      return true;
+    }
+
     virtual void readNormal(std::istream& in, bool swapBytes)
     {
       const TypeDescription* td = fun_getTypeDescription((T*)0);
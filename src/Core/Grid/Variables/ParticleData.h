@@ -25,6 +25,7 @@
 #ifndef UINTAH_HOMEBREW_PARTICLEDATA_H
 #define UINTAH_HOMEBREW_PARTICLEDATA_H
 
+#include <Core/Grid/Variables/VariableMemoryPool.h>
 #include <Core/Util/RefCounted.h>
 #include <Core/Grid/Variables/ParticleSubset.h> // For particleIndex
 
@@ -67,12 +68,12 @@ WARNING
       //////////
       // Insert Documentation Here:
       void resize(int newSize) {
-        T* newdata = scinew T[newSize];
+        T* newdata = VariableMemoryPool::allocateArray<T>(newSize);
         if(data){
           int smaller = ((newSize < size ) ? newSize:size);
           for(int i = 0; i < smaller; i++)
             newdata[i] = data[i];
-          delete[] data;
+          VariableMemoryPool::deallocateArray(data, size);
         }
         data = newdata;
         size = newSize;
@@ -99,14 +100,14 @@ WARNING
      ParticleData<T>::ParticleData(particleIndex size)
      : size(size)
       {
-        data = scinew T[size];
+        data = VariableMemoryPool::allocateArray<T>(size);
       }
       
    template<class T>
       ParticleData<T>::~ParticleData()
       {
         if(data)
-          delete[] data;
+          VariableMemoryPool::deallocateArray(data, size);
       }
 
    template<class T>
@@ -46,6 +46,8 @@
 
 #include <iostream>
 #include <cstring>
+#include <type_traits>
+#include <vector>
 
 
 namespace Uintah {
@@ -165,6 +167,8 @@ public:
                            const ProcessorGroup* pg,
                            ParticleSubset* pset);
   virtual void emitNormal( std::ostream& out, const IntVector&, const IntVector&, ProblemSpecP, bool outputDoubleAsFloat );
+  virtual bool emitWindows( const IntVector&, const IntVector&, ProblemSpecP varnode, bool outputDoubleAsFloat,
+                            std::vector<iovec>& windows, size_t& elementSize );
   virtual void emitPIDX(       PIDXOutputContext & oc,
                                unsigned char     * buffer,
                          const IntVector         & /* l */,
@@ -527,7 +531,7 @@ template<class T>
   {
     const TypeDescription* td = fun_getTypeDescription((T*)nullptr);
 
-    if (varnode->findBlock("numParticles") == nullptr) {
+    if (varnode != nullptr && varnode->findBlock("numParticles") == nullptr) {
       varnode->appendElement("numParticles", d_pset->numParticles());
     }
     if(!td->isFlat()){
@@ -550,6 +554,47 @@ template<class T>
     }
   }
 
+  template<class T>
+  bool
+  ParticleVariable<T>::emitWindows( const IntVector          & /* l */,
+                                    const IntVector          & /* h */,
+                                          ProblemSpecP         varnode,
+                                          bool                 outputDoubleAsFloat,
+                                          std::vector<iovec> & windows,
+                                          size_t             & elementSize )
+  {
+    const TypeDescription* td = fun_getTypeDescription((T*)nullptr);
+
+    if( !td->isFlat() ) {
+      return false;
+    }
+
+    // doubles written as floats have to be converted, see emitNormal
+    if( outputDoubleAsFloat && std::is_same<T, double>::value ) {
+      elementSize = sizeof(float);
+      return false;
+    }
+
+    if (varnode != nullptr && varnode->findBlock("numParticles") == nullptr) {
+      varnode->appendElement("numParticles", d_pset->numParticles());
+    }
+
+    // One window per run of consecutive particles, as emitNormal writes them.
+    ParticleSubset::iterator iter = d_pset->begin();
+    while(iter != d_pset->end()){
+      particleIndex start = *iter;
+      iter++;
+      particleIndex end = start+1;
+      while(iter != d_pset->end() && *iter == end) {
+        end++;
+        iter++;
+      }
+      windows.push_back({(void*)&(*this)[start], sizeof(T)*(end-start)});
+    }
+    elementSize = sizeof(T);
+    return true;
+  }
+
   template<class T>
   void
   ParticleVariable<T>::emitPIDX(       PIDXOutputContext & oc,
@@ -145,7 +145,7 @@ using namespace std;
   {
     const TypeDescription* td = fun_getTypeDescription((double*)nullptr);
 
-    if ( varnode->findBlock("numParticles") == nullptr ) {
+    if ( varnode != nullptr && varnode->findBlock("numParticles") == nullptr ) {
       varnode->appendElement("numParticles", d_pset->numParticles());
     }
     if( !td->isFlat() ) {
@@ -28,29 +28,73 @@
 
 #include <Core/Disclosure/TypeDescription.h>
 #include <Core/Exceptions/ErrnoException.h>
-#include <Core/Exceptions/InvalidCompressionMode.h>
 #include <Core/Grid/Patch.h>
+#include <Core/Grid/Variables/CompressionCodec.h>
 #include <Core/Malloc/Allocator.h>
 #include <Core/Util/Endian.h>
 #include <Core/Util/FancyAssert.h>
-#include <Core/Util/SizeTypeConvert.h>
 
 #include <CCA/Ports/InputContext.h>
 #include <CCA/Ports/OutputContext.h>
 #include <CCA/Ports/PIDXOutputContext.h>
 
+#include <algorithm>
 #include <cmath>
 #include <cerrno>
+#include <climits>
 #include <cstdio>
 #include <cstring>
 #include <iostream>
 #include <sstream>
 
-#include <zlib.h>
+#include <unistd.h>
 
 
 using namespace Uintah;
 
+namespace {
+
+  //______________________________________________________________________
+  //  Writes all of 'windows' to oc.fd, IOV_MAX windows per writev().
+  void
+  writeWindows( const OutputContext & oc, std::vector<iovec> & windows, size_t total )
+  {
+    size_t first   = 0;
+    size_t written = 0;
+
+    while( first < windows.size() ) {
+      const int count = (int) std::min( windows.size() - first, (size_t) IOV_MAX );
+
+      errno = -1;
+      ssize_t s = ::writev( oc.fd, &windows[first], count );
+
+      if ( s <= 0 ) {
+        std::cerr << "\nERROR Variable::emit - write system call failed writing to (" << oc.filename << ") with errno "
+                  << errno << ": " << strerror(errno) << std::endl;
+        std::cerr << " * Write buffer size: (" << total << "), but actually wrote buffer size:(" << written << ")\n\n";
+
+        SCI_THROW(ErrnoException("Variable::emit (write call)", errno, __FILE__, __LINE__));
+      }
+      written += s;
+
+      // Skip the windows written completely, trim a partially written one.
+      while( s > 0 ) {
+        iovec & window = windows[first];
+
+        if( (size_t) s >= window.iov_len ) {
+          s -= window.iov_len;
+          ++first;
+        }
+        else {
+          window.iov_base = static_cast<char*>( window.iov_base ) + s;
+          window.iov_len -= s;
+          s = 0;
+        }
+      }
+    }
+  }
+}
+
 
 //______________________________________________________________________
 //
@@ -83,57 +127,99 @@ Variable::emit(       OutputContext & oc
               , const std::string   & compressionMode
               )
 {
-  bool use_gzip = false;
+  const CompressionCodec * codec = CompressionCodec::find( compressionMode );
 
-  if (compressionMode == "gzip") {
-    use_gzip = true;
-  }
-  else if (compressionMode != "" && compressionMode != "none") {
-    std::cout << "Invalid Compression Mode - throwing exception...\n";
-    SCI_THROW(InvalidCompressionMode(compressionMode, "", __FILE__, __LINE__));
+  if ( codec != nullptr && oc.checkpoint && !codec->isLossless() ) {
+    codec = codec->getLosslessCodec();
   }
 
-  std::ostringstream outstream;
-  emitNormal( outstream, l, h, oc.varnode, oc.outputDoubleAsFloat );
+  // Write straight from the variable's storage when possible, only
+  // the variables that cannot describe their data as windows are
+  // serialized into a string first.
+  std::vector<iovec> windows;
+  size_t             elementSize = 1;
+  std::string        serialized;
 
-  std::string sourceString = outstream.str();
-  std::string bufferString;  // trying to avoid copying the strings back and forth
-  std::string* writeString = &sourceString;
+  if( !emitWindows( l, h, oc.varnode, oc.outputDoubleAsFloat, windows, elementSize ) ) {
+    std::ostringstream outstream;
+    emitNormal( outstream, l, h, oc.varnode, oc.outputDoubleAsFloat );
 
-  if (use_gzip) {
-    writeString = gzipCompress( &sourceString, &bufferString );
+    serialized = outstream.str();
+
+    // unless emitWindows() described the serialized elements the
+    // bytes are opaque
+    if( serialized.size() % elementSize != 0 ) {
+      elementSize = 1;
+    }
+
+    windows.clear();
+    if( !serialized.empty() ) {
+      windows.push_back( { &serialized[0], serialized.size() } );
+    }
   }
 
+  // Lossy codecs quantize doubles, doubles already written as floats
+  // (outputDoubleAsFloat) are compressed losslessly.
+  if ( codec != nullptr && !codec->isLossless() && elementSize != sizeof(double) ) {
+    codec = codec->getLosslessCodec();
+  }
 
-  //__________________________________
-  //  Write the buffer
-  errno = -1;
-  const char* writeBuffer = (*writeString).c_str();
-  size_t writeBufferSize  = (*writeString).size();
+  std::string compressed;
 
+  if( codec != nullptr ) {
+    codec->compress( windows, elementSize, compressed );
+    std::string().swap( serialized );
 
-  if ( writeBufferSize > 0 ) {
-    ssize_t s = ::write( oc.fd, writeBuffer, writeBufferSize );
+    windows.assign( 1, { &compressed[0], compressed.size() } );
+  }
 
-    if ( s != (long)writeBufferSize ) {
-      std::cerr << "\nERROR Variable::emit - write system call failed writing to (" << oc.filename << ") with errno "
-                << errno << ": " << strerror(errno) << std::endl;
-      std::cerr << " * Write buffer size: (" << writeBufferSize << "), but actually wrote buffer size:(" << s << ")\n\n";
+  size_t writeBufferSize = 0;
+  for( const iovec & window : windows ) {
+    writeBufferSize += window.iov_len;
+  }
 
-      SCI_THROW(ErrnoException("Variable::emit (write call)", errno, __FILE__, __LINE__));
+  //__________________________________
+  //  Write the buffer
+  if ( writeBufferSize > 0 && oc.buffer != nullptr ) {
+    // Staged (asynchronous) output - the DataArchiver writes the buffer later.
+    oc.buffer->reserve( oc.buffer->size() + writeBufferSize );
+    for( const iovec & window : windows ) {
+      oc.buffer->append( static_cast<const char*>( window.iov_base ), window.iov_len );
     }
     oc.cur += writeBufferSize;
   }
+  else if ( writeBufferSize > 0 ) {
+    writeWindows( oc, windows, writeBufferSize );
+    oc.cur += writeBufferSize;
+  }
 
   //__________________________________
   //write <compression> gzip </compression> to xml file
-  if (use_gzip) {
-    oc.varnode->appendElement("compression", compressionMode);
+  if ( codec != nullptr ) {
+    oc.compression = codec->getName();
+
+    if ( oc.varnode != nullptr ) {
+      oc.varnode->appendElement( "compression", codec->getName() );
+    }
   }
 
   return writeBufferSize;
 }
 
+//______________________________________________________________________
+//
+bool
+Variable::emitWindows( const IntVector          & /* l */
+                     , const IntVector          & /* h */
+                     ,       ProblemSpecP         /* varnode */
+                     ,       bool                 /* outputDoubleAsFloat */
+                     ,       std::vector<iovec> & /* windows */
+                     ,       size_t             & /* elementSize */
+                     )
+{
+  return false;
+}
+
 //______________________________________________________________________
 //
 #if HAVE_PIDX
@@ -171,49 +257,6 @@ Variable::emitPIDX(       PIDXOutputContext & /* oc */
 #endif
 
 
-//______________________________________________________________________
-//
-std::string*
-Variable::gzipCompress( std::string* source_str
-                      , std::string* dest_str
-                      )
-{
-  unsigned long source_size = source_str->size();
-
-  // follows compress guidelines: 1% more than source size + 12 (round up, so use + 13).
-  unsigned long dest_size = source_size * 101 / 100 + 13;
-
-
-  dest_str->resize( dest_size + sizeof(ssize_t) );          // increase the size and fill with "\000"
-
-  char* dest_buf = const_cast<char*>( dest_str->c_str() );  // casting from const
-
-  dest_buf += sizeof(ssize_t);                              // the first part will give the size of the source data
-
-                                                            // compress
-  int result = compress((Bytef*)dest_buf, &dest_size, (const Bytef*)source_str->c_str(), source_size);
-
-
-  if ( result != Z_OK ){
-    printf("compress error result is %d\n", result);
-    throw InternalError("ERROR Uintah::Variable::gzipCompress.   compression failed.", __FILE__, __LINE__);
-  }
-
-                                  // Add the source size to the first part of the dest_str
-                                  // The source size is needed during decompress()
-  dest_str->resize( dest_size + sizeof(ssize_t) );
-
-  char* pbyte = (char*)(&source_size);
-
-  for (int i = 0; i < (int)sizeof(ssize_t); i++, pbyte++) {
-    (*dest_str)[i] = *pbyte;
-  }
-
-  source_str->erase();         // the original dest_str isn't needed, erase it to save space
-
-  return dest_str;
-}
-
 //______________________________________________________________________
 //
 void
@@ -224,14 +267,7 @@ Variable::read(       InputContext & ic
               , const std::string  & compressionMode
               )
 {
-  bool use_gzip = false;
-
-  if (compressionMode == "gzip") {
-    use_gzip = true;
-  }
-  else if (compressionMode != "" && compressionMode != "none") {
-    SCI_THROW(InvalidCompressionMode(compressionMode, "", __FILE__, __LINE__));
-  }
+  const CompressionCodec * codec = CompressionCodec::find( compressionMode );
 
   long datasize = end - ic.cur;
 
@@ -258,40 +294,10 @@ Variable::read(       InputContext & ic
     ic.cur += datasize;
 
     //__________________________________
-    // gzip compression
-    if (use_gzip) {
-
-      // first read the uncompressed data size
-      std::istringstream compressedStream(data);
-      uint64_t uncompressed_size_64;
-      compressedStream.read((char*)&uncompressed_size_64, nByteMode);
-
-      unsigned long uncompressed_size = convertSizeType(&uncompressed_size_64, swapBytes, nByteMode);
-      if (uncompressed_size > 1000000000) {
-        std::cout << "\n";
-        std::cout << "--------------------------------------------------------------------------\n";
-        std::cout << "!!!!!!!! WARNING !!!!!!!! \n";
-        std::cout << "\n";
-        std::cout << "Size of uncompressed variable seems wrong: " << uncompressed_size << "\n";
-        std::cout << "Most likely, the UDA you are trying to read is corrupted due to a problem with\n";
-        std::cout << "libz when it was created... Also, an exception most likely is about to be thrown...\n";
-        std::cout << "--------------------------------------------------------------------------\n";
-        std::cout << "\n\n";
-      }
-
-      const char* compressed_data = data.c_str() + nByteMode;
-      long compressed_datasize = datasize - (long)(nByteMode);
-
-      // casting from const char* below to char* -- use caution
-      bufferStr.resize(uncompressed_size);
-      char* buffer = (char*)bufferStr.c_str();
-
-      int result = uncompress((Bytef*)buffer, &uncompressed_size, (const Bytef*)compressed_data, compressed_datasize);
-
-      if ( result != Z_OK ) {
-        printf("Uncompress error result is %d\n", result);
-        throw InternalError("ERROR Uintah::Variable::read.   Call to uncompress() failed.", __FILE__, __LINE__);
-      }
+    // compressed
+    if (codec != nullptr) {
+      codec->decompress( data.data(), datasize, nByteMode, swapBytes, bufferStr );
+      std::string().swap( data );
 
       uncompressedData = &bufferStr;
     }
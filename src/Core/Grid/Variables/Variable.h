@@ -29,8 +29,11 @@
 
 #include <sci_defs/pidx_defs.h>
 
+#include <sys/uio.h>
+
 #include <string>
 #include <iosfwd>
+#include <vector>
 
 namespace Uintah {
 
@@ -124,6 +127,20 @@ public:
                          ,       bool           outputDoubleAsFloat
                          ) = 0;
 
+  // Appends to 'windows' the pieces of the variable's storage that
+  // emitNormal would write, in the same order, so they can be written
+  // or compressed without copying.  Returns false if the variable has
+  // to be serialized through emitNormal, 'elementSize' may then be set
+  // to the size of the elements emitNormal writes (e.g. doubles output
+  // as floats).
+  virtual bool emitWindows( const IntVector          & l
+                          , const IntVector          & h
+                          ,       ProblemSpecP         varnode
+                          ,       bool                 outputDoubleAsFloat
+                          ,       std::vector<iovec> & windows
+                          ,       size_t             & elementSize
+                          );
+
   virtual void readNormal( std::istream& in, bool swapbytes ) = 0;
 
   virtual void allocate( const Patch* patch, const IntVector& boundary ) = 0;
@@ -157,13 +174,6 @@ private:
   Variable( Variable && )                 = delete;
   Variable& operator=( Variable && )      = delete;
 
-  // Compresses the string pointed to by pUncompressed and but the resulting
-  // compressed data into the string pointed to by pBuffer.
-  // Returns the pointer to whichever one is shortest and erases the  other one.
-  std::string* gzipCompress( std::string* pUncompressed
-                           , std::string* pBuffer
-                           );
-
   // states that the variable is from another node - these variables (ghost cells, slabs, corners) are communicated via MPI
   bool d_foreign {false};
 
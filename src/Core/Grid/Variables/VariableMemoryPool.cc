@@ -0,0 +1,297 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#include <Core/Grid/Variables/VariableMemoryPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+#ifdef __linux__
+#  include <sys/syscall.h>
+#  include <unistd.h>
+#endif
+
+using namespace Uintah;
+
+namespace {
+
+  const size_t ALIGNMENT   = 64;    // Also the size of the block header
+  const size_t PAGE_SIZE   = 4096;
+  const int    MIN_SHIFT   = 8;     // Smallest size class is 2^MIN_SHIFT bytes
+  const int    MAX_SHIFT   = 40;    // Larger blocks are not pooled
+  const int    NUM_CLASSES = ( MAX_SHIFT - MIN_SHIFT ) * 4 + 1;
+  const int    MAX_NODES   = 8;
+
+  // Stored in the ALIGNMENT bytes in front of every block.
+  struct BlockHeader {
+    int32_t sizeClass;   // -1 if the block is not pooled
+    int32_t node;
+    size_t  bytes;
+  };
+
+  static_assert( sizeof(BlockHeader) <= ALIGNMENT, "BlockHeader does not fit in front of the block" );
+
+  struct FreeList {
+    std::mutex          lock;
+    std::vector<char*>  blocks;
+    size_t              lowWater{ 0 };  // Fewest blocks held since the last trim
+  };
+
+  struct Pool {
+    std::atomic<bool>          enabled{ false };
+    FreeList                   freeLists[ MAX_NODES ][ NUM_CLASSES ];
+
+    std::atomic<unsigned long> requests{ 0 };
+    std::atomic<unsigned long> reused{ 0 };
+    std::atomic<unsigned long> bytesInUse{ 0 };
+    std::atomic<unsigned long> peakBytesInUse{ 0 };
+    std::atomic<unsigned long> bytesCached{ 0 };
+    std::atomic<unsigned long> numBlocksCached{ 0 };
+    std::atomic<unsigned long> bytesReleased{ 0 };
+  };
+
+  // Never deleted, variables may be freed by static destructors.
+  Pool &
+  pool()
+  {
+    static Pool * thePool = new Pool;
+    return *thePool;
+  }
+
+  //______________________________________________________________________
+  //  256 bytes, then four classes per power of two.
+  int
+  getSizeClass( size_t bytes, size_t & blockBytes )
+  {
+    if( bytes <= ( (size_t) 1 << MIN_SHIFT ) ) {
+      blockBytes = (size_t) 1 << MIN_SHIFT;
+      return 0;
+    }
+
+    // 2^e < bytes <= 2^(e+1)
+    const int e = 63 - __builtin_clzl( (unsigned long) ( bytes - 1 ) );
+    if( e >= MAX_SHIFT ) {
+      return -1;
+    }
+
+    const size_t base = (size_t) 1 << e;
+    const size_t step = base >> 2;
+    const size_t q    = ( bytes - 1 - base ) / step;
+
+    blockBytes = base + ( q + 1 ) * step;
+    return ( e - MIN_SHIFT ) * 4 + (int) q + 1;
+  }
+
+  //______________________________________________________________________
+  //
+  int
+  currentNode()
+  {
+#if defined( __linux__ ) && defined( SYS_getcpu )
+    unsigned int cpu  = 0;
+    unsigned int node = 0;
+    if( syscall( SYS_getcpu, &cpu, &node, nullptr ) == 0 ) {
+      return node % MAX_NODES;
+    }
+#endif
+    return 0;
+  }
+
+  //______________________________________________________________________
+  //
+  void
+  updatePeak( Pool & p, unsigned long inUse )
+  {
+    unsigned long peak = p.peakBytesInUse.load( std::memory_order_relaxed );
+    while( inUse > peak && !p.peakBytesInUse.compare_exchange_weak( peak, inUse, std::memory_order_relaxed ) ) {
+    }
+  }
+
+}
+
+//______________________________________________________________________
+//
+void
+VariableMemoryPool::setEnabled( bool enabled )
+{
+  pool().enabled = enabled;
+}
+
+//______________________________________________________________________
+//
+bool
+VariableMemoryPool::isEnabled()
+{
+  return pool().enabled;
+}
+
+//______________________________________________________________________
+//
+void *
+VariableMemoryPool::allocate( size_t bytes )
+{
+  Pool & p = pool();
+
+  size_t blockBytes = bytes;
+  int    sizeClass  = p.enabled ? getSizeClass( bytes, blockBytes ) : -1;
+  int    node       = 0;
+  char * block      = nullptr;
+
+  if( sizeClass >= 0 ) {
+    node = currentNode();
+    p.requests.fetch_add( 1, std::memory_order_relaxed );
+
+    FreeList & list = p.freeLists[ node ][ sizeClass ];
+    {
+      std::lock_guard<std::mutex> guard( list.lock );
+      if( !list.blocks.empty() ) {
+        block = list.blocks.back();
+        list.blocks.pop_back();
+        list.lowWater = std::min( list.lowWater, list.blocks.size() );
+      }
+    }
+
+    if( block ) {
+      p.reused.fetch_add( 1, std::memory_order_relaxed );
+      p.bytesCached.fetch_sub( blockBytes, std::memory_order_relaxed );
+      p.numBlocksCached.fetch_sub( 1, std::memory_order_relaxed );
+    }
+  }
+
+  if( block == nullptr ) {
+    void * ptr = nullptr;
+    if( posix_memalign( &ptr, ALIGNMENT, ALIGNMENT + blockBytes ) != 0 ) {
+      throw std::bad_alloc();
+    }
+    block = static_cast<char*>( ptr );
+
+    // First touch, so the pages land on this thread's NUMA node.
+    if( sizeClass >= 0 ) {
+      for( size_t offset = ALIGNMENT; offset < ALIGNMENT + blockBytes; offset += PAGE_SIZE ) {
+        block[ offset ] = 0;
+      }
+    }
+
+    BlockHeader * header = reinterpret_cast<BlockHeader*>( block );
+    header->sizeClass = sizeClass;
+    header->node      = node;
+    header->bytes     = blockBytes;
+  }
+
+  updatePeak( p, p.bytesInUse.fetch_add( blockBytes, std::memory_order_relaxed ) + blockBytes );
+
+  return block + ALIGNMENT;
+}
+
+//______________________________________________________________________
+//
+void
+VariableMemoryPool::deallocate( void * ptr )
+{
+  if( ptr == nullptr ) {
+    return;
+  }
+
+  Pool & p = pool();
+
+  char        * block  = static_cast<char*>( ptr ) - ALIGNMENT;
+  BlockHeader * header = reinterpret_cast<BlockHeader*>( block );
+
+  p.bytesInUse.fetch_sub( header->bytes, std::memory_order_relaxed );
+
+  if( header->sizeClass < 0 || !p.enabled ) {
+    free( block );
+    return;
+  }
+
+  FreeList & list = p.freeLists[ header->node ][ header->sizeClass ];
+  {
+    std::lock_guard<std::mutex> guard( list.lock );
+    list.blocks.push_back( block );
+  }
+
+  p.bytesCached.fetch_add( header->bytes, std::memory_order_relaxed );
+  p.numBlocksCached.fetch_add( 1, std::memory_order_relaxed );
+}
+
+//______________________________________________________________________
+//
+void
+VariableMemoryPool::trim()
+{
+  Pool & p = pool();
+
+  for( int node = 0; node < MAX_NODES; node++ ) {
+    for( int sizeClass = 0; sizeClass < NUM_CLASSES; sizeClass++ ) {
+      FreeList & list = p.freeLists[ node ][ sizeClass ];
+
+      std::vector<char*> released;
+      {
+        std::lock_guard<std::mutex> guard( list.lock );
+
+        // The blocks that were never taken since the last trim were
+        // not needed, release the ones that have been cached longest.
+        size_t count = p.enabled ? list.lowWater : list.blocks.size();
+        if( count > 0 ) {
+          released.assign( list.blocks.begin(), list.blocks.begin() + count );
+          list.blocks.erase( list.blocks.begin(), list.blocks.begin() + count );
+        }
+        list.lowWater = list.blocks.size();
+      }
+
+      for( size_t i = 0; i < released.size(); i++ ) {
+        const size_t bytes = reinterpret_cast<BlockHeader*>( released[i] )->bytes;
+
+        p.bytesCached.fetch_sub( bytes, std::memory_order_relaxed );
+        p.numBlocksCached.fetch_sub( 1, std::memory_order_relaxed );
+        p.bytesReleased.fetch_add( bytes, std::memory_order_relaxed );
+
+        free( released[i] );
+      }
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+VariableMemoryPool::Stats
+VariableMemoryPool::getStats()
+{
+  Pool & p = pool();
+
+  Stats stats;
+  stats.requests        = p.requests;
+  stats.reused          = p.reused;
+  stats.bytesInUse      = p.bytesInUse;
+  stats.peakBytesInUse  = p.peakBytesInUse;
+  stats.bytesCached     = p.bytesCached;
+  stats.numBlocksCached = p.numBlocksCached;
+  stats.bytesReleased   = p.bytesReleased;
+  return stats;
+}
@@ -0,0 +1,151 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+#ifndef CORE_GRID_VARIABLES_VARIABLEMEMORYPOOL_H
+#define CORE_GRID_VARIABLES_VARIABLEMEMORYPOOL_H
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+
+namespace Uintah {
+
+  /**************************************
+
+     CLASS
+       VariableMemoryPool
+
+       Size-class pool for the backing storage of Array3Data and
+       ParticleData.
+
+     GENERAL INFORMATION
+
+       VariableMemoryPool.h
+
+     KEYWORDS
+       Array3Data, ParticleData, allocator, NUMA
+
+     DESCRIPTION
+       Every timestep the new data warehouse allocates the same set of
+       grid and particle variables that the scrubbed/deleted old data
+       warehouse just freed.  Instead of handing those blocks back to
+       the system allocator they are kept on free lists, one per size
+       class and NUMA node, and reused by the next allocation of the
+       same size class.
+
+       Size classes are 256 bytes and then four classes per power of
+       two, so at most 25% of a block is unused.  A block that comes
+       from the system is touched by the allocating thread (first
+       touch places its pages on that thread's NUMA node); a freed
+       block goes back to the free list of the node it was placed on
+       and is only reused by threads running on that node.
+
+       trim() returns to the system the blocks that were not needed
+       since the previous trim (the low-water mark of each free list),
+       it is called once per timestep when the data warehouses are
+       advanced.  The statistics are written to the memory log
+       (Scheduler::logMemoryUse).
+
+       The pool is off by default, <memoryPool>true</memoryPool> in
+       the <Scheduler> block turns it on.  When it is off blocks come
+       straight from the system.  It may be switched at any time, the
+       blocks remember where they came from.
+
+  ****************************************/
+
+  class VariableMemoryPool {
+
+  public:
+
+    struct Stats {
+      unsigned long requests{ 0 };        // Pooled allocations
+      unsigned long reused{ 0 };          // ... satisfied from a free list
+      unsigned long bytesInUse{ 0 };
+      unsigned long peakBytesInUse{ 0 };
+      unsigned long bytesCached{ 0 };     // Held on the free lists
+      unsigned long numBlocksCached{ 0 };
+      unsigned long bytesReleased{ 0 };   // Returned to the system by trim()
+    };
+
+    static void setEnabled( bool enabled );
+    static bool isEnabled();
+
+    // Raw, 64 byte aligned storage.
+    static void * allocate( size_t bytes );
+    static void   deallocate( void * ptr );
+
+    // Storage for 'n' default initialized T's (as new T[n]).
+    template <class T>
+    static T * allocateArray( size_t n );
+
+    template <class T>
+    static void deallocateArray( T * ptr, size_t n );
+
+    static void trim();
+
+    static Stats getStats();
+
+  private:
+
+    VariableMemoryPool();
+  };
+
+  //______________________________________________________________________
+  //
+  template <class T>
+  T *
+  VariableMemoryPool::allocateArray( size_t n )
+  {
+    T * ptr = static_cast<T*>( allocate( n * sizeof(T) ) );
+
+    if( !std::is_trivially_default_constructible<T>::value ) {
+      for( size_t i = 0; i < n; i++ ) {
+        new ( ptr + i ) T;
+      }
+    }
+    return ptr;
+  }
+
+  //______________________________________________________________________
+  //
+  template <class T>
+  void
+  VariableMemoryPool::deallocateArray( T * ptr, size_t n )
+  {
+    if( ptr == nullptr ) {
+      return;
+    }
+
+    if( !std::is_trivially_destructible<T>::value ) {
+      for( size_t i = 0; i < n; i++ ) {
+        ptr[i].~T();
+      }
+    }
+    deallocate( ptr );
+  }
+
+} // End namespace Uintah
+
+#endif // CORE_GRID_VARIABLES_VARIABLEMEMORYPOOL_H
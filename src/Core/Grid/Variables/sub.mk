@@ -41,6 +41,7 @@ SRCS += \
         $(SRCDIR)/UnionIterator.cc              \
         $(SRCDIR)/ComputeSet.cc                 \
         $(SRCDIR)/ComputeSet_special.cc         \
+        $(SRCDIR)/CompressionCodec.cc           \
         $(SRCDIR)/GridVariableBase.cc           \
         $(SRCDIR)/LocallyComputedPatchVarMap.cc \
         $(SRCDIR)/ParticleSubset.cc             \
@@ -57,6 +58,7 @@ SRCS += \
         $(SRCDIR)/Stencil4.cc                   \
         $(SRCDIR)/Utils.cc                      \
         $(SRCDIR)/ugc_templates.cc              \
+        $(SRCDIR)/VariableMemoryPool.cc         \
         $(SRCDIR)/VarLabel.cc                   \
         $(SRCDIR)/Variable.cc                   
 
@@ -69,8 +69,18 @@ PackBufferInfo::get_type( void         *& out_buf
       }
     }
 
-    m_packed_buffer = scinew PackedBuffer(total_packed_size);
-    m_packed_buffer->addReference();
+    // Only allocate if there is no (large enough) buffer already.
+    if (m_packed_buffer && m_packed_buffer->getBufSize() < total_packed_size) {
+      if (m_packed_buffer->removeReference()) {
+        delete m_packed_buffer;
+      }
+      m_packed_buffer = nullptr;
+    }
+
+    if (!m_packed_buffer) {
+      m_packed_buffer = scinew PackedBuffer(total_packed_size);
+      m_packed_buffer->addReference();
+    }
 
     m_datatype = MPI_PACKED;
     m_count = total_packed_size;
@@ -95,6 +105,24 @@ PackBufferInfo::get_type( void        *&
   SCI_THROW(Uintah::InternalError("get_type(void*&, int&, MPI_Datatype&) should not be called on PackBufferInfo objects", __FILE__, __LINE__));
 }
 
+//_____________________________________________________________________________
+//
+void
+PackBufferInfo::setPackedBuffer( PackedBuffer * buffer )
+{
+  ASSERT(!m_have_datatype);
+
+  if (buffer) {
+    buffer->addReference();
+  }
+
+  if (m_packed_buffer && m_packed_buffer->removeReference()) {
+    delete m_packed_buffer;
+  }
+
+  m_packed_buffer = buffer;
+}
+
 //_____________________________________________________________________________
 //
 void
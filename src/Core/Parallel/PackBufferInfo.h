@@ -76,6 +76,13 @@ class PackBufferInfo : public BufferInfo {
 
     void pack( MPI_Comm comm, int & out_count );
 
+    // Pack into (or receive into) 'buffer' instead of a freshly
+    // allocated one, provided it is large enough - see get_type().
+    // Used to keep the buffer of a persistent MPI request.
+    void setPackedBuffer( PackedBuffer * buffer );
+
+    PackedBuffer * getPackedBuffer() const { return m_packed_buffer; }
+
     void unpack( MPI_Comm comm, MPI_Status & status );
 
     // PackBufferInfo is to be an AfterCommuncationHandler object for the
@@ -94,7 +94,8 @@ THREADEDTESTS = [  ("RMCRT_test_1L_thread",            "RMCRT_bm1_1L.ups",
                    ("RMCRT_ML_thread_2proc",           "RMCRT_ML.ups",              2,   "ALL", ["exactComparison", "sus_options=-nthreads 4"]),
                    ("RMCRT_+Domain_thread_2proc",      "RMCRT_+Domain.ups",         2,   "ALL", ["exactComparison", "sus_options=-nthreads 4"]),
                    ("RMCRT_+Domain_ML_thread_2proc",   "RMCRT_+Domain_ML.ups",      2,   "ALL", ["exactComparison", "sus_options=-nthreads 4"]),
-                   ("RMCRT_+Domain_DO_thread_2proc",   "RMCRT_+Domain_DO.ups",      2,   "ALL", ["exactComparison", "sus_options=-nthreads 4"])
+                   ("RMCRT_+Domain_DO_thread_2proc",   "RMCRT_+Domain_DO.ups",      2,   "ALL", ["exactComparison", "sus_options=-nthreads 4"]),
+                   ("wave_parallelCompile_2proc",      "wave_parallelCompile.ups",  2,   "ALL", ["exactComparison", "sus_options=-nthreads 4"])
                  ]
 
 GPUTESTS      = [
@@ -0,0 +1,259 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+/*
+ *  ConstitutiveBlockBench.cc: Benchmark of the batched stress update of
+ *  the MPM constitutive models (<batched_stress_update>).
+ *
+ *  The block update of UCNH (elastic and with plasticity) is run through
+ *  ConstitutiveModel::computeStressBlock on a set of particles with
+ *  random deformation gradients, particle by particle and a block at a
+ *  time.  The particle variables are copied into the blocks and back, as
+ *  computeStressTensor does.  The time per particle of both, and the
+ *  largest difference between their results (which should be 0), are
+ *  printed for each model.
+ *
+ */
+
+#include <CCA/Components/MPM/Core/MPMFlags.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/ParticleBlock.h>
+#include <CCA/Components/MPM/Materials/ConstitutiveModel/UCNH.h>
+
+#include <Core/Math/Matrix3.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/ProblemSpec/ProblemSpec.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+const int PARTICLES_DEFAULT = 100000;
+const int STEPS_DEFAULT     = 10;
+
+void usage ( void )
+{
+  cerr << "Usage: ConstitutiveBlockBench [<particles> [<timesteps>]]" << endl;
+  cerr << endl;
+  cerr << "  <particles>  Number of particles (default " << PARTICLES_DEFAULT << ")." << endl;
+  cerr << "  <timesteps>  Number of times each stress update is run (default " << STEPS_DEFAULT << ")." << endl;
+}
+
+struct Particles {
+  vector<Matrix3> defGrad, defGrad_new, bElBar;
+  vector<double>  yieldStress, plasticStrain;
+};
+
+struct Results {
+  vector<Matrix3> m1, m2;
+  vector<double>  d1;
+};
+
+//______________________________________________________________________
+//
+double
+maxDifference( const vector<Matrix3> & a,
+               const vector<Matrix3> & b )
+{
+  double diff = 0.0;
+  for (size_t p = 0; p < a.size(); p++) {
+    diff = max(diff, (a[p] - b[p]).MaxAbsElem());
+  }
+  return diff;
+}
+
+double
+maxDifference( const vector<double> & a,
+               const vector<double> & b )
+{
+  double diff = 0.0;
+  for (size_t p = 0; p < a.size(); p++) {
+    diff = max(diff, fabs(a[p] - b[p]));
+  }
+  return diff;
+}
+
+//______________________________________________________________________
+//
+// UCNH::computeStressBlock over all of the particles, returns the time
+double
+runUCNH( const ConstitutiveModel & cm,
+         const Particles         & p,
+               bool                plasticity,
+               bool                batched,
+               int                 steps,
+               Results           & r )
+{
+  const int numParticles = p.defGrad.size();
+  r.m1.resize(numParticles);
+  r.m2.resize(numParticles);
+  r.d1.resize(numParticles);
+
+  UCNH::StressBlock b;
+  Timers::Simple timer;
+  timer.reset(true);
+
+  for (int step = 0; step < steps; step++) {
+    for (int first = 0; first < numParticles; first += PARTICLE_BLOCK_SIZE) {
+      const int n = min(PARTICLE_BLOCK_SIZE, numParticles - first);
+
+      for (int l = 0; l < n; l++) {
+        const int idx = first + l;
+        b.defGrad.set(l,     p.defGrad[idx]);
+        b.defGrad_new.set(l, p.defGrad_new[idx]);
+        b.J[l] = p.defGrad_new[idx].Determinant();
+        if (plasticity) {
+          b.bElBar.set(l, p.bElBar[idx]);
+          b.yieldStress[l]   = p.yieldStress[idx];
+          b.plasticStrain[l] = p.plasticStrain[idx];
+        }
+      }
+
+      cm.computeStressBlock(b, n, batched);
+
+      for (int l = 0; l < n; l++) {
+        const int idx = first + l;
+        r.m1[idx] = b.stress.get(l);
+        if (plasticity) {
+          r.m2[idx] = b.bElBar.get(l);
+          r.d1[idx] = b.plasticStrain[l];
+        }
+      }
+    }
+  }
+
+  timer.stop();
+  return timer().seconds();
+}
+
+//______________________________________________________________________
+//
+void
+report( const char * name,
+              int    numParticles,
+              int    steps,
+              double scalar,
+              double batched,
+              double diff )
+{
+  const double scale = 1.0e9 / (static_cast<double>(numParticles) * steps);
+  cout << name << scale * scalar << "\t\t    " << scale * batched
+       << "\t\t  " << scalar / batched << "\t    " << diff << endl;
+}
+
+int main ( int argc, char** argv )
+{
+  int numParticles = PARTICLES_DEFAULT;
+  int steps        = STEPS_DEFAULT;
+
+  if (argc > 1) {
+    numParticles = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    steps = atoi(argv[2]);
+  }
+  if (argc > 3 || numParticles < 1 || steps < 1) {
+    usage();
+    exit(1);
+  }
+
+  Uintah::Parallel::initializeManager(argc, argv);
+
+  // Random deformation gradients a few percent away from the identity,
+  // and one timestep of a velocity gradient on top of them
+  mt19937 gen(1234);
+  uniform_real_distribution<double> small(-0.05, 0.05);
+  uniform_real_distribution<double> yield(0.5e6, 1.5e6);
+
+  Matrix3 one;
+  one.Identity();
+
+  auto randomMatrix = [&]() {
+    Matrix3 M;
+    for (int i = 0; i < 3; i++) {
+      for (int j = 0; j < 3; j++) {
+        M(i,j) = small(gen);
+      }
+    }
+    return M;
+  };
+
+  Particles p;
+  for (int idx = 0; idx < numParticles; idx++) {
+    const Matrix3 F = one + randomMatrix();
+    const Matrix3 L = randomMatrix();
+    const Matrix3 F_new = (one + L*0.1)*F;
+    const double  J     = F.Determinant();
+
+    p.defGrad.push_back(F);
+    p.defGrad_new.push_back(F_new);
+    p.bElBar.push_back(F*F.Transpose()/pow(J, 2.0/3.0));
+    p.yieldStress.push_back(yield(gen));
+    p.plasticStrain.push_back(0.01*fabs(small(gen)));
+  }
+
+  MPMFlags flags(Uintah::Parallel::getRootProcessorGroup());
+
+  ProblemSpecP ps = scinew ProblemSpec(
+    "<constitutive_model type=\"UCNH\">"
+    "  <bulk_modulus>1.0e9</bulk_modulus>"
+    "  <shear_modulus>3.0e8</shear_modulus>"
+    "  <yield_stress>1.0e6</yield_stress>"
+    "  <hardening_modulus>1.0e7</hardening_modulus>"
+    "</constitutive_model>" );
+
+  UCNH elastic(ps, &flags, false, false);
+  UCNH plastic(ps, &flags, true,  false);
+
+  cout << numParticles << " particles, " << steps << " timesteps, blocks of "
+       << PARTICLE_BLOCK_SIZE << " particles" << endl;
+  cout << endl;
+  cout << "model             scalar (ns/particle)   batched (ns/particle)   speedup   max difference" << endl;
+
+  Results scalar, batched;
+  double  t_scalar, t_batched, diff;
+
+  t_scalar  = runUCNH(elastic, p, false, false, steps, scalar);
+  t_batched = runUCNH(elastic, p, false, true,  steps, batched);
+  diff      = maxDifference(scalar.m1, batched.m1);
+  report("UCNH              ", numParticles, steps, t_scalar, t_batched, diff);
+
+  t_scalar  = runUCNH(plastic, p, true, false, steps, scalar);
+  t_batched = runUCNH(plastic, p, true, true,  steps, batched);
+  diff      = max(maxDifference(scalar.m1, batched.m1),
+                  max(maxDifference(scalar.m2, batched.m2),
+                      maxDifference(scalar.d1, batched.d1)));
+  report("UCNH (plastic)    ", numParticles, steps, t_scalar, t_batched, diff);
+
+  Uintah::Parallel::finalizeManager();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,321 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+/*
+ *  DWDatabaseBench.cc: Multi-threaded get/put benchmark for DWDatabase.
+ *
+ *  Each thread repeatedly looks up and copies variables that are never
+ *  replaced (as a task reads from the old DataWarehouse) and puts
+ *  variables on its own patches (as a task computes into the new
+ *  DataWarehouse). The concurrent DWDatabase is timed against
+ *  BaselineDWDatabase below, the DWDatabase it replaced (an
+ *  unordered_map of keys and a vector of variables, every call
+ *  serialized through one process-wide lock), reduced to the calls
+ *  timed here.
+ *
+ */
+
+#include <CCA/Components/Schedulers/DWDatabase.h>
+#include <CCA/Components/Schedulers/OnDemandDataWarehouse.h>
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Grid/Variables/GridIterator.h>
+#include <Core/Grid/Variables/VarLabel.h>
+#include <Core/Parallel/MasterLock.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+const int NUM_READ_LABELS  = 16;
+const int NUM_WRITE_LABELS = 4;
+const int PATCHES_PER_DIM  = 8;
+const int ITER_DEFAULT     = 200000;
+
+void usage ( void )
+{
+  cerr << "Usage: DWDatabaseBench <threads> [<iterations>]" << endl;
+  cerr << endl;
+  cerr << "  <threads>     Run with 1, 2, 4, ... up to <threads> threads." << endl;
+  cerr << "  <iterations>  Number of get/put rounds per thread (default " << ITER_DEFAULT << ")." << endl;
+  cerr << "                Each round does " << NUM_READ_LABELS << " exists+get and one put." << endl;
+}
+
+//______________________________________________________________________
+//
+namespace {
+
+Uintah::MasterLock g_keyDB_lock{};
+
+}
+
+class BaselineKeyDatabase {
+
+public:
+
+  void insert( const VarLabel * label, int matlIndex, const Patch * dom )
+  {
+    VarLabelMatl<Patch> v(label, matlIndex, getRealDomain(dom));
+    if (m_keys.find(v) == m_keys.end()) {
+      m_keys.insert(std::pair<VarLabelMatl<Patch>, int>(v, m_key_count++));
+    }
+  }
+
+  int lookup( const VarLabel * label, int matlIndex, const Patch * dom ) const
+  {
+    VarLabelMatl<Patch> v(label, matlIndex, getRealDomain(dom));
+    auto const_iter = m_keys.find(v);
+    return (const_iter == m_keys.end()) ? -1 : const_iter->second;
+  }
+
+  std::unordered_map<VarLabelMatl<Patch>, int> m_keys;
+  int                                          m_key_count { 0 };
+};
+
+class BaselineDWDatabase {
+
+public:
+
+  ~BaselineDWDatabase()
+  {
+    for (auto item : m_vars) {
+      delete item;
+    }
+  }
+
+  void doReserve( BaselineKeyDatabase * keydb )
+  {
+    m_keyDB = keydb;
+    m_vars.resize(m_keyDB->m_key_count + 1, nullptr);
+  }
+
+  bool exists( const VarLabel * label, int matlIndex, const Patch * dom ) const
+  {
+    std::lock_guard<Uintah::MasterLock> exists_lock(g_keyDB_lock);
+
+    int idx = m_keyDB->lookup(label, matlIndex, dom);
+    return idx != -1 && m_vars[idx] != nullptr;
+  }
+
+  void put( const VarLabel * label, int matlIndex, const Patch * dom, Variable * var, bool init, bool replace )
+  {
+    std::lock_guard<Uintah::MasterLock> put_lock(g_keyDB_lock);
+
+    int idx = m_keyDB->lookup(label, matlIndex, dom);
+    if (m_vars[idx]) {
+      if (!replace) {
+        SCI_THROW(InternalError("Put replacing old vars", __FILE__, __LINE__));
+      }
+      delete m_vars[idx];
+    }
+
+    DataItem* newdi = new DataItem();
+    newdi->m_var = var;
+    m_vars[idx] = newdi;
+  }
+
+  Variable* get( const VarLabel * label, int matlIndex, const Patch * dom ) const
+  {
+    std::lock_guard<Uintah::MasterLock> get_lock(g_keyDB_lock);
+
+    return m_vars[m_keyDB->lookup(label, matlIndex, dom)]->m_var;
+  }
+
+  void get( const VarLabel * label, int matlIndex, const Patch * dom, Variable & var ) const
+  {
+    Variable* tmp = get(label, matlIndex, dom);
+    var.copyPointer(*tmp);
+  }
+
+private:
+
+  struct DataItem {
+    ~DataItem() { delete m_var; }
+    Variable * m_var { nullptr };
+  };
+
+  BaselineKeyDatabase    * m_keyDB { nullptr };
+  std::vector<DataItem*>   m_vars  {};
+};
+
+//______________________________________________________________________
+//
+struct BenchData {
+  vector<const VarLabel*> read_labels;
+  vector<const VarLabel*> write_labels;
+  vector<const Patch*>    patches;
+};
+
+template<class DB>
+void worker( DB * db, const BenchData * data, int tid, int num_threads, int iterations )
+{
+  CCVariable<double> var;
+  const int num_patches = static_cast<int>(data->patches.size());
+  unsigned int seed = 1234u + tid;
+
+  for (int i = 0; i < iterations; i++) {
+    // reads - variables that are never replaced
+    for (int l = 0; l < NUM_READ_LABELS; l++) {
+      const Patch* patch = data->patches[rand_r(&seed) % num_patches];
+      if (db->exists(data->read_labels[l], 0, patch)) {
+        db->get(data->read_labels[l], 0, patch, var);
+      }
+    }
+
+    // write - only to patches owned by this thread
+    int p = tid + num_threads * (rand_r(&seed) % (num_patches / num_threads));
+    const VarLabel* label = data->write_labels[i % NUM_WRITE_LABELS];
+    db->put(label, 0, data->patches[p], scinew CCVariable<double>(), false, true);
+  }
+}
+
+template<class DB, class KeyDB>
+double run( KeyDB * keydb, const BenchData & data, int num_threads, int iterations )
+{
+  DB db;
+  db.doReserve(keydb);
+
+  for (auto label : data.read_labels) {
+    for (auto patch : data.patches) {
+      db.put(label, 0, patch, scinew CCVariable<double>(), false, false);
+    }
+  }
+
+  Timers::Simple timer;
+  timer.start();
+
+  vector<thread> threads;
+  for (int t = 0; t < num_threads; t++) {
+    threads.push_back(thread(worker<DB>, &db, &data, t, num_threads, iterations));
+  }
+  for (auto & t : threads) {
+    t.join();
+  }
+
+  timer.stop();
+
+  return timer().seconds();
+}
+
+int main ( int argc, char** argv )
+{
+  int max_threads = 0;
+  int iterations  = ITER_DEFAULT;
+
+  /*
+   * Parse arguments
+   */
+  if ( argc > 1 ) {
+    max_threads = atoi( argv[1] );
+
+    if (max_threads <= 0) {
+      usage();
+      return EXIT_FAILURE;
+    }
+
+    if ( argc > 2 ) {
+      iterations = atoi( argv[2] );
+
+      if (iterations <= 0) {
+        usage();
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  else {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  // one level of PATCHES_PER_DIM^3 patches
+  Grid grid;
+  LevelP level = grid.addLevel( Point(0,0,0), Vector(1,1,1) );
+  IntVector patch_size(16,16,16);
+
+  BenchData data;
+  int i = 0;
+  for (GridIterator iter(IntVector(0,0,0), IntVector(PATCHES_PER_DIM,PATCHES_PER_DIM,PATCHES_PER_DIM)); !iter.done(); iter++, i++) {
+    IntVector low  = *iter * patch_size;
+    IntVector high = (*iter + IntVector(1,1,1)) * patch_size;
+    level->addPatch(low, high, low, high, &grid);
+    data.patches.push_back(level->getPatch(i));
+  }
+
+  // every thread needs at least one patch of its own to put to
+  if (max_threads > static_cast<int>(data.patches.size())) {
+    max_threads = static_cast<int>(data.patches.size());
+  }
+
+  KeyDatabase<Patch>  keydb;
+  BaselineKeyDatabase baseline_keydb;
+  for (int l = 0; l < NUM_READ_LABELS + NUM_WRITE_LABELS; l++) {
+    ostringstream name;
+    name << "benchVar" << l;
+    const VarLabel* label = VarLabel::create(name.str(), CCVariable<double>::getTypeDescription());
+    if (l < NUM_READ_LABELS) {
+      data.read_labels.push_back(label);
+    }
+    else {
+      data.write_labels.push_back(label);
+    }
+    for (auto patch : data.patches) {
+      keydb.insert(label, 0, patch);
+      baseline_keydb.insert(label, 0, patch);
+    }
+  }
+
+  cout << "DWDatabase get/put Benchmark: " << endl;
+  cout << data.patches.size() << " patches, " << NUM_READ_LABELS << " read and " << NUM_WRITE_LABELS << " write labels" << endl;
+  cout << iterations << " rounds per thread" << endl;
+  cout << endl;
+  cout << "threads   baseline (s)   concurrent (s)   speedup" << endl;
+
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    double baseline   = run<BaselineDWDatabase>(&baseline_keydb, data, num_threads, iterations);
+    double concurrent = run<DWDatabase<Patch> >(&keydb,          data, num_threads, iterations);
+
+    cout << num_threads << "\t  " << baseline << "\t " << concurrent << "\t  " << baseline / concurrent << endl;
+  }
+
+  for (auto label : data.read_labels) {
+    VarLabel::destroy(label);
+  }
+  for (auto label : data.write_labels) {
+    VarLabel::destroy(label);
+  }
+
+  return EXIT_SUCCESS;
+}
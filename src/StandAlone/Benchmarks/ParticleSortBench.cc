@@ -0,0 +1,309 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+/*
+ *  ParticleSortBench.cc: Particle ordering benchmark for the MPM
+ *  particle to grid (P2G) and grid to particle (G2P) loops.
+ *
+ *  One patch is filled with particles stored in random order, which is
+ *  where the particles of a long running simulation end up after many
+ *  relocations.  The GIMP scatter of mass and momentum to the nodes and
+ *  the gather of the nodal velocity back to the particles are timed,
+ *  then the particles are put in the order Relocate uses with
+ *  <particleSortInterval> (Relocate::findParticleOrder) and the loops
+ *  are timed again, for both the cell and the Morton order.
+ *
+ */
+
+#include <CCA/Components/Schedulers/Relocate.h>
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Geometry/Point.h>
+#include <Core/Geometry/Vector.h>
+#include <Core/Grid/GIMPInterpolator.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Patch.h>
+#include <Core/Grid/Variables/NCVariable.h>
+#include <Core/Grid/Variables/ParticleSubset.h>
+#include <Core/Grid/Variables/ParticleVariable.h>
+#include <Core/Math/Matrix3.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+const int PATCH_CELLS_DEFAULT = 32;
+const int PPC_DEFAULT         = 2;     // particles per cell in each direction
+const int STEPS_DEFAULT       = 10;
+
+void usage ( void )
+{
+  cerr << "Usage: ParticleSortBench [<cells> [<ppc> [<timesteps>]]]" << endl;
+  cerr << endl;
+  cerr << "  <cells>      Patch size in cells per direction (default " << PATCH_CELLS_DEFAULT << ")." << endl;
+  cerr << "  <ppc>        Particles per cell per direction (default " << PPC_DEFAULT << ")." << endl;
+  cerr << "  <timesteps>  Number of times the P2G and G2P loops are run (default " << STEPS_DEFAULT << ")." << endl;
+}
+
+struct Particles {
+  ParticleSubset*           pset;
+  ParticleVariable<Point>   px;
+  ParticleVariable<double>  pmass;
+  ParticleVariable<Vector>  pvelocity;
+  ParticleVariable<Matrix3> psize;
+};
+
+//______________________________________________________________________
+//
+// P2G: mass and momentum of the particles to the nodes
+void
+interpolateParticlesToGrid( const Patch              * patch,
+                                  Particles          & p,
+                                  NCVariable<double> & gmass,
+                                  NCVariable<Vector> & gvelocity )
+{
+  GIMPInterpolator interpolator(patch);
+  vector<IntVector> ni(interpolator.size());
+  vector<double>    S(interpolator.size());
+
+  gmass.initialize(0.0);
+  gvelocity.initialize(Vector(0.0));
+
+  for (ParticleSubset::iterator iter = p.pset->begin(); iter != p.pset->end(); iter++) {
+    particleIndex idx = *iter;
+    int NN = interpolator.findCellAndWeights(p.px[idx], ni, S, p.psize[idx]);
+    const Vector pmom = p.pvelocity[idx] * p.pmass[idx];
+    for (int k = 0; k < NN; k++) {
+      gmass[ni[k]]     += p.pmass[idx] * S[k];
+      gvelocity[ni[k]] += pmom * S[k];
+    }
+  }
+}
+
+//______________________________________________________________________
+//
+// G2P: nodal velocity back to the particles
+void
+interpolateToParticles( const Patch              * patch,
+                              Particles          & p,
+                        const NCVariable<Vector> & gvelocity,
+                              double             & sum )
+{
+  GIMPInterpolator interpolator(patch);
+  vector<IntVector> ni(interpolator.size());
+  vector<double>    S(interpolator.size());
+
+  for (ParticleSubset::iterator iter = p.pset->begin(); iter != p.pset->end(); iter++) {
+    particleIndex idx = *iter;
+    int NN = interpolator.findCellAndWeights(p.px[idx], ni, S, p.psize[idx]);
+    Vector vel(0.0);
+    for (int k = 0; k < NN; k++) {
+      vel += gvelocity[ni[k]] * S[k];
+    }
+    p.pvelocity[idx] = vel;
+    sum += vel.x();
+  }
+}
+
+//______________________________________________________________________
+//
+// Applies 'order' to the particle variables, as Relocate does on a sort
+void
+reorder( const vector<particleIndex> & order,
+               Particles             & p )
+{
+  ParticleVariable<Point>   px;
+  ParticleVariable<double>  pmass;
+  ParticleVariable<Vector>  pvelocity;
+  ParticleVariable<Matrix3> psize;
+  px.allocate(p.pset);
+  pmass.allocate(p.pset);
+  pvelocity.allocate(p.pset);
+  psize.allocate(p.pset);
+
+  for (size_t i = 0; i < order.size(); i++) {
+    px[i]        = p.px[order[i]];
+    pmass[i]     = p.pmass[order[i]];
+    pvelocity[i] = p.pvelocity[order[i]];
+    psize[i]     = p.psize[order[i]];
+  }
+
+  p.px.copyPointer(px);
+  p.pmass.copyPointer(pmass);
+  p.pvelocity.copyPointer(pvelocity);
+  p.psize.copyPointer(psize);
+}
+
+//______________________________________________________________________
+//
+void
+run( const Patch     * patch,
+           Particles & p,
+           int         steps,
+           double    & p2g,
+           double    & g2p )
+{
+  NCVariable<double> gmass;
+  NCVariable<Vector> gvelocity;
+  gmass.allocate(patch->getExtraNodeLowIndex(), patch->getExtraNodeHighIndex());
+  gvelocity.allocate(patch->getExtraNodeLowIndex(), patch->getExtraNodeHighIndex());
+
+  double sum = 0.0;
+  Timers::Simple timer;
+  p2g = 0.0;
+  g2p = 0.0;
+
+  for (int step = 0; step < steps; step++) {
+    timer.reset(true);
+    interpolateParticlesToGrid(patch, p, gmass, gvelocity);
+    timer.stop();
+    p2g += timer().seconds();
+
+    timer.reset(true);
+    interpolateToParticles(patch, p, gvelocity, sum);
+    timer.stop();
+    g2p += timer().seconds();
+  }
+
+  // keep the loops from being optimized away
+  if (sum == 12345.678) {
+    cout << sum << endl;
+  }
+}
+
+int main ( int argc, char** argv )
+{
+  int cells = PATCH_CELLS_DEFAULT;
+  int ppc   = PPC_DEFAULT;
+  int steps = STEPS_DEFAULT;
+
+  if (argc > 1) {
+    cells = atoi(argv[1]);
+  }
+  if (argc > 2) {
+    ppc = atoi(argv[2]);
+  }
+  if (argc > 3) {
+    steps = atoi(argv[3]);
+  }
+  if (argc > 4 || cells < 1 || ppc < 1 || steps < 1) {
+    usage();
+    exit(1);
+  }
+
+  Uintah::Parallel::initializeManager(argc, argv);
+
+  // One patch with one layer of extra cells for the GIMP support
+  GridP grid = scinew Grid();
+  LevelP level = grid->addLevel(Point(0, 0, 0), Vector(1, 1, 1));
+  level->setExtraCells(IntVector(1, 1, 1));
+  const IntVector low(0, 0, 0);
+  const IntVector high(cells, cells, cells);
+  level->addPatch(low, high, low, high, grid.get_rep());
+  level->finalizeLevel();
+  const Patch* patch = level->getPatch(0);
+
+  // Regularly spaced particles, stored in random order
+  const double dxp = 1.0 / ppc;
+  vector<Point> points;
+  for (int k = 0; k < cells * ppc; k++) {
+    for (int j = 0; j < cells * ppc; j++) {
+      for (int i = 0; i < cells * ppc; i++) {
+        points.push_back(Point((i + 0.5) * dxp, (j + 0.5) * dxp, (k + 0.5) * dxp));
+      }
+    }
+  }
+  mt19937 gen(1234);
+  shuffle(points.begin(), points.end(), gen);
+
+  const unsigned int numParticles = points.size();
+
+  Particles original;
+  original.pset = scinew ParticleSubset(numParticles, 0, patch);
+  original.pset->addReference();
+  original.px.allocate(original.pset);
+  original.pmass.allocate(original.pset);
+  original.pvelocity.allocate(original.pset);
+  original.psize.allocate(original.pset);
+
+  for (unsigned int idx = 0; idx < numParticles; idx++) {
+    original.px[idx]        = points[idx];
+    original.pmass[idx]     = 1.0 / (ppc * ppc * ppc);
+    original.pvelocity[idx] = Vector(points[idx].x(), 0.0, 0.0);
+    original.psize[idx]     = Matrix3(dxp, 0, 0, 0, dxp, 0, 0, 0, dxp);
+  }
+
+  cout << "1 patch of " << cells << "^3 cells, " << numParticles << " particles (GIMP), "
+       << steps << " timesteps" << endl;
+  cout << endl;
+  cout << "order      P2G (ns/particle)   G2P (ns/particle)   P2G speedup   G2P speedup" << endl;
+
+  const double scale = 1.0e9 / (static_cast<double>(numParticles) * steps);
+
+  double p2gRandom, g2pRandom;
+  run(patch, original, steps, p2gRandom, g2pRandom);
+  cout << "random     " << scale * p2gRandom << "\t\t  " << scale * g2pRandom << endl;
+
+  const Relocate::SortOrder orders[] = { Relocate::CellOrder, Relocate::MortonOrder };
+  const char* names[]                = { "cell  ", "morton" };
+
+  for (int o = 0; o < 2; o++) {
+    Particles sorted;
+    sorted.pset = original.pset;
+    sorted.px.copyPointer(original.px);
+    sorted.pmass.copyPointer(original.pmass);
+    sorted.pvelocity.copyPointer(original.pvelocity);
+    sorted.psize.copyPointer(original.psize);
+
+    Timers::Simple timer;
+    timer.reset(true);
+    vector<particleIndex> order;
+    Relocate::findParticleOrder(patch, sorted.px, orders[o], order);
+    reorder(order, sorted);
+    timer.stop();
+
+    double p2g, g2p;
+    run(patch, sorted, steps, p2g, g2p);
+    cout << names[o] << "     " << scale * p2g << "\t\t  " << scale * g2p
+         << "\t\t      " << p2gRandom / p2g << "\t    " << g2pRandom / g2p
+         << "\t(sort " << timer().milliseconds() << " ms)" << endl;
+  }
+
+  if (original.pset->removeReference()) {
+    delete original.pset;
+  }
+
+  Uintah::Parallel::finalizeManager();
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,276 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+
+/*
+ *  TaskFusionBench.cc: Task fusion benchmark for DetailedTasks.
+ *
+ *  Every patch runs a chain of small stencil tasks, each one reading
+ *  the field computed by the previous task on the same patch. The
+ *  chain is scheduled through the real DetailedTask/DetailedTasks
+ *  internal dependency and ready queue code, as the MPI and Unified
+ *  schedulers do, once with every task going through the shared ready
+ *  queue and once with the tasks fused behind their prerequisite
+ *  (Task::setFusible(), <taskFusion>), i.e. run by the same thread
+ *  while the patch data is still in cache.
+ *
+ */
+
+#include <CCA/Components/Schedulers/DetailedTask.h>
+#include <CCA/Components/Schedulers/DetailedTasks.h>
+#include <CCA/Components/Schedulers/MPIScheduler.h>
+
+#include <Core/Geometry/IntVector.h>
+#include <Core/Grid/Grid.h>
+#include <Core/Grid/Level.h>
+#include <Core/Grid/Task.h>
+#include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Grid/Variables/ComputeSet.h>
+#include <Core/Grid/Variables/GridIterator.h>
+#include <Core/Grid/Variables/VarLabel.h>
+#include <Core/Parallel/Parallel.h>
+#include <Core/Util/Timers/Timers.hpp>
+
+#include <atomic>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+using namespace Uintah;
+using namespace std;
+
+const int CHAIN_LENGTH     = 8;
+const int PATCHES_PER_DIM  = 8;
+const int PATCH_CELLS      = 12;
+const int STEPS_DEFAULT    = 20;
+
+void usage ( void )
+{
+  cerr << "Usage: TaskFusionBench <threads> [<timesteps>]" << endl;
+  cerr << endl;
+  cerr << "  <threads>    Run with 1, 2, 4, ... up to <threads> threads." << endl;
+  cerr << "  <timesteps>  Number of times the task graph is executed (default " << STEPS_DEFAULT << ")." << endl;
+}
+
+struct BenchData {
+  vector<const Patch*>         patches;
+  map<const Task*, int>        stage;          // position of a task in the chain
+  map<const Patch*, int>       patchIndex;
+  vector<vector<double> >      fields;         // [patch * (CHAIN_LENGTH + 1) + stage]
+};
+
+// out = 7-point average of in, the work of one small task
+void kernel( BenchData * data, DetailedTask * dtask )
+{
+  const int stage = data->stage.find(dtask->getTask())->second;
+  const int p     = data->patchIndex.find(dtask->getPatches()->get(0))->second;
+
+  const vector<double> & in  = data->fields[p * (CHAIN_LENGTH + 1) + stage];
+  vector<double>       & out = data->fields[p * (CHAIN_LENGTH + 1) + stage + 1];
+
+  const int n  = PATCH_CELLS;
+  const int sy = n;
+  const int sz = n * n;
+
+  for (int k = 1; k < n - 1; k++) {
+    for (int j = 1; j < n - 1; j++) {
+      for (int i = 1; i < n - 1; i++) {
+        const int c = i + j * sy + k * sz;
+        out[c] = ( in[c] + in[c-1] + in[c+1] + in[c-sy] + in[c+sy] + in[c-sz] + in[c+sz] ) * (1.0 / 7.0);
+      }
+    }
+  }
+}
+
+// Same loop as the schedulers: take the next internally ready task,
+// run it and let done() satisfy its dependents.  With fusion on,
+// getNextInternalReadyTask() returns the task fused behind the one
+// this thread just finished.
+void worker( DetailedTasks * dts, BenchData * data, atomic<int> * numDone, int numTasks )
+{
+  vector<OnDemandDataWarehouseP> dws;
+
+  while (numDone->load(memory_order_relaxed) < numTasks) {
+    DetailedTask* dtask = dts->getNextInternalReadyTask();
+    if (dtask == nullptr) {
+      continue;
+    }
+
+    kernel(data, dtask);
+    dtask->done(dws);
+    numDone->fetch_add(1, memory_order_relaxed);
+  }
+}
+
+double run( DetailedTasks * dts, BenchData & data, int num_threads, int steps, bool fusion )
+{
+  const int numTasks = dts->numLocalTasks();
+
+  dts->setTaskFusion(fusion);
+
+  Timers::Simple timer;
+  timer.start();
+
+  for (int s = 0; s < steps; s++) {
+    dts->initTimestep();
+    for (int i = 0; i < numTasks; i++) {
+      dts->localTask(i)->resetDependencyCounts();
+    }
+
+    atomic<int> numDone{0};
+
+    vector<thread> threads;
+    for (int t = 1; t < num_threads; t++) {
+      threads.push_back(thread(worker, dts, &data, &numDone, numTasks));
+    }
+    worker(dts, &data, &numDone, numTasks);
+    for (auto & t : threads) {
+      t.join();
+    }
+  }
+
+  timer.stop();
+
+  return timer().seconds();
+}
+
+int main ( int argc, char** argv )
+{
+  int max_threads = 0;
+  int steps       = STEPS_DEFAULT;
+
+  /*
+   * Parse arguments
+   */
+  if ( argc > 1 ) {
+    max_threads = atoi( argv[1] );
+
+    if (max_threads <= 0) {
+      usage();
+      return EXIT_FAILURE;
+    }
+
+    if ( argc > 2 ) {
+      steps = atoi( argv[2] );
+
+      if (steps <= 0) {
+        usage();
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  else {
+    usage();
+    return EXIT_FAILURE;
+  }
+
+  Uintah::Parallel::initializeManager( argc, argv );
+  const ProcessorGroup* world = Uintah::Parallel::getRootProcessorGroup();
+
+  // DetailedTask::done() needs a scheduler (for the scrub lists)
+  MPIScheduler* scheduler = scinew MPIScheduler( world, nullptr );
+
+  // one level of PATCHES_PER_DIM^3 small patches
+  Grid grid;
+  LevelP level = grid.addLevel( Point(0,0,0), Vector(1,1,1) );
+  IntVector patch_size(PATCH_CELLS, PATCH_CELLS, PATCH_CELLS);
+
+  BenchData data;
+  int i = 0;
+  for (GridIterator iter(IntVector(0,0,0), IntVector(PATCHES_PER_DIM,PATCHES_PER_DIM,PATCHES_PER_DIM)); !iter.done(); iter++, i++) {
+    IntVector low  = *iter * patch_size;
+    IntVector high = (*iter + IntVector(1,1,1)) * patch_size;
+    level->addPatch(low, high, low, high, &grid);
+    data.patches.push_back(level->getPatch(i));
+    data.patchIndex[level->getPatch(i)] = i;
+  }
+
+  const int numCells = PATCH_CELLS * PATCH_CELLS * PATCH_CELLS;
+  data.fields.resize(data.patches.size() * (CHAIN_LENGTH + 1), vector<double>(numCells, 1.0));
+
+  const VarLabel* label = VarLabel::create("fusionBenchVar", CCVariable<double>::getTypeDescription());
+
+  // the chain of tasks, stage s of a patch depends on stage s-1 of the same patch
+  vector<Task*> tasks;
+  for (int s = 0; s < CHAIN_LENGTH; s++) {
+    ostringstream name;
+    name << "fusionBenchTask" << s;
+    Task* task = scinew Task(name.str(), Task::Normal);
+    task->setFusible(true);
+    tasks.push_back(task);
+    data.stage[task] = s;
+  }
+
+  DetailedTasks* dts = scinew DetailedTasks(scheduler, world, nullptr, std::unordered_set<int>(), true);
+
+  for (auto patch : data.patches) {
+    DetailedTask* prev = nullptr;
+    for (int s = 0; s < CHAIN_LENGTH; s++) {
+      PatchSubset* patches = scinew PatchSubset();
+      patches->add(patch);
+
+      DetailedTask* dtask = scinew DetailedTask(tasks[s], patches, nullptr, dts);
+      dtask->assignResource(world->myRank());
+      dts->add(dtask);
+
+      if (prev) {
+        dtask->addInternalDependency(prev, label);
+      }
+      prev = dtask;
+    }
+  }
+  dts->computeLocalTasks();
+
+  cout << "Task fusion Benchmark: " << endl;
+  cout << data.patches.size() << " patches of " << PATCH_CELLS << "^3 cells, chains of " << CHAIN_LENGTH << " tasks, "
+       << dts->numLocalTasks() << " tasks per timestep" << endl;
+  cout << steps << " timesteps" << endl;
+  cout << endl;
+  cout << "threads   queued (us/task)   fused (us/task)   speedup" << endl;
+
+  const double tasksRun = static_cast<double>(dts->numLocalTasks()) * steps;
+
+  for (int num_threads = 1; num_threads <= max_threads; num_threads *= 2) {
+    double queued = run(dts, data, num_threads, steps, false);
+    double fused  = run(dts, data, num_threads, steps, true);
+
+    cout << num_threads << "\t  " << 1.0e6 * queued / tasksRun << "\t\t     " << 1.0e6 * fused / tasksRun
+         << "\t       " << queued / fused << endl;
+  }
+
+  delete dts;
+  for (auto task : tasks) {
+    delete task;
+  }
+  VarLabel::destroy(label);
+  delete scheduler;
+
+  Uintah::Parallel::finalizeManager();
+
+  return EXIT_SUCCESS;
+}
@@ -68,3 +68,139 @@ endif
 include $(SCIRUN_SCRIPTS)/program.mk
 
 SimpleMath: prereqs StandAlone/Benchmarks/SimpleMath
+
+##############################################
+# DWDatabase concurrent get/put Benchmark
+
+SRCS    := $(SRCDIR)/DWDatabaseBench.cc
+
+PROGRAM := $(SRCDIR)/DWDatabaseBench
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  PSELIBS := $(ALL_STATIC_PSE_LIBS)
+else # Non-static build
+  ifeq ($(LARGESOS),yes)
+    PSELIBS := Datflow Packages/Uintah
+  else
+    PSELIBS := $(ALL_PSE_LIBS)
+  endif
+endif
+
+PSELIBS := $(GPU_EXTRA_LINK) $(PSELIBS)
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  LIBS := $(CORE_STATIC_LIBS) $(ZOLTAN_LIBRARY)    \
+          $(BOOST_LIBRARY)         \
+          $(EXPRLIB_LIBRARY) $(SPATIALOPS_LIBRARY) \
+          $(TABPROPS_LIBRARY) $(RADPROPS_LIBRARY)  \
+          $(M_LIBRARY) $(PIDX_LIBRARY)
+else
+  LIBS := $(XML2_LIBRARY) $(MPI_LIBRARY) $(F_LIBRARY) \
+          $(BLAS_LIBRARY) $(CUDA_LIBRARY) $(PIDX_LIBRARY)
+endif
+
+include $(SCIRUN_SCRIPTS)/program.mk
+
+DWDatabaseBench: prereqs StandAlone/Benchmarks/DWDatabaseBench
+
+##############################################
+# Task fusion Benchmark
+
+SRCS    := $(SRCDIR)/TaskFusionBench.cc
+
+PROGRAM := $(SRCDIR)/TaskFusionBench
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  PSELIBS := $(ALL_STATIC_PSE_LIBS)
+else # Non-static build
+  ifeq ($(LARGESOS),yes)
+    PSELIBS := Datflow Packages/Uintah
+  else
+    PSELIBS := $(ALL_PSE_LIBS)
+  endif
+endif
+
+PSELIBS := $(GPU_EXTRA_LINK) $(PSELIBS)
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  LIBS := $(CORE_STATIC_LIBS) $(ZOLTAN_LIBRARY)    \
+          $(BOOST_LIBRARY)         \
+          $(EXPRLIB_LIBRARY) $(SPATIALOPS_LIBRARY) \
+          $(TABPROPS_LIBRARY) $(RADPROPS_LIBRARY)  \
+          $(M_LIBRARY) $(PIDX_LIBRARY)
+else
+  LIBS := $(XML2_LIBRARY) $(MPI_LIBRARY) $(F_LIBRARY) \
+          $(BLAS_LIBRARY) $(CUDA_LIBRARY) $(PIDX_LIBRARY)
+endif
+
+include $(SCIRUN_SCRIPTS)/program.mk
+
+TaskFusionBench: prereqs StandAlone/Benchmarks/TaskFusionBench
+
+##############################################
+# Particle sort Benchmark
+
+SRCS    := $(SRCDIR)/ParticleSortBench.cc
+
+PROGRAM := $(SRCDIR)/ParticleSortBench
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  PSELIBS := $(ALL_STATIC_PSE_LIBS)
+else # Non-static build
+  ifeq ($(LARGESOS),yes)
+    PSELIBS := Datflow Packages/Uintah
+  else
+    PSELIBS := $(ALL_PSE_LIBS)
+  endif
+endif
+
+PSELIBS := $(GPU_EXTRA_LINK) $(PSELIBS)
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  LIBS := $(CORE_STATIC_LIBS) $(ZOLTAN_LIBRARY)    \
+          $(BOOST_LIBRARY)         \
+          $(EXPRLIB_LIBRARY) $(SPATIALOPS_LIBRARY) \
+          $(TABPROPS_LIBRARY) $(RADPROPS_LIBRARY)  \
+          $(M_LIBRARY) $(PIDX_LIBRARY)
+else
+  LIBS := $(XML2_LIBRARY) $(MPI_LIBRARY) $(F_LIBRARY) \
+          $(BLAS_LIBRARY) $(CUDA_LIBRARY) $(PIDX_LIBRARY)
+endif
+
+include $(SCIRUN_SCRIPTS)/program.mk
+
+ParticleSortBench: prereqs StandAlone/Benchmarks/ParticleSortBench
+
+##############################################
+# Constitutive model batched stress update Benchmark
+
+SRCS    := $(SRCDIR)/ConstitutiveBlockBench.cc
+
+PROGRAM := $(SRCDIR)/ConstitutiveBlockBench
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  PSELIBS := $(ALL_STATIC_PSE_LIBS)
+else # Non-static build
+  ifeq ($(LARGESOS),yes)
+    PSELIBS := Datflow Packages/Uintah
+  else
+    PSELIBS := $(ALL_PSE_LIBS)
+  endif
+endif
+
+PSELIBS := $(GPU_EXTRA_LINK) $(PSELIBS)
+
+ifeq ($(IS_STATIC_BUILD),yes)
+  LIBS := $(CORE_STATIC_LIBS) $(ZOLTAN_LIBRARY)    \
+          $(BOOST_LIBRARY)         \
+          $(EXPRLIB_LIBRARY) $(SPATIALOPS_LIBRARY) \
+          $(TABPROPS_LIBRARY) $(RADPROPS_LIBRARY)  \
+          $(M_LIBRARY) $(PIDX_LIBRARY)
+else
+  LIBS := $(XML2_LIBRARY) $(MPI_LIBRARY) $(F_LIBRARY) \
+          $(BLAS_LIBRARY) $(CUDA_LIBRARY) $(PIDX_LIBRARY)
+endif
+
+include $(SCIRUN_SCRIPTS)/program.mk
+
+ConstitutiveBlockBench: prereqs StandAlone/Benchmarks/ConstitutiveBlockBench
@@ -57,10 +57,12 @@
 #include <Core/Util/ProgressiveWarning.h>
 #include <Core/Util/StringUtil.h>
 #include <algorithm>
+#include <cfloat>
 #include <cmath>
 #include <iomanip>
 #include <iterator>
 #include <iostream>
+#include <map>
 
 #include <sstream>
 #include <string>
@@ -115,7 +117,9 @@ usage(const std::string& badarg, const std::string& progname)
   cerr << "  -skip_unknown_types              (Skip variable comparisons of unknown types without error)\n";
   cerr << "  -ignoreVariables [var1,var2....] (Skip these variables. Comma delimited list, no spaces.)\n";
   cerr << "  -compareVariables[var1,var2....] (Only these variables are compared. Comma delimited list, no spaces.)\n";
-  cerr << "  -dont_sort                       (Don't sort the variable names before comparing them)";
+  cerr << "  -dont_sort                       (Don't sort the variable names before comparing them)\n";
+  cerr << "  -report_error                    (Report the largest difference of each scalar grid variable,\n"
+       << "                                    e.g. the error of lossy compressed output)";
   cerr << "\nNote: The absolute and relative tolerance tests must both fail\n"
        << "      for a comparison to fail.\n\n";
   cerr << "  Exit values:\n";
@@ -140,6 +144,16 @@ bool m_tolerance_error       = false;
 bool m_concise               = false; // If true (and m_tolerance_error), only print 1st error per var.
 bool m_strict_types          = true;
 bool m_includeExtraCells     = false;
+bool m_report_error          = false;
+
+// -report_error: largest difference and range of the uda 1 values of
+// each (variable, material) over all patches and timesteps.
+struct ErrorReport {
+  double maxError{ 0.0 };
+  double low{  DBL_MAX };
+  double high{ -DBL_MAX };
+};
+map< pair<string, int>, ErrorReport > m_error_reports;
 
 
 //______________________________________________________________________
@@ -347,6 +361,55 @@ compare( const Matrix3 & a,
 }
 
 
+//______________________________________________________________________
+//  Scalar value of a field entry, for -report_error
+template <class T>
+bool
+scalarValue( const T & /* a */, double & /* value */ )
+{
+  return false;
+}
+
+bool
+scalarValue( double a, double & value )
+{
+  value = a;
+  return true;
+}
+
+bool
+scalarValue( float a, double & value )
+{
+  value = a;
+  return true;
+}
+
+//______________________________________________________________________
+//
+void
+printErrorReports()
+{
+  if( m_error_reports.empty() ) {
+    return;
+  }
+
+  cerr << "\nLargest differences (" << m_filebase2 << " - " << m_filebase1 << "):\n";
+
+  for( auto & report : m_error_reports ) {
+    const ErrorReport & r = report.second;
+    const double range    = r.high - r.low;
+
+    cerr << "  " << setw(30) << left << report.first.first << right
+         << " matl " << setw(3) << report.first.second
+         << "  max abs error " << setw(13) << r.maxError
+         << "  range [" << r.low << ", " << r.high << "]";
+    if( range > 0 ) {
+      cerr << "  max error/range " << r.maxError / range;
+    }
+    cerr << "\n";
+  }
+}
+
 /**********************************************************************
  * MaterialParticleVarData and MaterialParticleData are for comparing
  * ParticleVariables when the patch distributions are different in the
@@ -1233,6 +1296,16 @@ SpecificFieldComparator<Field, Iterator>::compareFields( DataArchive
         field2 = (*findIter).second;
       }
 
+      if (m_report_error) {
+        double value1, value2;
+        if (scalarValue(field[*iter], value1) && scalarValue((*field2)[*iter], value2)) {
+          ErrorReport & report = m_error_reports[ make_pair(var_name, matl) ];
+          report.maxError = std::max(report.maxError, fabs(value2 - value1));
+          report.low      = std::min(report.low,  value1);
+          report.high     = std::max(report.high, value1);
+        }
+      }
+
       if (!compare(field[*iter], (*field2)[*iter], abs_tolerance, rel_tolerance)) {
 
         cerr << "DIFFERENCE " << *iter << "  ";
@@ -1393,6 +1466,9 @@ main( int argc, char** argv )
     else if(s == "CONCISE") {
       m_concise = true;
     }
+    else if(s == "REPORT_ERROR") {
+      m_report_error = true;
+    }
     else if(s == "DONT_SORT") {
       sortVariables = false;
     }
@@ -2144,6 +2220,8 @@ main( int argc, char** argv )
 
     delete da1;
     delete da2;
+
+    printErrorReports();
   } catch (Exception& e) {
     cerr << "Caught exception: " << e.message() << '\n';
     abort();
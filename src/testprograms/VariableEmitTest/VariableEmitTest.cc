@@ -0,0 +1,158 @@
+/*
+ * The MIT License
+ *
+ * Copyright (c) 1997-2021 The University of Utah
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ *  VariableEmitTest.cc: Writes a CCVariable<double> with Variable::emit,
+ *  with every compression codec and with and without
+ *  outputDoubleAsFloat, and reads it back with Variable::read the way
+ *  the DataArchive does (into a CCVariable<float> for doubles output as
+ *  floats).
+ */
+
+#include <CCA/Ports/InputContext.h>
+#include <CCA/Ports/OutputContext.h>
+#include <Core/Grid/Variables/CCVariable.h>
+#include <Core/Grid/Variables/CellIterator.h>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <string>
+#include <unistd.h>
+
+using namespace Uintah;
+
+const double LOSSY_BOUND = 1.e-6;
+
+// Emits [low, high) of 'var' and reads it back into 'result'.
+template <class T>
+bool
+roundTrip( CCVariable<double> & var,
+           const IntVector    & low,
+           const IntVector    & high,
+           const std::string  & compression,
+           bool                 outputDoubleAsFloat,
+           CCVariable<T>      & result,
+           std::string        & codecUsed )
+{
+  std::string buffer;
+  OutputContext oc( &buffer, "VariableEmitTest", 0, nullptr, outputDoubleAsFloat );
+  var.emit( oc, low, high, compression );
+  codecUsed = oc.compression;
+
+  if( oc.cur != (long) buffer.size() ) {
+    std::cout << "Error: emit() reported " << oc.cur << " bytes, staged " << buffer.size() << "\n";
+    return false;
+  }
+
+  char filename[] = "/tmp/VariableEmitTestXXXXXX";
+  int fd = mkstemp( filename );
+  if( fd == -1 || write( fd, buffer.data(), buffer.size() ) != (ssize_t) buffer.size() ) {
+    std::cout << "Error: could not write " << filename << "\n";
+    return false;
+  }
+  lseek( fd, 0, SEEK_SET );
+
+  result.allocate( low, high );
+  InputContext ic( fd, filename, 0 );
+  static_cast<Variable&>( result ).read( ic, buffer.size(), false, sizeof(size_t), codecUsed );
+
+  close( fd );
+  unlink( filename );
+  return true;
+}
+
+int main()
+{
+  const IntVector low( 0, 0, 0 );
+  const IntVector high( 17, 9, 5 );
+
+  // One layer of extra cells that is not written, so the emitted
+  // region is not contiguous in memory.
+  CCVariable<double> var;
+  var.allocate( low - IntVector( 1, 1, 1 ), high + IntVector( 1, 1, 1 ) );
+  var.initialize( -1.e30 );
+
+  for( CellIterator iter( low, high ); !iter.done(); iter++ ) {
+    const IntVector c = *iter;
+    var[c] = 1000.0 * sin( 0.3 * c.x() ) * cos( 0.2 * c.y() ) + 0.1 * c.z() + 1.e-9 * c.x();
+  }
+
+  const char * codecs[] = { "", "gzip", "shuffle-zlib", "block-zlib", "lossy:abs=1e-6" };
+
+  int failures = 0;
+
+  for( const char * codec : codecs ) {
+    for( int asFloat = 0; asFloat < 2; asFloat++ ) {
+
+      const std::string compression( codec );
+      const bool        lossy = ( compression.compare( 0, 5, "lossy" ) == 0 );
+      std::string       codecUsed;
+      double            maxError = 0.0;
+      bool              ok;
+
+      if( asFloat ) {
+        CCVariable<float> result;
+        ok = roundTrip( var, low, high, compression, true, result, codecUsed );
+        for( CellIterator iter( low, high ); ok && !iter.done(); iter++ ) {
+          maxError = std::max( maxError, std::fabs( (double) result[*iter] - (double) (float) var[*iter] ) );
+        }
+      }
+      else {
+        CCVariable<double> result;
+        ok = roundTrip( var, low, high, compression, false, result, codecUsed );
+        for( CellIterator iter( low, high ); ok && !iter.done(); iter++ ) {
+          maxError = std::max( maxError, std::fabs( result[*iter] - var[*iter] ) );
+        }
+      }
+
+      // Doubles output as floats are already rounded, a lossy codec is
+      // replaced by its lossless one.
+      std::string expected = compression.substr( 0, compression.find( ':' ) );
+      if( lossy && asFloat ) {
+        expected = "shuffle-zlib";
+      }
+
+      const double tolerance = ( lossy && !asFloat ) ? LOSSY_BOUND : 0.0;
+
+      std::cout << "codec '" << compression << "'" << ( asFloat ? " as float" : "" )
+                << ": written with '" << codecUsed << "', max error " << maxError << "\n";
+
+      if( !ok || codecUsed != expected || maxError > tolerance ) {
+        std::cout << "Error: expected codec '" << expected << "' and max error <= " << tolerance << "\n";
+        failures++;
+      }
+    }
+  }
+
+  if( failures ) {
+    std::cout << failures << " test(s) failed\n";
+    return 1;
+  }
+
+  std::cout << "All tests passed\n";
+  return 0;
+}
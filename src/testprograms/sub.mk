@@ -41,7 +41,8 @@ SUBDIRS := \
         $(SRCDIR)/RegionTest              \
         $(SRCDIR)/CubeRootTest            \
         $(SRCDIR)/SFCTest                 \
-        $(SRCDIR)/PatchBVH
+        $(SRCDIR)/PatchBVH                \
+        $(SRCDIR)/VariableEmitTest
 
 include $(SCIRUN_SCRIPTS)/recurse.mk
 